@@ -0,0 +1,134 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <ompl/base/SpaceInformation.h>
+#include <ompl/base/spaces/FixedRealVectorStateSpace.h>
+#include <ompl/base/spaces/FixedSE3StateSpace.h>
+#include <ompl/base/spaces/StaticCompoundStateSpace.h>
+#include <ompl/datastructures/NearestNeighborsGNAT.h>
+#include <ompl/util/Time.h>
+
+#include <boost/lexical_cast.hpp>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ob = ompl::base;
+
+// Time nearest neighbor queries and motion checks in \e space. The distance function of the nearest neighbors
+// structure calls the space through its actual type, as TypedSpaceInformation-style code would.
+template <typename Space>
+static void run(const std::string &name, const std::shared_ptr<Space> &space, unsigned int n)
+{
+    space->setup();
+    auto si(std::make_shared<ob::SpaceInformation>(space));
+    si->setStateValidityChecker([](const ob::State *) { return true; });
+    si->setup();
+
+    std::vector<ob::State *> states(n);
+    auto sampler = space->allocDefaultStateSampler();
+    ompl::time::point start = ompl::time::now();
+    for (auto &state : states)
+    {
+        state = space->allocState();
+        sampler->sampleUniform(state);
+    }
+    double alloc = ompl::time::seconds(ompl::time::now() - start);
+
+    const Space *typed = space.get();
+    ompl::NearestNeighborsGNAT<ob::State *> nn;
+    nn.setDistanceFunction([typed](const ob::State *a, const ob::State *b) { return typed->distance(a, b); });
+    start = ompl::time::now();
+    nn.add(states);
+    std::vector<ob::State *> nbh;
+    for (ob::State *state : states)
+        nn.nearestK(state, 10, nbh);
+    double nearest = ompl::time::seconds(ompl::time::now() - start);
+
+    start = ompl::time::now();
+    unsigned int valid = 0;
+    for (std::size_t i = 1; i < states.size(); ++i)
+        valid += si->checkMotion(states[i - 1], states[i]) ? 1 : 0;
+    double motions = ompl::time::seconds(ompl::time::now() - start);
+
+    for (auto &state : states)
+        space->freeState(state);
+    std::cout << name << '\t' << alloc << '\t' << nearest << '\t' << motions << '\t' << valid << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int n = 5000;
+    if (argc > 1)
+        n = boost::lexical_cast<unsigned int>(argv[1]);
+
+    ob::RealVectorBounds bounds(3);
+    bounds.setLow(-1);
+    bounds.setHigh(1);
+
+    std::cout << "space\tallocation (s)\tnearestK (s)\tmotion checks (s)\tvalid motions" << std::endl;
+
+    auto rv7(std::make_shared<ob::RealVectorStateSpace>(7));
+    rv7->setBounds(-1, 1);
+    run("RealVectorStateSpace(7)", rv7, n);
+
+    auto frv7(std::make_shared<ob::FixedRealVectorStateSpace<7>>());
+    frv7->setBounds(-1, 1);
+    run("FixedRealVectorStateSpace<7>", frv7, n);
+
+    auto se3(std::make_shared<ob::SE3StateSpace>());
+    se3->setBounds(bounds);
+    run("SE3StateSpace", se3, n);
+
+    auto fse3(std::make_shared<ob::FixedSE3StateSpace>());
+    fse3->setBounds(bounds);
+    run("FixedSE3StateSpace", fse3, n);
+
+    auto compound(std::make_shared<ob::CompoundStateSpace>());
+    auto cse3(std::make_shared<ob::SE3StateSpace>());
+    cse3->setBounds(bounds);
+    auto crv7(std::make_shared<ob::RealVectorStateSpace>(7));
+    crv7->setBounds(-1, 1);
+    compound->addSubspace(cse3, 1.0);
+    compound->addSubspace(crv7, 1.0);
+    run("CompoundStateSpace(SE3, R^7)", compound, n);
+
+    auto fixed(std::make_shared<ob::StaticCompoundStateSpace<ob::FixedSE3StateSpace, ob::FixedRealVectorStateSpace<7>>>());
+    fixed->getTypedSubspace<0>()->setBounds(bounds);
+    fixed->getTypedSubspace<1>()->setBounds(-1, 1);
+    run("StaticCompoundStateSpace<FixedSE3, Fixed R^7>", fixed, n);
+
+    return 0;
+}
@@ -38,7 +38,9 @@
 #include <ompl/base/spaces/SE2StateSpace.h>
 #include <ompl/control/spaces/RealVectorControlSpace.h>
 #include <ompl/control/SimpleSetup.h>
+#include <ompl/util/Time.h>
 #include <ompl/config.h>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -160,7 +162,9 @@ void propagate(const ob::State *start, const oc::Control *control, const double
     SO2.enforceBounds (so2out);
 }
 
-void plan()
+/* Plan for the LTL problem below with an LTLPlanner that expands the lead with the given number
+   of threads. Returns whether a solution was found and stores the planning time in elapsed. */
+bool plan(unsigned int threads, bool verbose, double &elapsed)
 {
     // construct the state space we are planning in
     auto space(std::make_shared<ob::SE2StateSpace>());
@@ -243,11 +247,17 @@ void plan()
     //LTL planner (input: LTL space information, product automaton)
     oc::LTLPlanner ltlPlanner(ltlsi, product);
     ltlPlanner.setProblemDefinition(pdef);
+    ltlPlanner.setThreadCount(threads);
 
     // attempt to solve the problem within thirty seconds of planning time
     // considering the above cosafety/safety automata, a solution path is any
     // path that visits p2 followed by p0 while avoiding obstacles and avoiding p1.
+    ompl::time::point start_time = ompl::time::now();
     ob::PlannerStatus solved = ltlPlanner.ob::Planner::solve(30.0);
+    elapsed = ompl::time::seconds(ompl::time::now() - start_time);
+
+    if (!verbose)
+        return bool(solved);
 
     if (solved)
     {
@@ -259,10 +269,38 @@ void plan()
     }
     else
         std::cout << "No solution found" << std::endl;
+    return bool(solved);
+}
+
+/* Compare the planning time for an increasing number of threads. */
+void benchmark(unsigned int runs)
+{
+    ompl::msg::setLogLevel(ompl::msg::LOG_WARN);
+    std::cout << "threads\tsolved\taverage time (s)" << std::endl;
+    for (unsigned int threads : {1u, 2u, 4u, 8u})
+    {
+        unsigned int solved = 0;
+        double total = 0.;
+        for (unsigned int i = 0; i < runs; ++i)
+        {
+            double elapsed;
+            if (plan(threads, false, elapsed))
+                ++solved;
+            total += elapsed;
+        }
+        std::cout << threads << '\t' << solved << '/' << runs << '\t' << total / runs << std::endl;
+    }
 }
 
-int main(int /*argc*/, char ** /*argv*/)
+int main(int argc, char ** argv)
 {
-    plan();
+    // run with "--benchmark" to compare planning times for several thread counts
+    if (argc > 1 && std::strcmp(argv[1], "--benchmark") == 0)
+        benchmark(20);
+    else
+    {
+        double elapsed;
+        plan(1, true, elapsed);
+    }
     return 0;
 }
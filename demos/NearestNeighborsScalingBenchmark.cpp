@@ -0,0 +1,138 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+#include <ompl/datastructures/NearestNeighborsGNAT.h>
+#include <ompl/datastructures/NearestNeighborsConcurrent.h>
+#include <ompl/util/RandomNumbers.h>
+#include <ompl/util/Time.h>
+
+#include <boost/lexical_cast.hpp>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ob = ompl::base;
+
+using Motion = ob::State;
+
+// Each thread runs an RRT-like loop: sample a state, query its nearest
+// neighbor and insert it. The structure is shared between all threads.
+template <typename Insert, typename Nearest>
+static double run(const ob::StateSpacePtr &space, unsigned int threads, unsigned int opsPerThread,
+                  const Insert &insert, const Nearest &nearest)
+{
+    std::vector<std::vector<ob::State *>> states(threads);
+    for (auto &s : states)
+    {
+        s.reserve(opsPerThread);
+        auto sampler = space->allocDefaultStateSampler();
+        for (unsigned int i = 0; i < opsPerThread; ++i)
+        {
+            s.push_back(space->allocState());
+            sampler->sampleUniform(s.back());
+        }
+    }
+
+    ompl::time::point start = ompl::time::now();
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < threads; ++t)
+        workers.emplace_back([&, t]
+                             {
+                                 for (ob::State *s : states[t])
+                                 {
+                                     nearest(s);
+                                     insert(s);
+                                 }
+                             });
+    for (auto &w : workers)
+        w.join();
+    double elapsed = ompl::time::seconds(ompl::time::now() - start);
+
+    for (auto &s : states)
+        for (ob::State *state : s)
+            space->freeState(state);
+    return (double)threads * opsPerThread / elapsed;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int dim = 6, ops = 20000;
+    if (argc > 1)
+        dim = boost::lexical_cast<unsigned int>(argv[1]);
+    if (argc > 2)
+        ops = boost::lexical_cast<unsigned int>(argv[2]);
+
+    auto space(std::make_shared<ob::RealVectorStateSpace>(dim));
+    space->setBounds(0., 1.);
+    auto distance = [&space](const Motion *a, const Motion *b) { return space->distance(a, b); };
+
+    std::cout << "threads\tGNAT+mutex (ops/s)\tConcurrent (ops/s)" << std::endl;
+    for (unsigned int threads = 1; threads <= 64; threads *= 2)
+    {
+        unsigned int perThread = ops / threads;
+
+        ompl::NearestNeighborsGNAT<Motion *> gnat;
+        gnat.setDistanceFunction(distance);
+        std::mutex lock;
+        double locked = run(space, threads, perThread,
+                            [&](Motion *s)
+                            {
+                                std::lock_guard<std::mutex> _(lock);
+                                gnat.add(s);
+                            },
+                            [&](Motion *s)
+                            {
+                                std::lock_guard<std::mutex> _(lock);
+                                if (gnat.size() > 0)
+                                    gnat.nearest(s);
+                            });
+        gnat.clear();
+
+        ompl::NearestNeighborsConcurrent<Motion *> concurrent;
+        concurrent.setDistanceFunction(distance);
+        double lockFree = run(space, threads, perThread, [&](Motion *s) { concurrent.add(s); },
+                              [&](Motion *s)
+                              {
+                                  if (concurrent.size() > 0)
+                                      concurrent.nearest(s);
+                              });
+        concurrent.clear();
+
+        std::cout << threads << '\t' << locked << '\t' << lockFree << std::endl;
+    }
+    return 0;
+}
@@ -174,6 +174,38 @@ void addPlannerOption(po::options_description &desc, std::vector<enum PLANNER_TY
     desc.add_options()("planner,p", po::value<std::vector<enum PLANNER_TYPE>>(planners)->multitoken(), planner_msg);
 }
 
+const std::string projectionStr[4] = {"SVD", "QR", "LDLT", "QN"};
+
+// Defined in the namespace of the enumeration, so that program options can find them.
+namespace ompl
+{
+    namespace base
+    {
+        std::istream &operator>>(std::istream &in, Constraint::ProjectionMethod &method)
+        {
+            std::string token;
+            in >> token;
+            if (token == "SVD")
+                method = Constraint::PROJECTION_SVD;
+            else if (token == "QR")
+                method = Constraint::PROJECTION_QR;
+            else if (token == "LDLT")
+                method = Constraint::PROJECTION_LDLT;
+            else if (token == "QN")
+                method = Constraint::PROJECTION_QUASI_NEWTON;
+            else
+                in.setstate(std::ios_base::failbit);
+
+            return in;
+        }
+
+        std::ostream &operator<<(std::ostream &out, const Constraint::ProjectionMethod &method)
+        {
+            return out << projectionStr[method];
+        }
+    }
+}
+
 struct ConstrainedOptions
 {
     double delta;
@@ -182,6 +214,7 @@ struct ConstrainedOptions
     double time;
     unsigned int tries;
     double range;
+    ob::Constraint::ProjectionMethod projection;
 };
 
 void addConstrainedOptions(po::options_description &desc, struct ConstrainedOptions *options)
@@ -193,6 +226,8 @@ void addConstrainedOptions(po::options_description &desc, struct ConstrainedOpti
     auto tries_msg = "Maximum number sample tries per sample.";
     auto range_msg = "Planner `range` value for planners that support this parameter. Automatically determined "
                      "otherwise (when 0).";
+    auto projection_msg = "Linear solver used in the Newton iterations of the constraint projection. One of:\n"
+                          "SVD (Default), QR, LDLT, QN - Quasi-Newton.";
 
     desc.add_options()("delta,d", po::value<double>(&options->delta)->default_value(om::CONSTRAINED_STATE_SPACE_DELTA),
                        delta_msg);
@@ -206,6 +241,10 @@ void addConstrainedOptions(po::options_description &desc, struct ConstrainedOpti
         "tries", po::value<unsigned int>(&options->tries)->default_value(om::CONSTRAINT_PROJECTION_MAX_ITERATIONS),
         tries_msg);
     desc.add_options()("range,r", po::value<double>(&options->range)->default_value(0), range_msg);
+    desc.add_options()(
+        "projection",
+        po::value<ob::Constraint::ProjectionMethod>(&options->projection)->default_value(ob::Constraint::PROJECTION_SVD),
+        projection_msg);
 }
 
 struct AtlasOptions
@@ -288,6 +327,7 @@ public:
 
         constraint->setTolerance(opt.tolerance);
         constraint->setMaxIterations(opt.tries);
+        constraint->setProjectionMethod(opt.projection);
 
         css->setDelta(opt.delta);
         css->setLambda(opt.lambda);
@@ -522,6 +562,7 @@ public:
         bench->addExperimentParameter("k", "INTEGER", std::to_string(constraint->getManifoldDimension()));
         bench->addExperimentParameter("n - k", "INTEGER", std::to_string(constraint->getCoDimension()));
         bench->addExperimentParameter("space", "INTEGER", std::to_string(type));
+        bench->addExperimentParameter("projection", "INTEGER", std::to_string(c_opt.projection));
 
         request = ot::Benchmark::Request(c_opt.time, 2048, 100, 0.1, true, false, true, true);
 
@@ -0,0 +1,195 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2024, Rice University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Rice University nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <ompl/util/Time.h>
+
+#include "ConstrainedPlanningCommon.h"
+
+/** Sphere manifold, as in ConstrainedPlanningSphere. */
+class SphereConstraint : public ob::Constraint
+{
+public:
+    SphereConstraint() : ob::Constraint(3, 1)
+    {
+    }
+
+    void function(const Eigen::Ref<const Eigen::VectorXd> &x, Eigen::Ref<Eigen::VectorXd> out) const override
+    {
+        out[0] = x.norm() - 1;
+    }
+
+    void jacobian(const Eigen::Ref<const Eigen::VectorXd> &x, Eigen::Ref<Eigen::MatrixXd> out) const override
+    {
+        out = x.transpose().normalized();
+    }
+};
+
+/** Implicit kinematic chain with its end-effector on a sphere, as in ConstrainedPlanningImplicitChain (with one
+ * extra constraint and no obstacles). */
+class ChainConstraint : public ob::Constraint
+{
+public:
+    ChainConstraint(unsigned int links) : ob::Constraint(3 * links, links + 1), links_(links), radius_(links - 2)
+    {
+    }
+
+    void function(const Eigen::Ref<const Eigen::VectorXd> &x, Eigen::Ref<Eigen::VectorXd> out) const override
+    {
+        Eigen::Vector3d joint1 = Eigen::Vector3d::Zero();
+        for (unsigned int i = 0; i < links_; i++)
+        {
+            auto &&joint2 = x.segment(3 * i, 3);
+            out[i] = (joint1 - joint2).norm() - 1;
+            joint1 = joint2;
+        }
+
+        out[links_] = x.tail(3).norm() - radius_;
+    }
+
+    void jacobian(const Eigen::Ref<const Eigen::VectorXd> &x, Eigen::Ref<Eigen::MatrixXd> out) const override
+    {
+        out.setZero();
+
+        Eigen::Vector3d joint1 = Eigen::Vector3d::Zero();
+        for (unsigned int i = 0; i < links_; i++)
+        {
+            auto &&joint2 = x.segment(3 * i, 3);
+            const Eigen::Vector3d d = (joint2 - joint1).normalized();
+            out.row(i).segment(3 * i, 3) = d;
+            if (i > 0)
+                out.row(i).segment(3 * i - 3, 3) = -d;
+            joint1 = joint2;
+        }
+
+        out.row(links_).tail(3) = x.tail(3).normalized();
+    }
+
+private:
+    const unsigned int links_;
+    const double radius_;
+};
+
+/** Time projections and discrete geodesics on \a constraint with every projection method, from the same random
+ * ambient samples. */
+void benchmark(const std::string &name, const ob::ConstraintPtr &constraint, double bound, unsigned int n)
+{
+    const unsigned int dim = constraint->getAmbientDimension();
+    auto rvss = std::make_shared<ob::RealVectorStateSpace>(dim);
+    rvss->setBounds(-bound, bound);
+
+    ompl::RNG rng;
+    std::vector<Eigen::VectorXd> samples(n, Eigen::VectorXd(dim));
+    for (auto &sample : samples)
+        for (unsigned int i = 0; i < dim; ++i)
+            sample[i] = rng.uniformReal(-bound, bound);
+
+    for (auto method : {ob::Constraint::PROJECTION_SVD, ob::Constraint::PROJECTION_QR, ob::Constraint::PROJECTION_LDLT,
+                        ob::Constraint::PROJECTION_QUASI_NEWTON})
+    {
+        constraint->setProjectionMethod(method);
+
+        auto css = std::make_shared<ob::ProjectedStateSpace>(rvss, constraint);
+        auto csi = std::make_shared<ob::ConstrainedSpaceInformation>(css);
+        csi->setStateValidityChecker([](const ob::State *) { return true; });
+        csi->setup();
+
+        std::vector<ob::State *> states(n);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            states[i] = css->allocState();
+            states[i]->as<ob::ConstrainedStateSpace::StateType>()->copy(samples[i]);
+        }
+
+        // Project the samples one at a time
+        unsigned int projected = 0;
+        ompl::time::point start = ompl::time::now();
+        for (auto &state : states)
+            projected += constraint->project(state) ? 1 : 0;
+        double project = ompl::time::seconds(ompl::time::now() - start);
+
+        // Project the samples again, as a batch
+        for (unsigned int i = 0; i < n; ++i)
+            states[i]->as<ob::ConstrainedStateSpace::StateType>()->copy(samples[i]);
+        std::unique_ptr<bool[]> result(new bool[n]);
+        start = ompl::time::now();
+        constraint->projectBatch(states.data(), n, result.get());
+        double projectBatch = ompl::time::seconds(ompl::time::now() - start);
+
+        // Compute the discrete geodesics between consecutive projected samples
+        unsigned int reached = 0;
+        start = ompl::time::now();
+        for (unsigned int i = 1; i < n; ++i)
+            if (result[i - 1] && result[i])
+                reached += css->discreteGeodesic(states[i - 1], states[i], true) ? 1 : 0;
+        double geodesics = ompl::time::seconds(ompl::time::now() - start);
+
+        for (auto &state : states)
+            css->freeState(state);
+
+        std::cout << name << '\t' << method << '\t' << project << '\t' << projectBatch << '\t' << projected << '\t'
+                  << geodesics << '\t' << reached << std::endl;
+    }
+}
+
+auto help_msg = "Shows this help message.";
+auto samples_msg = "Number of random ambient samples to project.";
+auto links_msg = "Number of links in the implicit kinematic chain. Minimum is 4.";
+
+int main(int argc, char **argv)
+{
+    unsigned int samples, links;
+
+    po::options_description desc("Options");
+    desc.add_options()("help,h", help_msg);
+    desc.add_options()("samples,n", po::value<unsigned int>(&samples)->default_value(2000), samples_msg);
+    desc.add_options()("links,l", po::value<unsigned int>(&links)->default_value(5), links_msg);
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") != 0u)
+    {
+        std::cout << desc << std::endl;
+        return 1;
+    }
+
+    ompl::msg::setLogLevel(ompl::msg::LOG_WARN);
+
+    std::cout << "problem\tmethod\tproject (s)\tprojectBatch (s)\tprojected\tgeodesics (s)\treached" << std::endl;
+    benchmark("sphere", std::make_shared<SphereConstraint>(), 2., samples);
+    benchmark("chain", std::make_shared<ChainConstraint>(links), links, samples);
+
+    return 0;
+}
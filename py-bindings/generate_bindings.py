@@ -287,6 +287,13 @@ class ompl_base_generator_t(code_generator_t):
         cls.add_registration_code(
             'def("__bool__", &ompl::base::PlannerStatus::operator bool)')
 
+        # solution improvements are handed out as shared pointers to const objects; the
+        # time stamp is a std::chrono type, which is not exported
+        cls = self.ompl_ns.class_('SolutionImprovement')
+        cls.variable('stamp').exclude()
+        cls.add_registration_code(
+            'bp::register_ptr_to_python< std::shared_ptr< const ompl::base::SolutionImprovement > >();', False)
+
         # Using nullptr as a default value in method arguments causes
         # problems with Boost.Python.
         # See https://github.com/boostorg/python/issues/60
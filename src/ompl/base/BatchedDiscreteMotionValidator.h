@@ -0,0 +1,97 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_BASE_BATCHED_DISCRETE_MOTION_VALIDATOR_
+#define OMPL_BASE_BATCHED_DISCRETE_MOTION_VALIDATOR_
+
+#include "ompl/base/DiscreteMotionValidator.h"
+
+namespace ompl
+{
+    namespace base
+    {
+        /// @cond IGNORE
+        OMPL_CLASS_FORWARD(BatchedDiscreteMotionValidator);
+        /// @endcond
+
+        /** \class ompl::base::BatchedDiscreteMotionValidatorPtr
+            \brief A shared pointer wrapper for ompl::base::BatchedDiscreteMotionValidator */
+
+        /** \brief A motion validator that checks motions at the same resolution as DiscreteMotionValidator, but
+            hands the interpolated states to the StateValidityChecker in batches (see
+            StateValidityChecker::isValid(const State *const *, std::size_t, bool *) const). States along a
+            segment are interpolated into a buffer of at most getBatchSize() states and checked in bisection
+            order (or in sequential order when the last valid state is requested). Checking stops at the first
+            batch that contains an invalid state. */
+        class BatchedDiscreteMotionValidator : public DiscreteMotionValidator
+        {
+        public:
+            /** \brief Constructor */
+            BatchedDiscreteMotionValidator(SpaceInformation *si) : DiscreteMotionValidator(si)
+            {
+            }
+
+            /** \brief Constructor */
+            BatchedDiscreteMotionValidator(const SpaceInformationPtr &si) : DiscreteMotionValidator(si)
+            {
+            }
+
+            ~BatchedDiscreteMotionValidator() override = default;
+
+            bool checkMotion(const State *s1, const State *s2) const override;
+
+            bool checkMotion(const State *s1, const State *s2, std::pair<State *, double> &lastValid) const override;
+
+            /** \brief Set the maximum number of states sent to the state validity checker at once. */
+            void setBatchSize(unsigned int batchSize);
+
+            /** \brief Get the maximum number of states sent to the state validity checker at once. */
+            unsigned int getBatchSize() const
+            {
+                return batchSize_;
+            }
+
+        protected:
+            /** \brief Check the states at the interpolation steps \e steps (out of \e nd) of the motion from \e s1
+                to \e s2, in the order given. Return the position in \e steps of the first invalid state, or
+                steps.size() if all states are valid. */
+            std::size_t checkSteps(const State *s1, const State *s2, int nd, const std::vector<int> &steps) const;
+
+            /** \brief The maximum number of states sent to the state validity checker at once */
+            unsigned int batchSize_{32u};
+        };
+    }
+}
+
+#endif
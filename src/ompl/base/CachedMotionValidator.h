@@ -0,0 +1,195 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_BASE_CACHED_MOTION_VALIDATOR_
+#define OMPL_BASE_CACHED_MOTION_VALIDATOR_
+
+#include "ompl/base/MotionValidator.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace ompl
+{
+    namespace base
+    {
+        /// @cond IGNORE
+        OMPL_CLASS_FORWARD(CachedMotionValidator);
+        /// @endcond
+
+        /** \class ompl::base::CachedMotionValidatorPtr
+            \brief A shared pointer wrapper for ompl::base::CachedMotionValidator */
+
+        /** \brief A motion validator that remembers the results of another motion validator. Motions are
+            identified by a 64-bit hash of the serialized form of each of their two states, so a motion that
+            is checked again is recognized even if its states are different copies (for instance, when a
+            path is simplified or a roadmap is queried again). At most getCapacity() motions are remembered;
+            when the cache is full, the least recently used motion is forgotten.
+
+            The cache is safe to use from several threads at once. Its entries become stale when the state
+            validity checker or the validity checking resolution changes; SpaceInformation clears the cache
+            it manages in that case (see SpaceInformation::enableMotionValidityCache()). A cache constructed
+            by hand must be cleared with clear().
+
+            Motion validators that report the control of the last checked motion (see getCurrentControl())
+            should not be cached, since a remembered result does not update that control. */
+        class CachedMotionValidator : public MotionValidator
+        {
+        public:
+            /** \brief Constructor. Remember the results of \e validator for at most \e capacity motions. */
+            CachedMotionValidator(SpaceInformation *si, MotionValidatorPtr validator, std::size_t capacity = 100000);
+
+            /** \brief Constructor. Remember the results of \e validator for at most \e capacity motions. */
+            CachedMotionValidator(const SpaceInformationPtr &si, MotionValidatorPtr validator,
+                                  std::size_t capacity = 100000);
+
+            ~CachedMotionValidator() override;
+
+            bool checkMotion(const State *s1, const State *s2) const override;
+
+            /** \brief Remembered results are only used if the motion is valid; the last valid state of an
+                invalid motion is always computed by the underlying validator. */
+            bool checkMotion(const State *s1, const State *s2, std::pair<State *, double> &lastValid) const override;
+
+            control::Control *getCurrentControl() const override
+            {
+                return validator_->getCurrentControl();
+            }
+
+            double getControlDuration() const override
+            {
+                return validator_->getControlDuration();
+            }
+
+            /** \brief Get the motion validator whose results are remembered */
+            const MotionValidatorPtr &getMotionValidator() const
+            {
+                return validator_;
+            }
+
+            /** \brief Set the motion validator whose results are remembered. This clears the cache. */
+            void setMotionValidator(const MotionValidatorPtr &validator);
+
+            /** \brief Set the maximum number of remembered motions. This clears the cache. */
+            void setCapacity(std::size_t capacity);
+
+            /** \brief Get the maximum number of remembered motions */
+            std::size_t getCapacity() const
+            {
+                return capacity_;
+            }
+
+            /** \brief If \e symmetric is true, the motion from \e s2 to \e s1 is assumed to have the same
+                validity as the motion from \e s1 to \e s2, so both share a cache entry. This is false by
+                default. Changing this setting clears the cache. */
+            void setSymmetric(bool symmetric);
+
+            /** \brief Check whether motions in both directions share a cache entry */
+            bool getSymmetric() const
+            {
+                return symmetric_;
+            }
+
+            /** \brief Forget all remembered motions. Call this whenever the validity of motions may have
+                changed, for instance after changing the state validity checker. */
+            void clear();
+
+            /** \brief Get the number of remembered motions */
+            std::size_t size() const;
+
+            /** \brief Get the number of checks answered from the cache */
+            std::uint64_t getHitCount() const
+            {
+                return hits_;
+            }
+
+            /** \brief Get the number of checks passed on to the underlying motion validator */
+            std::uint64_t getMissCount() const
+            {
+                return misses_;
+            }
+
+            /** \brief Get the fraction of checks answered from the cache */
+            double getHitRate() const
+            {
+                std::uint64_t hits = hits_, misses = misses_;
+                return hits == 0 ? 0.0 : (double)hits / (double)(hits + misses);
+            }
+
+            /** \brief Reset the hit and miss counts */
+            void resetCacheStatistics()
+            {
+                hits_ = misses_ = 0;
+            }
+
+        private:
+            /** \brief The hashes of the start and end state of a motion */
+            struct Key
+            {
+                std::uint64_t from;
+                std::uint64_t to;
+            };
+
+            /** \brief A part of the cache with its own lock and its own least-recently-used order */
+            struct Shard;
+
+            /** \brief Compute the key of the motion from \e s1 to \e s2 */
+            Key makeKey(const State *s1, const State *s2) const;
+
+            /** \brief The shard \e key belongs to */
+            Shard &getShard(const Key &key) const;
+
+            /** \brief Look up \e key: 1 if the motion is remembered as valid, -1 if it is remembered as
+                invalid and 0 if it is not remembered */
+            int lookup(const Key &key) const;
+
+            /** \brief Remember the validity of the motion identified by \e key */
+            void store(const Key &key, bool valid) const;
+
+            MotionValidatorPtr validator_;
+
+            std::size_t capacity_;
+
+            bool symmetric_{false};
+
+            std::unique_ptr<Shard[]> shards_;
+
+            mutable std::atomic<std::uint64_t> hits_{0};
+
+            mutable std::atomic<std::uint64_t> misses_{0};
+        };
+    }
+}
+
+#endif
@@ -44,6 +44,7 @@
 
 #include <Eigen/Core>
 #include <Eigen/Dense>
+#include <cstddef>
 #include <utility>
 
 namespace ompl
@@ -75,6 +76,32 @@ namespace ompl
         class Constraint
         {
         public:
+            /** \brief The method used to solve the linear system in each
+             iteration of the projection routine. All methods compute the
+             minimum norm Newton step when the Jacobian has full rank. */
+            enum ProjectionMethod
+            {
+                /** \brief Singular value decomposition of the Jacobian. This
+                 is the slowest method, but the most robust near
+                 singularities. This is the default. */
+                PROJECTION_SVD,
+
+                /** \brief QR decomposition of the transposed Jacobian. */
+                PROJECTION_QR,
+
+                /** \brief Robust Cholesky (LDLT) decomposition of the product
+                 of the Jacobian with its transpose. This only factors a
+                 coDim by coDim matrix, which is cheap for constraints of low
+                 co-dimension. */
+                PROJECTION_LDLT,
+
+                /** \brief Quasi-Newton (chord) method. The Jacobian and its
+                 LDLT factorization are computed at the initial state and
+                 reused in later iterations, and only recomputed when the
+                 residual stops decreasing quickly. */
+                PROJECTION_QUASI_NEWTON
+            };
+
             /** \brief Constructor. The dimension of the ambient configuration
              space as well as the dimension of the function's output need to be
              specified (the co-dimension of the constraint manifold). I.E., for
@@ -206,6 +233,20 @@ namespace ompl
                 tolerance_ = tolerance;
             }
 
+            /** \brief Returns the method used to solve the linear system in
+             * each iteration of the projection routine. */
+            ProjectionMethod getProjectionMethod() const
+            {
+                return method_;
+            }
+
+            /** \brief Sets the method used to solve the linear system in each
+             * iteration of the projection routine. */
+            void setProjectionMethod(ProjectionMethod method)
+            {
+                method_ = method;
+            }
+
             /** \brief Sets the maximum number of iterations in the projection
              * routine. */
             void setMaxIterations(const unsigned int iterations)
@@ -232,6 +273,10 @@ namespace ompl
             /** \brief Maximum number of iterations for Newton method used in
              * projection onto manifold. */
             unsigned int maxIterations_;
+
+            /** \brief Linear solver used by the Newton method used in
+             * projection onto manifold. */
+            ProjectionMethod method_{PROJECTION_SVD};
         };
 
         /// @cond IGNORE
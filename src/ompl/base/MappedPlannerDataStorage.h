@@ -0,0 +1,304 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_BASE_MAPPED_PLANNER_DATA_STORAGE_
+#define OMPL_BASE_MAPPED_PLANNER_DATA_STORAGE_
+
+#include "ompl/base/PlannerData.h"
+#include "ompl/base/SpaceInformation.h"
+#include "ompl/base/spaces/RealVectorStateSpace.h"
+#include "ompl/util/ClassForward.h"
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ompl
+{
+    namespace base
+    {
+        /// @cond IGNORE
+        OMPL_CLASS_FORWARD(MappedPlannerDataStorage);
+        /// @endcond
+
+        /** \brief Flat, versioned on-disk format for roadmaps that is memory-mapped and used in place.
+
+            A file is a sequence of self-describing records. Each record holds the state space
+            signature, a flat array of serialized states, the vertex tags and start/goal marks, CSR
+            adjacency (source vertices, row offsets and target indices) and one weight per edge.
+            Opening a file maps it with copy-on-write semantics and validates the records; no state
+            is deserialized up front.
+
+            A record either starts a new roadmap or extends the roadmap of the record before it with
+            more vertices and edges (see append()). Extending records let a file be used as an
+            append-only log: the cost of saving depends on the size of the change only, and a record
+            torn by a crash at the end of the file is dropped when the file is opened.
+
+            States handed out by a Roadmap are read-only views into the mapping. For
+            RealVectorStateSpace the view aliases the mapped values directly; for other spaces a
+            state is deserialized the first time it is requested. Writing through
+            Roadmap::getMutableState() only copies the touched pages, never the file.
+
+            Only the base PlannerDataVertex and PlannerDataEdge are stored (state, tag, start/goal
+            marks, edge weight). Use PlannerDataStorage for planner data with derived vertex or edge
+            types, such as control::PlannerData. */
+        class MappedPlannerDataStorage
+        {
+        public:
+            /** \brief Version of the record layout written by this class */
+            static const std::uint32_t VERSION = 2;
+
+            /** \brief Read-only view of one record inside a mapped file. The vertices of the record
+                are numbered from getBaseVertex() within their roadmap; edges refer to vertices by
+                that number, so they may start or end at vertices of the preceding records. */
+            class Roadmap
+            {
+            public:
+                Roadmap(const Roadmap &) = delete;
+                Roadmap &operator=(const Roadmap &) = delete;
+
+                ~Roadmap();
+
+                /** \brief Number of vertices of the roadmap stored in the records before this one.
+                    This is zero for records that start a new roadmap. */
+                std::size_t getBaseVertex() const
+                {
+                    return baseVertex_;
+                }
+
+                /** \brief Number of vertices in this record */
+                std::size_t numVertices() const
+                {
+                    return vertexCount_;
+                }
+
+                /** \brief Number of directed edges in this record */
+                std::size_t numEdges() const
+                {
+                    return edgeCount_;
+                }
+
+                /** \brief The serialized form of vertex \e i, as produced by StateSpace::serialize() */
+                const void *getSerializedState(std::size_t i) const
+                {
+                    return states_ + i * stateStride_;
+                }
+
+                /** \brief The state of vertex \e i. The state is owned by the roadmap and remains
+                    valid while the storage that opened it is open. This function is thread safe. */
+                const State *getState(std::size_t i) const;
+
+                /** \brief Writable access to the state of vertex \e i. Changes are private to this
+                    process and are not written back to the file. */
+                State *getMutableState(std::size_t i)
+                {
+                    return const_cast<State *>(getState(i));
+                }
+
+                /** \brief The tag of vertex \e i */
+                int getTag(std::size_t i) const
+                {
+                    return tags_[i];
+                }
+
+                /** \brief Check whether vertex \e i is a start vertex */
+                bool isStartVertex(std::size_t i) const
+                {
+                    return (marks_[i] & START_MARK) != 0;
+                }
+
+                /** \brief Check whether vertex \e i is a goal vertex */
+                bool isGoalVertex(std::size_t i) const
+                {
+                    return (marks_[i] & GOAL_MARK) != 0;
+                }
+
+                /** \brief Number of adjacency rows. Records written by store() have one row per
+                    vertex, so row \e i holds the edges of vertex \e i. */
+                std::size_t numRows() const
+                {
+                    return rowCount_;
+                }
+
+                /** \brief The roadmap vertex whose outgoing edges are stored in row \e r */
+                std::size_t getSource(std::size_t r) const
+                {
+                    return sources_[r];
+                }
+
+                /** \brief Number of edges in row \e r */
+                std::size_t getEdgeCount(std::size_t r) const
+                {
+                    return rows_[r + 1] - rows_[r];
+                }
+
+                /** \brief Roadmap vertices the edges of row \e r lead to; getEdgeCount(r) entries */
+                const std::uint32_t *getEdges(std::size_t r) const
+                {
+                    return targets_ + rows_[r];
+                }
+
+                /** \brief Weights of the edges of row \e r, in the same order as getEdges(r) */
+                const double *getEdgeWeights(std::size_t r) const
+                {
+                    return weights_ + rows_[r];
+                }
+
+                /** \brief Add the vertices and edges of this record to \e pd. A record that extends a
+                    roadmap must be added right after the records before it, so that the last
+                    getBaseVertex() vertices of \e pd are the ones it extends; returns false otherwise.
+                    The vertices of \e pd refer to the states of this record, so the storage must stay
+                    open for as long as \e pd is used, unless PlannerData::decoupleFromPlanner() is called. */
+                bool toPlannerData(PlannerData &pd) const;
+
+            private:
+                friend class MappedPlannerDataStorage;
+
+                static const std::uint8_t START_MARK = 1;
+                static const std::uint8_t GOAL_MARK = 2;
+
+                Roadmap(StateSpacePtr space, const char *record);
+
+                StateSpacePtr space_;
+
+                std::size_t baseVertex_;
+                std::size_t vertexCount_;
+                std::size_t rowCount_;
+                std::size_t edgeCount_;
+                std::size_t stateStride_;
+
+                const char *states_;
+                const std::int32_t *tags_;
+                const std::uint8_t *marks_;
+                const std::uint32_t *sources_;
+                const std::uint64_t *rows_;
+                const std::uint32_t *targets_;
+                const double *weights_;
+
+                /** \brief Headers of RealVectorStateSpace states whose values alias the mapping */
+                std::unique_ptr<RealVectorStateSpace::StateType[]> views_;
+
+                /** \brief States deserialized on demand, for spaces that cannot alias the mapping */
+                std::unique_ptr<std::atomic<State *>[]> lazy_;
+            };
+
+            MappedPlannerDataStorage();
+
+            ~MappedPlannerDataStorage();
+
+            MappedPlannerDataStorage(const MappedPlannerDataStorage &) = delete;
+            MappedPlannerDataStorage &operator=(const MappedPlannerDataStorage &) = delete;
+
+            /** \brief Check whether \e filename starts with a record in this format */
+            static bool isMappedFile(const char *filename);
+
+            /** \brief Write \e pd as a single record to the stream \e out. Returns false (and
+                writes nothing) if \e pd cannot be represented in this format. */
+            static bool store(const PlannerData &pd, std::ostream &out);
+
+            /** \brief Write the roadmaps in \e pds, one record each, to \e filename. The file is
+                written next to its destination and renamed into place, so files that are currently
+                mapped by other storages are left intact. */
+            static bool store(const std::vector<PlannerDataPtr> &pds, const char *filename);
+
+            /** \brief Write \e pd to \e filename; see store(const std::vector<PlannerDataPtr>&, const char*) */
+            static bool store(const PlannerData &pd, const char *filename);
+
+            /** \brief Write a record that extends a roadmap of \e baseVertex vertices to the stream
+                \e out. \e index gives the roadmap vertex of every vertex of \e pd; the vertices
+                numbered \e baseVertex and up are written, and must be numbered contiguously. Only
+                the edges in \e edges, given as pairs of vertices of \e pd, are written. */
+            static bool append(const PlannerData &pd, const std::vector<unsigned int> &index, std::size_t baseVertex,
+                               const std::vector<std::pair<unsigned int, unsigned int>> &edges, std::ostream &out);
+
+            /** \brief Append already encoded \e records to the end of \e filename. Anything past
+                \e validSize, such as a record torn by a crash, is dropped first. Returns the new
+                size of the file, or zero if the file could not be written. */
+            static std::uint64_t appendRecords(const std::string &records, const char *filename,
+                                               std::uint64_t validSize);
+
+            /** \brief Map \e filename and validate all its records against the state space of
+                \e si. An incomplete record at the end of the file is ignored with a warning. Any
+                previously opened file is closed first. */
+            bool open(const SpaceInformationPtr &si, const char *filename);
+
+            /** \brief Release the mapping and all states handed out by the roadmaps */
+            void close();
+
+            /** \brief Check whether a file is currently open */
+            bool isOpen() const
+            {
+                return region_ != nullptr;
+            }
+
+            /** \brief Size of the open file up to the end of its last complete record */
+            std::uint64_t getValidSize() const
+            {
+                return validSize_;
+            }
+
+            /** \brief Number of records in the open file */
+            std::size_t numRoadmaps() const
+            {
+                return roadmaps_.size();
+            }
+
+            /** \brief Access record \e i of the open file */
+            const Roadmap &getRoadmap(std::size_t i) const
+            {
+                return *roadmaps_[i];
+            }
+
+            /** \brief Access record \e i of the open file */
+            Roadmap &getRoadmap(std::size_t i)
+            {
+                return *roadmaps_[i];
+            }
+
+        private:
+            /** \brief Opaque handle to the mapped region, to keep Boost.Interprocess out of this header */
+            struct Region;
+
+            std::unique_ptr<Region> region_;
+
+            std::vector<std::unique_ptr<Roadmap>> roadmaps_;
+
+            std::uint64_t validSize_{0};
+        };
+    }
+}
+
+#endif
@@ -40,6 +40,7 @@
 #include "ompl/base/State.h"
 #include "ompl/control/Control.h"
 #include "ompl/util/ClassForward.h"
+#include <atomic>
 #include <utility>
 
 namespace ompl
@@ -145,11 +146,11 @@ namespace ompl
             /** \brief The instance of space information this state validity checker operates on */
             SpaceInformation *si_;
 
-            /** \brief Number of valid segments */
-            mutable unsigned int valid_;
+            /** \brief Number of valid segments. Atomic, so motions can be checked from several threads at once. */
+            mutable std::atomic<unsigned int> valid_;
 
-            /** \brief Number of invalid segments */
-            mutable unsigned int invalid_;
+            /** \brief Number of invalid segments. Atomic, so motions can be checked from several threads at once. */
+            mutable std::atomic<unsigned int> invalid_;
         };
     }
 }
@@ -63,14 +63,18 @@ namespace ompl
         class PlannerTerminationCondition
         {
         public:
+            /** \brief Construct a termination condition that only becomes true when terminate() is called. Evaluating
+                it is a single atomic load. */
+            PlannerTerminationCondition();
+
             /** \brief Construct a termination condition. By default, eval() will call the externally specified function
                \e fn to decide whether
                 the planner should terminate. */
             PlannerTerminationCondition(const PlannerTerminationConditionFn &fn);
 
             /** \brief Construct a termination condition that is evaluated every \e period seconds. The evaluation of
-                the condition consists of calling \e fn() in a separate thread. Calls to eval() will always return the
-                last value computed by the call to \e fn(). */
+                the condition consists of calling \e fn() in a timer thread shared by all termination conditions. Once
+                \e fn() returns true, the condition is terminated and eval() returns true. */
             PlannerTerminationCondition(const PlannerTerminationConditionFn &fn, double period);
 
             ~PlannerTerminationCondition() = default;
@@ -97,6 +101,14 @@ namespace ompl
         private:
             class PlannerTerminationConditionImpl;
             std::shared_ptr<PlannerTerminationConditionImpl> impl_;
+
+            friend PlannerTerminationCondition plannerOrTerminationCondition(const PlannerTerminationCondition &c1,
+                                                                             const PlannerTerminationCondition &c2);
+            friend PlannerTerminationCondition plannerAndTerminationCondition(const PlannerTerminationCondition &c1,
+                                                                              const PlannerTerminationCondition &c2);
+            friend PlannerTerminationCondition timedPlannerTerminationCondition(time::duration duration);
+            friend PlannerTerminationCondition
+            exactSolnPlannerTerminationCondition(const ompl::base::ProblemDefinitionPtr &pdef);
         };
 
         /** \brief Simple termination condition that always returns false. The termination condition will never be met
@@ -108,27 +120,31 @@ namespace ompl
         PlannerTerminationCondition plannerAlwaysTerminatingCondition();
 
         /** \brief Combine two termination conditions into one. If either termination condition returns true, this one
-         * will return true as well. */
+         * will return true as well. If neither condition calls a function, the combination does not either: it is
+         * terminated by the conditions it combines. */
         PlannerTerminationCondition plannerOrTerminationCondition(const PlannerTerminationCondition &c1,
                                                                   const PlannerTerminationCondition &c2);
 
         /** \brief Combine two termination conditions into one. Both termination conditions need to return true for this
-         * one to return true. */
+         * one to return true. If neither condition calls a function, the combination does not either: it is
+         * terminated by the conditions it combines. */
         PlannerTerminationCondition plannerAndTerminationCondition(const PlannerTerminationCondition &c1,
                                                                    const PlannerTerminationCondition &c2);
 
-        /** \brief Return a termination condition that will become true \e duration seconds in the future (wall-time) */
+        /** \brief Return a termination condition that will become true \e duration seconds in the future (wall-time).
+         * The deadline is enforced by a timer thread shared by all termination conditions, so evaluating the
+         * condition does not read the clock. */
         PlannerTerminationCondition timedPlannerTerminationCondition(double duration);
 
         /** \brief Return a termination condition that will become true \e duration in the future (wall-time) */
         PlannerTerminationCondition timedPlannerTerminationCondition(time::duration duration);
 
-        /** \brief Return a termination condition that will become true \e duration seconds in the future (wall-time),
-         * but is checked in a separate thread, every \e interval seconds; \e interval must be less than \e duration */
+        /** \brief Return a termination condition that will become true \e duration seconds in the future (wall-time).
+         * \e interval is no longer used; the condition is the same as timedPlannerTerminationCondition(duration). */
         PlannerTerminationCondition timedPlannerTerminationCondition(double duration, double interval);
 
-        /** \brief Return a termination condition that will become true as soon as the problem definition has an exact
-         * solution */
+        /** \brief Return a termination condition that will become true as soon as an exact solution is added to the
+         * problem definition. Once true, the condition remains true even if the solutions are cleared. */
         PlannerTerminationCondition exactSolnPlannerTerminationCondition(const ompl::base::ProblemDefinitionPtr &pdef);
 
         /** \brief A class to run a planner for a specific number of iterations. Casts to a PTC for use with
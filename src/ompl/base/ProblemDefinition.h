@@ -43,6 +43,7 @@
 #include "ompl/base/Cost.h"
 #include "ompl/base/SpaceInformation.h"
 #include "ompl/base/SolutionNonExistenceProof.h"
+#include "ompl/base/SolutionChannel.h"
 #include "ompl/util/Console.h"
 #include "ompl/util/ClassForward.h"
 #include "ompl/base/ScopedState.h"
@@ -144,6 +145,9 @@ namespace ompl
         using ReportIntermediateSolutionFn =
             std::function<void(const Planner *, const std::vector<const base::State *> &, const Cost)>;
 
+        /** \brief The signature of functions notified every time a solution is added to a problem definition */
+        using SolutionAddedFn = std::function<void(const PlannerSolution &)>;
+
         OMPL_CLASS_FORWARD(OptimizationObjective);
 
         /** \brief Definition of a problem to be solved. This includes
@@ -372,13 +376,29 @@ namespace ompl
             /** \brief Add a solution path in a thread-safe manner. Multiple solutions can be set for a goal. */
             void addSolutionPath(const PlannerSolution &sol) const;
 
+            /** \brief Register a function that is called every time a solution is added, from the thread that adds
+                it. Returns an identifier that can be passed to removeSolutionAddedCallback(). */
+            unsigned int addSolutionAddedCallback(const SolutionAddedFn &callback) const;
+
+            /** \brief Stop calling the function registered under the identifier \e id */
+            void removeSolutionAddedCallback(unsigned int id) const;
+
+            /** \brief Get the channel on which improvements of the solution are published as they are found.
+                Exact solutions added with addSolutionPath() are published if they improve on the last published
+                one; optimizing planners also publish the improvements they find while planning. */
+            const SolutionChannelPtr &getSolutionChannel() const
+            {
+                return solutionChannel_;
+            }
+
             /** \brief Get the number of solutions already found */
             std::size_t getSolutionCount() const;
 
             /** \brief Get all the solution paths available for this goal */
             std::vector<PlannerSolution> getSolutions() const;
 
-            /** \brief Forget the solution paths (thread safe). Memory is freed. */
+            /** \brief Forget the solution paths (thread safe). Memory is freed. The next solution is published on the
+                solution channel regardless of its cost. */
             void clearSolutionPaths() const;
 
             /** \brief Returns true if the problem definition has a proof of non existence for a solution */
@@ -425,6 +445,9 @@ namespace ompl
 
             /** \brief The set of solutions computed for this goal (maintains an array of PlannerSolution) */
             PlannerSolutionSetPtr solutions_;
+
+            /** \brief The channel on which solution improvements are published */
+            SolutionChannelPtr solutionChannel_;
         };
     }
 }
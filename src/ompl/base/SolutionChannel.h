@@ -0,0 +1,188 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_BASE_SOLUTION_CHANNEL_
+#define OMPL_BASE_SOLUTION_CHANNEL_
+
+#include "ompl/base/Cost.h"
+#include "ompl/base/Path.h"
+#include "ompl/util/ClassForward.h"
+#include "ompl/util/Time.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace ompl
+{
+    namespace base
+    {
+        /// @cond IGNORE
+        /** \brief Forward declaration of ompl::base::SolutionChannel */
+        OMPL_CLASS_FORWARD(SolutionChannel);
+        OMPL_CLASS_FORWARD(OptimizationObjective);
+        /// @endcond
+
+        /** \class ompl::base::SolutionChannelPtr
+            \brief A shared pointer wrapper for ompl::base::SolutionChannel */
+
+        /** \brief An improvement of the best solution to a planning problem, as published on a SolutionChannel */
+        struct SolutionImprovement
+        {
+            /** \brief The improved solution path, from a start state to the goal. The path is not modified after it
+                is published. */
+            PathPtr path;
+
+            /** \brief The cost of \e path */
+            Cost cost;
+
+            /** \brief The time at which the improvement was published */
+            time::point stamp;
+
+            /** \brief Name of the planner that found the improvement */
+            std::string plannerName;
+
+            /** \brief The number of improvements published on the channel before this one */
+            unsigned int index{0};
+        };
+
+        /** \brief A stream of solution improvements, fed by planners as they find better solutions and read by any
+            number of subscribers.
+
+            Each improvement is stored once, in an immutable node of a singly linked list. Publishers append nodes
+            (publishers are serialized by a mutex, but there is normally only one), while every Subscriber follows
+            the list from its own position without taking any lock. Nodes are reference counted: they are freed as
+            soon as every subscriber has moved past them, so the channel itself only keeps the latest improvement.
+            Subscribers that want to block until an improvement arrives can call Subscriber::wait(). */
+        class SolutionChannel
+        {
+        private:
+            /// @cond IGNORE
+            struct Node;
+            /// @endcond
+
+        public:
+            /** \brief A reader of the improvements published on a channel. A subscriber is meant to be used by one
+                thread at a time; use one subscriber per consuming thread. */
+            class Subscriber
+            {
+            public:
+                /** \brief Follow the improvements published on \e channel after this subscriber is constructed. If
+                    \e includeLatest is true, the last improvement published before is reported as well. */
+                Subscriber(const SolutionChannelPtr &channel, bool includeLatest = true);
+
+                ~Subscriber();
+
+                // non-copyable
+                Subscriber(const Subscriber &) = delete;
+                Subscriber &operator=(const Subscriber &) = delete;
+
+                /** \brief Return the next improvement this subscriber has not seen yet, or nullptr if there is none.
+                    This never blocks. */
+                std::shared_ptr<const SolutionImprovement> next();
+
+                /** \brief Return the most recent improvement, skipping over the ones this subscriber has not seen
+                    yet, or nullptr if there is no unseen improvement. This never blocks. */
+                std::shared_ptr<const SolutionImprovement> latest();
+
+                /** \brief Wait for at most \e timeout seconds for an improvement this subscriber has not seen yet
+                    and return it, or return nullptr if none was published in time. */
+                std::shared_ptr<const SolutionImprovement> wait(double timeout);
+
+            private:
+                SolutionChannelPtr channel_;
+
+                /** \brief The last node this subscriber reported (or the node it started from) */
+                std::shared_ptr<Node> cursor_;
+
+                /** \brief A node to report before following cursor_, if any */
+                std::shared_ptr<Node> pending_;
+            };
+
+            SolutionChannel();
+
+            ~SolutionChannel();
+
+            // non-copyable
+            SolutionChannel(const SolutionChannel &) = delete;
+            SolutionChannel &operator=(const SolutionChannel &) = delete;
+
+            /** \brief Publish \e path of cost \e cost, found by \e plannerName. If \e opt is specified, the path is
+                only published if its cost is better than that of the last published improvement (since the last
+                call to reset()). Return true if the path was published. */
+            bool publish(const PathPtr &path, Cost cost, const std::string &plannerName,
+                         const OptimizationObjective *opt = nullptr);
+
+            /** \brief Forget the cost of the last published improvement, so the next path is published regardless of
+                its cost. Subscribers are not affected. */
+            void reset();
+
+            /** \brief Return true if there is at least one subscriber. Planners can use this to avoid constructing
+                paths nobody will read. */
+            bool hasSubscribers() const
+            {
+                return subscribers_.load(std::memory_order_relaxed) > 0;
+            }
+
+            /** \brief Get the number of improvements published so far */
+            unsigned int getPublishedCount() const;
+
+        private:
+            /** \brief The most recently published node. Only accessed under writeLock_. */
+            std::shared_ptr<Node> tail_;
+
+            /** \brief True if tail_ holds an improvement that publish() should compare against */
+            bool compareToTail_{false};
+
+            /** \brief The number of improvements published so far. Only accessed under writeLock_. */
+            unsigned int published_{0};
+
+            /** \brief Serializes publishers and the creation of subscribers */
+            mutable std::mutex writeLock_;
+
+            /** \brief The number of existing subscribers */
+            std::atomic<unsigned int> subscribers_{0};
+
+            /** \brief The number of subscribers blocked in Subscriber::wait() */
+            std::atomic<unsigned int> waiting_{0};
+
+            /** \brief Lock and condition used only to wake up blocked subscribers */
+            std::mutex waitLock_;
+            std::condition_variable wakeup_;
+        };
+    }
+}
+
+#endif
@@ -40,12 +40,15 @@
 #include "ompl/base/State.h"
 #include "ompl/base/StateValidityChecker.h"
 #include "ompl/base/MotionValidator.h"
+#include "ompl/base/CachedMotionValidator.h"
 #include "ompl/base/StateSpace.h"
+#include "ompl/base/StatePool.h"
 #include "ompl/base/ValidStateSampler.h"
 
 #include "ompl/util/ClassForward.h"
 #include "ompl/util/Console.h"
 #include "ompl/util/Exception.h"
+#include "ompl/util/Tracer.h"
 
 #include <functional>
 #include <utility>
@@ -93,9 +96,18 @@ namespace ompl
             /** \brief Check if a given state is valid or not */
             bool isValid(const State *state) const
             {
+                OMPL_TRACE_SCOPE("isValid");
                 return stateValidityChecker_->isValid(state);
             }
 
+            /** \brief Check the validity of \e n states at once, writing the result for \e states[i] to \e out[i].
+                Return true if all states are valid. */
+            bool isValid(const State *const *states, std::size_t n, bool *out) const
+            {
+                OMPL_TRACE_SCOPE("isValid");
+                return stateValidityChecker_->isValid(states, n, out);
+            }
+
             /** \brief Return the instance of the used state space */
             const StateSpacePtr &getStateSpace() const
             {
@@ -123,6 +135,13 @@ namespace ompl
                 return stateSpace_->distance(state1, state2);
             }
 
+            /** \brief Compute the distances from \e state to the \e n states in \e states (see
+                StateSpace::distanceBatch()) */
+            void distanceBatch(const State *state, const State *const *states, std::size_t n, double *distances) const
+            {
+                stateSpace_->distanceBatch(state, states, n, distances);
+            }
+
             /** \brief Bring the state within the bounds of the state space */
             void enforceBounds(State *state) const
             {
@@ -146,6 +165,7 @@ namespace ompl
             void setStateValidityChecker(const StateValidityCheckerPtr &svc)
             {
                 stateValidityChecker_ = svc;
+                clearMotionValidityCache();
                 setup_ = false;
             }
 
@@ -164,10 +184,18 @@ namespace ompl
 
             /** \brief Set the instance of the motion validity checker
                 to use. Parallel implementations of planners assume
-                this validity checker is thread safe.  */
+                this validity checker is thread safe. If the motion
+                validity cache is enabled, it remembers the results of
+                \e mv from now on. */
             void setMotionValidator(const MotionValidatorPtr &mv)
             {
-                motionValidator_ = mv;
+                if (motionValidityCache_ && mv)
+                    motionValidityCache_->setMotionValidator(mv);
+                else
+                {
+                    motionValidator_ = mv;
+                    motionValidityCache_.reset();
+                }
                 setup_ = false;
             }
 
@@ -192,6 +220,7 @@ namespace ompl
             void setStateValidityCheckingResolution(double resolution)
             {
                 stateSpace_->setLongestValidSegmentFraction(resolution);
+                clearMotionValidityCache();
                 setup_ = false;
             }
 
@@ -204,6 +233,31 @@ namespace ompl
                 return stateSpace_->getLongestValidSegmentFraction();
             }
 
+            /** \brief Remember the results of the motion validator for the \e capacity most recently
+                checked motions, so that motions checked again (by the same or another planner using this
+                instance) are not checked again. If \e symmetric is true, a motion and its reverse share
+                their result. The cache is cleared whenever the state validity checker or the checking
+                resolution changes. See CachedMotionValidator. */
+            void enableMotionValidityCache(std::size_t capacity = 100000, bool symmetric = false);
+
+            /** \brief Stop remembering the results of the motion validator */
+            void disableMotionValidityCache();
+
+            /** \brief Get the motion validity cache (nullptr if the cache is not enabled) */
+            const CachedMotionValidatorPtr &getMotionValidityCache() const
+            {
+                return motionValidityCache_;
+            }
+
+            /** \brief Forget the motions remembered by the motion validity cache, if enabled. Call this
+                when the validity of motions changes without a change of the state validity checker, for
+                instance when the environment the checker refers to is modified. */
+            void clearMotionValidityCache()
+            {
+                if (motionValidityCache_)
+                    motionValidityCache_->clear();
+            }
+
             /** @}*/
 
             /** \brief Return the dimension of the state space */
@@ -247,6 +301,80 @@ namespace ompl
                     stateSpace_->freeState(state);
             }
 
+            /** \brief Enable the state pool: states allocated with allocPooledState() are carved out of slabs
+                of \e slabSize states. If \e resetOnClear is true, freePooledState() does nothing and all pooled
+                states are released at once when the last planner using the pool releases it from
+                Planner::clear() (see acquireStatePool()). A pool that is already enabled is replaced, under the
+                conditions of disableStatePool(). */
+            void enableStatePool(std::size_t slabSize = 4096, bool resetOnClear = false);
+
+            /** \brief Disable the state pool. This throws an exception if planners are registered as users of the
+                pool, or if states allocated from the pool have not been freed, as they could no longer be freed
+                through this instance. */
+            void disableStatePool();
+
+            /** \brief Get the state pool (nullptr if the pool is not enabled) */
+            const StatePoolPtr &getStatePool() const
+            {
+                return statePool_;
+            }
+
+            /** \brief Allocate a state from the state pool, if enabled; otherwise, this is the same as allocState().
+                Use this for states that are kept for a long time, such as the states of tree nodes. */
+            State *allocPooledState() const
+            {
+                return statePool_ ? statePool_->allocState() : stateSpace_->allocState();
+            }
+
+            /** \brief Allocate a state with allocPooledState() and copy \e source into it */
+            State *clonePooledState(const State *source) const
+            {
+                State *copy = allocPooledState();
+                stateSpace_->copyState(copy, source);
+                return copy;
+            }
+
+            /** \brief Free a state allocated with allocPooledState() or clonePooledState() */
+            void freePooledState(State *state) const
+            {
+                if (statePool_)
+                    statePool_->freeState(state);
+                else
+                    stateSpace_->freeState(state);
+            }
+
+            /** \brief Get a state for temporary use by the calling thread. Every thread keeps its own cache of
+                scratch states for this instance, so once the cache has warmed up, no memory is allocated and no
+                lock is taken. The state must be returned with freeScratchState() by the same thread. Scratch
+                states that are returned are released when this instance is destroyed. */
+            State *allocScratchState() const;
+
+            /** \brief Return a state obtained with allocScratchState() to the cache of the calling thread */
+            void freeScratchState(State *state) const;
+
+            /** \brief Register the caller as a user of the state pool, if it is enabled. The returned pool
+                (nullptr if it is not enabled) is kept by the caller and handed to releaseStatePool() when the
+                caller no longer holds pooled states. */
+            StatePoolPtr acquireStatePool() const
+            {
+                if (statePool_)
+                    statePool_->addUser();
+                return statePool_;
+            }
+
+            /** \brief Release a registration obtained with acquireStatePool() and reset \e pool. If \e reset is
+                true and the caller was the last user of a pool in reset-on-clear mode, all pooled states are
+                released at once. Destructors pass false, so that pooled states are only released by an
+                explicit Planner::clear(). */
+            static void releaseStatePool(StatePoolPtr &pool, bool reset = true)
+            {
+                if (pool)
+                {
+                    pool->removeUser(reset);
+                    pool.reset();
+                }
+            }
+
             /** \brief Copy a state to another */
             void copyState(State *destination, const State *source) const
             {
@@ -444,6 +572,18 @@ namespace ompl
              * planning process */
             MotionValidatorPtr motionValidator_;
 
+            /** \brief The optional cache of motion validity; when enabled, it is also the motion validator */
+            CachedMotionValidatorPtr motionValidityCache_;
+
+            /** \brief The optional pool for long-lived states */
+            StatePoolPtr statePool_;
+
+            /** \brief Per-thread caches of scratch states */
+            struct ScratchStates;
+
+            /** \brief The caches of scratch states handed out by allocScratchState() */
+            std::shared_ptr<ScratchStates> scratchStates_;
+
             /** \brief Flag indicating whether setup() has been called on this instance */
             bool setup_;
 
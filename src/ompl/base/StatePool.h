@@ -0,0 +1,199 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_BASE_STATE_POOL_
+#define OMPL_BASE_STATE_POOL_
+
+#include "ompl/base/StateSpace.h"
+#include "ompl/util/ClassForward.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ompl
+{
+    namespace base
+    {
+        /// @cond IGNORE
+        /** \brief Forward declaration of ompl::base::StatePool */
+        OMPL_CLASS_FORWARD(StatePool);
+        /// @endcond
+
+        /** \class ompl::base::StatePoolPtr
+            \brief A shared pointer wrapper for ompl::base::StatePool */
+
+        /** \brief An arena allocator for states of a particular state space.
+
+            For RealVectorStateSpace, SO2StateSpace, SO3StateSpace, SE2StateSpace, SE3StateSpace and
+            CompoundStateSpace instances made of these, states are carved out of large slabs of memory with
+            all their values (and the components of compound states) stored inline, right after the state
+            itself. This replaces the one or more heap allocations per state that StateSpace::allocState()
+            performs and keeps the data of consecutively allocated states next to each other. For other state
+            spaces, states are allocated with StateSpace::allocState() but are still recycled by the pool.
+
+            Freed states are kept on a free list and handed out again. Every thread keeps a small cache of free
+            states, so most calls to allocState() and freeState() take no lock. Alternatively, the pool can work
+            in reset-on-clear mode: freeState() does nothing and all memory is reclaimed at once by clear().
+
+            A pool may be shared by several planners. Each of them registers with addUser() and unregisters with
+            removeUser(); in reset-on-clear mode, the pool is cleared when the last user unregisters and asks
+            for it, so one planner never releases the states of another.
+
+            States allocated by the pool must be freed with freeState() of the same pool (never with
+            StateSpace::freeState()). The state space must not be modified after the pool is constructed.
+            All operations are thread safe, except clear(), which must not run while other threads use the
+            pool. */
+        class StatePool
+        {
+        public:
+            // non-copyable
+            StatePool(const StatePool &) = delete;
+            StatePool &operator=(const StatePool &) = delete;
+
+            /** \brief Construct a pool for states of \e space. Each slab holds \e slabSize states. */
+            StatePool(StateSpacePtr space, std::size_t slabSize = 4096);
+
+            ~StatePool();
+
+            /** \brief Allocate a state */
+            State *allocState();
+
+            /** \brief Return a state to the pool. In reset-on-clear mode, this function does nothing. */
+            void freeState(State *state);
+
+            /** \brief Free all states allocated by the pool at once. Memory is kept for later allocations. */
+            void clear();
+
+            /** \brief Register a user of the pool */
+            void addUser();
+
+            /** \brief Unregister a user of the pool. If \e reset is true, this was the last user and the pool is
+                in reset-on-clear mode, clear() is called. */
+            void removeUser(bool reset);
+
+            /** \brief Get the number of registered users */
+            unsigned int getUserCount() const;
+
+            /** \brief Return true if states are stored inline in slabs (as opposed to being allocated through
+                the state space) */
+            bool isInline() const
+            {
+                return stateSize_ > 0;
+            }
+
+            /** \brief Enable or disable reset-on-clear mode */
+            void setResetOnClear(bool flag)
+            {
+                resetOnClear_ = flag;
+            }
+
+            /** \brief Check whether reset-on-clear mode is enabled */
+            bool getResetOnClear() const
+            {
+                return resetOnClear_;
+            }
+
+            /** \brief Get the number of states currently handed out by the pool */
+            std::size_t size() const;
+
+            /** \brief Get the state space the pool allocates states for */
+            const StateSpacePtr &getStateSpace() const
+            {
+                return space_;
+            }
+
+        private:
+            /** \brief The free states cached by one thread */
+            struct ThreadCache
+            {
+                std::thread::id owner;
+                std::vector<State *> free;
+            };
+
+            /** \brief Allocate a state in a slab (or through the state space, if states are not stored inline) */
+            State *newState();
+
+            /** \brief Find or create the cache of free states of the calling thread */
+            std::vector<State *> &localCache();
+
+            /** \brief The state space states are allocated for */
+            StateSpacePtr space_;
+
+            /** \brief The number of states in one slab */
+            std::size_t slabSize_;
+
+            /** \brief The number of bytes used by an inline state (0 if states are not stored inline) */
+            std::size_t stateSize_;
+
+            /** \brief The slabs of memory (inline mode) */
+            std::vector<std::unique_ptr<char[]>> slabs_;
+
+            /** \brief The slab new states are currently carved from */
+            std::size_t currentSlab_{0};
+
+            /** \brief The number of states carved from the current slab */
+            std::size_t used_{0};
+
+            /** \brief All the states allocated through the state space (when not in inline mode) */
+            std::vector<State *> allocated_;
+
+            /** \brief States that can be handed out again */
+            std::vector<State *> freeList_;
+
+            /** \brief The caches of free states of the threads that used the pool */
+            std::vector<std::unique_ptr<ThreadCache>> threads_;
+
+            /** \brief Unique number of this pool, used to find the cache of a thread */
+            const std::uint64_t instance_;
+
+            /** \brief The number of states handed out */
+            std::atomic<std::size_t> count_{0};
+
+            /** \brief The number of registered users */
+            unsigned int users_{0};
+
+            /** \brief Flag indicating whether reset-on-clear mode is enabled */
+            bool resetOnClear_{false};
+
+            /** \brief Lock for the slabs, the shared free list and the list of thread caches */
+            mutable std::mutex lock_;
+        };
+    }
+}
+
+#endif
@@ -314,6 +314,13 @@ namespace ompl
                */
             virtual double distance(const State *state1, const State *state2) const = 0;
 
+            /** \brief Compute the distances from \e state to each of the \e n states in \e states, writing
+                distance(state, states[i]) to \e distances[i]. Spaces with cheap, non-virtual distance kernels
+                override this to avoid one virtual call per pair; nearest neighbor structures that compare a query
+                to many states can use it. The default implementation calls distance() for each state. */
+            virtual void distanceBatch(const State *state, const State *const *states, std::size_t n,
+                                       double *distances) const;
+
             /** \brief Get the number of chars in the serialization of a state in this space */
             virtual unsigned int getSerializationLength() const;
 
@@ -693,6 +700,14 @@ namespace ompl
 
             double distance(const State *state1, const State *state2) const override;
 
+            /** \brief Compute the distances from \e state to each of the \e n states in \e states. For an instance
+                of exactly this class, the weighted sums of the component distances are computed with one
+                StateSpace::distanceBatch() call per component. Subclasses may redefine distance(), so for them
+                distance() is called for each state, unless they override this function to call
+                distanceBatchByComponent(). */
+            void distanceBatch(const State *state, const State *const *states, std::size_t n,
+                               double *distances) const override;
+
             /** \brief When performing discrete validation of motions,
                 the length of the longest segment that does not
                 require state validation needs to be specified. This
@@ -731,6 +746,12 @@ namespace ompl
             /** \brief Allocate the state components. Called by allocState(). Usually called by derived state spaces. */
             void allocStateComponents(CompoundState *state) const;
 
+            /** \brief Compute the weighted sums of the component distances from \e state to each of the \e n states
+                in \e states, with one StateSpace::distanceBatch() call per component. This is only correct for
+                spaces whose distance() is the weighted sum of the component distances. */
+            void distanceBatchByComponent(const State *state, const State *const *states, std::size_t n,
+                                          double *distances) const;
+
             /** \brief The state spaces that make up the compound state space */
             std::vector<StateSpacePtr> components_;
 
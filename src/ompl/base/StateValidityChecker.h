@@ -39,6 +39,7 @@
 
 #include "ompl/base/State.h"
 #include "ompl/util/ClassForward.h"
+#include <cstddef>
 
 namespace ompl
 {
@@ -110,6 +111,19 @@ namespace ompl
                ompl::base::SpaceInformation::satisfiesBounds(). */
             virtual bool isValid(const State *state) const = 0;
 
+            /** \brief Check the validity of \e n states at once. The validity of \e states[i] is written to
+                \e out[i]. Return true if all the states are valid. Implementations that can amortize work
+                across many states (e.g., collision checkers that operate on batches) should override this
+                function; the default implementation calls isValid() on each state in turn. */
+            virtual bool isValid(const State *const *states, std::size_t n, bool *out) const
+            {
+                bool result = true;
+                for (std::size_t i = 0; i < n; ++i)
+                    if (!(out[i] = isValid(states[i])))
+                        result = false;
+                return result;
+            }
+
             /** \brief Return true if the state \e state is valid. In addition, set \e dist to the distance to the
              * nearest invalid state. */
             virtual bool isValid(const State *state, double &dist) const
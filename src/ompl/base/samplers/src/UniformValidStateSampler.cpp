@@ -36,6 +36,7 @@
 
 #include "ompl/base/samplers/UniformValidStateSampler.h"
 #include "ompl/base/SpaceInformation.h"
+#include "ompl/util/Tracer.h"
 
 ompl::base::UniformValidStateSampler::UniformValidStateSampler(const SpaceInformation *si)
   : ValidStateSampler(si), sampler_(si->allocStateSampler())
@@ -45,6 +46,7 @@ ompl::base::UniformValidStateSampler::UniformValidStateSampler(const SpaceInform
 
 bool ompl::base::UniformValidStateSampler::sample(State *state)
 {
+    OMPL_TRACE_SCOPE("sampleValid");
     unsigned int attempts = 0;
     bool valid = false;
     do
@@ -58,6 +60,7 @@ bool ompl::base::UniformValidStateSampler::sample(State *state)
 
 bool ompl::base::UniformValidStateSampler::sampleNear(State *state, const State *near, const double distance)
 {
+    OMPL_TRACE_SCOPE("sampleValid");
     unsigned int attempts = 0;
     bool valid = false;
     do
@@ -0,0 +1,153 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_BASE_SPACES_FIXED_REAL_VECTOR_STATE_SPACE_
+#define OMPL_BASE_SPACES_FIXED_REAL_VECTOR_STATE_SPACE_
+
+#include "ompl/base/spaces/RealVectorStateSpace.h"
+#include "ompl/util/Exception.h"
+#include <cmath>
+#include <limits>
+#include <string>
+
+namespace ompl
+{
+    namespace base
+    {
+        /** \brief A state space representing R<sup>N</sup>, with N known at compile time.
+
+            This space behaves exactly like RealVectorStateSpace(N) and can be used everywhere a
+            RealVectorStateSpace is expected. States store their values inline, so allocating a state is a single
+            allocation, and the loops of distance(), interpolate(), copyState() and equalStates() have a constant
+            trip count that the compiler unrolls. These functions are final: code that knows the type of the space
+            (e.g., through TypedSpaceInformation::getTypedStateSpace()) calls them without a virtual call and can
+            inline them. The dimension cannot be changed with addDimension(). */
+        template <unsigned int N>
+        class FixedRealVectorStateSpace : public RealVectorStateSpace
+        {
+        public:
+            static_assert(N > 0, "FixedRealVectorStateSpace needs at least one dimension");
+
+            /** \brief The definition of a state in R<sup>N</sup>. The values are stored inside the state. */
+            class StateType : public RealVectorStateSpace::StateType
+            {
+            public:
+                StateType()
+                {
+                    values = storage_;
+                }
+
+            private:
+                double storage_[N];
+            };
+
+            FixedRealVectorStateSpace() : RealVectorStateSpace(N)
+            {
+            }
+
+            ~FixedRealVectorStateSpace() override = default;
+
+            /** \brief The dimension of a FixedRealVectorStateSpace is fixed */
+            void addDimension(double minBound = 0.0, double maxBound = 0.0) = delete;
+
+            /** \brief The dimension of a FixedRealVectorStateSpace is fixed */
+            void addDimension(const std::string &name, double minBound = 0.0, double maxBound = 0.0) = delete;
+
+            unsigned int getDimension() const final
+            {
+                return N;
+            }
+
+            void copyState(State *destination, const State *source) const final
+            {
+                double *d = static_cast<StateType *>(destination)->values;
+                const double *s = static_cast<const StateType *>(source)->values;
+                for (unsigned int i = 0; i < N; ++i)
+                    d[i] = s[i];
+            }
+
+            double distance(const State *state1, const State *state2) const final
+            {
+                const double *s1 = static_cast<const StateType *>(state1)->values;
+                const double *s2 = static_cast<const StateType *>(state2)->values;
+                double dist = 0.0;
+                for (unsigned int i = 0; i < N; ++i)
+                {
+                    double diff = s1[i] - s2[i];
+                    dist += diff * diff;
+                }
+                return std::sqrt(dist);
+            }
+
+            bool equalStates(const State *state1, const State *state2) const final
+            {
+                const double *s1 = static_cast<const StateType *>(state1)->values;
+                const double *s2 = static_cast<const StateType *>(state2)->values;
+                for (unsigned int i = 0; i < N; ++i)
+                    if (std::fabs(s1[i] - s2[i]) > std::numeric_limits<double>::epsilon() * 2.0)
+                        return false;
+                return true;
+            }
+
+            void interpolate(const State *from, const State *to, double t, State *state) const final
+            {
+                const double *f = static_cast<const StateType *>(from)->values;
+                const double *o = static_cast<const StateType *>(to)->values;
+                double *s = static_cast<StateType *>(state)->values;
+                for (unsigned int i = 0; i < N; ++i)
+                    s[i] = f[i] + (o[i] - f[i]) * t;
+            }
+
+            State *allocState() const final
+            {
+                return new StateType();
+            }
+
+            void freeState(State *state) const final
+            {
+                delete static_cast<StateType *>(state);
+            }
+
+            void setup() override
+            {
+                if (dimension_ != N)
+                    throw Exception("FixedRealVectorStateSpace: the dimension of the space must remain " +
+                                    std::to_string(N));
+                RealVectorStateSpace::setup();
+            }
+        };
+    }
+}
+
+#endif
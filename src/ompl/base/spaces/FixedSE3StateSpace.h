@@ -0,0 +1,92 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_BASE_SPACES_FIXED_SE3_STATE_SPACE_
+#define OMPL_BASE_SPACES_FIXED_SE3_STATE_SPACE_
+
+#include "ompl/base/spaces/SE3StateSpace.h"
+
+namespace ompl
+{
+    namespace base
+    {
+        /** \brief A state space representing SE(3), specialized for speed.
+
+            This space has the same components, weights and behavior as SE3StateSpace and can be used everywhere an
+            SE3StateSpace is expected. A state and its two components are allocated as a single block, and
+            distance(), interpolate(), copyState() and equalStates() work on the position and the quaternion directly
+            instead of going through the subspaces. These functions are final, so code that knows the type of the
+            space can call them without a virtual call. */
+        class FixedSE3StateSpace : public SE3StateSpace
+        {
+        public:
+            /** \brief A state in SE(3), with its components stored inside the state */
+            class StateType : public SE3StateSpace::StateType
+            {
+            public:
+                StateType()
+                {
+                    storage_[0] = &position_;
+                    storage_[1] = &rotation_;
+                    components = storage_;
+                    position_.values = xyz_;
+                }
+
+            private:
+                State *storage_[2];
+                RealVectorStateSpace::StateType position_;
+                double xyz_[3];
+                SO3StateSpace::StateType rotation_;
+            };
+
+            FixedSE3StateSpace() = default;
+
+            ~FixedSE3StateSpace() override = default;
+
+            void copyState(State *destination, const State *source) const final;
+
+            double distance(const State *state1, const State *state2) const final;
+
+            bool equalStates(const State *state1, const State *state2) const final;
+
+            void interpolate(const State *from, const State *to, double t, State *state) const final;
+
+            State *allocState() const final;
+
+            void freeState(State *state) const final;
+        };
+    }
+}
+
+#endif
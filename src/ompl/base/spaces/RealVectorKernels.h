@@ -0,0 +1,71 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_BASE_SPACES_REAL_VECTOR_KERNELS_
+#define OMPL_BASE_SPACES_REAL_VECTOR_KERNELS_
+
+namespace ompl
+{
+    namespace base
+    {
+        /** \brief Kernels for operations on arrays of doubles, used by RealVectorStateSpace and other state spaces
+            whose states contain vectors of real values.
+
+            On x86 processors the implementation is selected the first time a kernel is called, based on the
+            instruction set extensions the processor supports (AVX-512, AVX2+FMA). Other processors use a
+            portable implementation that the compiler is free to auto-vectorize. */
+        namespace kernels
+        {
+            /** \brief Return the sum of the squared differences between the \e n elements of \e a and \e b */
+            double squaredDistance(const double *a, const double *b, unsigned int n);
+
+            /** \brief Set \e out[i] = \e from[i] + (\e to[i] - \e from[i]) * \e t for the \e n elements of the
+                arrays. \e out may alias \e from or \e to. */
+            void interpolate(const double *from, const double *to, double t, double *out, unsigned int n);
+
+            /** \brief Clamp the \e n elements of \e values to the interval [\e low[i], \e high[i]] */
+            void clamp(double *values, const double *low, const double *high, unsigned int n);
+
+            /** \brief Check whether the \e n elements of \e values are in [\e low[i] - \e eps, \e high[i] + \e eps] */
+            bool withinBounds(const double *values, const double *low, const double *high, double eps,
+                              unsigned int n);
+
+            /** \brief Get the name of the instruction set the kernels were selected for ("avx512f", "avx2" or
+                "generic") */
+            const char *getInstructionSet();
+        }
+    }
+}
+
+#endif
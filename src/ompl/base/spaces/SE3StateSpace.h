@@ -138,6 +138,12 @@ namespace ompl
             State *allocState() const override;
             void freeState(State *state) const override;
 
+            /** \brief Compute the distances from \e state to each of the \e n states in \e states, with one batch
+                per component. Subclasses may redefine distance(), so for them distance() is called for each
+                state. */
+            void distanceBatch(const State *state, const State *const *states, std::size_t n,
+                               double *distances) const override;
+
             void registerProjections() override;
         };
     }
@@ -140,6 +140,9 @@ namespace ompl
 
             double distance(const State *state1, const State *state2) const override;
 
+            void distanceBatch(const State *state, const State *const *states, std::size_t n,
+                               double *distances) const override;
+
             bool equalStates(const State *state1, const State *state2) const override;
 
             void interpolate(const State *from, const State *to, double t, State *state) const override;
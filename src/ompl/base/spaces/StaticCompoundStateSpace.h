@@ -0,0 +1,154 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_BASE_SPACES_STATIC_COMPOUND_STATE_SPACE_
+#define OMPL_BASE_SPACES_STATIC_COMPOUND_STATE_SPACE_
+
+#include "ompl/base/StateSpace.h"
+#include <memory>
+#include <tuple>
+#include <utility>
+
+namespace ompl
+{
+    namespace base
+    {
+        /** \brief A compound state space whose subspaces have types known at compile time.
+
+            The subspaces are instances of \e Spaces, in order, each with weight 1.0 (weights can still be changed
+            with setSubspaceWeight()). No further subspaces can be added. distance(), interpolate(), copyState() and
+            equalStates() call the functions of the subspaces directly instead of through their virtual tables,
+            which lets the compiler inline them when the subspaces are, e.g., FixedRealVectorStateSpace. These
+            functions are final as well. The space can be used everywhere a CompoundStateSpace is expected. */
+        template <typename... Spaces>
+        class StaticCompoundStateSpace : public CompoundStateSpace
+        {
+        public:
+            /** \brief The type of the subspace at index \e I */
+            template <std::size_t I>
+            using SubspaceType = typename std::tuple_element<I, std::tuple<Spaces...>>::type;
+
+            /** \brief Construct the space from default-constructed subspaces */
+            StaticCompoundStateSpace() : StaticCompoundStateSpace(std::make_shared<Spaces>()...)
+            {
+            }
+
+            /** \brief Construct the space from existing subspaces */
+            StaticCompoundStateSpace(const std::shared_ptr<Spaces> &... spaces)
+            {
+                setName("StaticCompound" + getName());
+                using expand = int[];
+                (void)expand{0, (addSubspace(spaces, 1.0), 0)...};
+                lock();
+            }
+
+            ~StaticCompoundStateSpace() override = default;
+
+            /** \brief Get the subspace at index \e I, with its actual type */
+            template <std::size_t I>
+            SubspaceType<I> *getTypedSubspace() const
+            {
+                return static_cast<SubspaceType<I> *>(components_[I].get());
+            }
+
+            void copyState(State *destination, const State *source) const final
+            {
+                copyState(static_cast<CompoundState *>(destination), static_cast<const CompoundState *>(source),
+                          std::index_sequence_for<Spaces...>());
+            }
+
+            double distance(const State *state1, const State *state2) const final
+            {
+                return distance(static_cast<const CompoundState *>(state1), static_cast<const CompoundState *>(state2),
+                                std::index_sequence_for<Spaces...>());
+            }
+
+            bool equalStates(const State *state1, const State *state2) const final
+            {
+                return equalStates(static_cast<const CompoundState *>(state1),
+                                   static_cast<const CompoundState *>(state2), std::index_sequence_for<Spaces...>());
+            }
+
+            void interpolate(const State *from, const State *to, double t, State *state) const final
+            {
+                interpolate(static_cast<const CompoundState *>(from), static_cast<const CompoundState *>(to), t,
+                            static_cast<CompoundState *>(state), std::index_sequence_for<Spaces...>());
+            }
+
+        private:
+            template <std::size_t... I>
+            void copyState(CompoundState *destination, const CompoundState *source, std::index_sequence<I...>) const
+            {
+                using expand = int[];
+                (void)expand{0, (getTypedSubspace<I>()->SubspaceType<I>::copyState(destination->components[I],
+                                                                                   source->components[I]),
+                                 0)...};
+            }
+
+            template <std::size_t... I>
+            double distance(const CompoundState *state1, const CompoundState *state2, std::index_sequence<I...>) const
+            {
+                double dist = 0.0;
+                using expand = int[];
+                (void)expand{0, (dist += weights_[I] * getTypedSubspace<I>()->SubspaceType<I>::distance(
+                                             state1->components[I], state2->components[I]),
+                                 0)...};
+                return dist;
+            }
+
+            template <std::size_t... I>
+            bool equalStates(const CompoundState *state1, const CompoundState *state2, std::index_sequence<I...>) const
+            {
+                bool equal = true;
+                using expand = int[];
+                (void)expand{0, (equal = equal && getTypedSubspace<I>()->SubspaceType<I>::equalStates(
+                                                      state1->components[I], state2->components[I]),
+                                 0)...};
+                return equal;
+            }
+
+            template <std::size_t... I>
+            void interpolate(const CompoundState *from, const CompoundState *to, double t, CompoundState *state,
+                             std::index_sequence<I...>) const
+            {
+                using expand = int[];
+                (void)expand{0, (getTypedSubspace<I>()->SubspaceType<I>::interpolate(
+                                     from->components[I], to->components[I], t, state->components[I]),
+                                 0)...};
+            }
+        };
+    }
+}
+
+#endif
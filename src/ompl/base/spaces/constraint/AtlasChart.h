@@ -40,6 +40,7 @@
 #include "ompl/base/spaces/constraint/AtlasStateSpace.h"
 #include "ompl/datastructures/PDF.h"
 
+#include <mutex>
 #include <vector>
 #include <Eigen/Core>
 
@@ -66,17 +67,21 @@ namespace ompl
                 /** \brief Create a halfspace equitably separating charts \a
                  * owner and \a neighbor. This halfspace will coincide with
                  * chart \a owner. */
-                Halfspace(const AtlasChart *owner, const AtlasChart *neighbor);
+                Halfspace(AtlasChart *owner, const AtlasChart *neighbor);
 
                 /** \brief Return whether point \a v on the owning chart
                  * lies within the halfspace. */
                 bool contains(const Eigen::Ref<const Eigen::VectorXd> &v) const;
 
-                /** \brief If point \a v on the owning chart is very close to
-                 * the halfspace boundary, the "complementary" halfspace will
-                 * extend its boundary so that it also contains \a v when \a v
-                 * is projected onto the neighboring chart. */
-                void checkNear(const Eigen::Ref<const Eigen::VectorXd> &v) const;
+                /** \brief Return whether point \a v on the owning chart is
+                 * very close to the halfspace boundary, in which case the
+                 * "complementary" halfspace should be expanded to include it. */
+                bool isNear(const Eigen::Ref<const Eigen::VectorXd> &v) const;
+
+                /** \brief Expand the halfspace to include ambient point \a x
+                 * when it is projected onto our chart. \note The caller must
+                 * hold the lock of the owning chart. */
+                void expandToInclude(const Eigen::Ref<const Eigen::VectorXd> &x);
 
                 /** \brief Compute up to two vertices of intersection with a
                  * circle of radius \a r.  If one vertex is found, it is stored
@@ -110,8 +115,14 @@ namespace ompl
                 }
 
             private:
+                friend class AtlasChart;
+
                 /** \brief Chart to which this halfspace belongs. */
-                const AtlasChart *owner_;
+                AtlasChart *owner_;
+
+                /** \brief Position of this halfspace in the polytope of the
+                 * owning chart, once it has been added to it. */
+                std::size_t index_{static_cast<std::size_t>(-1)};
 
                 /** \brief Halfspace complementary to this one, but on the
                  * neighboring chart. */
@@ -136,10 +147,6 @@ namespace ompl
                  * \a u_. That is, \a result * \a u_ lies on the halfspace
                  * boundary, and \a v, \a u_, \a result * \a u_ are colinear. */
                 double distanceToPoint(const Eigen::Ref<const Eigen::VectorXd> &v) const;
-
-                /** \brief Expand the halfspace to include ambient point \a x
-                 * when it is projected onto our chart. */
-                void expandToInclude(const Eigen::Ref<const Eigen::VectorXd> &x);
             };
 
         public:
@@ -196,13 +203,15 @@ namespace ompl
 
             /** \brief Check if a point \a u on the chart lies within its
              * polytope boundary. Can ignore up to 2 of the halfspaces if
-             * specified in \a ignore1 and \a ignore2. */
+             * specified in \a ignore1 and \a ignore2. This is safe to call
+             * while other threads add charts to the atlas. */
             bool inPolytope(const Eigen::Ref<const Eigen::VectorXd> &u, const Halfspace *ignore1 = nullptr,
                             const Halfspace *ignore2 = nullptr) const;
 
             /** \brief Check if chart point \a v lies very close to any part of
              * the boundary. Wherever it does, expand the neighboring chart's
-             * boundary to include. */
+             * boundary to include. This is safe to call while other threads
+             * add charts to the atlas. */
             void borderCheck(const Eigen::Ref<const Eigen::VectorXd> &v) const;
 
             /** \brief Try to find an owner for ambient point \x from among the
@@ -220,6 +229,7 @@ namespace ompl
              * halfspace boundary with. */
             std::size_t getNeighborCount() const
             {
+                std::lock_guard<std::mutex> lock(lock_);
                 return polytope_.size();
             }
 
@@ -241,11 +251,27 @@ namespace ompl
             /** \brief Set of halfspaces defining the polytope boundary. */
             std::vector<Halfspace *> polytope_;
 
+            /** \brief The inequalities of polytope_, stored contiguously so
+             * that inPolytope() does not have to visit every halfspace. Each
+             * halfspace takes k_ + 1 entries: its normal followed by the
+             * right-hand side of the inequality. */
+            std::vector<double> inequalities_;
+
+            /** \brief Lock guarding polytope_ and inequalities_. The lock is
+             * picked from a pool of locks shared by all the charts of the
+             * atlas, and no chart ever holds two of them at once. */
+            std::mutex &lock_;
+
             /** \brief Introduce a new \a halfspace to the chart's bounding
              * polytope. This chart assumes responsibility for deleting \a
              * halfspace. */
             void addBoundary(Halfspace *halfspace);
 
+            /** \brief Same as inPolytope(), without checking the radius of the
+             * chart or taking lock_. */
+            bool withinHalfspaces(const Eigen::Ref<const Eigen::VectorXd> &u, const Halfspace *ignore1 = nullptr,
+                                  const Halfspace *ignore2 = nullptr) const;
+
         private:
             /** \brief Dimension of the ambient space. */
             const unsigned int n_;
@@ -48,6 +48,12 @@
 #include <boost/math/constants/constants.hpp>
 #include <Eigen/Core>
 
+#include <array>
+#include <atomic>
+#include <iosfwd>
+#include <mutex>
+#include <shared_mutex>
+
 namespace ompl
 {
     namespace magic
@@ -59,6 +65,7 @@ namespace ompl
         static const double ATLAS_STATE_SPACE_EXPLORATION = 0.75;
         static const unsigned int ATLAS_STATE_SPACE_MAX_CHARTS_PER_EXTENSION = 200;
         static const double ATLAS_STATE_SPACE_BACKOFF = 0.75;
+        static const unsigned int ATLAS_STATE_SPACE_CHART_LOCKS = 64;
     }
 
     namespace base
@@ -124,7 +131,17 @@ namespace ompl
         */
 
         /** \brief ConstrainedStateSpace encapsulating a planner-agnostic atlas
-         * algorithm for planning on a constraint manifold. */
+         * algorithm for planning on a constraint manifold.
+         *
+         * The atlas can be shared by several threads, e.g., by the planners
+         * of CForest or by a multithreaded planner such as pRRT: sampling,
+         * chart lookup, chart creation and manifold traversal can be called
+         * concurrently. Lookups only take a shared lock on the chart index,
+         * which is held exclusively only to add a chart that has already been
+         * computed. The polytope of each chart is guarded by one of a fixed
+         * pool of locks. Changing the parameters of the atlas, clear(),
+         * anchorChart() and loadAtlas() are not meant to be called while
+         * planning. */
         class AtlasStateSpace : public ConstrainedStateSpace
         {
         public:
@@ -314,6 +331,7 @@ namespace ompl
             /** \brief Return the number of charts currently in the atlas. */
             std::size_t getChartCount() const
             {
+                std::shared_lock<std::shared_timed_mutex> lock(atlasLock_);
                 return charts_.size();
             }
 
@@ -382,7 +400,37 @@ namespace ompl
 
             /** @} */
 
+            /** @name Storage
+                @{ */
+
+            /** \brief Write the atlas to a stream: the anchor states and the
+             * centers of all the charts, in the order they were created. */
+            void saveAtlas(std::ostream &out) const;
+
+            /** \brief Replace the atlas (including anchor charts) with one
+             * written by saveAtlas() for the same manifold. The charts are
+             * recreated at the saved centers, in the same order, so their
+             * halfspace boundaries are separated as they were when first
+             * created.
+             * \throws ompl::Exception if the stream does not hold an atlas
+             * of matching dimensions. */
+            void loadAtlas(std::istream &in);
+
+            /** @} */
+
         protected:
+            friend class AtlasChart;
+
+            /** \brief Delete all the charts, including the anchor charts.
+             * \note The caller must hold atlasLock_ exclusively. */
+            void deleteCharts();
+
+            /** \brief Pick a lock for a new chart to guard its polytope. */
+            std::mutex &chartLock() const
+            {
+                return chartLocks_[nextChartLock_++ % chartLocks_.size()];
+            }
+
             /** \brief Set of states on which there are anchored charts. */
             mutable std::vector<StateType *> anchors_;
 
@@ -396,6 +444,17 @@ namespace ompl
              * nearest-neighbor queries to the chart centers. */
             mutable NearestNeighborsGNAT<NNElement> chartNN_;
 
+            /** \brief Lock guarding anchors_, charts_, chartPDF_ and chartNN_.
+             * Queries take it shared; adding or removing charts takes it
+             * exclusively. */
+            mutable std::shared_timed_mutex atlasLock_;
+
+            /** \brief Pool of locks guarding the polytopes of the charts. */
+            mutable std::array<std::mutex, ompl::magic::ATLAS_STATE_SPACE_CHART_LOCKS> chartLocks_;
+
+            /** \brief The next lock of chartLocks_ to give to a chart. */
+            mutable std::atomic<unsigned int> nextChartLock_{0};
+
             /** @name Tunable Parameters
                 @{ */
 
@@ -427,9 +486,6 @@ namespace ompl
 
             /** \brief Enable or disable halfspace separation of the charts. */
             bool separate_;
-
-            /** \brief Random number generator. */
-            mutable RNG rng_;
         };
     }
 }
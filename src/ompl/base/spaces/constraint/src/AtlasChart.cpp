@@ -42,7 +42,7 @@
 
 /// Public
 
-ompl::base::AtlasChart::Halfspace::Halfspace(const AtlasChart *owner, const AtlasChart *neighbor) : owner_(owner)
+ompl::base::AtlasChart::Halfspace::Halfspace(AtlasChart *owner, const AtlasChart *neighbor) : owner_(owner)
 {
     // Project neighbor's chart center onto our chart.
     Eigen::VectorXd u(owner_->k_);
@@ -58,15 +58,22 @@ bool ompl::base::AtlasChart::Halfspace::contains(const Eigen::Ref<const Eigen::V
     return v.dot(u_) <= rhs_;
 }
 
-void ompl::base::AtlasChart::Halfspace::checkNear(const Eigen::Ref<const Eigen::VectorXd> &v) const
+bool ompl::base::AtlasChart::Halfspace::isNear(const Eigen::Ref<const Eigen::VectorXd> &v) const
 {
     // Threshold is 10% of the distance from the boundary to the origin.
-    if (distanceToPoint(v) < 1.0 / 20)
-    {
-        Eigen::VectorXd x(owner_->n_);
-        owner_->psi(v, x);
-        complement_->expandToInclude(x);
-    }
+    return distanceToPoint(v) < 1.0 / 20;
+}
+
+void ompl::base::AtlasChart::Halfspace::expandToInclude(const Eigen::Ref<const Eigen::VectorXd> &x)
+{
+    // Compute how far v = psiInverse(x) lies past the boundary, if at all.
+    Eigen::VectorXd v(owner_->k_);
+    owner_->psiInverse(x, v);
+    const double t = -distanceToPoint(v);
+
+    // Move u_ further out by twice that much.
+    if (t > 0)
+        setU((1 + 2 * t) * u_);
 }
 
 bool ompl::base::AtlasChart::Halfspace::circleIntersect(const double r, Eigen::Ref<Eigen::VectorXd> v1,
@@ -125,6 +132,14 @@ void ompl::base::AtlasChart::Halfspace::setU(const Eigen::Ref<const Eigen::Vecto
 
     // Precompute the right-hand side of the linear inequality.
     rhs_ = usqnorm_ / 2;
+
+    // Keep the owner's copy of the inequality up to date.
+    if (index_ < owner_->polytope_.size())
+    {
+        double *row = &owner_->inequalities_[index_ * (owner_->k_ + 1)];
+        Eigen::Map<Eigen::VectorXd>(row, owner_->k_) = u_;
+        row[owner_->k_] = rhs_;
+    }
 }
 
 double ompl::base::AtlasChart::Halfspace::distanceToPoint(const Eigen::Ref<const Eigen::VectorXd> &v) const
@@ -133,24 +148,13 @@ double ompl::base::AtlasChart::Halfspace::distanceToPoint(const Eigen::Ref<const
     return (0.5 - v.dot(u_)) / usqnorm_;
 }
 
-void ompl::base::AtlasChart::Halfspace::expandToInclude(const Eigen::Ref<const Eigen::VectorXd> &x)
-{
-    // Compute how far v = psiInverse(x) lies past the boundary, if at all.
-    Eigen::VectorXd v(owner_->k_);
-    owner_->psiInverse(x, v);
-    const double t = -distanceToPoint(v);
-
-    // Move u_ further out by twice that much.
-    if (t > 0)
-        setU((1 + 2 * t) * u_);
-}
-
 /// AtlasChart
 
 /// Public
 
 ompl::base::AtlasChart::AtlasChart(const AtlasStateSpace *atlas, const AtlasStateSpace::StateType *state)
   : constraint_(atlas->getConstraint().get())
+  , lock_(atlas->chartLock())
   , n_(atlas->getAmbientDimension())
   , k_(atlas->getManifoldDimension())
   , state_(state)
@@ -176,10 +180,12 @@ ompl::base::AtlasChart::~AtlasChart()
 
 void ompl::base::AtlasChart::clear()
 {
+    std::lock_guard<std::mutex> lock(lock_);
     for (auto h : polytope_)
         delete h;
 
     polytope_.clear();
+    inequalities_.clear();
 }
 
 void ompl::base::AtlasChart::phi(const Eigen::Ref<const Eigen::VectorXd> &u, Eigen::Ref<Eigen::VectorXd> out) const
@@ -241,31 +247,47 @@ bool ompl::base::AtlasChart::inPolytope(const Eigen::Ref<const Eigen::VectorXd>
     if (u.norm() > radius_)
         return false;
 
-    for (Halfspace *h : polytope_)
-    {
-        if (h == ignore1 || h == ignore2)
-            continue;
-
-        if (!h->contains(u))
-            return false;
-    }
-
-    return true;
+    std::lock_guard<std::mutex> lock(lock_);
+    return withinHalfspaces(u, ignore1, ignore2);
 }
 
 void ompl::base::AtlasChart::borderCheck(const Eigen::Ref<const Eigen::VectorXd> &v) const
 {
-    for (Halfspace *h : polytope_)
-        h->checkNear(v);
+    // Collect the boundaries v is close to. Their complements belong to other
+    // charts, so they are expanded after our lock is released.
+    std::vector<Halfspace *> near;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        for (Halfspace *h : polytope_)
+            if (h->isNear(v))
+                near.push_back(h->getComplement());
+    }
+
+    if (near.empty())
+        return;
+
+    Eigen::VectorXd x(n_);
+    psi(v, x);
+    for (Halfspace *complement : near)
+    {
+        std::lock_guard<std::mutex> lock(complement->owner_->lock_);
+        complement->expandToInclude(x);
+    }
 }
 
 const ompl::base::AtlasChart *ompl::base::AtlasChart::owningNeighbor(const Eigen::Ref<const Eigen::VectorXd> &x) const
 {
+    std::vector<const AtlasChart *> neighbors;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        for (Halfspace *h : polytope_)
+            neighbors.push_back(h->getComplement()->getOwner());
+    }
+
     Eigen::VectorXd projx(n_), proju(k_);
-    for (Halfspace *h : polytope_)
+    for (const AtlasChart *c : neighbors)
     {
         // Project onto the neighboring chart.
-        const AtlasChart *c = h->getComplement()->getOwner();
         c->psiInverse(x, proju);
         c->phi(proju, projx);
 
@@ -285,6 +307,8 @@ bool ompl::base::AtlasChart::toPolygon(std::vector<Eigen::VectorXd> &vertices) c
     if (k_ != 2)
         throw ompl::Exception("AtlasChart::toPolygon() only works on 2D manifold/charts.");
 
+    std::lock_guard<std::mutex> lock(lock_);
+
     // Compile a list of all the vertices in P and all the times the border
     // intersects the circle.
     Eigen::VectorXd v(2);
@@ -298,7 +322,7 @@ bool ompl::base::AtlasChart::toPolygon(std::vector<Eigen::VectorXd> &vertices) c
             // within the circle.
             Halfspace::intersect(*polytope_[i], *polytope_[j], v);
             phi(v, intersection);
-            if (inPolytope(v, polytope_[i], polytope_[j]))
+            if (v.norm() <= radius_ && withinHalfspaces(v, polytope_[i], polytope_[j]))
                 vertices.push_back(intersection);
         }
 
@@ -306,12 +330,12 @@ bool ompl::base::AtlasChart::toPolygon(std::vector<Eigen::VectorXd> &vertices) c
         Eigen::VectorXd v1(2), v2(2);
         if ((polytope_[i])->circleIntersect(radius_, v1, v2))
         {
-            if (inPolytope(v1, polytope_[i]))
+            if (v1.norm() <= radius_ && withinHalfspaces(v1, polytope_[i]))
             {
                 phi(v1, intersection);
                 vertices.push_back(intersection);
             }
-            if (inPolytope(v2, polytope_[i]))
+            if (v2.norm() <= radius_ && withinHalfspaces(v2, polytope_[i]))
             {
                 phi(v2, intersection);
                 vertices.push_back(intersection);
@@ -328,7 +352,7 @@ bool ompl::base::AtlasChart::toPolygon(std::vector<Eigen::VectorXd> &vertices) c
     {
         const Eigen::VectorXd vn = Eigen::Rotation2Dd(a) * v0;
 
-        if (inPolytope(vn))
+        if (withinHalfspaces(vn))
         {
             is_frontier = true;
             phi(vn, intersection);
@@ -386,5 +410,25 @@ void ompl::base::AtlasChart::generateHalfspace(AtlasChart *c1, AtlasChart *c2)
 
 void ompl::base::AtlasChart::addBoundary(Halfspace *halfspace)
 {
+    std::lock_guard<std::mutex> lock(lock_);
+    halfspace->index_ = polytope_.size();
     polytope_.push_back(halfspace);
+    inequalities_.insert(inequalities_.end(), halfspace->u_.data(), halfspace->u_.data() + k_);
+    inequalities_.push_back(halfspace->rhs_);
+}
+
+bool ompl::base::AtlasChart::withinHalfspaces(const Eigen::Ref<const Eigen::VectorXd> &u,
+                                              const Halfspace *const ignore1, const Halfspace *const ignore2) const
+{
+    const double *row = inequalities_.data();
+    for (std::size_t i = 0; i < polytope_.size(); ++i, row += k_ + 1)
+    {
+        if (Eigen::Map<const Eigen::VectorXd>(row, k_).dot(u) <= row[k_])
+            continue;
+
+        if (polytope_[i] != ignore1 && polytope_[i] != ignore2)
+            return false;
+    }
+
+    return true;
 }
@@ -40,6 +40,22 @@
 #include "ompl/base/SpaceInformation.h"
 #include "ompl/util/Exception.h"
 
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+
+namespace
+{
+    /** \brief Random number generator for picking charts, one per thread so
+     * that several threads can sample the same atlas. */
+    ompl::RNG &chartRNG()
+    {
+        thread_local ompl::RNG rng;
+        return rng;
+    }
+}
+
 /// AtlasStateSampler
 
 /// Public
@@ -225,7 +241,20 @@ ompl::base::AtlasStateSpace::~AtlasStateSpace()
 
 void ompl::base::AtlasStateSpace::clear()
 {
-    // Delete the non-anchor charts
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(atlasLock_);
+        deleteCharts();
+    }
+
+    // Reinstate the anchor charts
+    for (auto anchor : anchors_)
+        newChart(anchor);
+
+    ConstrainedStateSpace::clear();
+}
+
+void ompl::base::AtlasStateSpace::deleteCharts()
+{
     for (auto chart : charts_)
         delete chart;
     charts_.clear();
@@ -240,18 +269,15 @@ void ompl::base::AtlasStateSpace::clear()
 
     chartNN_.clear();
     chartPDF_.clear();
-
-    // Reinstate the anchor charts
-    for (auto anchor : anchors_)
-        newChart(anchor);
-
-    ConstrainedStateSpace::clear();
 }
 
 ompl::base::AtlasChart *ompl::base::AtlasStateSpace::anchorChart(const ompl::base::State *state) const
 {
     auto anchor = cloneState(state)->as<StateType>();
-    anchors_.push_back(anchor);
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(atlasLock_);
+        anchors_.push_back(anchor);
+    }
 
     // This could fail with an exception. We cannot recover if that happens.
     AtlasChart *chart = newChart(anchor);
@@ -283,6 +309,10 @@ ompl::base::AtlasChart *ompl::base::AtlasStateSpace::newChart(const StateType *s
         return nullptr;
     }
 
+    // The chart is computed above without any lock; only adding it to the
+    // atlas is exclusive.
+    std::unique_lock<std::shared_timed_mutex> lock(atlasLock_);
+
     // Ensure all charts respect boundaries of the new one, and vice versa, but
     // only look at nearby ones (within 2*rho).
     if (separate_)
@@ -308,11 +338,12 @@ ompl::base::AtlasChart *ompl::base::AtlasStateSpace::newChart(const StateType *s
 
 ompl::base::AtlasChart *ompl::base::AtlasStateSpace::sampleChart() const
 {
+    std::shared_lock<std::shared_timed_mutex> lock(atlasLock_);
     if (charts_.empty())
         throw ompl::Exception("ompl::base::AtlasStateSpace::sampleChart(): "
                               "Atlas sampled before any charts were made. Use AtlasStateSpace::anchorChart() first.");
 
-    return chartPDF_.sample(rng_.uniform01());
+    return chartPDF_.sample(chartRNG().uniform01());
 }
 
 ompl::base::AtlasChart *ompl::base::AtlasStateSpace::getChart(const StateType *state, bool force, bool *created) const
@@ -341,6 +372,7 @@ ompl::base::AtlasChart *ompl::base::AtlasStateSpace::owningChart(const StateType
     Eigen::VectorXd u_t(k_);
     auto temp = allocState()->as<StateType>();
 
+    std::shared_lock<std::shared_timed_mutex> lock(atlasLock_);
     std::vector<NNElement> nearby;
     chartNN_.nearestR(std::make_pair(state, 0), rho_, nearby);
 
@@ -498,6 +530,7 @@ bool ompl::base::AtlasStateSpace::discreteGeodesic(const State *from, const Stat
 
 double ompl::base::AtlasStateSpace::estimateFrontierPercent() const
 {
+    std::shared_lock<std::shared_timed_mutex> lock(atlasLock_);
     double frontier = 0;
     for (const AtlasChart *c : charts_)
         frontier += c->estimateIsFrontier() ? 1 : 0;
@@ -511,6 +544,7 @@ void ompl::base::AtlasStateSpace::printPLY(std::ostream &out) const
     std::size_t vcount = 0;
     std::size_t fcount = 0;
     std::vector<Eigen::VectorXd> vertices;
+    std::shared_lock<std::shared_timed_mutex> lock(atlasLock_);
     for (AtlasChart *c : charts_)
     {
         vertices.clear();
@@ -544,3 +578,74 @@ void ompl::base::AtlasStateSpace::printPLY(std::ostream &out) const
     out << "end_header\n";
     out << v.str() << f.str();
 }
+
+void ompl::base::AtlasStateSpace::saveAtlas(std::ostream &out) const
+{
+    std::shared_lock<std::shared_timed_mutex> lock(atlasLock_);
+
+    const auto precision = out.precision(std::numeric_limits<double>::max_digits10);
+    const Eigen::IOFormat format(Eigen::FullPrecision, Eigen::DontAlignCols, " ", " ");
+
+    out << "atlas " << n_ << " " << k_ << "\n";
+    out << "anchors " << anchors_.size() << "\n";
+    for (const StateType *anchor : anchors_)
+        out << anchor->transpose().format(format) << "\n";
+
+    out << "charts " << charts_.size() << "\n";
+    for (const AtlasChart *c : charts_)
+        out << c->getOrigin()->transpose().format(format) << "\n";
+
+    out.precision(precision);
+}
+
+void ompl::base::AtlasStateSpace::loadAtlas(std::istream &in)
+{
+    // Read everything before changing the atlas.
+    std::string token;
+    unsigned int n, k;
+    if (!(in >> token >> n >> k) || token != "atlas" || n != n_ || k != k_)
+        throw ompl::Exception("ompl::base::AtlasStateSpace::loadAtlas(): "
+                              "Stream does not hold an atlas of matching dimensions.");
+
+    auto readStates = [&](const std::string &header) {
+        std::size_t count;
+        if (!(in >> token >> count) || token != header)
+            throw ompl::Exception("ompl::base::AtlasStateSpace::loadAtlas(): Expected " + header + ".");
+
+        std::vector<Eigen::VectorXd> states(count, Eigen::VectorXd(n_));
+        for (auto &x : states)
+            for (unsigned int i = 0; i < n_; ++i)
+                if (!(in >> x[i]))
+                    throw ompl::Exception("ompl::base::AtlasStateSpace::loadAtlas(): Truncated " + header + ".");
+        return states;
+    };
+    const std::vector<Eigen::VectorXd> anchors = readStates("anchors");
+    const std::vector<Eigen::VectorXd> origins = readStates("charts");
+
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(atlasLock_);
+        deleteCharts();
+
+        for (auto anchor : anchors_)
+            freeState(anchor);
+        anchors_.clear();
+
+        for (const auto &x : anchors)
+        {
+            auto anchor = allocState()->as<StateType>();
+            anchor->copy(x);
+            anchors_.push_back(anchor);
+        }
+    }
+
+    // Recreate the charts in order, so they are separated as they were.
+    auto origin = allocState()->as<StateType>();
+    for (const auto &x : origins)
+    {
+        origin->copy(x);
+        newChart(origin);
+    }
+    freeState(origin);
+
+    ConstrainedStateSpace::clear();
+}
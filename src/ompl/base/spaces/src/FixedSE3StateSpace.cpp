@@ -0,0 +1,117 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "ompl/base/spaces/FixedSE3StateSpace.h"
+#include <cmath>
+#include <limits>
+
+/// @cond IGNORE
+namespace
+{
+    // same tolerance as SO3StateSpace
+    const double MAX_QUATERNION_NORM_ERROR = 1e-9;
+
+    inline double arcLength(const ompl::base::SO3StateSpace::StateType *q1,
+                            const ompl::base::SO3StateSpace::StateType *q2)
+    {
+        double dq = std::fabs(q1->x * q2->x + q1->y * q2->y + q1->z * q2->z + q1->w * q2->w);
+        if (dq > 1.0 - MAX_QUATERNION_NORM_ERROR)
+            return 0.0;
+        return std::acos(dq);
+    }
+}
+/// @endcond
+
+void ompl::base::FixedSE3StateSpace::copyState(State *destination, const State *source) const
+{
+    auto *d = static_cast<StateType *>(destination);
+    const auto *s = static_cast<const StateType *>(source);
+    double *dp = d->as<RealVectorStateSpace::StateType>(0)->values;
+    const double *sp = s->as<RealVectorStateSpace::StateType>(0)->values;
+    dp[0] = sp[0];
+    dp[1] = sp[1];
+    dp[2] = sp[2];
+    d->rotation().x = s->rotation().x;
+    d->rotation().y = s->rotation().y;
+    d->rotation().z = s->rotation().z;
+    d->rotation().w = s->rotation().w;
+}
+
+double ompl::base::FixedSE3StateSpace::distance(const State *state1, const State *state2) const
+{
+    const auto *s1 = static_cast<const StateType *>(state1);
+    const auto *s2 = static_cast<const StateType *>(state2);
+    const double *p1 = s1->as<RealVectorStateSpace::StateType>(0)->values;
+    const double *p2 = s2->as<RealVectorStateSpace::StateType>(0)->values;
+    double dx = p1[0] - p2[0], dy = p1[1] - p2[1], dz = p1[2] - p2[2];
+    return weights_[0] * std::sqrt(dx * dx + dy * dy + dz * dz) +
+           weights_[1] * arcLength(&s1->rotation(), &s2->rotation());
+}
+
+bool ompl::base::FixedSE3StateSpace::equalStates(const State *state1, const State *state2) const
+{
+    const auto *s1 = static_cast<const StateType *>(state1);
+    const auto *s2 = static_cast<const StateType *>(state2);
+    const double *p1 = s1->as<RealVectorStateSpace::StateType>(0)->values;
+    const double *p2 = s2->as<RealVectorStateSpace::StateType>(0)->values;
+    for (unsigned int i = 0; i < 3; ++i)
+        if (std::fabs(p1[i] - p2[i]) > std::numeric_limits<double>::epsilon() * 2.0)
+            return false;
+    return arcLength(&s1->rotation(), &s2->rotation()) < std::numeric_limits<double>::epsilon();
+}
+
+void ompl::base::FixedSE3StateSpace::interpolate(const State *from, const State *to, const double t,
+                                                 State *state) const
+{
+    const auto *f = static_cast<const StateType *>(from);
+    const auto *o = static_cast<const StateType *>(to);
+    auto *s = static_cast<StateType *>(state);
+    const double *fp = f->as<RealVectorStateSpace::StateType>(0)->values;
+    const double *op = o->as<RealVectorStateSpace::StateType>(0)->values;
+    double *sp = s->as<RealVectorStateSpace::StateType>(0)->values;
+    sp[0] = fp[0] + (op[0] - fp[0]) * t;
+    sp[1] = fp[1] + (op[1] - fp[1]) * t;
+    sp[2] = fp[2] + (op[2] - fp[2]) * t;
+    as<SO3StateSpace>(1)->SO3StateSpace::interpolate(&f->rotation(), &o->rotation(), t, &s->rotation());
+}
+
+ompl::base::State *ompl::base::FixedSE3StateSpace::allocState() const
+{
+    return new StateType();
+}
+
+void ompl::base::FixedSE3StateSpace::freeState(State *state) const
+{
+    delete static_cast<StateType *>(state);
+}
@@ -0,0 +1,267 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "ompl/base/spaces/RealVectorKernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define OMPL_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+/// @cond IGNORE
+namespace
+{
+    struct KernelTable
+    {
+        double (*squaredDistance)(const double *, const double *, unsigned int);
+        void (*interpolate)(const double *, const double *, double, double *, unsigned int);
+        void (*clamp)(double *, const double *, const double *, unsigned int);
+        bool (*withinBounds)(const double *, const double *, const double *, double, unsigned int);
+        const char *name;
+    };
+
+    // Portable implementations. Several accumulators break the dependency chain of the sum.
+    double squaredDistanceGeneric(const double *a, const double *b, unsigned int n)
+    {
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        unsigned int i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const double d0 = a[i] - b[i], d1 = a[i + 1] - b[i + 1], d2 = a[i + 2] - b[i + 2],
+                         d3 = a[i + 3] - b[i + 3];
+            s0 += d0 * d0;
+            s1 += d1 * d1;
+            s2 += d2 * d2;
+            s3 += d3 * d3;
+        }
+        for (; i < n; ++i)
+        {
+            const double d = a[i] - b[i];
+            s0 += d * d;
+        }
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    void interpolateGeneric(const double *from, const double *to, double t, double *out, unsigned int n)
+    {
+        for (unsigned int i = 0; i < n; ++i)
+            out[i] = from[i] + (to[i] - from[i]) * t;
+    }
+
+    void clampGeneric(double *values, const double *low, const double *high, unsigned int n)
+    {
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            if (values[i] > high[i])
+                values[i] = high[i];
+            else if (values[i] < low[i])
+                values[i] = low[i];
+        }
+    }
+
+    bool withinBoundsGeneric(const double *values, const double *low, const double *high, double eps,
+                             unsigned int n)
+    {
+        for (unsigned int i = 0; i < n; ++i)
+            if (values[i] - eps > high[i] || values[i] + eps < low[i])
+                return false;
+        return true;
+    }
+
+#ifdef OMPL_KERNELS_X86
+    __attribute__((target("avx2,fma"))) double squaredDistanceAVX2(const double *a, const double *b, unsigned int n)
+    {
+        __m256d acc0 = _mm256_setzero_pd();
+        __m256d acc1 = _mm256_setzero_pd();
+        unsigned int i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+            const __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4));
+            acc0 = _mm256_fmadd_pd(d0, d0, acc0);
+            acc1 = _mm256_fmadd_pd(d1, d1, acc1);
+        }
+        if (i + 4 <= n)
+        {
+            const __m256d d = _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+            acc0 = _mm256_fmadd_pd(d, d, acc0);
+            i += 4;
+        }
+        acc0 = _mm256_add_pd(acc0, acc1);
+        const __m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc0), _mm256_extractf128_pd(acc0, 1));
+        double sum = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+        for (; i < n; ++i)
+        {
+            const double d = a[i] - b[i];
+            sum += d * d;
+        }
+        return sum;
+    }
+
+    __attribute__((target("avx2,fma"))) void interpolateAVX2(const double *from, const double *to, double t,
+                                                             double *out, unsigned int n)
+    {
+        const __m256d vt = _mm256_set1_pd(t);
+        unsigned int i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m256d f = _mm256_loadu_pd(from + i);
+            _mm256_storeu_pd(out + i, _mm256_fmadd_pd(_mm256_sub_pd(_mm256_loadu_pd(to + i), f), vt, f));
+        }
+        for (; i < n; ++i)
+            out[i] = from[i] + (to[i] - from[i]) * t;
+    }
+
+    __attribute__((target("avx2"))) void clampAVX2(double *values, const double *low, const double *high,
+                                                   unsigned int n)
+    {
+        unsigned int i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            // the bound is the first operand, so NaN values are left untouched, as in the scalar version
+            const __m256d v = _mm256_max_pd(_mm256_loadu_pd(low + i), _mm256_loadu_pd(values + i));
+            _mm256_storeu_pd(values + i, _mm256_min_pd(_mm256_loadu_pd(high + i), v));
+        }
+        clampGeneric(values + i, low + i, high + i, n - i);
+    }
+
+    __attribute__((target("avx2"))) bool withinBoundsAVX2(const double *values, const double *low,
+                                                          const double *high, double eps, unsigned int n)
+    {
+        const __m256d ve = _mm256_set1_pd(eps);
+        unsigned int i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m256d v = _mm256_loadu_pd(values + i);
+            const __m256d above = _mm256_cmp_pd(_mm256_sub_pd(v, ve), _mm256_loadu_pd(high + i), _CMP_GT_OQ);
+            const __m256d below = _mm256_cmp_pd(_mm256_add_pd(v, ve), _mm256_loadu_pd(low + i), _CMP_LT_OQ);
+            if (_mm256_movemask_pd(_mm256_or_pd(above, below)) != 0)
+                return false;
+        }
+        return withinBoundsGeneric(values + i, low + i, high + i, eps, n - i);
+    }
+
+    __attribute__((target("avx512f"))) double squaredDistanceAVX512(const double *a, const double *b,
+                                                                     unsigned int n)
+    {
+        __m512d acc = _mm512_setzero_pd();
+        unsigned int i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m512d d = _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i));
+            acc = _mm512_fmadd_pd(d, d, acc);
+        }
+        if (i < n)
+        {
+            // masked loads take care of the remaining elements
+            const __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+            const __m512d d = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, a + i), _mm512_maskz_loadu_pd(mask, b + i));
+            acc = _mm512_fmadd_pd(d, d, acc);
+        }
+        // reduce by hand: _mm512_reduce_add_pd() and the unmasked extracts make GCC 12 warn about an uninitialized
+        // variable, the zero-masked extracts keep all four lanes and do not
+        const __m256d sum4 =
+            _mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xF, acc, 0), _mm512_maskz_extractf64x4_pd(0xF, acc, 1));
+        const __m128d half = _mm_add_pd(_mm256_castpd256_pd128(sum4), _mm256_extractf128_pd(sum4, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+    }
+
+    __attribute__((target("avx512f"))) void interpolateAVX512(const double *from, const double *to, double t,
+                                                              double *out, unsigned int n)
+    {
+        const __m512d vt = _mm512_set1_pd(t);
+        unsigned int i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m512d f = _mm512_loadu_pd(from + i);
+            _mm512_storeu_pd(out + i, _mm512_fmadd_pd(_mm512_sub_pd(_mm512_loadu_pd(to + i), f), vt, f));
+        }
+        if (i < n)
+        {
+            const __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+            const __m512d f = _mm512_maskz_loadu_pd(mask, from + i);
+            const __m512d r = _mm512_fmadd_pd(_mm512_sub_pd(_mm512_maskz_loadu_pd(mask, to + i), f), vt, f);
+            _mm512_mask_storeu_pd(out + i, mask, r);
+        }
+    }
+
+    KernelTable selectKernels()
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return {squaredDistanceAVX512, interpolateAVX512, clampAVX2, withinBoundsAVX2, "avx512f"};
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return {squaredDistanceAVX2, interpolateAVX2, clampAVX2, withinBoundsAVX2, "avx2"};
+        return {squaredDistanceGeneric, interpolateGeneric, clampGeneric, withinBoundsGeneric, "generic"};
+    }
+#else
+    KernelTable selectKernels()
+    {
+        return {squaredDistanceGeneric, interpolateGeneric, clampGeneric, withinBoundsGeneric, "generic"};
+    }
+#endif
+
+    const KernelTable &getKernels()
+    {
+        static const KernelTable table = selectKernels();
+        return table;
+    }
+}
+/// @endcond
+
+double ompl::base::kernels::squaredDistance(const double *a, const double *b, unsigned int n)
+{
+    return getKernels().squaredDistance(a, b, n);
+}
+
+void ompl::base::kernels::interpolate(const double *from, const double *to, double t, double *out, unsigned int n)
+{
+    getKernels().interpolate(from, to, t, out, n);
+}
+
+void ompl::base::kernels::clamp(double *values, const double *low, const double *high, unsigned int n)
+{
+    getKernels().clamp(values, low, high, n);
+}
+
+bool ompl::base::kernels::withinBounds(const double *values, const double *low, const double *high, double eps,
+                                       unsigned int n)
+{
+    return getKernels().withinBounds(values, low, high, eps, n);
+}
+
+const char *ompl::base::kernels::getInstructionSet()
+{
+    return getKernels().name;
+}
@@ -36,6 +36,7 @@
 
 #include "ompl/base/spaces/RealVectorStateSpace.h"
 #include "ompl/base/spaces/RealVectorStateProjections.h"
+#include "ompl/base/spaces/RealVectorKernels.h"
 #include "ompl/util/Exception.h"
 #include <algorithm>
 #include <cstring>
@@ -187,24 +188,13 @@ double ompl::base::RealVectorStateSpace::getMeasure() const
 
 void ompl::base::RealVectorStateSpace::enforceBounds(State *state) const
 {
-    auto *rstate = static_cast<StateType *>(state);
-    for (unsigned int i = 0; i < dimension_; ++i)
-    {
-        if (rstate->values[i] > bounds_.high[i])
-            rstate->values[i] = bounds_.high[i];
-        else if (rstate->values[i] < bounds_.low[i])
-            rstate->values[i] = bounds_.low[i];
-    }
+    kernels::clamp(static_cast<StateType *>(state)->values, bounds_.low.data(), bounds_.high.data(), dimension_);
 }
 
 bool ompl::base::RealVectorStateSpace::satisfiesBounds(const State *state) const
 {
-    const auto *rstate = static_cast<const StateType *>(state);
-    for (unsigned int i = 0; i < dimension_; ++i)
-        if (rstate->values[i] - std::numeric_limits<double>::epsilon() > bounds_.high[i] ||
-            rstate->values[i] + std::numeric_limits<double>::epsilon() < bounds_.low[i])
-            return false;
-    return true;
+    return kernels::withinBounds(static_cast<const StateType *>(state)->values, bounds_.low.data(),
+                                 bounds_.high.data(), std::numeric_limits<double>::epsilon(), dimension_);
 }
 
 void ompl::base::RealVectorStateSpace::copyState(State *destination, const State *source) const
@@ -229,16 +219,16 @@ void ompl::base::RealVectorStateSpace::deserialize(State *state, const void *ser
 
 double ompl::base::RealVectorStateSpace::distance(const State *state1, const State *state2) const
 {
-    double dist = 0.0;
-    const double *s1 = static_cast<const StateType *>(state1)->values;
-    const double *s2 = static_cast<const StateType *>(state2)->values;
+    return sqrt(kernels::squaredDistance(static_cast<const StateType *>(state1)->values,
+                                         static_cast<const StateType *>(state2)->values, dimension_));
+}
 
-    for (unsigned int i = 0; i < dimension_; ++i)
-    {
-        double diff = (*s1++) - (*s2++);
-        dist += diff * diff;
-    }
-    return sqrt(dist);
+void ompl::base::RealVectorStateSpace::distanceBatch(const State *state, const State *const *states, std::size_t n,
+                                                     double *distances) const
+{
+    const double *s = static_cast<const StateType *>(state)->values;
+    for (std::size_t i = 0; i < n; ++i)
+        distances[i] = sqrt(kernels::squaredDistance(s, static_cast<const StateType *>(states[i])->values, dimension_));
 }
 
 bool ompl::base::RealVectorStateSpace::equalStates(const State *state1, const State *state2) const
@@ -257,11 +247,8 @@ bool ompl::base::RealVectorStateSpace::equalStates(const State *state1, const St
 void ompl::base::RealVectorStateSpace::interpolate(const State *from, const State *to, const double t,
                                                    State *state) const
 {
-    const auto *rfrom = static_cast<const StateType *>(from);
-    const auto *rto = static_cast<const StateType *>(to);
-    const StateType *rstate = static_cast<StateType *>(state);
-    for (unsigned int i = 0; i < dimension_; ++i)
-        rstate->values[i] = rfrom->values[i] + (rto->values[i] - rfrom->values[i]) * t;
+    kernels::interpolate(static_cast<const StateType *>(from)->values, static_cast<const StateType *>(to)->values, t,
+                         static_cast<StateType *>(state)->values, dimension_);
 }
 
 ompl::base::StateSamplerPtr ompl::base::RealVectorStateSpace::allocDefaultStateSampler() const
@@ -37,6 +37,7 @@
 #include "ompl/base/spaces/SE3StateSpace.h"
 #include "ompl/tools/config/MagicConstants.h"
 #include <cstring>
+#include <typeinfo>
 
 ompl::base::State *ompl::base::SE3StateSpace::allocState() const
 {
@@ -50,6 +51,15 @@ void ompl::base::SE3StateSpace::freeState(State *state) const
     CompoundStateSpace::freeState(state);
 }
 
+void ompl::base::SE3StateSpace::distanceBatch(const State *state, const State *const *states, std::size_t n,
+                                               double *distances) const
+{
+    if (typeid(*this) == typeid(SE3StateSpace))
+        distanceBatchByComponent(state, states, n, distances);
+    else
+        StateSpace::distanceBatch(state, states, n, distances);
+}
+
 void ompl::base::SE3StateSpace::registerProjections()
 {
     class SE3DefaultProjection : public ProjectionEvaluator
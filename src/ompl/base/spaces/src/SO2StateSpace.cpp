@@ -132,6 +132,17 @@ double ompl::base::SO2StateSpace::distance(const State *state1, const State *sta
     return (d > pi) ? 2.0 * pi - d : d;
 }
 
+void ompl::base::SO2StateSpace::distanceBatch(const State *state, const State *const *states, std::size_t n,
+                                              double *distances) const
+{
+    const double value = state->as<StateType>()->value;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        double d = fabs(value - states[i]->as<StateType>()->value);
+        distances[i] = (d > pi) ? 2.0 * pi - d : d;
+    }
+}
+
 bool ompl::base::SO2StateSpace::equalStates(const State *state1, const State *state2) const
 {
     return fabs(state1->as<StateType>()->value - state2->as<StateType>()->value) <
@@ -276,6 +276,13 @@ double ompl::base::SO3StateSpace::distance(const State *state1, const State *sta
     return arcLength(state1, state2);
 }
 
+void ompl::base::SO3StateSpace::distanceBatch(const State *state, const State *const *states, std::size_t n,
+                                              double *distances) const
+{
+    for (std::size_t i = 0; i < n; ++i)
+        distances[i] = arcLength(state, states[i]);
+}
+
 bool ompl::base::SO3StateSpace::equalStates(const State *state1, const State *state2) const
 {
     return arcLength(state1, state2) < std::numeric_limits<double>::epsilon();
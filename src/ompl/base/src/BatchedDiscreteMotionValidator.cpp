@@ -0,0 +1,156 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "ompl/base/BatchedDiscreteMotionValidator.h"
+#include "ompl/util/Exception.h"
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+void ompl::base::BatchedDiscreteMotionValidator::setBatchSize(unsigned int batchSize)
+{
+    if (batchSize == 0)
+        throw Exception("The batch size for motion validation must be positive");
+    batchSize_ = batchSize;
+}
+
+std::size_t ompl::base::BatchedDiscreteMotionValidator::checkSteps(const State *s1, const State *s2, int nd,
+                                                                   const std::vector<int> &steps) const
+{
+    const std::size_t count = steps.size();
+    if (count == 0)
+        return 0;
+
+    /* storage for one batch of interpolated states; it keeps its memory between calls of the same thread */
+    thread_local std::vector<State *> batch;
+    thread_local std::unique_ptr<bool[]> valid;
+    thread_local std::size_t validSize = 0;
+    batch.resize(std::min<std::size_t>(batchSize_, count));
+    for (auto &state : batch)
+        state = si_->allocScratchState();
+    if (validSize < batch.size())
+    {
+        validSize = batch.size();
+        valid.reset(new bool[validSize]);
+    }
+
+    std::size_t first = count;
+    for (std::size_t start = 0; start < count; start += batch.size())
+    {
+        const std::size_t n = std::min(batch.size(), count - start);
+        for (std::size_t i = 0; i < n; ++i)
+            stateSpace_->interpolate(s1, s2, (double)steps[start + i] / (double)nd, batch[i]);
+
+        if (!si_->isValid(batch.data(), n, valid.get()))
+        {
+            first = start + (std::find(valid.get(), valid.get() + n, false) - valid.get());
+            break;
+        }
+    }
+
+    for (auto &state : batch)
+        si_->freeScratchState(state);
+    return first;
+}
+
+bool ompl::base::BatchedDiscreteMotionValidator::checkMotion(const State *s1, const State *s2,
+                                                             std::pair<State *, double> &lastValid) const
+{
+    /* assume motion starts in a valid configuration so s1 is valid */
+
+    int nd = stateSpace_->validSegmentCount(s1, s2);
+
+    /* check the intermediate states in order, followed by s2 itself */
+    thread_local std::vector<int> steps;
+    steps.clear();
+    for (int j = 1; j < nd; ++j)
+        steps.push_back(j);
+
+    std::size_t firstInvalid = checkSteps(s1, s2, nd, steps);
+    if (firstInvalid == steps.size() && si_->isValid(s2))
+    {
+        valid_++;
+        return true;
+    }
+
+    /* steps[i] is the interpolation step i + 1; s2 is step nd */
+    lastValid.second = (double)firstInvalid / (double)nd;
+    if (lastValid.first != nullptr)
+        stateSpace_->interpolate(s1, s2, lastValid.second, lastValid.first);
+    invalid_++;
+    return false;
+}
+
+bool ompl::base::BatchedDiscreteMotionValidator::checkMotion(const State *s1, const State *s2) const
+{
+    /* assume motion starts in a valid configuration so s1 is valid */
+    if (!si_->isValid(s2))
+    {
+        invalid_++;
+        return false;
+    }
+
+    int nd = stateSpace_->validSegmentCount(s1, s2);
+
+    /* compute the order in which DiscreteMotionValidator subdivides the segment */
+    thread_local std::vector<int> steps;
+    thread_local std::vector<std::pair<int, int>> pos;
+    steps.clear();
+    if (nd >= 2)
+    {
+        pos.clear();
+        pos.emplace_back(1, nd - 1);
+        for (std::size_t front = 0; front < pos.size(); ++front)
+        {
+            std::pair<int, int> x = pos[front];
+
+            int mid = (x.first + x.second) / 2;
+            steps.push_back(mid);
+
+            if (x.first < mid)
+                pos.emplace_back(x.first, mid - 1);
+            if (x.second > mid)
+                pos.emplace_back(mid + 1, x.second);
+        }
+    }
+
+    bool result = checkSteps(s1, s2, nd, steps) == steps.size();
+
+    if (result)
+        valid_++;
+    else
+        invalid_++;
+
+    return result;
+}
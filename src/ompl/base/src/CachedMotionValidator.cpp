@@ -0,0 +1,267 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "ompl/base/CachedMotionValidator.h"
+#include "ompl/base/SpaceInformation.h"
+#include "ompl/util/Exception.h"
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// @cond IGNORE
+namespace
+{
+    /* Number of independently locked parts of the cache */
+    const std::size_t NUM_SHARDS = 16;
+
+    std::uint64_t mix(std::uint64_t h)
+    {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+}
+
+struct ompl::base::CachedMotionValidator::Shard
+{
+    struct Entry
+    {
+        Key key;
+        bool valid;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key &key) const
+        {
+            return mix(key.from ^ mix(key.to));
+        }
+    };
+
+    struct KeyEqual
+    {
+        bool operator()(const Key &a, const Key &b) const
+        {
+            return a.from == b.from && a.to == b.to;
+        }
+    };
+
+    std::mutex lock;
+
+    /* The remembered motions, most recently used first */
+    std::list<Entry> entries;
+
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash, KeyEqual> index;
+
+    std::size_t capacity{0};
+};
+/// @endcond
+
+ompl::base::CachedMotionValidator::CachedMotionValidator(SpaceInformation *si, MotionValidatorPtr validator,
+                                                         std::size_t capacity)
+  : MotionValidator(si), validator_(std::move(validator)), shards_(new Shard[NUM_SHARDS])
+{
+    if (!validator_)
+        throw Exception("A cached motion validator needs a motion validator to cache the results of");
+    setCapacity(capacity);
+}
+
+ompl::base::CachedMotionValidator::CachedMotionValidator(const SpaceInformationPtr &si, MotionValidatorPtr validator,
+                                                         std::size_t capacity)
+  : CachedMotionValidator(si.get(), std::move(validator), capacity)
+{
+}
+
+ompl::base::CachedMotionValidator::~CachedMotionValidator() = default;
+
+void ompl::base::CachedMotionValidator::setMotionValidator(const MotionValidatorPtr &validator)
+{
+    if (!validator)
+        throw Exception("A cached motion validator needs a motion validator to cache the results of");
+    validator_ = validator;
+    clear();
+}
+
+void ompl::base::CachedMotionValidator::setCapacity(std::size_t capacity)
+{
+    if (capacity == 0)
+        throw Exception("The capacity of the motion validity cache must be positive");
+    capacity_ = capacity;
+    clear();
+    for (std::size_t i = 0; i < NUM_SHARDS; ++i)
+        shards_[i].capacity = (capacity + NUM_SHARDS - 1) / NUM_SHARDS;
+}
+
+void ompl::base::CachedMotionValidator::setSymmetric(bool symmetric)
+{
+    symmetric_ = symmetric;
+    clear();
+}
+
+void ompl::base::CachedMotionValidator::clear()
+{
+    for (std::size_t i = 0; i < NUM_SHARDS; ++i)
+    {
+        std::lock_guard<std::mutex> slock(shards_[i].lock);
+        shards_[i].entries.clear();
+        shards_[i].index.clear();
+    }
+}
+
+std::size_t ompl::base::CachedMotionValidator::size() const
+{
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < NUM_SHARDS; ++i)
+    {
+        std::lock_guard<std::mutex> slock(shards_[i].lock);
+        total += shards_[i].entries.size();
+    }
+    return total;
+}
+
+ompl::base::CachedMotionValidator::Key ompl::base::CachedMotionValidator::makeKey(const State *s1,
+                                                                                   const State *s2) const
+{
+    thread_local std::vector<unsigned char> buffer;
+    const StateSpacePtr &space = si_->getStateSpace();
+    buffer.resize(space->getSerializationLength());
+
+    // FNV-1a over the serialized state, followed by a finalizer to spread the bits
+    auto hash = [&space](const State *state)
+    {
+        space->serialize(buffer.data(), state);
+        std::uint64_t h = 0xcbf29ce484222325ULL;
+        for (unsigned char c : buffer)
+        {
+            h ^= c;
+            h *= 0x100000001b3ULL;
+        }
+        return mix(h);
+    };
+
+    Key key{hash(s1), hash(s2)};
+    if (symmetric_ && key.to < key.from)
+        std::swap(key.from, key.to);
+    return key;
+}
+
+ompl::base::CachedMotionValidator::Shard &ompl::base::CachedMotionValidator::getShard(const Key &key) const
+{
+    return shards_[(key.from ^ key.to) % NUM_SHARDS];
+}
+
+int ompl::base::CachedMotionValidator::lookup(const Key &key) const
+{
+    Shard &shard = getShard(key);
+    std::lock_guard<std::mutex> slock(shard.lock);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end())
+        return 0;
+    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+    return it->second->valid ? 1 : -1;
+}
+
+void ompl::base::CachedMotionValidator::store(const Key &key, bool valid) const
+{
+    Shard &shard = getShard(key);
+    std::lock_guard<std::mutex> slock(shard.lock);
+    auto it = shard.index.find(key);
+    if (it != shard.index.end())
+    {
+        // another thread checked the same motion in the meantime
+        it->second->valid = valid;
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        return;
+    }
+    shard.entries.push_front(Shard::Entry{key, valid});
+    shard.index[key] = shard.entries.begin();
+    if (shard.entries.size() > shard.capacity)
+    {
+        shard.index.erase(shard.entries.back().key);
+        shard.entries.pop_back();
+    }
+}
+
+bool ompl::base::CachedMotionValidator::checkMotion(const State *s1, const State *s2) const
+{
+    Key key = makeKey(s1, s2);
+    bool result;
+    int known = lookup(key);
+    if (known != 0)
+    {
+        ++hits_;
+        result = known > 0;
+    }
+    else
+    {
+        ++misses_;
+        result = validator_->checkMotion(s1, s2);
+        store(key, result);
+    }
+
+    if (result)
+        valid_++;
+    else
+        invalid_++;
+    return result;
+}
+
+bool ompl::base::CachedMotionValidator::checkMotion(const State *s1, const State *s2,
+                                                    std::pair<State *, double> &lastValid) const
+{
+    Key key = makeKey(s1, s2);
+    bool result;
+    if (lookup(key) > 0)
+    {
+        ++hits_;
+        result = true;
+    }
+    else
+    {
+        ++misses_;
+        result = validator_->checkMotion(s1, s2, lastValid);
+        store(key, result);
+    }
+
+    if (result)
+        valid_++;
+    else
+        invalid_++;
+    return result;
+}
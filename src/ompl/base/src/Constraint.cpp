@@ -37,6 +37,70 @@
 #include "ompl/base/Constraint.h"
 #include "ompl/base/spaces/constraint/ConstrainedStateSpace.h"
 
+#include <memory>
+
+namespace
+{
+    /// Storage used by the projection routine. Matrices and decompositions keep their size between calls, so once
+    /// a thread has projected a state with a constraint, projecting more states with it does not allocate.
+    struct ProjectionWorkspace
+    {
+        void resize(unsigned int coDim, unsigned int ambientDim)
+        {
+            f.resize(coDim);
+            j.resize(coDim, ambientDim);
+        }
+
+        Eigen::VectorXd f;
+        Eigen::VectorXd y;
+        Eigen::VectorXd z;
+        Eigen::MatrixXd j;
+        Eigen::MatrixXd jjt;
+        Eigen::JacobiSVD<Eigen::MatrixXd> svd;
+        Eigen::HouseholderQR<Eigen::MatrixXd> qr;
+        Eigen::LDLT<Eigen::MatrixXd> ldlt;
+
+        /// True while a projection uses this workspace
+        bool busy{false};
+    };
+
+    /// The workspace of the calling thread
+    thread_local ProjectionWorkspace t_workspace;
+
+    /// Gives access to the workspace of the calling thread, or to a temporary one if the workspace of the thread
+    /// is already in use (e.g., if a constraint function itself projects states)
+    class WorkspaceLease
+    {
+    public:
+        WorkspaceLease(unsigned int coDim, unsigned int ambientDim)
+        {
+            if (t_workspace.busy)
+            {
+                temp_ = std::make_unique<ProjectionWorkspace>();
+                ws_ = temp_.get();
+            }
+            else
+                ws_ = &t_workspace;
+            ws_->busy = true;
+            ws_->resize(coDim, ambientDim);
+        }
+
+        ~WorkspaceLease()
+        {
+            ws_->busy = false;
+        }
+
+        ProjectionWorkspace *operator->() const
+        {
+            return ws_;
+        }
+
+    private:
+        ProjectionWorkspace *ws_;
+        std::unique_ptr<ProjectionWorkspace> temp_;
+    };
+}
+
 void ompl::base::Constraint::function(const State *state, Eigen::Ref<Eigen::VectorXd> out) const
 {
     function(*state->as<ConstrainedStateSpace::StateType>(), out);
@@ -95,17 +159,59 @@ bool ompl::base::Constraint::project(Eigen::Ref<Eigen::VectorXd> x) const
     // Newton's method
     unsigned int iter = 0;
     double norm = 0;
-    Eigen::VectorXd f(getCoDimension());
-    Eigen::MatrixXd j(getCoDimension(), n_);
+    WorkspaceLease ws(getCoDimension(), n_);
+    Eigen::VectorXd &f = ws->f;
+    Eigen::MatrixXd &j = ws->j;
 
     const double squaredTolerance = tolerance_ * tolerance_;
 
+    // Whether j and its factorization can be reused in the next iteration (quasi-Newton method only)
+    bool cached = false;
+
     function(x, f);
     while ((norm = f.squaredNorm()) > squaredTolerance && iter++ < maxIterations_)
     {
-        jacobian(x, j);
-        x -= j.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV).solve(f);
+        switch (method_)
+        {
+            case PROJECTION_SVD:
+                jacobian(x, j);
+                x -= ws->svd.compute(j, Eigen::ComputeThinU | Eigen::ComputeThinV).solve(f);
+                break;
+
+            case PROJECTION_QR:
+            {
+                // With J^T = QR, the minimum norm solution of J dx = f is dx = Q R^-T f.
+                const unsigned int coDim = getCoDimension();
+                jacobian(x, j);
+                ws->qr.compute(j.transpose());
+                ws->z.setZero(n_);
+                ws->z.head(coDim) = ws->qr.matrixQR()
+                                        .topLeftCorner(coDim, coDim)
+                                        .triangularView<Eigen::Upper>()
+                                        .transpose()
+                                        .solve(f);
+                x -= ws->qr.householderQ() * ws->z;
+                break;
+            }
+
+            case PROJECTION_LDLT:
+            case PROJECTION_QUASI_NEWTON:
+                if (!cached)
+                {
+                    jacobian(x, j);
+                    ws->jjt.noalias() = j * j.transpose();
+                    ws->ldlt.compute(ws->jjt);
+                    cached = method_ == PROJECTION_QUASI_NEWTON;
+                }
+                ws->y = ws->ldlt.solve(f);
+                x.noalias() -= j.transpose() * ws->y;
+                break;
+        }
         function(x, f);
+
+        // Recompute the Jacobian if the residual did not at least halve with the cached one
+        if (cached && f.squaredNorm() > 0.25 * norm)
+            cached = false;
     }
 
     return norm < squaredTolerance;
@@ -118,9 +224,9 @@ double ompl::base::Constraint::distance(const State *state) const
 
 double ompl::base::Constraint::distance(const Eigen::Ref<const Eigen::VectorXd> &x) const
 {
-    Eigen::VectorXd f(getCoDimension());
-    function(x, f);
-    return f.norm();
+    WorkspaceLease ws(getCoDimension(), n_);
+    function(x, ws->f);
+    return ws->f.norm();
 }
 
 bool ompl::base::Constraint::isSatisfied(const State *state) const
@@ -130,7 +236,7 @@ bool ompl::base::Constraint::isSatisfied(const State *state) const
 
 bool ompl::base::Constraint::isSatisfied(const Eigen::Ref<const Eigen::VectorXd> &x) const
 {
-    Eigen::VectorXd f(getCoDimension());
-    function(x, f);
-    return f.allFinite() && f.squaredNorm() <= tolerance_ * tolerance_;
+    WorkspaceLease ws(getCoDimension(), n_);
+    function(x, ws->f);
+    return ws->f.allFinite() && ws->f.squaredNorm() <= tolerance_ * tolerance_;
 }
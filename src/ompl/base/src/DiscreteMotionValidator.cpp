@@ -36,7 +36,9 @@
 
 #include "ompl/base/DiscreteMotionValidator.h"
 #include "ompl/util/Exception.h"
-#include <queue>
+#include "ompl/util/Tracer.h"
+#include <utility>
+#include <vector>
 
 void ompl::base::DiscreteMotionValidator::defaultSettings()
 {
@@ -48,6 +50,8 @@ void ompl::base::DiscreteMotionValidator::defaultSettings()
 bool ompl::base::DiscreteMotionValidator::checkMotion(const State *s1, const State *s2,
                                                       std::pair<State *, double> &lastValid) const
 {
+    OMPL_TRACE_SCOPE("checkMotion");
+
     /* assume motion starts in a valid configuration so s1 is valid */
 
     bool result = true;
@@ -56,7 +60,7 @@ bool ompl::base::DiscreteMotionValidator::checkMotion(const State *s1, const Sta
     if (nd > 1)
     {
         /* temporary storage for the checked state */
-        State *test = si_->allocState();
+        State *test = si_->allocScratchState();
 
         for (int j = 1; j < nd; ++j)
         {
@@ -70,7 +74,7 @@ bool ompl::base::DiscreteMotionValidator::checkMotion(const State *s1, const Sta
                 break;
             }
         }
-        si_->freeState(test);
+        si_->freeScratchState(test);
     }
 
     if (result)
@@ -92,6 +96,8 @@ bool ompl::base::DiscreteMotionValidator::checkMotion(const State *s1, const Sta
 
 bool ompl::base::DiscreteMotionValidator::checkMotion(const State *s1, const State *s2) const
 {
+    OMPL_TRACE_SCOPE("checkMotion");
+
     /* assume motion starts in a valid configuration so s1 is valid */
     if (!si_->isValid(s2))
     {
@@ -102,19 +108,21 @@ bool ompl::base::DiscreteMotionValidator::checkMotion(const State *s1, const Sta
     bool result = true;
     int nd = stateSpace_->validSegmentCount(s1, s2);
 
-    /* initialize the queue of test positions */
-    std::queue<std::pair<int, int>> pos;
+    /* the queue of test positions; it keeps its memory between calls of the same thread */
+    thread_local std::vector<std::pair<int, int>> pos;
     if (nd >= 2)
     {
-        pos.emplace(1, nd - 1);
+        pos.clear();
+        pos.emplace_back(1, nd - 1);
+        std::size_t front = 0;
 
         /* temporary storage for the checked state */
-        State *test = si_->allocState();
+        State *test = si_->allocScratchState();
 
         /* repeatedly subdivide the path segment in the middle (and check the middle) */
-        while (!pos.empty())
+        while (front < pos.size())
         {
-            std::pair<int, int> x = pos.front();
+            std::pair<int, int> x = pos[front];
 
             int mid = (x.first + x.second) / 2;
             stateSpace_->interpolate(s1, s2, (double)mid / (double)nd, test);
@@ -125,15 +133,15 @@ bool ompl::base::DiscreteMotionValidator::checkMotion(const State *s1, const Sta
                 break;
             }
 
-            pos.pop();
+            ++front;
 
             if (x.first < mid)
-                pos.emplace(x.first, mid - 1);
+                pos.emplace_back(x.first, mid - 1);
             if (x.second > mid)
-                pos.emplace(mid + 1, x.second);
+                pos.emplace_back(mid + 1, x.second);
         }
 
-        si_->freeState(test);
+        si_->freeScratchState(test);
     }
 
     if (result)
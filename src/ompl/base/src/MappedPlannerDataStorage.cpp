@@ -0,0 +1,649 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "ompl/base/MappedPlannerDataStorage.h"
+#include "ompl/util/Console.h"
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <typeinfo>
+#include <utility>
+
+namespace
+{
+    const char RECORD_MAGIC[8] = {'O', 'M', 'P', 'L', 'R', 'M', 'A', 'P'};
+    const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    /* Every record starts with this header. All offsets are relative to the start of the record
+       and all sections start on an 8 byte boundary, so the mapped arrays are properly aligned. */
+    struct RecordHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint64_t recordSize;
+        std::uint64_t baseVertex;
+        std::uint64_t vertexCount;
+        std::uint64_t rowCount;
+        std::uint64_t edgeCount;
+        std::uint64_t stateSize;
+        std::uint64_t stateStride;
+        std::uint64_t signatureSize;
+        std::uint64_t signatureOffset;
+        std::uint64_t statesOffset;
+        std::uint64_t tagsOffset;
+        std::uint64_t marksOffset;
+        std::uint64_t sourcesOffset;
+        std::uint64_t rowsOffset;
+        std::uint64_t targetsOffset;
+        std::uint64_t weightsOffset;
+    };
+    static_assert(sizeof(RecordHeader) == 144, "Unexpected padding in the roadmap record header");
+
+    /* The sections of a record, as assembled by the writers before encoding */
+    struct RecordContents
+    {
+        std::uint64_t baseVertex{0};
+        std::vector<const ompl::base::State *> states;
+        std::vector<std::int32_t> tags;
+        std::vector<std::uint8_t> marks;
+        std::vector<std::uint32_t> sources;
+        std::vector<std::uint64_t> rows{0};
+        std::vector<std::uint32_t> targets;
+        std::vector<double> weights;
+    };
+
+    std::uint64_t align8(std::uint64_t n)
+    {
+        return (n + 7) & ~static_cast<std::uint64_t>(7);
+    }
+
+    /* Fill in the magic, version and section offsets of a header from its counts and sizes. The
+       reader recomputes the layout the same way and requires an exact match. */
+    void computeLayout(RecordHeader &h)
+    {
+        std::memcpy(h.magic, RECORD_MAGIC, sizeof(RECORD_MAGIC));
+        h.version = ompl::base::MappedPlannerDataStorage::VERSION;
+        h.byteOrder = BYTE_ORDER_MARK;
+        h.stateStride = align8(h.stateSize);
+        h.signatureOffset = sizeof(RecordHeader);
+        h.statesOffset = align8(h.signatureOffset + h.signatureSize * sizeof(std::int32_t));
+        h.tagsOffset = h.statesOffset + h.vertexCount * h.stateStride;
+        h.marksOffset = align8(h.tagsOffset + h.vertexCount * sizeof(std::int32_t));
+        h.sourcesOffset = align8(h.marksOffset + h.vertexCount * sizeof(std::uint8_t));
+        h.rowsOffset = align8(h.sourcesOffset + h.rowCount * sizeof(std::uint32_t));
+        h.targetsOffset = h.rowsOffset + (h.rowCount + 1) * sizeof(std::uint64_t);
+        h.weightsOffset = align8(h.targetsOffset + h.edgeCount * sizeof(std::uint32_t));
+        h.recordSize = h.weightsOffset + h.edgeCount * sizeof(double);
+    }
+
+    void writeAt(std::ostream &out, std::uint64_t &pos, std::uint64_t offset)
+    {
+        static const char zeros[8] = {};
+        out.write(zeros, offset - pos);
+        pos = offset;
+    }
+
+    template <typename T>
+    void writeArray(std::ostream &out, std::uint64_t &pos, const std::vector<T> &data)
+    {
+        out.write(reinterpret_cast<const char *>(data.data()), data.size() * sizeof(T));
+        pos += data.size() * sizeof(T);
+    }
+
+    bool checkStore(const ompl::base::PlannerData &pd, std::ostream &out)
+    {
+        if (!out.good())
+        {
+            OMPL_ERROR("Failed to store PlannerData: output stream is invalid");
+            return false;
+        }
+        if (!pd.getSpaceInformation())
+        {
+            OMPL_ERROR("Failed to store PlannerData: SpaceInformation is invalid");
+            return false;
+        }
+        if (pd.hasControls())
+        {
+            OMPL_ERROR("Failed to store PlannerData: controls cannot be stored in a mapped roadmap");
+            return false;
+        }
+        return true;
+    }
+
+    /* Append the edge from pd vertex v1 to v2, leading to roadmap vertex target, to the last row */
+    bool addEdge(const ompl::base::PlannerData &pd, unsigned int v1, unsigned int v2, std::uint32_t target,
+                 RecordContents &rc)
+    {
+        if (!pd.edgeExists(v1, v2))
+        {
+            OMPL_ERROR("Failed to store PlannerData: there is no edge from vertex %u to vertex %u", v1, v2);
+            return false;
+        }
+        if (typeid(pd.getEdge(v1, v2)) != typeid(ompl::base::PlannerDataEdge))
+        {
+            OMPL_ERROR("Failed to store PlannerData: derived edge types cannot be stored in a mapped roadmap");
+            return false;
+        }
+        ompl::base::Cost w;
+        pd.getEdgeWeight(v1, v2, &w);
+        rc.targets.push_back(target);
+        rc.weights.push_back(w.value());
+        return true;
+    }
+
+    bool writeRecord(const ompl::base::StateSpacePtr &space, const RecordContents &rc, std::ostream &out)
+    {
+        std::vector<int> signature;
+        space->computeSignature(signature);
+
+        RecordHeader h;
+        std::memset(&h, 0, sizeof(h));
+        h.baseVertex = rc.baseVertex;
+        h.vertexCount = rc.states.size();
+        h.rowCount = rc.sources.size();
+        h.edgeCount = rc.targets.size();
+        h.stateSize = space->getSerializationLength();
+        h.signatureSize = signature.size();
+        computeLayout(h);
+
+        std::uint64_t pos = sizeof(h);
+        out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+
+        writeAt(out, pos, h.signatureOffset);
+        std::vector<std::int32_t> signature32(signature.begin(), signature.end());
+        writeArray(out, pos, signature32);
+
+        writeAt(out, pos, h.statesOffset);
+        std::vector<char> buffer(h.stateStride, 0);
+        for (const ompl::base::State *state : rc.states)
+        {
+            space->serialize(buffer.data(), state);
+            out.write(buffer.data(), buffer.size());
+        }
+        pos += h.vertexCount * h.stateStride;
+
+        writeAt(out, pos, h.tagsOffset);
+        writeArray(out, pos, rc.tags);
+        writeAt(out, pos, h.marksOffset);
+        writeArray(out, pos, rc.marks);
+        writeAt(out, pos, h.sourcesOffset);
+        writeArray(out, pos, rc.sources);
+        writeAt(out, pos, h.rowsOffset);
+        writeArray(out, pos, rc.rows);
+        writeAt(out, pos, h.targetsOffset);
+        writeArray(out, pos, rc.targets);
+        writeAt(out, pos, h.weightsOffset);
+        writeArray(out, pos, rc.weights);
+
+        if (!out.good())
+        {
+            OMPL_ERROR("Failed to store PlannerData: error writing to output stream");
+            return false;
+        }
+        return true;
+    }
+
+    /* Check the record starting at \e record, with \e available bytes left in the file. Returns an
+       empty string if the record can be used in place, and the reason otherwise. \e truncated is
+       set if the record is cut short by the end of the file. */
+    std::string validateRecord(const char *record, std::uint64_t available, const std::vector<int> &signature,
+                               std::uint64_t stateSize, bool &truncated)
+    {
+        truncated = available < sizeof(RecordHeader);
+        if (truncated)
+            return "truncated record header";
+        RecordHeader h;
+        std::memcpy(&h, record, sizeof(RecordHeader));
+        if (std::memcmp(h.magic, RECORD_MAGIC, sizeof(RECORD_MAGIC)) != 0)
+            return "record marker not found";
+        if (h.byteOrder != BYTE_ORDER_MARK)
+            return "record was written with a different byte order";
+        if (h.version != ompl::base::MappedPlannerDataStorage::VERSION)
+            return "unsupported record version " + std::to_string(h.version);
+        if (h.signatureSize != signature.size() || h.stateSize != stateSize)
+            return "StateSpace signature mismatch";
+        const std::uint64_t limit = std::numeric_limits<std::uint32_t>::max();
+        if (h.baseVertex > limit || h.vertexCount > limit - h.baseVertex || h.rowCount > limit ||
+            h.edgeCount > std::numeric_limits<std::uint64_t>::max() / 16)
+            return "corrupted record layout";
+
+        RecordHeader expected = h;
+        computeLayout(expected);
+        if (std::memcmp(&expected, &h, sizeof(RecordHeader)) != 0)
+            return "corrupted record layout";
+        truncated = h.recordSize > available;
+        if (truncated)
+            return "truncated record";
+        if (std::memcmp(record + h.signatureOffset, signature.data(), signature.size() * sizeof(std::int32_t)) != 0)
+            return "StateSpace signature mismatch";
+
+        const std::uint64_t vertices = h.baseVertex + h.vertexCount;
+        const auto *sources = reinterpret_cast<const std::uint32_t *>(record + h.sourcesOffset);
+        const auto *rows = reinterpret_cast<const std::uint64_t *>(record + h.rowsOffset);
+        const auto *targets = reinterpret_cast<const std::uint32_t *>(record + h.targetsOffset);
+        if (rows[0] != 0 || rows[h.rowCount] != h.edgeCount)
+            return "corrupted adjacency";
+        for (std::uint64_t r = 0; r < h.rowCount; ++r)
+            if (rows[r] > rows[r + 1] || sources[r] >= vertices || (r > 0 && sources[r - 1] >= sources[r]))
+                return "corrupted adjacency";
+        for (std::uint64_t e = 0; e < h.edgeCount; ++e)
+            if (targets[e] >= vertices)
+                return "corrupted adjacency";
+        return std::string();
+    }
+}
+
+/// @cond IGNORE
+struct ompl::base::MappedPlannerDataStorage::Region
+{
+    explicit Region(const char *filename)
+      : file(filename, boost::interprocess::read_only), region(file, boost::interprocess::copy_on_write)
+    {
+    }
+
+    boost::interprocess::file_mapping file;
+    boost::interprocess::mapped_region region;
+};
+/// @endcond
+
+ompl::base::MappedPlannerDataStorage::Roadmap::Roadmap(StateSpacePtr space, const char *record)
+  : space_(std::move(space))
+{
+    RecordHeader h;
+    std::memcpy(&h, record, sizeof(RecordHeader));
+    baseVertex_ = h.baseVertex;
+    vertexCount_ = h.vertexCount;
+    rowCount_ = h.rowCount;
+    edgeCount_ = h.edgeCount;
+    stateStride_ = h.stateStride;
+    states_ = record + h.statesOffset;
+    tags_ = reinterpret_cast<const std::int32_t *>(record + h.tagsOffset);
+    marks_ = reinterpret_cast<const std::uint8_t *>(record + h.marksOffset);
+    sources_ = reinterpret_cast<const std::uint32_t *>(record + h.sourcesOffset);
+    rows_ = reinterpret_cast<const std::uint64_t *>(record + h.rowsOffset);
+    targets_ = reinterpret_cast<const std::uint32_t *>(record + h.targetsOffset);
+    weights_ = reinterpret_cast<const double *>(record + h.weightsOffset);
+
+    // RealVectorStateSpace serializes its values verbatim, so the mapped bytes are the state
+    // itself and only the headers need to be allocated. Derived spaces may allocate larger
+    // states, hence the exact type check.
+    const StateSpace &s = *space_;
+    if (typeid(s) == typeid(RealVectorStateSpace))
+    {
+        views_.reset(new RealVectorStateSpace::StateType[vertexCount_]);
+        for (std::size_t i = 0; i < vertexCount_; ++i)
+            views_[i].values = reinterpret_cast<double *>(const_cast<char *>(states_ + i * stateStride_));
+    }
+    else
+        lazy_.reset(new std::atomic<State *>[vertexCount_]());
+}
+
+ompl::base::MappedPlannerDataStorage::Roadmap::~Roadmap()
+{
+    if (lazy_)
+        for (std::size_t i = 0; i < vertexCount_; ++i)
+            if (State *s = lazy_[i].load(std::memory_order_relaxed))
+                space_->freeState(s);
+}
+
+const ompl::base::State *ompl::base::MappedPlannerDataStorage::Roadmap::getState(std::size_t i) const
+{
+    if (views_)
+        return &views_[i];
+
+    State *s = lazy_[i].load(std::memory_order_acquire);
+    if (s == nullptr)
+    {
+        State *fresh = space_->allocState();
+        space_->deserialize(fresh, getSerializedState(i));
+        if (lazy_[i].compare_exchange_strong(s, fresh, std::memory_order_acq_rel))
+            s = fresh;
+        else
+            space_->freeState(fresh);
+    }
+    return s;
+}
+
+bool ompl::base::MappedPlannerDataStorage::Roadmap::toPlannerData(PlannerData &pd) const
+{
+    if (pd.numVertices() < baseVertex_)
+    {
+        OMPL_ERROR("Failed to load PlannerData: record extends a roadmap of %lu vertices, but only %u are loaded",
+                   (unsigned long)baseVertex_, pd.numVertices());
+        return false;
+    }
+
+    // Vertices of the preceding records are the last baseVertex_ vertices of pd
+    const std::size_t offset = pd.numVertices() - baseVertex_;
+    std::vector<unsigned int> index(vertexCount_);
+    for (std::size_t i = 0; i < vertexCount_; ++i)
+    {
+        PlannerDataVertex v(getState(i), getTag(i));
+        if (isStartVertex(i))
+        {
+            index[i] = pd.addStartVertex(v);
+            if (isGoalVertex(i))
+                pd.markGoalState(v.getState());
+        }
+        else if (isGoalVertex(i))
+            index[i] = pd.addGoalVertex(v);
+        else
+            index[i] = pd.addVertex(v);
+    }
+    auto vertex = [&](std::size_t g) { return g < baseVertex_ ? offset + g : index[g - baseVertex_]; };
+
+    for (std::size_t r = 0; r < rowCount_; ++r)
+    {
+        const unsigned int source = vertex(getSource(r));
+        const std::uint32_t *edges = getEdges(r);
+        const double *weights = getEdgeWeights(r);
+        for (std::size_t j = 0; j < getEdgeCount(r); ++j)
+            pd.addEdge(source, vertex(edges[j]), PlannerDataEdge(), Cost(weights[j]));
+    }
+    return true;
+}
+
+ompl::base::MappedPlannerDataStorage::MappedPlannerDataStorage() = default;
+
+ompl::base::MappedPlannerDataStorage::~MappedPlannerDataStorage()
+{
+    close();
+}
+
+bool ompl::base::MappedPlannerDataStorage::isMappedFile(const char *filename)
+{
+    std::ifstream in(filename, std::ios::binary);
+    char magic[sizeof(RECORD_MAGIC)];
+    if (!in.read(magic, sizeof(magic)))
+        return false;
+    return std::memcmp(magic, RECORD_MAGIC, sizeof(RECORD_MAGIC)) == 0;
+}
+
+bool ompl::base::MappedPlannerDataStorage::store(const PlannerData &pd, std::ostream &out)
+{
+    if (!checkStore(pd, out))
+        return false;
+
+    const std::size_t n = pd.numVertices();
+    RecordContents rc;
+    rc.states.resize(n);
+    rc.tags.resize(n);
+    rc.marks.resize(n, 0);
+    rc.sources.resize(n);
+    rc.rows.reserve(n + 1);
+    rc.targets.reserve(pd.numEdges());
+    rc.weights.reserve(pd.numEdges());
+
+    std::vector<unsigned int> edges;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const PlannerDataVertex &v = pd.getVertex(i);
+        if (typeid(v) != typeid(PlannerDataVertex))
+        {
+            OMPL_ERROR("Failed to store PlannerData: derived vertex types cannot be stored in a mapped roadmap");
+            return false;
+        }
+        rc.states[i] = v.getState();
+        rc.tags[i] = v.getTag();
+        if (pd.isStartVertex(i))
+            rc.marks[i] |= Roadmap::START_MARK;
+        if (pd.isGoalVertex(i))
+            rc.marks[i] |= Roadmap::GOAL_MARK;
+
+        rc.sources[i] = i;
+        edges.clear();
+        pd.getEdges(i, edges);
+        std::sort(edges.begin(), edges.end());
+        for (unsigned int j : edges)
+            if (!addEdge(pd, i, j, j, rc))
+                return false;
+        rc.rows.push_back(rc.targets.size());
+    }
+
+    return writeRecord(pd.getSpaceInformation()->getStateSpace(), rc, out);
+}
+
+bool ompl::base::MappedPlannerDataStorage::append(const PlannerData &pd, const std::vector<unsigned int> &index,
+                                                  std::size_t baseVertex,
+                                                  const std::vector<std::pair<unsigned int, unsigned int>> &edges,
+                                                  std::ostream &out)
+{
+    if (!checkStore(pd, out))
+        return false;
+    if (index.size() != pd.numVertices())
+    {
+        OMPL_ERROR("Failed to store PlannerData: expected the roadmap index of %u vertices", pd.numVertices());
+        return false;
+    }
+
+    // Find the vertices of pd that are new to the roadmap, in roadmap order
+    std::vector<unsigned int> added;
+    for (unsigned int i = 0; i < index.size(); ++i)
+        if (index[i] >= baseVertex)
+        {
+            if (index[i] - baseVertex >= added.size())
+                added.resize(index[i] - baseVertex + 1, std::numeric_limits<unsigned int>::max());
+            added[index[i] - baseVertex] = i;
+        }
+
+    RecordContents rc;
+    rc.baseVertex = baseVertex;
+    for (unsigned int i : added)
+    {
+        if (i == std::numeric_limits<unsigned int>::max())
+        {
+            OMPL_ERROR("Failed to store PlannerData: appended vertices are not numbered contiguously");
+            return false;
+        }
+        const PlannerDataVertex &v = pd.getVertex(i);
+        if (typeid(v) != typeid(PlannerDataVertex))
+        {
+            OMPL_ERROR("Failed to store PlannerData: derived vertex types cannot be stored in a mapped roadmap");
+            return false;
+        }
+        rc.states.push_back(v.getState());
+        rc.tags.push_back(v.getTag());
+        std::uint8_t mark = 0;
+        if (pd.isStartVertex(i))
+            mark |= Roadmap::START_MARK;
+        if (pd.isGoalVertex(i))
+            mark |= Roadmap::GOAL_MARK;
+        rc.marks.push_back(mark);
+    }
+
+    // Group the edges by the roadmap vertex they start at
+    std::vector<std::pair<unsigned int, unsigned int>> sorted(edges);
+    std::sort(sorted.begin(), sorted.end(),
+              [&index](const std::pair<unsigned int, unsigned int> &a, const std::pair<unsigned int, unsigned int> &b)
+              {
+                  return std::make_pair(index[a.first], index[a.second]) <
+                         std::make_pair(index[b.first], index[b.second]);
+              });
+    for (const auto &e : sorted)
+    {
+        if (rc.sources.empty() || rc.sources.back() != index[e.first])
+        {
+            if (!rc.sources.empty())
+                rc.rows.push_back(rc.targets.size());
+            rc.sources.push_back(index[e.first]);
+        }
+        if (!addEdge(pd, e.first, e.second, index[e.second], rc))
+            return false;
+    }
+    if (!rc.sources.empty())
+        rc.rows.push_back(rc.targets.size());
+
+    return writeRecord(pd.getSpaceInformation()->getStateSpace(), rc, out);
+}
+
+std::uint64_t ompl::base::MappedPlannerDataStorage::appendRecords(const std::string &records, const char *filename,
+                                                                  std::uint64_t validSize)
+{
+    boost::system::error_code ec;
+    const std::uintmax_t size = boost::filesystem::file_size(filename, ec);
+    if (!ec && size != validSize)
+    {
+        OMPL_WARN("Dropping %lu bytes of incomplete records at the end of '%s'",
+                  (unsigned long)(size - validSize), filename);
+        boost::filesystem::resize_file(filename, validSize, ec);
+    }
+    if (ec)
+    {
+        OMPL_ERROR("Failed to append to '%s': %s", filename, ec.message().c_str());
+        return 0;
+    }
+
+    std::ofstream out(filename, std::ios::binary | std::ios::app);
+    out.write(records.data(), records.size());
+    out.close();
+    if (out.fail())
+    {
+        OMPL_ERROR("Failed to append to '%s'", filename);
+        return 0;
+    }
+    return validSize + records.size();
+}
+
+bool ompl::base::MappedPlannerDataStorage::store(const std::vector<PlannerDataPtr> &pds, const char *filename)
+{
+    const std::string temporary = std::string(filename) + ".tmp";
+    std::ofstream out(temporary.c_str(), std::ios::binary | std::ios::trunc);
+    bool result = true;
+    for (const auto &pd : pds)
+        if (!(result = store(*pd, out)))
+            break;
+    out.close();
+
+    boost::system::error_code ec;
+    if (result && !out.fail())
+        boost::filesystem::rename(temporary, filename, ec);
+    if (!result || out.fail() || ec)
+    {
+        if (ec)
+            OMPL_ERROR("Failed to store PlannerData to '%s': %s", filename, ec.message().c_str());
+        boost::filesystem::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
+
+bool ompl::base::MappedPlannerDataStorage::store(const PlannerData &pd, const char *filename)
+{
+    // The vector does not own pd; the no-op deleter keeps the overloads sharing one code path
+    std::vector<PlannerDataPtr> pds(1, PlannerDataPtr(const_cast<PlannerData *>(&pd), [](PlannerData *) {}));
+    return store(pds, filename);
+}
+
+bool ompl::base::MappedPlannerDataStorage::open(const SpaceInformationPtr &si, const char *filename)
+{
+    close();
+    if (!si)
+    {
+        OMPL_ERROR("Failed to load PlannerData: SpaceInformation is invalid");
+        return false;
+    }
+
+    boost::system::error_code ec;
+    const std::uintmax_t size = boost::filesystem::file_size(filename, ec);
+    if (ec || size < sizeof(RecordHeader))
+    {
+        OMPL_ERROR("Failed to load PlannerData: '%s' is not a mapped roadmap", filename);
+        return false;
+    }
+
+    try
+    {
+        region_.reset(new Region(filename));
+    }
+    catch (boost::interprocess::interprocess_exception &ie)
+    {
+        OMPL_ERROR("Failed to map '%s': %s", filename, ie.what());
+        return false;
+    }
+
+    const StateSpacePtr &space = si->getStateSpace();
+    std::vector<int> signature;
+    space->computeSignature(signature);
+
+    const char *data = static_cast<const char *>(region_->region.get_address());
+    const std::uint64_t total = region_->region.get_size();
+    std::uint64_t offset = 0;
+    std::uint64_t roadmapSize = 0;
+    while (offset < total)
+    {
+        bool truncated;
+        std::string error =
+            validateRecord(data + offset, total - offset, signature, space->getSerializationLength(), truncated);
+        if (truncated && !roadmaps_.empty())
+        {
+            // Most likely a save that was interrupted; the records before it are intact
+            OMPL_WARN("Ignoring %s at the end of '%s'", error.c_str(), filename);
+            break;
+        }
+        if (!error.empty())
+        {
+            OMPL_ERROR("Failed to load PlannerData from '%s': %s", filename, error.c_str());
+            close();
+            return false;
+        }
+
+        roadmaps_.emplace_back(new Roadmap(space, data + offset));
+        const Roadmap &roadmap = *roadmaps_.back();
+        if (roadmap.getBaseVertex() != 0 && roadmap.getBaseVertex() != roadmapSize)
+        {
+            OMPL_ERROR("Failed to load PlannerData from '%s': record does not extend the preceding roadmap", filename);
+            close();
+            return false;
+        }
+        roadmapSize = roadmap.getBaseVertex() + roadmap.numVertices();
+
+        RecordHeader h;
+        std::memcpy(&h, data + offset, sizeof(RecordHeader));
+        offset += h.recordSize;
+    }
+    validSize_ = offset;
+    return true;
+}
+
+void ompl::base::MappedPlannerDataStorage::close()
+{
+    roadmaps_.clear();
+    region_.reset();
+    validSize_ = 0;
+}
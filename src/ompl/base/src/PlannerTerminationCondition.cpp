@@ -36,127 +36,232 @@
 
 #include "ompl/base/PlannerTerminationCondition.h"
 #include "ompl/util/Time.h"
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace ompl
 {
     namespace base
     {
         /// @cond IGNORE
+        namespace
+        {
+            /** \brief A single thread that fires the deadlines of all termination conditions in the process */
+            template <typename Target>
+            class TerminationTimer
+            {
+            public:
+                /** \brief A deadline, made unique by a sequence number */
+                using Key = std::pair<time::point, unsigned long>;
+
+                /** \brief The timer is never destroyed, so conditions that outlive main() can still cancel their
+                    deadlines */
+                static TerminationTimer &instance()
+                {
+                    static auto *timer = new TerminationTimer();
+                    return *timer;
+                }
+
+                /** \brief Call fire() on \e target at time \e when, unless \e target was destroyed by then. The
+                    deadline is remembered in target->timerKey_. */
+                void schedule(const time::point &when, const std::shared_ptr<Target> &target)
+                {
+                    std::lock_guard<std::mutex> slock(lock_);
+                    if (!running_)
+                    {
+                        std::thread([this]
+                                    {
+                                        run();
+                                    }).detach();
+                        running_ = true;
+                    }
+                    target->timerKey_ = Key(when, ++sequence_);
+                    bool earliest = deadlines_.empty() || target->timerKey_ < deadlines_.begin()->first;
+                    deadlines_.emplace(target->timerKey_, target);
+                    if (earliest)
+                        wakeup_.notify_one();
+                }
+
+                /** \brief Forget the deadline of \e target, if it has not fired yet */
+                void cancel(Target *target)
+                {
+                    std::lock_guard<std::mutex> slock(lock_);
+                    deadlines_.erase(target->timerKey_);
+                }
+
+            private:
+                TerminationTimer() = default;
+
+                void run()
+                {
+                    std::unique_lock<std::mutex> slock(lock_);
+                    while (true)
+                    {
+                        if (deadlines_.empty())
+                        {
+                            wakeup_.wait(slock);
+                            continue;
+                        }
+                        auto first = deadlines_.begin();
+                        if (time::now() < first->first.first)
+                        {
+                            wakeup_.wait_until(slock, first->first.first);
+                            continue;
+                        }
+                        std::shared_ptr<Target> target = first->second.lock();
+                        deadlines_.erase(first);
+
+                        // firing may schedule or cancel deadlines, and may destroy the target
+                        slock.unlock();
+                        if (target)
+                            target->fire();
+                        target.reset();
+                        slock.lock();
+                    }
+                }
+
+                std::map<Key, std::weak_ptr<Target>> deadlines_;
+                unsigned long sequence_{0};
+                bool running_{false};
+                std::mutex lock_;
+                std::condition_variable wakeup_;
+            };
+        }
+
         class PlannerTerminationCondition::PlannerTerminationConditionImpl
+          : public std::enable_shared_from_this<PlannerTerminationConditionImpl>
         {
         public:
+            using Timer = TerminationTimer<PlannerTerminationConditionImpl>;
+
             PlannerTerminationConditionImpl(PlannerTerminationConditionFn fn, double period)
-              : fn_(std::move(fn))
-              , period_(period)
-              , terminate_(false)
-              , thread_(nullptr)
-              , evalValue_(false)
-              , signalThreadStop_(false)
+              : fn_(std::move(fn)), period_(period), polling_(fn_ && period_ <= 0.0)
             {
-                if (period_ > 0.0)
-                    startEvalThread();
             }
 
             ~PlannerTerminationConditionImpl()
             {
-                stopEvalThread();
+                Timer::instance().cancel(this);
+                for (auto &release : release_)
+                    release();
             }
 
             bool eval() const
             {
-                if (terminate_)
+                if (terminate_.load(std::memory_order_relaxed))
                     return true;
-                if (period_ > 0.0)
-                    return evalValue_;
-                return fn_();
+                return polling_ && fn_();
             }
 
-            void terminate() const
+            /** \brief True if eval() does not call a function */
+            bool eventDriven() const
             {
-                // it is ok to have unprotected write here
-                terminate_ = true;
+                return !polling_;
             }
 
-        private:
-            /** \brief Start the thread evaluating termination conditions if not already started */
-            void startEvalThread()
+            void terminate() const
             {
-                if (thread_ == nullptr)
+                if (terminate_.exchange(true))
+                    return;
+                std::vector<std::pair<unsigned int, std::function<void()>>> callbacks;
                 {
-                    signalThreadStop_ = false;
-                    evalValue_ = false;
-                    thread_ = new std::thread([this]
-                                              {
-                                                  periodicEval();
-                                              });
+                    std::lock_guard<std::mutex> slock(callbacksLock_);
+                    callbacks.swap(callbacks_);
                 }
+                for (auto &callback : callbacks)
+                    callback.second();
             }
 
-            /** \brief Stop the thread evaluating termination conditions if not already stopped */
-            void stopEvalThread()
+            /** \brief Call \e callback once, when this condition is terminated (immediately if it already is) */
+            unsigned int addCallback(const std::function<void()> &callback) const
             {
-                signalThreadStop_ = true;
-                if (thread_ != nullptr)
                 {
-                    thread_->join();
-                    delete thread_;
-                    thread_ = nullptr;
+                    std::lock_guard<std::mutex> slock(callbacksLock_);
+                    if (!terminate_)
+                    {
+                        callbacks_.emplace_back(++lastCallbackId_, callback);
+                        return lastCallbackId_;
+                    }
                 }
+                callback();
+                return 0;
             }
 
-            /** \brief Worker function that runs in a separate thread (calls computeEval())*/
-            void periodicEval()
+            void removeCallback(unsigned int id) const
             {
-                // we want to check for termination at least once every ms;
-                // even though we may evaluate the condition itself more rarely
+                std::lock_guard<std::mutex> slock(callbacksLock_);
+                for (auto it = callbacks_.begin(); it != callbacks_.end(); ++it)
+                    if (it->first == id)
+                    {
+                        callbacks_.erase(it);
+                        break;
+                    }
+            }
 
-                unsigned int count = 1;
-                time::duration s = time::seconds(period_);
-                if (period_ > 0.001)
-                {
-                    count = 0.5 + period_ / 0.001;
-                    s = time::seconds(period_ / (double)count);
-                }
+            /** \brief Terminate this condition at \e when, or start evaluating it periodically from \e when */
+            void schedule(const time::point &when)
+            {
+                Timer::instance().schedule(when, shared_from_this());
+            }
 
-                while (!terminate_ && !signalThreadStop_)
+            /** \brief Called by the timer thread when the scheduled time is reached */
+            void fire()
+            {
+                if (period_ <= 0.0)
+                    terminate();
+                else if (!terminate_)
                 {
-                    evalValue_ = fn_();
-                    for (unsigned int i = 0; i < count; ++i)
-                    {
-                        if (terminate_ || signalThreadStop_)
-                            break;
-                        std::this_thread::sleep_for(s);
-                    }
+                    if (fn_())
+                        terminate();
+                    else
+                        schedule(time::now() + time::seconds(period_));
                 }
             }
 
+            /** \brief Functions called on destruction, to undo the registrations this condition depends on. They may
+                also keep alive the conditions this one is computed from. */
+            std::vector<std::function<void()>> release_;
+
+            /** \brief The pending deadline of this condition, if any. It is only accessed by the timer, under its
+                lock. */
+            Timer::Key timerKey_;
+
+        private:
             /** \brief Function pointer to the piece of code that decides whether a termination condition has been met
              */
             PlannerTerminationConditionFn fn_;
 
-            /** \brief Interval of time (seconds) to wait between calls to computeEval() */
+            /** \brief Interval of time (seconds) to wait between calls to fn_(), or a negative value if fn_() is called
+                by eval() */
             double period_;
 
-            /** \brief Flag indicating whether the user has externally requested that the condition for termination
-             * should become true */
-            mutable bool terminate_;
+            /** \brief Flag indicating whether eval() calls fn_() */
+            const bool polling_;
 
-            /** \brief Thread for periodicEval() */
-            std::thread *thread_;
+            /** \brief Flag indicating whether the condition for termination has become true. It is set by terminate(),
+                deadlines and the callbacks of the conditions this one depends on */
+            mutable std::atomic<bool> terminate_{false};
 
-            /** \brief Cached value returned by fn_() */
-            bool evalValue_;
-
-            /** \brief Flag used to signal the condition evaluation thread to stop. */
-            bool signalThreadStop_;
+            /** \brief Functions to call when terminate_ is first set */
+            mutable std::vector<std::pair<unsigned int, std::function<void()>>> callbacks_;
+            mutable unsigned int lastCallbackId_{0};
+            mutable std::mutex callbacksLock_;
         };
 
         /// @endcond
     }
 }
 
+ompl::base::PlannerTerminationCondition::PlannerTerminationCondition()
+  : impl_(std::make_shared<PlannerTerminationConditionImpl>(PlannerTerminationConditionFn(), -1.0))
+{
+}
+
 ompl::base::PlannerTerminationCondition::PlannerTerminationCondition(const PlannerTerminationConditionFn &fn)
   : impl_(std::make_shared<PlannerTerminationConditionImpl>(fn, -1.0))
 {
@@ -166,6 +271,8 @@ ompl::base::PlannerTerminationCondition::PlannerTerminationCondition(const Plann
                                                                      double period)
   : impl_(std::make_shared<PlannerTerminationConditionImpl>(fn, period))
 {
+    if (period > 0.0)
+        impl_->schedule(time::now());
 }
 
 void ompl::base::PlannerTerminationCondition::terminate() const
@@ -180,36 +287,68 @@ bool ompl::base::PlannerTerminationCondition::eval() const
 
 ompl::base::PlannerTerminationCondition ompl::base::plannerNonTerminatingCondition()
 {
-    return PlannerTerminationCondition([]
-                                       {
-                                           return false;
-                                       });
+    return PlannerTerminationCondition();
 }
 
 ompl::base::PlannerTerminationCondition ompl::base::plannerAlwaysTerminatingCondition()
 {
-    return PlannerTerminationCondition([]
-                                       {
-                                           return true;
-                                       });
+    PlannerTerminationCondition ptc;
+    ptc.terminate();
+    return ptc;
 }
 
 ompl::base::PlannerTerminationCondition ompl::base::plannerOrTerminationCondition(const PlannerTerminationCondition &c1,
                                                                                   const PlannerTerminationCondition &c2)
 {
-    return PlannerTerminationCondition([c1, c2]
-                                       {
-                                           return c1() || c2();
-                                       });
+    if (!c1.impl_->eventDriven() || !c2.impl_->eventDriven())
+        return PlannerTerminationCondition([c1, c2]
+                                           {
+                                               return c1() || c2();
+                                           });
+
+    PlannerTerminationCondition ptc;
+    std::weak_ptr<PlannerTerminationCondition::PlannerTerminationConditionImpl> target(ptc.impl_);
+    for (const PlannerTerminationCondition &c : {c1, c2})
+    {
+        unsigned int id = c.impl_->addCallback([target]
+                                               {
+                                                   if (auto impl = target.lock())
+                                                       impl->terminate();
+                                               });
+        ptc.impl_->release_.emplace_back([c, id]
+                                         {
+                                             c.impl_->removeCallback(id);
+                                         });
+    }
+    return ptc;
 }
 
 ompl::base::PlannerTerminationCondition
 ompl::base::plannerAndTerminationCondition(const PlannerTerminationCondition &c1, const PlannerTerminationCondition &c2)
 {
-    return PlannerTerminationCondition([c1, c2]
-                                       {
-                                           return c1() && c2();
-                                       });
+    if (!c1.impl_->eventDriven() || !c2.impl_->eventDriven())
+        return PlannerTerminationCondition([c1, c2]
+                                           {
+                                               return c1() && c2();
+                                           });
+
+    PlannerTerminationCondition ptc;
+    std::weak_ptr<PlannerTerminationCondition::PlannerTerminationConditionImpl> target(ptc.impl_);
+    auto remaining = std::make_shared<std::atomic<unsigned int>>(2u);
+    for (const PlannerTerminationCondition &c : {c1, c2})
+    {
+        unsigned int id = c.impl_->addCallback([target, remaining]
+                                               {
+                                                   if (--*remaining == 0)
+                                                       if (auto impl = target.lock())
+                                                           impl->terminate();
+                                               });
+        ptc.impl_->release_.emplace_back([c, id]
+                                         {
+                                             c.impl_->removeCallback(id);
+                                         });
+    }
+    return ptc;
 }
 
 ompl::base::PlannerTerminationCondition ompl::base::timedPlannerTerminationCondition(double duration)
@@ -219,31 +358,35 @@ ompl::base::PlannerTerminationCondition ompl::base::timedPlannerTerminationCondi
 
 ompl::base::PlannerTerminationCondition ompl::base::timedPlannerTerminationCondition(time::duration duration)
 {
-    const time::point endTime(time::now() + duration);
-    return PlannerTerminationCondition([endTime]
-                                       {
-                                           return time::now() > endTime;
-                                       });
+    PlannerTerminationCondition ptc;
+    ptc.impl_->schedule(time::now() + duration);
+    return ptc;
 }
 
-ompl::base::PlannerTerminationCondition ompl::base::timedPlannerTerminationCondition(double duration, double interval)
+ompl::base::PlannerTerminationCondition ompl::base::timedPlannerTerminationCondition(double duration, double /*interval*/)
 {
-    if (interval > duration)
-        interval = duration;
-    const time::point endTime(time::now() + time::seconds(duration));
-    return PlannerTerminationCondition([endTime]
-                                       {
-                                           return time::now() > endTime;
-                                       });
+    return timedPlannerTerminationCondition(time::seconds(duration));
 }
 
 ompl::base::PlannerTerminationCondition
 ompl::base::exactSolnPlannerTerminationCondition(const ompl::base::ProblemDefinitionPtr& pdef)
 {
-    return PlannerTerminationCondition([pdef]
-                                       {
-                                           return pdef->hasExactSolution();
-                                       });
+    PlannerTerminationCondition ptc;
+    std::weak_ptr<PlannerTerminationCondition::PlannerTerminationConditionImpl> target(ptc.impl_);
+    unsigned int id = pdef->addSolutionAddedCallback([target](const PlannerSolution &solution)
+                                                     {
+                                                         if (!solution.approximate_)
+                                                             if (auto impl = target.lock())
+                                                                 impl->terminate();
+                                                     });
+    ptc.impl_->release_.emplace_back([pdef, id]
+                                     {
+                                         pdef->removeSolutionAddedCallback(id);
+                                     });
+    // a solution may have been added before the callback was registered
+    if (pdef->hasExactSolution())
+        ptc.terminate();
+    return ptc;
 }
 
 namespace ompl
@@ -59,11 +59,42 @@ namespace ompl
 
             void add(const PlannerSolution &s)
             {
-                std::lock_guard<std::mutex> slock(lock_);
-                int index = solutions_.size();
-                solutions_.push_back(s);
-                solutions_.back().index_ = index;
-                std::sort(solutions_.begin(), solutions_.end());
+                {
+                    std::lock_guard<std::mutex> slock(lock_);
+                    int index = solutions_.size();
+                    solutions_.push_back(s);
+                    solutions_.back().index_ = index;
+                    std::sort(solutions_.begin(), solutions_.end());
+                }
+
+                // callbacks run without holding any lock, so they may use this problem definition
+                std::vector<std::pair<unsigned int, SolutionAddedFn>> callbacks;
+                {
+                    std::lock_guard<std::mutex> clock(callbacksLock_);
+                    if (callbacks_.empty())
+                        return;
+                    callbacks = callbacks_;
+                }
+                for (const auto &callback : callbacks)
+                    callback.second(s);
+            }
+
+            unsigned int addCallback(const SolutionAddedFn &callback)
+            {
+                std::lock_guard<std::mutex> clock(callbacksLock_);
+                callbacks_.emplace_back(++lastCallbackId_, callback);
+                return lastCallbackId_;
+            }
+
+            void removeCallback(unsigned int id)
+            {
+                std::lock_guard<std::mutex> clock(callbacksLock_);
+                callbacks_.erase(std::remove_if(callbacks_.begin(), callbacks_.end(),
+                                                [id](const std::pair<unsigned int, SolutionAddedFn> &callback)
+                                                {
+                                                    return callback.first == id;
+                                                }),
+                                 callbacks_.end());
             }
 
             void clear()
@@ -140,6 +171,10 @@ namespace ompl
         private:
             std::vector<PlannerSolution> solutions_;
             std::mutex lock_;
+
+            std::vector<std::pair<unsigned int, SolutionAddedFn>> callbacks_;
+            unsigned int lastCallbackId_{0};
+            std::mutex callbacksLock_;
         };
     }
 }
@@ -161,7 +196,9 @@ bool ompl::base::PlannerSolution::operator<(const PlannerSolution &b) const
 }
 
 ompl::base::ProblemDefinition::ProblemDefinition(SpaceInformationPtr si)
-  : si_(std::move(si)), solutions_(std::make_shared<PlannerSolutionSet>())
+  : si_(std::move(si))
+  , solutions_(std::make_shared<PlannerSolutionSet>())
+  , solutionChannel_(std::make_shared<SolutionChannel>())
 {
 }
 
@@ -431,6 +468,17 @@ void ompl::base::ProblemDefinition::addSolutionPath(const PlannerSolution &sol)
     if (sol.approximate_)
         OMPL_INFORM("ProblemDefinition: Adding approximate solution from planner %s", sol.plannerName_.c_str());
     solutions_->add(sol);
+
+    if (!sol.approximate_ && sol.path_)
+    {
+        if (sol.opt_)
+            solutionChannel_->publish(sol.path_, sol.cost_, sol.plannerName_, sol.opt_.get());
+        else if (optimizationObjective_)
+            solutionChannel_->publish(sol.path_, sol.path_->cost(optimizationObjective_), sol.plannerName_,
+                                      optimizationObjective_.get());
+        else
+            solutionChannel_->publish(sol.path_, Cost(sol.length_), sol.plannerName_);
+    }
 }
 
 bool ompl::base::ProblemDefinition::hasApproximateSolution() const
@@ -453,9 +501,20 @@ std::vector<ompl::base::PlannerSolution> ompl::base::ProblemDefinition::getSolut
     return solutions_->getSolutions();
 }
 
+unsigned int ompl::base::ProblemDefinition::addSolutionAddedCallback(const SolutionAddedFn &callback) const
+{
+    return solutions_->addCallback(callback);
+}
+
+void ompl::base::ProblemDefinition::removeSolutionAddedCallback(unsigned int id) const
+{
+    solutions_->removeCallback(id);
+}
+
 void ompl::base::ProblemDefinition::clearSolutionPaths() const
 {
     solutions_->clear();
+    solutionChannel_->reset();
 }
 
 void ompl::base::ProblemDefinition::print(std::ostream &out) const
@@ -0,0 +1,165 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "ompl/base/SolutionChannel.h"
+#include "ompl/base/OptimizationObjective.h"
+#include <utility>
+
+/// @cond IGNORE
+struct ompl::base::SolutionChannel::Node
+{
+    ~Node()
+    {
+        // release the nodes that follow one at a time, instead of recursively
+        std::shared_ptr<Node> node(std::move(nextOwner));
+        while (node && node.use_count() == 1)
+        {
+            std::shared_ptr<Node> following(std::move(node->nextOwner));
+            node = std::move(following);
+        }
+    }
+
+    SolutionImprovement improvement;
+
+    /** \brief The node published after this one, or nullptr. Readers must load this before nextOwner. */
+    std::atomic<Node *> next{nullptr};
+
+    /** \brief Owner of the node published after this one. It is set before next is, and never changes after. */
+    std::shared_ptr<Node> nextOwner;
+};
+/// @endcond
+
+ompl::base::SolutionChannel::SolutionChannel() : tail_(std::make_shared<Node>())
+{
+}
+
+ompl::base::SolutionChannel::~SolutionChannel() = default;
+
+bool ompl::base::SolutionChannel::publish(const PathPtr &path, Cost cost, const std::string &plannerName,
+                                          const OptimizationObjective *opt)
+{
+    {
+        std::lock_guard<std::mutex> slock(writeLock_);
+        if (opt != nullptr && compareToTail_ && !opt->isCostBetterThan(cost, tail_->improvement.cost))
+            return false;
+
+        auto node = std::make_shared<Node>();
+        node->improvement.path = path;
+        node->improvement.cost = cost;
+        node->improvement.stamp = time::now();
+        node->improvement.plannerName = plannerName;
+        node->improvement.index = published_++;
+
+        tail_->nextOwner = node;
+        tail_->next.store(node.get());
+        tail_ = std::move(node);
+        compareToTail_ = true;
+    }
+
+    // the store to next above and this load are sequentially consistent, so either a waiting subscriber sees the new
+    // node before it blocks, or we see the subscriber and wake it up
+    if (waiting_.load() > 0)
+    {
+        std::lock_guard<std::mutex> wlock(waitLock_);
+        wakeup_.notify_all();
+    }
+    return true;
+}
+
+void ompl::base::SolutionChannel::reset()
+{
+    std::lock_guard<std::mutex> slock(writeLock_);
+    compareToTail_ = false;
+}
+
+unsigned int ompl::base::SolutionChannel::getPublishedCount() const
+{
+    std::lock_guard<std::mutex> slock(writeLock_);
+    return published_;
+}
+
+ompl::base::SolutionChannel::Subscriber::Subscriber(const SolutionChannelPtr &channel, bool includeLatest)
+  : channel_(channel)
+{
+    std::lock_guard<std::mutex> slock(channel_->writeLock_);
+    cursor_ = channel_->tail_;
+    if (includeLatest && channel_->published_ > 0)
+        pending_ = cursor_;
+    ++channel_->subscribers_;
+}
+
+ompl::base::SolutionChannel::Subscriber::~Subscriber()
+{
+    --channel_->subscribers_;
+}
+
+std::shared_ptr<const ompl::base::SolutionImprovement> ompl::base::SolutionChannel::Subscriber::next()
+{
+    if (pending_)
+    {
+        std::shared_ptr<Node> node(std::move(pending_));
+        return std::shared_ptr<const SolutionImprovement>(node, &node->improvement);
+    }
+    if (cursor_->next.load(std::memory_order_acquire) == nullptr)
+        return nullptr;
+    std::shared_ptr<Node> node(cursor_->nextOwner);
+    cursor_ = node;
+    return std::shared_ptr<const SolutionImprovement>(node, &node->improvement);
+}
+
+std::shared_ptr<const ompl::base::SolutionImprovement> ompl::base::SolutionChannel::Subscriber::latest()
+{
+    std::shared_ptr<const SolutionImprovement> result;
+    while (auto improvement = next())
+        result = std::move(improvement);
+    return result;
+}
+
+std::shared_ptr<const ompl::base::SolutionImprovement> ompl::base::SolutionChannel::Subscriber::wait(double timeout)
+{
+    if (auto improvement = next())
+        return improvement;
+
+    time::point deadline = time::now() + time::seconds(timeout);
+    ++channel_->waiting_;
+    {
+        std::unique_lock<std::mutex> wlock(channel_->waitLock_);
+        channel_->wakeup_.wait_until(wlock, deadline, [this]
+                                     {
+                                         return cursor_->next.load() != nullptr;
+                                     });
+    }
+    --channel_->waiting_;
+    return next();
+}
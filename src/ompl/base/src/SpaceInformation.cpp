@@ -35,8 +35,11 @@
 /* Author: Ioan Sucan */
 
 #include "ompl/base/SpaceInformation.h"
+#include <atomic>
 #include <cassert>
+#include <mutex>
 #include <queue>
+#include <thread>
 #include <utility>
 #include "ompl/base/DiscreteMotionValidator.h"
 #include "ompl/base/DynamicalMotionValidator.h"
@@ -48,10 +51,83 @@
 #include "ompl/util/Exception.h"
 #include "ompl/util/Time.h"
 
+/// @cond IGNORE
+namespace
+{
+    std::atomic<std::uint64_t> g_scratchStatesCount{0};
+
+    /// The scratch states the calling thread used last, and the instance they belong to
+    struct ScratchCache
+    {
+        std::uint64_t instance{0};
+        std::vector<ompl::base::State *> *states{nullptr};
+    };
+
+    thread_local ScratchCache t_scratchCache;
+}
+
+struct ompl::base::SpaceInformation::ScratchStates
+{
+    struct ThreadStates
+    {
+        std::thread::id owner;
+        std::vector<State *> free;
+    };
+
+    explicit ScratchStates(StateSpacePtr space) : space(std::move(space)), instance(++g_scratchStatesCount)
+    {
+    }
+
+    ~ScratchStates()
+    {
+        for (auto &thread : threads)
+            for (State *state : thread->free)
+                space->freeState(state);
+    }
+
+    /// Find or create the free list of the calling thread
+    std::vector<State *> &local()
+    {
+        if (t_scratchCache.instance == instance)
+            return *t_scratchCache.states;
+
+        std::lock_guard<std::mutex> slock(lock);
+        const std::thread::id self = std::this_thread::get_id();
+        ThreadStates *states = nullptr;
+        for (auto &thread : threads)
+            if (thread->owner == self)
+            {
+                states = thread.get();
+                break;
+            }
+        if (states == nullptr)
+        {
+            threads.emplace_back(new ThreadStates{self, {}});
+            states = threads.back().get();
+            states->free.reserve(16);
+        }
+        t_scratchCache.instance = instance;
+        t_scratchCache.states = &states->free;
+        return states->free;
+    }
+
+    StateSpacePtr space;
+
+    /// Unique number of this cache, used to find the free list of a thread
+    const std::uint64_t instance;
+
+    /// Protects the list of threads, not their free lists
+    std::mutex lock;
+
+    std::vector<std::unique_ptr<ThreadStates>> threads;
+};
+/// @endcond
+
 ompl::base::SpaceInformation::SpaceInformation(StateSpacePtr space) : stateSpace_(std::move(space)), setup_(false)
 {
     if (!stateSpace_)
         throw Exception("Invalid space definition");
+    scratchStates_ = std::make_shared<ScratchStates>(stateSpace_);
     setDefaultMotionValidator();
     params_.include(stateSpace_->params());
 }
@@ -120,6 +196,66 @@ void ompl::base::SpaceInformation::setDefaultMotionValidator()
         //motionValidator_ = std::make_shared<DiscreteMotionValidator>(this);
 }
 
+ompl::base::State *ompl::base::SpaceInformation::allocScratchState() const
+{
+    std::vector<State *> &free = scratchStates_->local();
+    if (free.empty())
+        return stateSpace_->allocState();
+    State *state = free.back();
+    free.pop_back();
+    return state;
+}
+
+void ompl::base::SpaceInformation::freeScratchState(State *state) const
+{
+    scratchStates_->local().push_back(state);
+}
+
+void ompl::base::SpaceInformation::enableMotionValidityCache(std::size_t capacity, bool symmetric)
+{
+    if (!motionValidityCache_)
+    {
+        // the cache can be enabled before setup(), which would otherwise set the default validator
+        if (!motionValidator_)
+            setDefaultMotionValidator();
+        motionValidityCache_ = std::make_shared<CachedMotionValidator>(this, motionValidator_, capacity);
+        motionValidator_ = motionValidityCache_;
+    }
+    else
+        motionValidityCache_->setCapacity(capacity);
+    motionValidityCache_->setSymmetric(symmetric);
+}
+
+void ompl::base::SpaceInformation::disableMotionValidityCache()
+{
+    if (motionValidityCache_)
+    {
+        motionValidator_ = motionValidityCache_->getMotionValidator();
+        motionValidityCache_.reset();
+    }
+}
+
+void ompl::base::SpaceInformation::enableStatePool(std::size_t slabSize, bool resetOnClear)
+{
+    disableStatePool();
+    statePool_ = std::make_shared<StatePool>(stateSpace_, slabSize);
+    statePool_->setResetOnClear(resetOnClear);
+    if (!statePool_->isInline())
+        OMPL_DEBUG("States of space '%s' cannot be stored inline; the state pool will only recycle them",
+                   stateSpace_->getName().c_str());
+}
+
+void ompl::base::SpaceInformation::disableStatePool()
+{
+    if (!statePool_)
+        return;
+    if (statePool_->getUserCount() > 0)
+        throw Exception("Cannot disable a state pool that planners are still using");
+    if (!statePool_->getResetOnClear() && statePool_->size() > 0)
+        throw Exception("Cannot disable a state pool before all its states are freed");
+    statePool_.reset();
+}
+
 void ompl::base::SpaceInformation::setValidStateSamplerAllocator(const ValidStateSamplerAllocator &vssa)
 {
     vssa_ = vssa;
@@ -0,0 +1,288 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "ompl/base/StatePool.h"
+#include "ompl/base/spaces/SE2StateSpace.h"
+#include "ompl/base/spaces/SE3StateSpace.h"
+#include "ompl/util/Exception.h"
+#include <typeinfo>
+#include <utility>
+
+/// @cond IGNORE
+namespace
+{
+    /// The number of states moved at once between the cache of a thread and the shared free list
+    const std::size_t CACHE_BATCH = 32;
+
+    std::atomic<std::uint64_t> g_statePoolCount{0};
+
+    /// The cache of free states the calling thread used last, and the pool it belongs to
+    struct PoolCache
+    {
+        std::uint64_t instance{0};
+        std::vector<ompl::base::State *> *states{nullptr};
+    };
+
+    thread_local PoolCache t_poolCache;
+
+    static_assert(sizeof(ompl::base::SE2StateSpace::StateType) == sizeof(ompl::base::CompoundState) &&
+                      sizeof(ompl::base::SE3StateSpace::StateType) == sizeof(ompl::base::CompoundState),
+                  "SE(2) and SE(3) states are expected to have the layout of compound states");
+
+    std::size_t aligned(std::size_t size)
+    {
+        const std::size_t align = alignof(std::max_align_t);
+        return (size + align - 1) / align * align;
+    }
+
+    bool isInlineCompound(const std::type_info &type)
+    {
+        return type == typeid(ompl::base::CompoundStateSpace) || type == typeid(ompl::base::SE2StateSpace) ||
+               type == typeid(ompl::base::SE3StateSpace);
+    }
+
+    // The number of bytes an inline state of space takes, or 0 if the layout of its states is not known.
+    // Only the exact types are accepted, since derived spaces may allocate different state types.
+    std::size_t inlineStateSize(const ompl::base::StateSpace *space)
+    {
+        using namespace ompl::base;
+        const std::type_info &type = typeid(*space);
+        if (type == typeid(RealVectorStateSpace))
+            return aligned(sizeof(RealVectorStateSpace::StateType)) + aligned(sizeof(double) * space->getDimension());
+        if (type == typeid(SO2StateSpace))
+            return aligned(sizeof(SO2StateSpace::StateType));
+        if (type == typeid(SO3StateSpace))
+            return aligned(sizeof(SO3StateSpace::StateType));
+        if (isInlineCompound(type))
+        {
+            const auto *cspace = space->as<CompoundStateSpace>();
+            std::size_t size =
+                aligned(sizeof(CompoundState)) + aligned(sizeof(State *) * cspace->getSubspaceCount());
+            for (unsigned int i = 0; i < cspace->getSubspaceCount(); ++i)
+            {
+                std::size_t s = inlineStateSize(cspace->getSubspace(i).get());
+                if (s == 0)
+                    return 0;
+                size += s;
+            }
+            return size;
+        }
+        return 0;
+    }
+
+    // Construct a state of space at memory (which must have room for inlineStateSize(space) bytes) and advance
+    // memory past it
+    ompl::base::State *constructInlineState(const ompl::base::StateSpace *space, char *&memory)
+    {
+        using namespace ompl::base;
+        const std::type_info &type = typeid(*space);
+        if (type == typeid(RealVectorStateSpace))
+        {
+            auto *state = new (memory) RealVectorStateSpace::StateType();
+            memory += aligned(sizeof(RealVectorStateSpace::StateType));
+            state->values = reinterpret_cast<double *>(memory);
+            memory += aligned(sizeof(double) * space->getDimension());
+            return state;
+        }
+        if (type == typeid(SO2StateSpace))
+        {
+            auto *state = new (memory) SO2StateSpace::StateType();
+            memory += aligned(sizeof(SO2StateSpace::StateType));
+            return state;
+        }
+        if (type == typeid(SO3StateSpace))
+        {
+            auto *state = new (memory) SO3StateSpace::StateType();
+            memory += aligned(sizeof(SO3StateSpace::StateType));
+            return state;
+        }
+
+        CompoundState *state;
+        if (type == typeid(SE2StateSpace))
+            state = new (memory) SE2StateSpace::StateType();
+        else if (type == typeid(SE3StateSpace))
+            state = new (memory) SE3StateSpace::StateType();
+        else
+            state = new (memory) CompoundStateSpace::StateType();
+        memory += aligned(sizeof(CompoundState));
+
+        const auto *cspace = space->as<CompoundStateSpace>();
+        state->components = reinterpret_cast<State **>(memory);
+        memory += aligned(sizeof(State *) * cspace->getSubspaceCount());
+        for (unsigned int i = 0; i < cspace->getSubspaceCount(); ++i)
+            state->components[i] = constructInlineState(cspace->getSubspace(i).get(), memory);
+        return state;
+    }
+}
+/// @endcond
+
+ompl::base::StatePool::StatePool(StateSpacePtr space, std::size_t slabSize)
+  : space_(std::move(space)), slabSize_(slabSize), instance_(++g_statePoolCount)
+{
+    if (!space_)
+        throw Exception("No state space specified for state pool");
+    if (slabSize_ == 0)
+        throw Exception("The slab size of a state pool must be positive");
+    stateSize_ = inlineStateSize(space_.get());
+}
+
+ompl::base::StatePool::~StatePool()
+{
+    // inline states have no resources of their own; only states allocated by the state space need freeing
+    for (auto &state : allocated_)
+        space_->freeState(state);
+}
+
+ompl::base::State *ompl::base::StatePool::newState()
+{
+    if (stateSize_ == 0)
+    {
+        allocated_.push_back(space_->allocState());
+        return allocated_.back();
+    }
+
+    if (slabs_.empty() || used_ == slabSize_)
+    {
+        if (!slabs_.empty())
+            ++currentSlab_;
+        if (currentSlab_ == slabs_.size())
+            slabs_.emplace_back(new char[stateSize_ * slabSize_]);
+        used_ = 0;
+    }
+    char *memory = slabs_[currentSlab_].get() + stateSize_ * used_++;
+    return constructInlineState(space_.get(), memory);
+}
+
+std::vector<ompl::base::State *> &ompl::base::StatePool::localCache()
+{
+    if (t_poolCache.instance == instance_)
+        return *t_poolCache.states;
+
+    std::lock_guard<std::mutex> slock(lock_);
+    const std::thread::id self = std::this_thread::get_id();
+    ThreadCache *cache = nullptr;
+    for (auto &thread : threads_)
+        if (thread->owner == self)
+        {
+            cache = thread.get();
+            break;
+        }
+    if (cache == nullptr)
+    {
+        threads_.emplace_back(new ThreadCache{self, {}});
+        cache = threads_.back().get();
+        cache->free.reserve(2 * CACHE_BATCH);
+    }
+    t_poolCache.instance = instance_;
+    t_poolCache.states = &cache->free;
+    return cache->free;
+}
+
+ompl::base::State *ompl::base::StatePool::allocState()
+{
+    std::vector<State *> &cache = localCache();
+    if (cache.empty())
+    {
+        // take a batch of states from the shared free list, or carve new ones
+        std::lock_guard<std::mutex> slock(lock_);
+        while (cache.size() < CACHE_BATCH && !freeList_.empty())
+        {
+            cache.push_back(freeList_.back());
+            freeList_.pop_back();
+        }
+        while (cache.size() < CACHE_BATCH)
+            cache.push_back(newState());
+    }
+    ++count_;
+    State *state = cache.back();
+    cache.pop_back();
+    return state;
+}
+
+void ompl::base::StatePool::freeState(State *state)
+{
+    if (resetOnClear_ || state == nullptr)
+        return;
+    --count_;
+    std::vector<State *> &cache = localCache();
+    cache.push_back(state);
+    if (cache.size() >= 2 * CACHE_BATCH)
+    {
+        // return the oldest states to the shared free list, so that other threads can use them
+        std::lock_guard<std::mutex> slock(lock_);
+        freeList_.insert(freeList_.end(), cache.begin(), cache.begin() + CACHE_BATCH);
+        cache.erase(cache.begin(), cache.begin() + CACHE_BATCH);
+    }
+}
+
+void ompl::base::StatePool::clear()
+{
+    std::lock_guard<std::mutex> slock(lock_);
+    count_ = 0;
+    currentSlab_ = 0;
+    used_ = 0;
+    for (auto &thread : threads_)
+        thread->free.clear();
+    // states allocated by the state space are kept for reuse
+    freeList_ = allocated_;
+}
+
+void ompl::base::StatePool::addUser()
+{
+    std::lock_guard<std::mutex> slock(lock_);
+    ++users_;
+}
+
+void ompl::base::StatePool::removeUser(bool reset)
+{
+    {
+        std::lock_guard<std::mutex> slock(lock_);
+        if (users_ == 0)
+            throw Exception("State pool has no registered user");
+        if (--users_ > 0 || !reset || !resetOnClear_)
+            return;
+    }
+    clear();
+}
+
+unsigned int ompl::base::StatePool::getUserCount() const
+{
+    std::lock_guard<std::mutex> slock(lock_);
+    return users_;
+}
+
+std::size_t ompl::base::StatePool::size() const
+{
+    return count_;
+}
@@ -38,6 +38,7 @@
 #include "ompl/base/spaces/RealVectorStateSpace.h"
 #include "ompl/util/String.h"
 #include <mutex>
+#include <algorithm>
 #include <boost/scoped_ptr.hpp>
 #include <numeric>
 #include <limits>
@@ -45,6 +46,7 @@
 #include <cmath>
 #include <list>
 #include <set>
+#include <typeinfo>
 
 const std::string ompl::base::StateSpace::DEFAULT_PROJECTION_NAME = "";
 
@@ -223,6 +225,13 @@ void ompl::base::StateSpace::computeSignature(std::vector<int> &signature) const
     signature.insert(signature.begin(), signature.size());
 }
 
+void ompl::base::StateSpace::distanceBatch(const State *state, const State *const *states, std::size_t n,
+                                           double *distances) const
+{
+    for (std::size_t i = 0; i < n; ++i)
+        distances[i] = distance(state, states[i]);
+}
+
 ompl::base::State *ompl::base::StateSpace::cloneState(const State *source) const
 {
     State *copy = allocState();
@@ -1075,6 +1084,40 @@ double ompl::base::CompoundStateSpace::distance(const State *state1, const State
     return dist;
 }
 
+void ompl::base::CompoundStateSpace::distanceBatch(const State *state, const State *const *states, std::size_t n,
+                                                   double *distances) const
+{
+    if (typeid(*this) == typeid(CompoundStateSpace))
+        distanceBatchByComponent(state, states, n, distances);
+    else
+        StateSpace::distanceBatch(state, states, n, distances);
+}
+
+void ompl::base::CompoundStateSpace::distanceBatchByComponent(const State *state, const State *const *states,
+                                                              std::size_t n, double *distances) const
+{
+    // the states are processed in chunks, so the component states fit in buffers on the stack
+    const std::size_t CHUNK = 64;
+    const State *componentStates[CHUNK];
+    double componentDistances[CHUNK];
+    const auto *cstate = static_cast<const CompoundState *>(state);
+    std::fill(distances, distances + n, 0.0);
+
+    for (std::size_t begin = 0; begin < n; begin += CHUNK)
+    {
+        const std::size_t count = std::min(CHUNK, n - begin);
+        // one batch per component, so each component space is dispatched to once
+        for (unsigned int i = 0; i < componentCount_; ++i)
+        {
+            for (std::size_t j = 0; j < count; ++j)
+                componentStates[j] = static_cast<const CompoundState *>(states[begin + j])->components[i];
+            components_[i]->distanceBatch(cstate->components[i], componentStates, count, componentDistances);
+            for (std::size_t j = 0; j < count; ++j)
+                distances[begin + j] += weights_[i] * componentDistances[j];
+        }
+    }
+}
+
 void ompl::base::CompoundStateSpace::setLongestValidSegmentFraction(double segmentFraction)
 {
     StateSpace::setLongestValidSegmentFraction(segmentFraction);
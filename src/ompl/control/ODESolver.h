@@ -51,7 +51,10 @@
 #include <boost/numeric/odeint/integrate/integrate_adaptive.hpp>
 namespace odeint = boost::numeric::odeint;
 #include <functional>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -149,6 +152,25 @@ namespace ompl
                             postEvent_(state, control, duration, result);
                     }
 
+                    void propagateBatch(const base::State *const *states, const Control *const *controls,
+                                        const double *durations, std::size_t n, base::State **results) const override
+                    {
+                        // kept between calls so that the values of the states are not reallocated at every step;
+                        // one per thread, as the propagator may be shared by several threads
+                        static thread_local std::vector<ODESolver::StateType> reals;
+                        if (reals.size() < n)
+                            reals.resize(n);
+                        for (std::size_t i = 0; i < n; ++i)
+                            si_->getStateSpace()->copyToReals(reals[i], states[i]);
+                        solver_->solveBatch(reals.data(), n, controls, durations);
+                        for (std::size_t i = 0; i < n; ++i)
+                        {
+                            si_->getStateSpace()->copyFromReals(results[i], reals[i]);
+                            if (postEvent_)
+                                postEvent_(states[i], controls[i], durations[i], results[i]);
+                        }
+                    }
+
                 protected:
                     ODESolverPtr solver_;
                     ODESolver::PostPropagationEvent postEvent_;
@@ -160,6 +182,15 @@ namespace ompl
             /// \brief Solve the ODE given the initial state, and a control to apply for some duration.
             virtual void solve(StateType &state, const Control *control, double duration) const = 0;
 
+            /// \brief Solve the ODE for \e n initial states at once: \e states[i] is integrated with control
+            /// \e controls[i] for \e durations[i]. By default, solve() is called for each state.
+            virtual void solveBatch(StateType *states, std::size_t n, const Control *const *controls,
+                                    const double *durations) const
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                    solve(states[i], controls[i], durations[i]);
+            }
+
             /// \brief The SpaceInformation that this ODESolver operates in.
             const SpaceInformationPtr si_;
 
@@ -322,6 +353,127 @@ namespace ompl
             /// \brief The maximum error allowed during one step of numerical integration
             double maxEpsilonError_;
         };
+
+        /// \brief Fixed step size solver that integrates many ordinary differential equations of the type
+        /// q' = f(q, u) together, using the classical fourth order Runge-Kutta method. Instead of an ODE that
+        /// computes the derivative of one state, this solver takes a BatchODE that computes the derivatives of
+        /// \e n states at once. The states are stored as a structure of arrays: value \e j of state \e i is
+        /// at index j * n + i, so a BatchODE written as plain loops over \e i (and the Runge-Kutta updates of
+        /// this class) can be vectorized by the compiler. Propagating many controls from the same state, as
+        /// control::SpaceInformation::propagateBatch() does, then costs about as much as propagating a few.
+        ///
+        /// Each state is integrated for floor(|duration| / intStep) steps of size intStep, backward in time if
+        /// the duration is negative.
+        class ODEBatchSolver : public ODESolver
+        {
+        public:
+            /// \brief Callback function that defines the ODE for a batch of \e n states. It receives the
+            /// current values \e q, the controls applied to each state, and must fill in the derivatives
+            /// \e qdot. Both \e q and \e qdot hold n * dimension values in structure of arrays layout.
+            using BatchODE = std::function<void(const double *q, const Control *const *controls, std::size_t n,
+                                                double *qdot)>;
+
+            /// \brief Parameterized constructor.  Takes a reference to the SpaceInformation,
+            /// an ODE to solve, and an optional integration step size - default is 0.01
+            ODEBatchSolver(const SpaceInformationPtr &si, const BatchODE &ode, double intStep = 1e-2)
+              : ODESolver(si, singleODE(ode), intStep), batchODE_(ode)
+            {
+            }
+
+            /// \brief Set the batch ODE to solve
+            void setBatchODE(const BatchODE &ode)
+            {
+                batchODE_ = ode;
+                setODE(singleODE(ode));
+            }
+
+        protected:
+            /// \brief Solve the ODE for a single state
+            void solve(StateType &state, const Control *control, double duration) const override
+            {
+                solveBatch(&state, 1, &control, &duration);
+            }
+
+            /// \brief Solve the ODE for all the states together
+            void solveBatch(StateType *states, std::size_t n, const Control *const *controls,
+                            const double *durations) const override
+            {
+                if (n == 0)
+                    return;
+                const std::size_t size = n * states[0].size();
+
+                // the buffers only grow, so that a batch of the usual size allocates nothing; there is one set per
+                // thread, as the solver may be shared by several threads
+                static thread_local Workspace workspace;
+                std::vector<double> &q = workspace.q, &tmp = workspace.tmp, &k1 = workspace.k1, &k2 = workspace.k2,
+                                    &k3 = workspace.k3, &k4 = workspace.k4, &h = workspace.h;
+                std::vector<unsigned int> &remaining = workspace.remaining;
+                for (std::vector<double> *v : {&q, &tmp, &k1, &k2, &k3, &k4})
+                    v->resize(size);
+                h.resize(n);
+                remaining.resize(n);
+                unsigned int maxSteps = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    for (std::size_t j = 0; j < states[i].size(); ++j)
+                        q[j * n + i] = states[i][j];
+                    remaining[i] = (unsigned int)(std::fabs(durations[i]) / intStep_ +
+                                                  std::numeric_limits<float>::epsilon());
+                    maxSteps = std::max(maxSteps, remaining[i]);
+                }
+
+                for (unsigned int st = 0; st < maxSteps; ++st)
+                {
+                    // states that performed all their steps are still evaluated, but not moved
+                    for (std::size_t i = 0; i < n; ++i)
+                        h[i] = st < remaining[i] ? (durations[i] < 0.0 ? -intStep_ : intStep_) : 0.0;
+
+                    batchODE_(q.data(), controls, n, k1.data());
+                    advance(tmp.data(), q.data(), 0.5, h.data(), k1.data(), n, size);
+                    batchODE_(tmp.data(), controls, n, k2.data());
+                    advance(tmp.data(), q.data(), 0.5, h.data(), k2.data(), n, size);
+                    batchODE_(tmp.data(), controls, n, k3.data());
+                    advance(tmp.data(), q.data(), 1.0, h.data(), k3.data(), n, size);
+                    batchODE_(tmp.data(), controls, n, k4.data());
+                    for (std::size_t j = 0; j < size; ++j)
+                        k1[j] += 2.0 * (k2[j] + k3[j]) + k4[j];
+                    advance(q.data(), q.data(), 1.0 / 6.0, h.data(), k1.data(), n, size);
+                }
+
+                for (std::size_t i = 0; i < n; ++i)
+                    for (std::size_t j = 0; j < states[i].size(); ++j)
+                        states[i][j] = q[j * n + i];
+            }
+
+            /// \brief The ODE for batches of states
+            BatchODE batchODE_;
+
+        private:
+            /// \brief The buffers used by solveBatch()
+            struct Workspace
+            {
+                std::vector<double> q, tmp, k1, k2, k3, k4, h;
+                std::vector<unsigned int> remaining;
+            };
+
+            /// \brief Compute out = q + a * h * k, where h holds the step size of each of the \e n states
+            static void advance(double *out, const double *q, double a, const double *h, const double *k,
+                             std::size_t n, std::size_t size)
+            {
+                for (std::size_t j = 0; j < size; j += n)
+                    for (std::size_t i = 0; i < n; ++i)
+                        out[j + i] = q[j + i] + a * h[i] * k[j + i];
+            }
+
+            static ODE singleODE(const BatchODE &ode)
+            {
+                return [ode](const StateType &q, const Control *control, StateType &qdot)
+                {
+                    qdot.resize(q.size());
+                    ode(q.data(), &control, 1, qdot.data());
+                };
+            }
+        };
     }
 }
 
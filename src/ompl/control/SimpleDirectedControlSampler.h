@@ -41,6 +41,7 @@
 #include "ompl/control/ControlSampler.h"
 #include "ompl/util/ClassForward.h"
 #include <functional>
+#include <vector>
 
 namespace ompl
 {
@@ -114,11 +115,29 @@ namespace ompl
             virtual unsigned int getBestControl(Control *control, const base::State *source, base::State *dest,
                                                 const Control *previous);
 
+            /** \brief Free the memory used by the sampled controls and states */
+            void freeSamples();
+
             /** \brief An instance of the control sampler*/
             ControlSamplerPtr cs_;
 
             /** \brief The number of controls to sample when finding the best control*/
             unsigned int numControlSamples_;
+
+            /** \brief The controls sampled by getBestControl() */
+            std::vector<Control *> controls_;
+
+            /** \brief The states reached with each sampled control */
+            std::vector<base::State *> states_;
+
+            /** \brief The number of steps each sampled control is applied for */
+            std::vector<int> steps_;
+
+            /** \brief The number of valid steps performed with each sampled control */
+            std::vector<unsigned int> validSteps_;
+
+            /** \brief The distance from each reached state to the target */
+            std::vector<double> distances_;
 //##########################################
 	    double distanceFactor_{0.25};
 	    double toleratedDistance_;
@@ -291,6 +291,47 @@ namespace ompl
             unsigned int propagateWhileValid(const base::State *state, const Control *control, int steps,
                                              std::vector<base::State *> &result, bool alloc) const;
 
+            /** \brief Propagate the model of the system from the same state with \e n controls. Control \e
+               controls[i] is applied for \e steps[i] steps (backward if \e steps[i] is negative) and the final
+               state is stored in \e results[i]. The result is the same as calling propagate() for each control,
+               but all controls advance together, one call to StatePropagator::propagateBatch() per time step.
+                \param state the state to start at
+                \param controls the controls to apply
+                \param steps the number of time steps to apply each control for
+                \param n the number of controls
+                \param results the states at the end of the propagation */
+            void propagateBatch(const base::State *state, const Control *const *controls, const int *steps,
+                                std::size_t n, base::State **results) const;
+
+            /** \brief Propagate the model of the system from the same state with \e n controls, stopping the
+               propagation of each control at the first invalid state. For each control, this computes the same
+               result as propagateWhileValid(): \e results[i] is the last valid state (or \e state if the first
+               step is invalid) and \e validSteps[i] is the number of steps performed without collision. All controls
+               advance together, with one call to StatePropagator::propagateBatch() and one batched validity check per
+               time step.
+                \param state the state to start at
+                \param controls the controls to apply
+                \param steps the maximum number of time steps to apply each control for
+                \param n the number of controls
+                \param results the states at the end of the propagation
+                \param validSteps the number of valid steps performed with each control */
+            void propagateWhileValidBatch(const base::State *state, const Control *const *controls, const int *steps,
+                                          std::size_t n, base::State **results, unsigned int *validSteps) const;
+
+            /** \brief Same as propagateWhileValidBatch(), but keep the states along each propagated motion, as
+               propagateWhileValid() does: the valid states reached with \e controls[i] are stored in
+               \e trajectories[i][0] to \e trajectories[i][validSteps[i] - 1]. Each \e trajectories[i] must hold at
+               least abs(\e steps[i]) allocated states.
+                \param state the state to start at
+                \param controls the controls to apply
+                \param steps the maximum number of time steps to apply each control for
+                \param n the number of controls
+                \param trajectories the states along each propagated motion
+                \param validSteps the number of valid steps performed with each control */
+            void propagateWhileValidBatch(const base::State *state, const Control *const *controls, const int *steps,
+                                          std::size_t n, std::vector<base::State *> *trajectories,
+                                          unsigned int *validSteps) const;
+
             /** @} */
 
             /** \brief Print information about the current instance of the state space */
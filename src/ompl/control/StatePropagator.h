@@ -40,6 +40,7 @@
 #include "ompl/base/State.h"
 #include "ompl/control/Control.h"
 #include "ompl/util/ClassForward.h"
+#include <cstddef>
 
 namespace ompl
 {
@@ -92,6 +93,18 @@ namespace ompl
             virtual void propagate(const base::State *state, const Control *control, double duration,
                                    base::State *result) const = 0;
 
+            /** \brief Propagate \e n states at once: \e states[i] is propagated with control \e controls[i] for
+                \e durations[i], and the result is stored in \e results[i]. By default, this calls propagate() for
+                each state. Propagators that can share work between the states (e.g., by integrating them together)
+                should override this function. As for propagate(), \e results[i] may be the same as \e states[i],
+                and the same start state may appear several times in \e states. */
+            virtual void propagateBatch(const base::State *const *states, const Control *const *controls,
+                                        const double *durations, std::size_t n, base::State **results) const
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                    propagate(states[i], controls[i], durations[i], results[i]);
+            }
+
             /** \brief Some systems can only propagate forward in time (i.e., the \e duration argument for the
                propagate()
                 function is always positive). If this is the case, this function should return false. Planners that need
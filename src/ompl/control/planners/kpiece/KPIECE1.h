@@ -39,7 +39,8 @@
 
 #include "ompl/control/planners/PlannerIncludes.h"
 #include "ompl/base/ProjectionEvaluator.h"
-#include "ompl/datastructures/GridB.h"
+#include "ompl/datastructures/GridBFlat.h"
+#include <algorithm>
 #include <vector>
 #include <set>
 
@@ -172,6 +173,20 @@ namespace ompl
                 return nCloseSamples_;
             }
 
+            /** \brief Set the number of controls sampled when extending a motion. The controls are propagated
+                together (see SpaceInformation::propagateWhileValidBatch()) and the one that takes the system
+                farthest from the extended state is used. The default value is 1. */
+            void setNumControlSamples(unsigned int numControlSamples)
+            {
+                numControlSamples_ = std::max(numControlSamples, 1u);
+            }
+
+            /** \brief Get the number of controls sampled when extending a motion */
+            unsigned int getNumControlSamples() const
+            {
+                return numControlSamples_;
+            }
+
             /** \brief Set the projection evaluator. This class is
                 able to compute the projection of a given state. */
             void setProjectionEvaluator(const base::ProjectionEvaluatorPtr &projectionEvaluator)
@@ -264,7 +279,7 @@ namespace ompl
             };
 
             /** \brief The datatype for the maintained grid datastructure */
-            using Grid = GridB<CellData *, OrderCellsByImportance>;
+            using Grid = GridBFlat<CellData *, OrderCellsByImportance>;
 
             /** \brief Information about a known good sample (closer to the goal than others) */
             struct CloseSample
@@ -413,6 +428,9 @@ namespace ompl
                 to keep in that queue. */
             unsigned int nCloseSamples_{30};
 
+            /** \brief The number of controls sampled when extending a motion */
+            unsigned int numControlSamples_{1u};
+
             /** \brief The fraction of time to focus exploration on
                 the border of the grid. */
             double selectBorderFraction_{0.8};
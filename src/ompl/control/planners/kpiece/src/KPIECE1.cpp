@@ -57,6 +57,8 @@ ompl::control::KPIECE1::KPIECE1(const SpaceInformationPtr &si) : base::Planner(s
                                   &KPIECE1::getBadCellScoreFactor);
     Planner::declareParam<double>("good_score_factor", this, &KPIECE1::setGoodCellScoreFactor,
                                   &KPIECE1::getGoodCellScoreFactor);
+    Planner::declareParam<unsigned int>("num_control_samples", this, &KPIECE1::setNumControlSamples,
+                                        &KPIECE1::getNumControlSamples, "1:1:100");
 }
 
 ompl::control::KPIECE1::~KPIECE1()
@@ -211,6 +213,22 @@ ompl::base::PlannerStatus ompl::control::KPIECE1::solve(const base::PlannerTermi
     for (auto &state : states)
         state = si_->allocState();
 
+    // controls sampled for each extension, when more than one is requested
+    const unsigned int k = numControlSamples_;
+    std::vector<Control *> sampledControls(k > 1 ? k : 0);
+    std::vector<std::vector<base::State *>> sampledMotions(sampledControls.size(),
+                                                           std::vector<base::State *>(states.size()));
+    std::vector<const base::State *> sampledStates(sampledControls.size());
+    std::vector<int> sampledSteps(sampledControls.size());
+    std::vector<unsigned int> validSteps(sampledControls.size());
+    std::vector<double> distances(sampledControls.size());
+    for (std::size_t i = 0; i < sampledControls.size(); ++i)
+    {
+        sampledControls[i] = siC_->allocControl();
+        for (auto &state : sampledMotions[i])
+            state = si_->allocState();
+    }
+
     // samples that were found to be the best, so far
     CloseSamples closeSamples(nCloseSamples_);
 
@@ -232,12 +250,41 @@ ompl::base::PlannerStatus ompl::control::KPIECE1::solve(const base::PlannerTermi
         assert(existing);
 
         /* sample a random control */
-        controlSampler_->sampleNext(rctrl, existing->control, existing->state);
+        unsigned int cd = 0;
+        if (k > 1)
+        {
+            /* sample several controls, propagate them together, and keep the motion that goes the farthest */
+            for (unsigned int i = 0; i < k; ++i)
+            {
+                controlSampler_->sampleNext(sampledControls[i], existing->control, existing->state);
+                sampledSteps[i] =
+                    controlSampler_->sampleStepCount(siC_->getMinControlDuration(), siC_->getMaxControlDuration());
+            }
+            siC_->propagateWhileValidBatch(existing->state, sampledControls.data(), sampledSteps.data(), k,
+                                           sampledMotions.data(), validSteps.data());
+            for (unsigned int i = 0; i < k; ++i)
+                sampledStates[i] = validSteps[i] > 0 ? sampledMotions[i][validSteps[i] - 1] : existing->state;
+            si_->distanceBatch(existing->state, sampledStates.data(), k, distances.data());
+
+            unsigned int best = 0;
+            for (unsigned int i = 1; i < k; ++i)
+                if (validSteps[i] >= siC_->getMinControlDuration() &&
+                    (validSteps[best] < siC_->getMinControlDuration() || distances[i] > distances[best]))
+                    best = i;
+            siC_->copyControl(rctrl, sampledControls[best]);
+            cd = validSteps[best];
+
+            /* the states along the chosen motion are already computed */
+            states.swap(sampledMotions[best]);
+        }
+        else
+        {
+            controlSampler_->sampleNext(rctrl, existing->control, existing->state);
+            cd = controlSampler_->sampleStepCount(siC_->getMinControlDuration(), siC_->getMaxControlDuration());
 
-        /* propagate */
-        unsigned int cd =
-            controlSampler_->sampleStepCount(siC_->getMinControlDuration(), siC_->getMaxControlDuration());
-        cd = siC_->propagateWhileValid(existing->state, rctrl, cd, states, false);
+            /* propagate */
+            cd = siC_->propagateWhileValid(existing->state, rctrl, cd, states, false);
+        }
 
         /* if we have enough steps */
         if (cd >= siC_->getMinControlDuration())
@@ -342,6 +389,12 @@ ompl::base::PlannerStatus ompl::control::KPIECE1::solve(const base::PlannerTermi
     siC_->freeControl(rctrl);
     for (auto &state : states)
         si_->freeState(state);
+    for (std::size_t i = 0; i < sampledControls.size(); ++i)
+    {
+        siC_->freeControl(sampledControls[i]);
+        for (auto &state : sampledMotions[i])
+            si_->freeState(state);
+    }
 
     OMPL_INFORM("%s: Created %u states in %u cells (%u internal + %u external)", getName().c_str(), tree_.size,
                 tree_.grid.size(), tree_.grid.countInternal(), tree_.grid.countExternal());
@@ -43,6 +43,8 @@
 #include "ompl/datastructures/PDF.h"
 #include <unordered_map>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace ompl
@@ -91,6 +93,18 @@ namespace ompl
             std::vector<ProductGraph::State *> getHighLevelPath(const std::vector<base::State *> &path,
                                                                 ProductGraph::State *start = nullptr) const;
 
+            /** \brief Set the number of threads that expand the tree of motions along a lead at the same time.
+                Each thread repeatedly selects a high-level state from the lead and extends the tree from one of
+                its motions. The state propagator and the state validity checker must be thread safe if this is
+                more than 1. Default is 1. */
+            void setThreadCount(unsigned int nthreads);
+
+            /** \brief Get the number of threads that expand the tree of motions along a lead at the same time. */
+            unsigned int getThreadCount() const
+            {
+                return threadCount_;
+            }
+
         protected:
             /** \brief Representation of a motion
 
@@ -146,6 +160,8 @@ namespace ompl
                 double autWeight{0.};
                 unsigned int numSel{0};
                 PDF<ProductGraph::State *>::Element *pdfElem{nullptr};
+                /** \brief Guards motions and motionElems while the tree is expanded by several threads */
+                std::mutex lock;
             };
 
             /** \brief Updates and returns the weight of an abstraction state. */
@@ -200,6 +216,25 @@ namespace ompl
             /** \brief Map of abstraction states to their details. */
             std::unordered_map<ProductGraph::State *, ProductGraphStateInfo> abstractInfo_;
 
+            /** \brief The number of threads that expand the tree along a lead */
+            unsigned int threadCount_{1};
+
+            /** \brief Control samplers and random number generators of the threads other than the one that
+                called solve(), which uses controlSampler_ and rng_ */
+            std::vector<ControlSamplerPtr> workerControlSamplers_;
+            std::vector<RNG> workerRNGs_;
+
+            /** \brief Guards availDist_, motions_, the weights in abstractInfo_ and the lead computation state of
+                abstraction_ while the tree is expanded by several threads */
+            std::mutex estimatesLock_;
+
+            /** \brief The threads that expand the tree along the leads */
+            class WorkerPool;
+
+            /** \brief The threads used by explore(), started at the beginning of solve() and stopped at its end.
+                Empty when the tree is expanded by the calling thread only. */
+            std::shared_ptr<WorkerPool> workerPool_;
+
         private:
             /** \brief Clears this planner's underlying tree of system states. */
             void clearMotions();
@@ -40,10 +40,13 @@
 #include "ompl/base/State.h"
 #include "ompl/control/planners/ltl/Automaton.h"
 #include "ompl/control/planners/ltl/PropositionalDecomposition.h"
+#include "ompl/datastructures/IncrementalShortestPath.h"
 #include "ompl/util/ClassForward.h"
 #include <boost/graph/adjacency_list.hpp>
 #include <unordered_map>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <vector>
 
@@ -155,6 +158,17 @@ namespace ompl
                 the given edge-weight function. */
             std::vector<State *> computeLead(State *start, const std::function<double(State *, State *)> &edgeWeight);
 
+            /** \brief Same as computeLead(), but the shortest paths of the previous call are repaired instead of
+                recomputed. The first call (and the first call after the graph is rebuilt or \e start changes)
+                computes the weights of all edges; later calls only recompute the weights of the edges incident
+                to the States passed to invalidateEdgeWeights() since the previous call. */
+            std::vector<State *> computeLeadIncremental(State *start,
+                                                        const std::function<double(State *, State *)> &edgeWeight);
+
+            /** \brief Signal that the weights of the edges entering or leaving \e s may have changed, so that
+                the next call to computeLeadIncremental() recomputes them. */
+            void invalidateEdgeWeights(State *s);
+
             /** \brief Clears all memory belonging to this ProductGraph. */
             void clear();
 
@@ -217,6 +231,7 @@ namespace ompl
                 s.decompRegion = region;
                 s.cosafeState = cosafe;
                 s.safeState = safe;
+                std::lock_guard<std::mutex> lock(stateLock_);
                 State *&ret = stateToPtr_[s];
                 if (ret == nullptr)
                     ret = new State(s);
@@ -226,10 +241,12 @@ namespace ompl
         protected:
             struct Edge
             {
-                double cost;
+                double cost{0.0};
+                /* Index of this edge in leadSearch_ */
+                std::size_t index{0};
             };
 
-            using GraphType = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, State *, Edge>;
+            using GraphType = boost::adjacency_list<boost::vecS, boost::vecS, boost::bidirectionalS, State *, Edge>;
             using Vertex = boost::graph_traits<GraphType>::vertex_descriptor;
             using VertexIter = boost::graph_traits<GraphType>::vertex_iterator;
             using VertexIndexMap = boost::property_map<GraphType, boost::vertex_index_t>::type;
@@ -249,9 +266,24 @@ namespace ompl
                We use this map to access it. */
             mutable std::unordered_map<State, State *, HashState> stateToPtr_;
 
+            /* Guards stateToPtr_ (and the automata, which cache their
+               transitions), since states are looked up by state propagators
+               that may run in several threads. */
+            mutable std::mutex stateLock_;
+
             /* Map from State pointer to the index of the corresponding vertex
                in the graph. */
             std::unordered_map<State *, int> stateToIndex_;
+
+            /* Shortest paths maintained by computeLeadIncremental(), from
+               leadStart_ to the solution states. */
+            std::unique_ptr<IncrementalShortestPath> leadSearch_;
+            State *leadStart_{nullptr};
+
+            /* Indices of the vertices passed to invalidateEdgeWeights() since the
+               last call to computeLeadIncremental(), and a flag for each vertex. */
+            std::vector<int> invalidated_;
+            std::vector<bool> isInvalidated_;
         };
     }
 }
@@ -41,6 +41,10 @@
 #include "ompl/datastructures/PDF.h"
 #include "ompl/util/Console.h"
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <thread>
 #include <unordered_map>
 #include <limits>
 #include <map>
@@ -49,6 +53,86 @@
 
 #include <cstdio>
 
+class ompl::control::LTLPlanner::WorkerPool
+{
+public:
+    /* Start numThreads - 1 workers, the thread calling run() being the first one */
+    explicit WorkerPool(unsigned int numThreads)
+    {
+        for (unsigned int t = 1; t < numThreads; ++t)
+            workers_.emplace_back([this, t] { work(t); });
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wakeUp_.notify_all();
+        for (auto &worker : workers_)
+            worker.join();
+    }
+
+    /* The number of threads running a task, including the calling thread */
+    unsigned int size() const
+    {
+        return workers_.size() + 1;
+    }
+
+    /* Run task(t) on worker t, for t from 1 to size() - 1, and on the calling thread as t = 0, and
+       return once they have all returned from it */
+    void run(const std::function<void(unsigned int)> &task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            numActive_ = workers_.size();
+            ++batch_;
+        }
+        wakeUp_.notify_all();
+
+        task(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return numActive_ == 0; });
+        task_ = nullptr;
+    }
+
+private:
+    void work(unsigned int t)
+    {
+        // the last batch this worker took part in
+        unsigned long seen = 0;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            wakeUp_.wait(lock, [this, &seen] { return stop_ || batch_ != seen; });
+            if (stop_)
+                return;
+            seen = batch_;
+
+            const std::function<void(unsigned int)> *task = task_;
+            lock.unlock();
+            (*task)(t);
+            lock.lock();
+
+            if (--numActive_ == 0)
+                done_.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::condition_variable done_;
+    const std::function<void(unsigned int)> *task_{nullptr};
+    std::size_t numActive_{0};
+    unsigned long batch_{0};
+    bool stop_{false};
+};
+
 ompl::control::LTLPlanner::LTLPlanner(const LTLSpaceInformationPtr &ltlsi, ProductGraphPtr a, double exploreTime)
   : ompl::base::Planner(ltlsi, "LTLPlanner")
   , ltlsi_(ltlsi.get())
@@ -56,6 +140,14 @@ ompl::control::LTLPlanner::LTLPlanner(const LTLSpaceInformationPtr &ltlsi, Produ
   , exploreTime_(exploreTime)
 {
     specs_.approximateSolutions = true;
+    Planner::declareParam<unsigned int>("thread_count", this, &LTLPlanner::setThreadCount,
+                                        &LTLPlanner::getThreadCount, "1:64");
+}
+
+void ompl::control::LTLPlanner::setThreadCount(unsigned int nthreads)
+{
+    assert(nthreads > 0);
+    threadCount_ = nthreads;
 }
 
 ompl::control::LTLPlanner::~LTLPlanner()
@@ -109,16 +201,20 @@ ompl::base::PlannerStatus ompl::control::LTLPlanner::solve(const ompl::base::Pla
     bool solved = false;
     Motion *soln;
 
+    // the same threads explore every lead of this call
+    if (threadCount_ > 1)
+        workerPool_ = std::make_shared<WorkerPool>(threadCount_);
     while (ptc() == false && !solved)
     {
         const std::vector<ProductGraph::State *> lead =
-            abstraction_->computeLead(prodStart_, [this](ProductGraph::State *a, ProductGraph::State *b)
-                                      {
-                                          return abstractEdgeWeight(a, b);
-                                      });
+            abstraction_->computeLeadIncremental(prodStart_, [this](ProductGraph::State *a, ProductGraph::State *b)
+                                                 {
+                                                     return abstractEdgeWeight(a, b);
+                                                 });
         buildAvail(lead);
         solved = explore(lead, soln, exploreTime_);
     }
+    workerPool_.reset();
 
     if (solved)
     {
@@ -184,6 +280,8 @@ double ompl::control::LTLPlanner::updateWeight(ProductGraph::State *as)
     /* \todo weight should include freeVolume, for cases in which decomposition
        does not respect obstacles. */
     info.weight = ((info.motions.size() + 1) * info.volume) / (info.autWeight * (info.numSel + 1) * (info.numSel + 1));
+    // the weights of the edges around as depend on info.weight
+    abstraction_->invalidateEdgeWeights(as);
     return info.weight;
 }
 
@@ -224,67 +322,108 @@ void ompl::control::LTLPlanner::buildAvail(const std::vector<ProductGraph::State
 
 bool ompl::control::LTLPlanner::explore(const std::vector<ProductGraph::State *> &lead, Motion *&soln, double duration)
 {
-    bool solved = false;
+    std::atomic<bool> solved(false);
     base::PlannerTerminationCondition ptc = base::timedPlannerTerminationCondition(duration);
     base::GoalPtr goal = pdef_->getGoal();
-    while (!ptc() && !solved)
+
+    auto expand = [&](RNG &rng, const ControlSamplerPtr &controlSampler)
     {
-        ProductGraph::State *as = availDist_.sample(rng_.uniform01());
-        ++abstractInfo_[as].numSel;
-        updateWeight(as);
-
-        PDF<Motion *> &motions = abstractInfo_[as].motions;
-        Motion *v = motions.sample(rng_.uniform01());
-        PDF<Motion *>::Element *velem = abstractInfo_[as].motionElems[v];
-        double vweight = motions.getWeight(velem);
-        if (vweight > 1e-20)
-            motions.update(velem, vweight / (vweight + 1.));
-
-        Control *rctrl = ltlsi_->allocControl();
-        controlSampler_->sampleNext(rctrl, v->control, v->state);
-        unsigned int cd =
-            controlSampler_->sampleStepCount(ltlsi_->getMinControlDuration(), ltlsi_->getMaxControlDuration());
-
-        base::State *newState = si_->allocState();
-        cd = ltlsi_->propagateWhileValid(v->state, rctrl, cd, newState);
-        if (cd < ltlsi_->getMinControlDuration())
-        {
-            si_->freeState(newState);
-            ltlsi_->freeControl(rctrl);
-            continue;
-        }
-        auto *m = new Motion();
-        m->state = newState;
-        m->control = rctrl;
-        m->steps = cd;
-        m->parent = v;
-        // Since the state was determined to be valid by SpaceInformation, we don't need to check automaton states
-        m->abstractState = ltlsi_->getProdGraphState(m->state);
-        motions_.push_back(m);
-
-        abstractInfo_[m->abstractState].addMotion(m);
-        updateWeight(m->abstractState);
-        // update weight if hl state already exists in avail
-        if (abstractInfo_[m->abstractState].pdfElem != nullptr)
-            availDist_.update(abstractInfo_[m->abstractState].pdfElem, abstractInfo_[m->abstractState].weight);
-        else
+        while (!ptc() && !solved)
         {
-            // otherwise, only add hl state to avail if it already exists in lead
-            if (std::find(lead.begin(), lead.end(), m->abstractState) != lead.end())
+            ProductGraphStateInfo *info;
             {
-                PDF<ProductGraph::State *>::Element *elem =
-                    availDist_.add(m->abstractState, abstractInfo_[m->abstractState].weight);
-                abstractInfo_[m->abstractState].pdfElem = elem;
+                std::lock_guard<std::mutex> lock(estimatesLock_);
+                ProductGraph::State *as = availDist_.sample(rng.uniform01());
+                info = &abstractInfo_[as];
+                ++info->numSel;
+                updateWeight(as);
             }
-        }
 
-        solved = goal->isSatisfied(m->state);
-        if (solved)
-        {
-            soln = m;
-            break;
+            Motion *v;
+            {
+                std::lock_guard<std::mutex> lock(info->lock);
+                PDF<Motion *> &motions = info->motions;
+                v = motions.sample(rng.uniform01());
+                PDF<Motion *>::Element *velem = info->motionElems[v];
+                double vweight = motions.getWeight(velem);
+                if (vweight > 1e-20)
+                    motions.update(velem, vweight / (vweight + 1.));
+            }
+
+            Control *rctrl = ltlsi_->allocControl();
+            controlSampler->sampleNext(rctrl, v->control, v->state);
+            unsigned int cd =
+                controlSampler->sampleStepCount(ltlsi_->getMinControlDuration(), ltlsi_->getMaxControlDuration());
+
+            base::State *newState = si_->allocState();
+            cd = ltlsi_->propagateWhileValid(v->state, rctrl, cd, newState);
+            if (cd < ltlsi_->getMinControlDuration())
+            {
+                si_->freeState(newState);
+                ltlsi_->freeControl(rctrl);
+                continue;
+            }
+            auto *m = new Motion();
+            m->state = newState;
+            m->control = rctrl;
+            m->steps = cd;
+            m->parent = v;
+            // Since the state was determined to be valid by SpaceInformation, we don't need to check automaton states
+            m->abstractState = ltlsi_->getProdGraphState(m->state);
+            const bool satisfied = goal->isSatisfied(m->state);
+
+            std::lock_guard<std::mutex> lock(estimatesLock_);
+            motions_.push_back(m);
+
+            ProductGraphStateInfo &newInfo = abstractInfo_[m->abstractState];
+            {
+                std::lock_guard<std::mutex> infoLock(newInfo.lock);
+                newInfo.addMotion(m);
+            }
+            updateWeight(m->abstractState);
+            // update weight if hl state already exists in avail
+            if (newInfo.pdfElem != nullptr)
+                availDist_.update(newInfo.pdfElem, newInfo.weight);
+            else
+            {
+                // otherwise, only add hl state to avail if it already exists in lead
+                if (std::find(lead.begin(), lead.end(), m->abstractState) != lead.end())
+                {
+                    PDF<ProductGraph::State *>::Element *elem = availDist_.add(m->abstractState, newInfo.weight);
+                    newInfo.pdfElem = elem;
+                }
+            }
+
+            if (satisfied && !solved)
+            {
+                soln = m;
+                solved = true;
+            }
         }
+    };
+
+    // the calling thread uses controlSampler_ and rng_; the others have their own
+    if (workerRNGs_.size() + 1 < threadCount_)
+        workerRNGs_.resize(threadCount_ - 1);
+    while (workerControlSamplers_.size() + 1 < threadCount_)
+        workerControlSamplers_.push_back(ltlsi_->allocControlSampler());
+    if (threadCount_ == 1)
+    {
+        expand(rng_, controlSampler_);
+        return solved;
     }
+
+    // Outside of solve(), the threads only last for this call
+    std::shared_ptr<WorkerPool> pool = workerPool_;
+    if (!pool || pool->size() != threadCount_)
+        pool = std::make_shared<WorkerPool>(threadCount_);
+    pool->run([this, &expand](unsigned int t)
+              {
+                  if (t == 0)
+                      expand(rng_, controlSampler_);
+                  else
+                      expand(workerRNGs_[t - 1], workerControlSamplers_[t - 1]);
+              });
     return solved;
 }
 
@@ -187,8 +187,81 @@ OMPL_POP_GCC
     return lead;
 }
 
+std::vector<ompl::control::ProductGraph::State *> ompl::control::ProductGraph::computeLeadIncremental(
+    ProductGraph::State *start, const std::function<double(ProductGraph::State *, ProductGraph::State *)> &edgeWeight)
+{
+    if (!leadSearch_ || leadStart_ != start)
+    {
+        std::vector<std::size_t> targets;
+        for (State *s : solutionStates_)
+            targets.push_back(stateToIndex_[s]);
+        leadSearch_.reset(new IncrementalShortestPath(boost::num_vertices(graph_), stateToIndex_[start], targets));
+        leadStart_ = start;
+
+        EdgeIter ei, eend;
+        for (boost::tie(ei, eend) = boost::edges(graph_); ei != eend; ++ei)
+        {
+            GraphType::vertex_descriptor src = boost::source(*ei, graph_);
+            GraphType::vertex_descriptor target = boost::target(*ei, graph_);
+            graph_[*ei].cost = edgeWeight(graph_[src], graph_[target]);
+            graph_[*ei].index = leadSearch_->addEdge(src, target, graph_[*ei].cost);
+        }
+        isInvalidated_.assign(boost::num_vertices(graph_), false);
+    }
+    else
+    {
+        // only reweigh the edges around the states that changed; the search keeps its own copy of the weights,
+        // as computeLead() may have overwritten the ones in graph_ since
+        auto reweigh = [&](const GraphType::edge_descriptor &e) {
+            graph_[e].cost = edgeWeight(graph_[boost::source(e, graph_)], graph_[boost::target(e, graph_)]);
+            leadSearch_->setEdgeWeight(graph_[e].index, graph_[e].cost);
+        };
+        for (int v : invalidated_)
+        {
+            boost::graph_traits<GraphType>::out_edge_iterator oi, oend;
+            for (boost::tie(oi, oend) = boost::out_edges(v, graph_); oi != oend; ++oi)
+                reweigh(*oi);
+            boost::graph_traits<GraphType>::in_edge_iterator ii, iend;
+            for (boost::tie(ii, iend) = boost::in_edges(v, graph_); ii != iend; ++ii)
+                reweigh(*ii);
+            isInvalidated_[v] = false;
+        }
+    }
+    invalidated_.clear();
+
+    std::vector<std::size_t> path;
+    leadSearch_->computeShortestPath(path);
+
+    // Truncate the lead as early when it hits the desired automaton states
+    std::vector<State *> lead;
+    for (std::size_t v : path)
+    {
+        lead.push_back(graph_[v]);
+        if (lead.back()->cosafeState == solutionStates_.front()->cosafeState &&
+            lead.back()->safeState == solutionStates_.front()->safeState)
+            break;
+    }
+    if (lead.empty())
+        lead.push_back(start);
+    return lead;
+}
+
+void ompl::control::ProductGraph::invalidateEdgeWeights(State *s)
+{
+    if (!leadSearch_)
+        return;
+    auto it = stateToIndex_.find(s);
+    if (it == stateToIndex_.end() || isInvalidated_[it->second])
+        return;
+    isInvalidated_[it->second] = true;
+    invalidated_.push_back(it->second);
+}
+
 void ompl::control::ProductGraph::clear()
 {
+    leadSearch_.reset();
+    leadStart_ = nullptr;
+    invalidated_.clear();
     solutionStates_.clear();
     stateToIndex_.clear();
     startState_ = nullptr;
@@ -200,6 +273,9 @@ void ompl::control::ProductGraph::clear()
 
 void ompl::control::ProductGraph::buildGraph(State *start, const std::function<void(State *)> &initialize)
 {
+    leadSearch_.reset();
+    leadStart_ = nullptr;
+    invalidated_.clear();
     graph_.clear();
     solutionStates_.clear();
     std::queue<State *> q;
@@ -309,6 +385,7 @@ ompl::control::ProductGraph::State *ompl::control::ProductGraph::getState(const
     s.decompRegion = decomp_->locateRegion(cs);
     s.cosafeState = cosafe;
     s.safeState = safe;
+    std::lock_guard<std::mutex> lock(stateLock_);
     State *&ret = stateToPtr_[s];
     if (ret == nullptr)
         ret = new State(s);
@@ -320,6 +397,7 @@ ompl::control::ProductGraph::State *ompl::control::ProductGraph::getState(const
     State s;
     s.decompRegion = nextRegion;
     const World nextWorld = decomp_->worldAtRegion(nextRegion);
+    std::lock_guard<std::mutex> lock(stateLock_);
     s.cosafeState = cosafety_->step(parent->cosafeState, nextWorld);
     s.safeState = safety_->step(parent->safeState, nextWorld);
     State *&ret = stateToPtr_[s];
@@ -39,6 +39,7 @@
 
 #include "ompl/control/planners/PlannerIncludes.h"
 #include "ompl/datastructures/NearestNeighbors.h"
+#include <algorithm>
 
 namespace ompl
 {
@@ -134,6 +135,21 @@ namespace ompl
                 return pruningRadius_;
             }
 
+            /** \brief Set the number of controls sampled at each iteration. The controls are propagated together
+                (see SpaceInformation::propagateWhileValidBatch()) and, among the ones that can be applied for their
+                full duration, the one that brings the system closest to the random state is used. The default value
+                is 1, which corresponds to the original algorithm. */
+            void setNumControlSamples(unsigned int numControlSamples)
+            {
+                numControlSamples_ = std::max(numControlSamples, 1u);
+            }
+
+            /** \brief Get the number of controls sampled at each iteration */
+            unsigned int getNumControlSamples() const
+            {
+                return numControlSamples_;
+            }
+
             /** \brief Set a different nearest neighbors datastructure */
             template <template <typename T> class NN>
             void setNearestNeighbors()
@@ -260,6 +276,9 @@ namespace ompl
             /** \brief The radius for determining the size of the pruning region. */
             double pruningRadius_{0.1};
 
+            /** \brief The number of controls sampled at each iteration */
+            unsigned int numControlSamples_{1u};
+
             /** \brief The random number generator */
             RNG rng_;
 
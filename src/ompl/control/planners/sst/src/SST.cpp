@@ -55,6 +55,8 @@ ompl::control::SST::SST(const SpaceInformationPtr &si) : base::Planner(si, "SST"
     Planner::declareParam<double>("selection_radius", this, &SST::setSelectionRadius, &SST::getSelectionRadius, "0.:.1:"
                                                                                                                 "100");
     Planner::declareParam<double>("pruning_radius", this, &SST::setPruningRadius, &SST::getPruningRadius, "0.:.1:100");
+    Planner::declareParam<unsigned int>("num_control_samples", this, &SST::setNumControlSamples,
+                                        &SST::getNumControlSamples, "1:1:100");
 }
 
 ompl::control::SST::~SST()
@@ -247,6 +249,19 @@ ompl::base::PlannerStatus ompl::control::SST::solve(const base::PlannerTerminati
     Control *rctrl = rmotion->control_;
     base::State *xstate = si_->allocState();
 
+    // controls sampled at each iteration, when more than one is requested
+    const unsigned int k = numControlSamples_;
+    std::vector<Control *> sampledControls(k > 1 ? k : 0);
+    std::vector<base::State *> sampledStates(sampledControls.size());
+    std::vector<int> sampledSteps(sampledControls.size());
+    std::vector<unsigned int> validSteps(sampledControls.size());
+    std::vector<double> distances(sampledControls.size());
+    for (std::size_t i = 0; i < sampledControls.size(); ++i)
+    {
+        sampledControls[i] = siC_->allocControl();
+        sampledStates[i] = si_->allocState();
+    }
+
     unsigned iterations = 0;
 
     while (ptc == false)
@@ -261,9 +276,40 @@ ompl::base::PlannerStatus ompl::control::SST::solve(const base::PlannerTerminati
         Motion *nmotion = selectNode(rmotion);
 
         /* sample a random control that attempts to go towards the random state, and also sample a control duration */
-        controlSampler_->sample(rctrl);
-        unsigned int cd = rng_.uniformInt(siC_->getMinControlDuration(), siC_->getMaxControlDuration());
-        unsigned int propCd = siC_->propagateWhileValid(nmotion->state_, rctrl, cd, rstate);
+        unsigned int cd = 0;
+        unsigned int propCd = 0;
+        if (k > 1)
+        {
+            /* sample several controls, and keep the one that is valid for its whole duration and gets closest to
+             * the random state */
+            for (unsigned int i = 0; i < k; ++i)
+            {
+                controlSampler_->sample(sampledControls[i]);
+                sampledSteps[i] = rng_.uniformInt(siC_->getMinControlDuration(), siC_->getMaxControlDuration());
+            }
+            siC_->propagateWhileValidBatch(nmotion->state_, sampledControls.data(), sampledSteps.data(), k,
+                                           sampledStates.data(), validSteps.data());
+            si_->distanceBatch(rstate, sampledStates.data(), k, distances.data());
+
+            int best = -1;
+            for (unsigned int i = 0; i < k; ++i)
+                if (validSteps[i] == (unsigned int)sampledSteps[i] && (best < 0 || distances[i] < distances[best]))
+                    best = i;
+            if (best < 0)
+            {
+                iterations++;
+                continue;
+            }
+            siC_->copyControl(rctrl, sampledControls[best]);
+            si_->copyState(rstate, sampledStates[best]);
+            cd = propCd = sampledSteps[best];
+        }
+        else
+        {
+            controlSampler_->sample(rctrl);
+            cd = rng_.uniformInt(siC_->getMinControlDuration(), siC_->getMaxControlDuration());
+            propCd = siC_->propagateWhileValid(nmotion->state_, rctrl, cd, rstate);
+        }
 
         if (propCd == cd)
         {
@@ -391,6 +437,11 @@ ompl::base::PlannerStatus ompl::control::SST::solve(const base::PlannerTerminati
     }
 
     si_->freeState(xstate);
+    for (std::size_t i = 0; i < sampledControls.size(); ++i)
+    {
+        siC_->freeControl(sampledControls[i]);
+        si_->freeState(sampledStates[i]);
+    }
     if (rmotion->state_)
         si_->freeState(rmotion->state_);
     if (rmotion->control_)
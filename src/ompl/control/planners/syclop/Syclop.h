@@ -37,17 +37,20 @@
 #ifndef OMPL_CONTROL_PLANNERS_SYCLOP_SYCLOP_
 #define OMPL_CONTROL_PLANNERS_SYCLOP_SYCLOP_
 
-#include <boost/graph/astar_search.hpp>
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <unordered_map>
 #include "ompl/control/planners/PlannerIncludes.h"
 #include "ompl/control/planners/syclop/Decomposition.h"
 #include "ompl/control/planners/syclop/GridDecomposition.h"
+#include "ompl/datastructures/IncrementalShortestPath.h"
 #include "ompl/datastructures/PDF.h"
 #include "ompl/util/Hash.h"
+#include <atomic>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -121,6 +124,8 @@ namespace ompl
                                               &Syclop::getProbAddingToAvailableRegions, "0.:.05:1.");
                 Planner::declareParam<double>("prob_shortest_path_lead", this, &Syclop::setProbShortestPathLead,
                                               &Syclop::getProbShortestPathLead, "0.:.05:1.");
+                Planner::declareParam<unsigned int>("thread_count", this, &Syclop::setThreadCount,
+                                                    &Syclop::getThreadCount, "1:64");
             }
 
             ~Syclop() override = default;
@@ -231,6 +236,18 @@ namespace ompl
             {
                 probAbandonLeadEarly_ = probability;
             }
+
+            /// \brief Set the number of threads that expand the low-level tree along a lead at the same time. Each
+            ///  thread repeatedly selects a region from the lead and extends the tree from it. This only has an
+            ///  effect if the low-level tree planner supports it (see canExtendConcurrently()). The state propagator
+            ///  and the state validity checker must be thread safe if this is more than 1. Default is 1.
+            void setThreadCount(unsigned int nthreads);
+
+            /// \brief Get the number of threads that expand the low-level tree along a lead at the same time.
+            unsigned int getThreadCount() const
+            {
+                return threadCount_;
+            }
             /// @}
 
             /** \brief Contains default values for Syclop parameters. */
@@ -332,19 +349,21 @@ namespace ompl
                     direct connections along this adjacency */
                 std::set<int> covGridCells;
                 /** \brief The source region of this adjacency edge */
-                const Region *source;
+                const Region *source{nullptr};
                 /** \brief The target region of this adjacency edge */
-                const Region *target;
+                const Region *target{nullptr};
                 /** \brief The cost of this adjacency edge, used in lead computations */
-                double cost;
+                double cost{0.};
                 /** \brief The number of times this adjacency has been included in a lead */
-                int numLeadInclusions;
+                int numLeadInclusions{0};
                 /** \brief The number of times the low-level tree planner has selected motions from the source region
                     when attempting to extend the tree toward the target region. */
-                int numSelections;
+                int numSelections{0};
                 /** \brief This value is true if and only if this adjacency's source and target regions both contain
                  * zero tree motions. */
-                bool empty;
+                bool empty{true};
+                /** \brief The index of this adjacency in the incremental shortest path search used for leads */
+                std::size_t searchIndex{0};
             };
 
             /** \brief Add State s as a new root in the low-level tree, and return the Motion corresponding to s. */
@@ -354,6 +373,31 @@ namespace ompl
                 Add any new motions created to newMotions. */
             virtual void selectAndExtend(Region &region, std::vector<Motion *> &newMotions) = 0;
 
+            /** \brief Return true if selectAndExtend() can be called by several threads at the same time. This
+                requires each thread to use its own samplers and getWorkerRNG(), the motions of a region to only be
+                read while holding getRegionLock(), and the low-level tree to be protected by a lock of its own.
+                By default, this returns false and the tree is expanded by one thread regardless of
+                getThreadCount(). */
+            virtual bool canExtendConcurrently() const
+            {
+                return false;
+            }
+
+            /** \brief The index of the calling thread among the threads that expand the tree, between 0 and
+                getThreadCount() - 1. The thread that called solve() has index 0. */
+            unsigned int getWorkerIndex() const;
+
+            /** \brief The random number generator selectAndExtend() should use in the calling thread. When the tree
+                is expanded by one thread, this is rng_. */
+            RNG &getWorkerRNG();
+
+            /** \brief The lock that guards the list of motions of the region with index \e rid while the tree is
+                expanded. */
+            std::mutex &getRegionLock(int rid) const
+            {
+                return regionLocks_[rid];
+            }
+
             /** \brief Returns a reference to the Region object with the given index. Assumes the index is valid. */
             inline const Region &getRegionFromIndex(const int rid) const
             {
@@ -390,6 +434,20 @@ namespace ompl
             RNG rng_;
 
         private:
+            /** \brief The threads that expand the tree along the leads */
+            class WorkerPool;
+
+            /// @cond IGNORE
+            /** \brief The best motion found so far while expanding the tree. Only modified while holding
+                estimatesLock_. */
+            struct Solution
+            {
+                const Motion *motion{nullptr};
+                double distance;
+                std::atomic<bool> exact{false};
+            };
+            /// @endcond
+
             /// @cond IGNORE
             /** \brief Hash function for std::pair<int,int> to be used in std::unordered_map */
             struct HashRegionPair
@@ -438,48 +496,6 @@ namespace ompl
             using VertexIndexMap = boost::property_map<RegionGraph, boost::vertex_index_t>::type;
             using EdgeIter = boost::graph_traits<RegionGraph>::edge_iterator;
 
-            /// @cond IGNORE
-            friend class DecompositionHeuristic;
-
-            class DecompositionHeuristic : public boost::astar_heuristic<RegionGraph, double>
-            {
-            public:
-                DecompositionHeuristic(const Syclop *s, const Region &goal) : syclop(s), goalRegion(goal)
-                {
-                }
-
-                double operator()(Vertex v)
-                {
-                    const Region &region = syclop->getRegionFromIndex(v);
-                    return region.alpha * goalRegion.alpha;
-                }
-
-            private:
-                const Syclop *syclop;
-                const Region &goalRegion;
-            };
-
-            struct found_goal
-            {
-            };
-
-            class GoalVisitor : public boost::default_astar_visitor
-            {
-            public:
-                GoalVisitor(const int goal) : goalRegion(goal)
-                {
-                }
-                void examine_vertex(Vertex v, const RegionGraph & /*g*/)
-                {
-                    if (static_cast<int>(v) == goalRegion)
-                        throw found_goal();
-                }
-
-            private:
-                const int goalRegion;
-            };
-            /// @endcond
-
             /// @cond IGNORE
             class RegionSet
             {
@@ -567,6 +583,17 @@ namespace ompl
             /** \brief Default edge cost factor, which is used by Syclop for edge weights between adjacent Regions. */
             double defaultEdgeCost(int r, int s);
 
+            /** \brief Expand the tree along the current lead with the threads of workerPool_, or only the calling
+                thread if there is none, until the lead is exhausted or abandoned, \e sol is exact or \e ptc is
+                met. */
+            void expandLead(const base::PlannerTerminationCondition &ptc, Solution &sol);
+
+            /** \brief Add the motions obtained by extending the tree from Region \e region to the regions that
+                contain them, and update the coverage and connection estimates accordingly. Motions that satisfy
+                the goal better than \e sol replace it. Returns true if the estimates improved. */
+            bool addMotions(int region, const std::vector<Motion *> &newMotions,
+                            const base::PlannerTerminationCondition &ptc, Solution &sol);
+
             /** \brief Lead computaton std::function object */
             LeadComputeFn leadComputeFn;
             /** \brief The current computed lead */
@@ -590,6 +617,24 @@ namespace ompl
             RegionSet startRegions_;
             /** \brief The set of all regions that contain goal states */
             RegionSet goalRegions_;
+            /** \brief Shortest paths from leadStart_ to leadGoal_, repaired as adjacency costs change */
+            std::unique_ptr<IncrementalShortestPath> leadSearch_;
+            int leadStart_{-1};
+            int leadGoal_{-1};
+            /** \brief The number of threads that expand the tree along a lead */
+            unsigned int threadCount_{1};
+            /** \brief The number of threads expanding the tree in the current call to solve() */
+            unsigned int workerCount_{1};
+            /** \brief A random number generator for each thread, when the tree is expanded by several threads */
+            std::vector<RNG> workerRNGs_;
+            /** \brief The threads used by expandLead(), started at the beginning of solve() and stopped at its end.
+                Empty when the tree is expanded by the calling thread only. */
+            std::shared_ptr<WorkerPool> workerPool_;
+            /** \brief One lock for each region, guarding its list of motions */
+            std::unique_ptr<std::mutex[]> regionLocks_;
+            /** \brief Guards the coverage and connection estimates, availDist_, numMotions_ and the solution
+                while the tree is expanded by several threads */
+            std::mutex estimatesLock_;
         };
     }
 }
@@ -40,6 +40,8 @@
 #include "ompl/control/planners/syclop/Syclop.h"
 #include "ompl/control/planners/syclop/Decomposition.h"
 #include "ompl/control/planners/syclop/GridDecomposition.h"
+#include <mutex>
+#include <vector>
 
 namespace ompl
 {
@@ -63,21 +65,31 @@ namespace ompl
 
             void setup() override;
             void clear() override;
+            base::PlannerStatus solve(const base::PlannerTerminationCondition &ptc) override;
             void getPlannerData(base::PlannerData &data) const override;
 
         protected:
             Syclop::Motion *addRoot(const base::State *s) override;
             void selectAndExtend(Region &region, std::vector<Motion *> &newMotions) override;
 
+            bool canExtendConcurrently() const override
+            {
+                return true;
+            }
+
             /** \brief Free the memory allocated by this planner. */
             void freeMemory();
 
             base::StateSamplerPtr sampler_;
-            ControlSamplerPtr controlSampler_;
+            /** \brief A control sampler for each thread that expands the tree */
+            std::vector<ControlSamplerPtr> controlSamplers_;
             std::vector<Motion *> motions_;
 
             /** \brief The most recent goal motion.  Used for PlannerData computation */
             Motion *lastGoalMotion_;
+
+            /** \brief Guards motions_ and lastGoalMotion_ while the tree is expanded by several threads */
+            std::mutex treeLock_;
         };
     }
 }
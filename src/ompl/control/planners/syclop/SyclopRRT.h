@@ -41,6 +41,8 @@
 #include "ompl/control/planners/syclop/Decomposition.h"
 #include "ompl/control/planners/syclop/GridDecomposition.h"
 #include "ompl/datastructures/NearestNeighbors.h"
+#include <mutex>
+#include <vector>
 
 namespace ompl
 {
@@ -65,6 +67,7 @@ namespace ompl
 
             void setup() override;
             void clear() override;
+            base::PlannerStatus solve(const base::PlannerTerminationCondition &ptc) override;
             void getPlannerData(base::PlannerData &data) const override;
 
             /** \brief If regionalNearestNeighbors is enabled, then when computing the closest Motion to a generated
@@ -98,6 +101,11 @@ namespace ompl
             Syclop::Motion *addRoot(const base::State *s) override;
             void selectAndExtend(Region &region, std::vector<Motion *> &newMotions) override;
 
+            bool canExtendConcurrently() const override
+            {
+                return true;
+            }
+
             /** \brief Free the memory allocated by this planner. */
             void freeMemory();
 
@@ -108,12 +116,17 @@ namespace ompl
             }
 
             base::StateSamplerPtr sampler_;
-            DirectedControlSamplerPtr controlSampler_;
+            /** \brief A directed control sampler for each thread that expands the tree */
+            std::vector<DirectedControlSamplerPtr> controlSamplers_;
             std::shared_ptr<NearestNeighbors<Motion *>> nn_;
             bool regionalNN_;
 
             /** \brief The most recent goal motion.  Used for PlannerData computation */
             Motion *lastGoalMotion_;
+
+            /** \brief Guards nn_ and lastGoalMotion_ while the tree is expanded by several threads. Nearest
+                neighbor queries are serialized as well. */
+            std::mutex treeLock_;
         };
     }
 }
@@ -37,11 +37,89 @@
 #include "ompl/control/planners/syclop/Syclop.h"
 #include "ompl/base/goals/GoalSampleableRegion.h"
 #include "ompl/base/ProblemDefinition.h"
-#include "ompl/util/DisableCompilerWarning.h"
+#include <boost/range/iterator_range.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <limits>
 #include <stack>
+#include <thread>
 #include <algorithm>
 
+class ompl::control::Syclop::WorkerPool
+{
+public:
+    /* Start numThreads - 1 workers, the thread calling run() being the first one */
+    explicit WorkerPool(unsigned int numThreads)
+    {
+        for (unsigned int t = 1; t < numThreads; ++t)
+            workers_.emplace_back([this, t] { work(t); });
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wakeUp_.notify_all();
+        for (auto &worker : workers_)
+            worker.join();
+    }
+
+    /* Run task(t) on worker t, for t from 1 to the number of workers, and on the calling thread as t = 0, and
+       return once they have all returned from it */
+    void run(const std::function<void(unsigned int)> &task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            numActive_ = workers_.size();
+            ++batch_;
+        }
+        wakeUp_.notify_all();
+
+        task(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return numActive_ == 0; });
+        task_ = nullptr;
+    }
+
+private:
+    void work(unsigned int t)
+    {
+        // the last batch this worker took part in
+        unsigned long seen = 0;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            wakeUp_.wait(lock, [this, &seen] { return stop_ || batch_ != seen; });
+            if (stop_)
+                return;
+            seen = batch_;
+
+            const std::function<void(unsigned int)> *task = task_;
+            lock.unlock();
+            (*task)(t);
+            lock.lock();
+
+            if (--numActive_ == 0)
+                done_.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::condition_variable done_;
+    const std::function<void(unsigned int)> *task_{nullptr};
+    std::size_t numActive_{0};
+    unsigned long batch_{0};
+    bool stop_{false};
+};
+
 const double ompl::control::Syclop::Defaults::PROB_ABANDON_LEAD_EARLY = 0.25;
 const double ompl::control::Syclop::Defaults::PROB_KEEP_ADDING_TO_AVAIL = 0.50;
 const double ompl::control::Syclop::Defaults::PROB_SHORTEST_PATH = 0.95;
@@ -111,12 +189,27 @@ ompl::base::PlannerStatus ompl::control::Syclop::solve(const base::PlannerTermin
 
     OMPL_INFORM("%s: Starting planning with %u states already in datastructure", getName().c_str(), numMotions_);
 
-    std::vector<Motion *> newMotions;
-    const Motion *solution = nullptr;
-    base::Goal *goal = pdef_->getGoal().get();
-    double goalDist = std::numeric_limits<double>::infinity();
-    bool solved = false;
-    while (!ptc && !solved)
+    unsigned int workers = 1;
+    if (threadCount_ > 1)
+    {
+        if (canExtendConcurrently())
+            workers = threadCount_;
+        else
+            OMPL_WARN("%s: The low-level planner cannot be expanded by several threads. Using one thread.",
+                      getName().c_str());
+    }
+    workerCount_ = workers;
+    if (workers > 1)
+    {
+        if (workerRNGs_.size() < workers)
+            workerRNGs_.resize(workers);
+        // the same threads expand every lead of this call
+        workerPool_ = std::make_shared<WorkerPool>(workers);
+    }
+
+    Solution sol;
+    sol.distance = std::numeric_limits<double>::infinity();
+    while (!ptc && !sol.exact)
     {
         const int chosenStartRegion = startRegions_.sampleUniform();
         int chosenGoalRegion = -1;
@@ -135,65 +228,14 @@ ompl::base::PlannerStatus ompl::control::Syclop::solve(const base::PlannerTermin
 
         leadComputeFn(chosenStartRegion, chosenGoalRegion, lead_);
         computeAvailableRegions();
-        for (int i = 0; i < numRegionExpansions_ && !solved && !ptc; ++i)
-        {
-            const int region = selectRegion();
-            bool improved = false;
-            for (int j = 0; j < numTreeSelections_ && !solved && !ptc; ++j)
-            {
-                newMotions.clear();
-                selectAndExtend(graph_[boost::vertex(region, graph_)], newMotions);
-                for (std::vector<Motion *>::const_iterator m = newMotions.begin(); m != newMotions.end() && !ptc; ++m)
-                {
-                    Motion *motion = *m;
-                    double distance;
-                    solved = goal->isSatisfied(motion->state, &distance);
-                    if (solved)
-                    {
-                        goalDist = distance;
-                        solution = motion;
-                        break;
-                    }
-
-                    // Check for approximate (best-so-far) solution
-                    if (distance < goalDist)
-                    {
-                        goalDist = distance;
-                        solution = motion;
-                    }
-                    const int newRegion = decomp_->locateRegion(motion->state);
-                    graph_[boost::vertex(newRegion, graph_)].motions.push_back(motion);
-                    ++numMotions_;
-                    Region &newRegionObj = graph_[boost::vertex(newRegion, graph_)];
-                    improved |= updateCoverageEstimate(newRegionObj, motion->state);
-                    /* If tree has just crossed from one region to its neighbor,
-                       update the connection estimates. If the tree has crossed an entire region,
-                       then region and newRegion are not adjacent, and so we do not update estimates. */
-                    if (newRegion != region && regionsToEdge_.count(std::pair<int, int>(region, newRegion)) > 0)
-                    {
-                        Adjacency *adj = regionsToEdge_[std::pair<int, int>(region, newRegion)];
-                        adj->empty = false;
-                        ++adj->numSelections;
-                        improved |= updateConnectionEstimate(graph_[boost::vertex(region, graph_)], newRegionObj,
-                                                             motion->state);
-                    }
-
-                    /* If this region already exists in availDist, update its weight. */
-                    if (newRegionObj.pdfElem != nullptr)
-                        availDist_.update(newRegionObj.pdfElem, newRegionObj.weight);
-                    /* Otherwise, only add this region to availDist
-                       if it already exists in the lead. */
-                    else if (std::find(lead_.begin(), lead_.end(), newRegion) != lead_.end())
-                    {
-                        PDF<int>::Element *elem = availDist_.add(newRegion, newRegionObj.weight);
-                        newRegionObj.pdfElem = elem;
-                    }
-                }
-            }
-            if (!improved && rng_.uniform01() < probAbandonLeadEarly_)
-                break;
-        }
+        expandLead(ptc, sol);
     }
+    workerPool_.reset();
+    workerCount_ = 1;
+
+    const bool solved = sol.exact;
+    const Motion *solution = sol.motion;
+    const double goalDist = sol.distance;
     bool addedSolution = false;
     if (solution != nullptr)
     {
@@ -215,6 +257,125 @@ ompl::base::PlannerStatus ompl::control::Syclop::solve(const base::PlannerTermin
     return addedSolution ? base::PlannerStatus::EXACT_SOLUTION : base::PlannerStatus::TIMEOUT;
 }
 
+namespace
+{
+    /* The index of the calling thread among the threads that expand the tree */
+    thread_local unsigned int syclopWorkerIndex = 0;
+}
+
+void ompl::control::Syclop::expandLead(const base::PlannerTerminationCondition &ptc, Solution &sol)
+{
+    std::atomic<int> expansions(0);
+    std::atomic<bool> abandoned(false);
+
+    auto expand = [&]
+    {
+        std::vector<Motion *> newMotions;
+        while (!sol.exact && !abandoned && !ptc && expansions++ < numRegionExpansions_)
+        {
+            int region;
+            {
+                std::lock_guard<std::mutex> lock(estimatesLock_);
+                region = selectRegion();
+            }
+            bool improved = false;
+            for (int j = 0; j < numTreeSelections_ && !sol.exact && !ptc; ++j)
+            {
+                newMotions.clear();
+                selectAndExtend(graph_[boost::vertex(region, graph_)], newMotions);
+                improved |= addMotions(region, newMotions, ptc, sol);
+            }
+            if (!improved && getWorkerRNG().uniform01() < probAbandonLeadEarly_)
+                abandoned = true;
+        }
+    };
+
+    if (!workerPool_)
+    {
+        expand();
+        return;
+    }
+    // the calling thread is worker 0
+    workerPool_->run([&expand](unsigned int t)
+                     {
+                         syclopWorkerIndex = t;
+                         expand();
+                     });
+}
+
+bool ompl::control::Syclop::addMotions(int region, const std::vector<Motion *> &newMotions,
+                                       const base::PlannerTerminationCondition &ptc, Solution &sol)
+{
+    base::Goal *goal = pdef_->getGoal().get();
+    bool improved = false;
+    for (std::vector<Motion *>::const_iterator m = newMotions.begin(); m != newMotions.end() && !ptc; ++m)
+    {
+        Motion *motion = *m;
+        double distance;
+        const bool satisfied = goal->isSatisfied(motion->state, &distance);
+        const int newRegion = decomp_->locateRegion(motion->state);
+
+        std::lock_guard<std::mutex> lock(estimatesLock_);
+        if (sol.exact)
+            break;
+        if (satisfied || distance < sol.distance)
+        {
+            sol.motion = motion;
+            sol.distance = distance;
+            sol.exact = satisfied;
+            if (satisfied)
+                break;
+        }
+
+        Region &newRegionObj = graph_[boost::vertex(newRegion, graph_)];
+        {
+            std::lock_guard<std::mutex> regionLock(regionLocks_[newRegion]);
+            newRegionObj.motions.push_back(motion);
+        }
+        ++numMotions_;
+        improved |= updateCoverageEstimate(newRegionObj, motion->state);
+        /* If tree has just crossed from one region to its neighbor,
+           update the connection estimates. If the tree has crossed an entire region,
+           then region and newRegion are not adjacent, and so we do not update estimates. */
+        auto edge = regionsToEdge_.find(std::pair<int, int>(region, newRegion));
+        if (newRegion != region && edge != regionsToEdge_.end())
+        {
+            Adjacency *adj = edge->second;
+            adj->empty = false;
+            ++adj->numSelections;
+            improved |= updateConnectionEstimate(graph_[boost::vertex(region, graph_)], newRegionObj, motion->state);
+        }
+
+        /* If this region already exists in availDist, update its weight. */
+        if (newRegionObj.pdfElem != nullptr)
+            availDist_.update(newRegionObj.pdfElem, newRegionObj.weight);
+        /* Otherwise, only add this region to availDist
+           if it already exists in the lead. */
+        else if (std::find(lead_.begin(), lead_.end(), newRegion) != lead_.end())
+        {
+            PDF<int>::Element *elem = availDist_.add(newRegion, newRegionObj.weight);
+            newRegionObj.pdfElem = elem;
+        }
+    }
+    return improved;
+}
+
+unsigned int ompl::control::Syclop::getWorkerIndex() const
+{
+    return syclopWorkerIndex;
+}
+
+ompl::RNG &ompl::control::Syclop::getWorkerRNG()
+{
+    return workerCount_ > 1 ? workerRNGs_[syclopWorkerIndex] : rng_;
+}
+
+void ompl::control::Syclop::setThreadCount(unsigned int nthreads)
+{
+    assert(nthreads > 0);
+    threadCount_ = nthreads;
+}
+
 void ompl::control::Syclop::setLeadComputeFn(const LeadComputeFn &compute)
 {
     leadComputeFn = compute;
@@ -292,12 +453,9 @@ void ompl::control::Syclop::initEdge(Adjacency &adj, const Region *source, const
 
 void ompl::control::Syclop::setupEdgeEstimates()
 {
-OMPL_PUSH_DISABLE_GCC_WARNING(-Wmaybe-uninitialized)
-    EdgeIter ei, eend;
-OMPL_POP_GCC
-    for (boost::tie(ei, eend) = boost::edges(graph_); ei != eend; ++ei)
+    for (auto e : boost::make_iterator_range(boost::edges(graph_)))
     {
-        Adjacency &adj = graph_[*ei];
+        Adjacency &adj = graph_[e];
         adj.empty = true;
         adj.numLeadInclusions = 0;
         adj.numSelections = 0;
@@ -312,6 +470,8 @@ void ompl::control::Syclop::updateEdge(Adjacency &a)
     {
         a.cost *= factor(a.source->index, a.target->index);
     }
+    if (leadSearch_)
+        leadSearch_->setEdgeWeight(a.searchIndex, a.cost);
 }
 
 bool ompl::control::Syclop::updateCoverageEstimate(Region &r, const base::State *s)
@@ -339,6 +499,7 @@ void ompl::control::Syclop::buildGraph()
 {
     VertexIndexMap index = get(boost::vertex_index, graph_);
     std::vector<int> neighbors;
+    regionLocks_.reset(new std::mutex[decomp_->getNumRegions()]);
     for (int i = 0; i < decomp_->getNumRegions(); ++i)
     {
         const RegionGraph::vertex_descriptor v = boost::add_vertex(graph_);
@@ -368,11 +529,9 @@ void ompl::control::Syclop::clearGraphDetails()
     VertexIter vi, vend;
     for (boost::tie(vi, vend) = boost::vertices(graph_); vi != vend; ++vi)
         graph_[*vi].clear();
-OMPL_PUSH_DISABLE_GCC_WARNING(-Wmaybe-uninitialized)
-    EdgeIter ei, eend;
-OMPL_POP_GCC
-    for (boost::tie(ei, eend) = boost::edges(graph_); ei != eend; ++ei)
-        graph_[*ei].clear();
+    for (auto e : boost::make_iterator_range(boost::edges(graph_)))
+        graph_[e].clear();
+    leadSearch_.reset();
     graphReady_ = false;
 }
 
@@ -413,38 +572,24 @@ void ompl::control::Syclop::defaultComputeLead(int startRegion, int goalRegion,
 
     if (rng_.uniform01() < probShortestPath_)
     {
-        std::vector<RegionGraph::vertex_descriptor> parents(decomp_->getNumRegions());
-        std::vector<double> distances(decomp_->getNumRegions());
-
-        try
+        /* The shortest path search is kept between leads: updateEdge() forwards the new costs of the
+           adjacencies, and only the part of the search affected by them is repeated. */
+        if (!leadSearch_ || leadStart_ != startRegion || leadGoal_ != goalRegion)
         {
-            boost::astar_search(graph_, boost::vertex(startRegion, graph_),
-                                DecompositionHeuristic(this, getRegionFromIndex(goalRegion)),
-                                boost::weight_map(get(&Adjacency::cost, graph_))
-                                    .distance_map(boost::make_iterator_property_map(distances.begin(),
-                                                                                    get(boost::vertex_index, graph_)))
-                                    .predecessor_map(boost::make_iterator_property_map(
-                                        parents.begin(), get(boost::vertex_index, graph_)))
-                                    .visitor(GoalVisitor(goalRegion)));
-        }
-        catch (found_goal fg)
-        {
-            int region = goalRegion;
-            int leadLength = 1;
-
-            while (region != startRegion)
+            leadSearch_.reset(new IncrementalShortestPath(decomp_->getNumRegions(), startRegion,
+                                                          std::vector<std::size_t>(1, goalRegion)));
+            leadStart_ = startRegion;
+            leadGoal_ = goalRegion;
+            for (auto e : boost::make_iterator_range(boost::edges(graph_)))
             {
-                region = parents[region];
-                ++leadLength;
-            }
-            lead.resize(leadLength);
-            region = goalRegion;
-            for (int i = leadLength - 1; i >= 0; --i)
-            {
-                lead[i] = region;
-                region = parents[region];
+                Adjacency &adj = graph_[e];
+                adj.searchIndex = leadSearch_->addEdge(adj.source->index, adj.target->index, adj.cost);
             }
         }
+
+        std::vector<std::size_t> path;
+        leadSearch_->computeShortestPath(path);
+        lead.assign(path.begin(), path.end());
     }
     else
     {
@@ -499,7 +644,7 @@ void ompl::control::Syclop::defaultComputeLead(int startRegion, int goalRegion,
     }
 
     // Now that we have a lead, update the edge weights.
-    for (std::size_t i = 0; i < lead.size() - 1; ++i)
+    for (std::size_t i = 0; i + 1 < lead.size(); ++i)
     {
         Adjacency &adj = *regionsToEdge_[std::pair<int, int>(lead[i], lead[i + 1])];
         if (adj.empty)
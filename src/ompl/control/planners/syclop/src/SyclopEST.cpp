@@ -41,7 +41,7 @@ void ompl::control::SyclopEST::setup()
 {
     Syclop::setup();
     sampler_ = si_->allocStateSampler();
-    controlSampler_ = siC_->allocControlSampler();
+    controlSamplers_.assign(1, siC_->allocControlSampler());
     lastGoalMotion_ = nullptr;
 }
 
@@ -53,6 +53,14 @@ void ompl::control::SyclopEST::clear()
     lastGoalMotion_ = nullptr;
 }
 
+ompl::base::PlannerStatus ompl::control::SyclopEST::solve(const base::PlannerTerminationCondition &ptc)
+{
+    checkValidity();
+    while (controlSamplers_.size() < getThreadCount())
+        controlSamplers_.push_back(siC_->allocControlSampler());
+    return Syclop::solve(ptc);
+}
+
 void ompl::control::SyclopEST::getPlannerData(base::PlannerData &data) const
 {
     Planner::getPlannerData(data);
@@ -88,13 +96,18 @@ ompl::control::Syclop::Motion *ompl::control::SyclopEST::addRoot(const base::Sta
 
 void ompl::control::SyclopEST::selectAndExtend(Region &region, std::vector<Motion *> &newMotions)
 {
-    Motion *treeMotion = region.motions[rng_.uniformInt(0, region.motions.size() - 1)];
+    Motion *treeMotion;
+    {
+        std::lock_guard<std::mutex> lock(getRegionLock(region.index));
+        treeMotion = region.motions[getWorkerRNG().uniformInt(0, region.motions.size() - 1)];
+    }
     Control *rctrl = siC_->allocControl();
     base::State *newState = si_->allocState();
 
-    controlSampler_->sample(rctrl, treeMotion->state);
+    const ControlSamplerPtr &controlSampler = controlSamplers_[getWorkerIndex()];
+    controlSampler->sample(rctrl, treeMotion->state);
     unsigned int duration =
-        controlSampler_->sampleStepCount(siC_->getMinControlDuration(), siC_->getMaxControlDuration());
+        controlSampler->sampleStepCount(siC_->getMinControlDuration(), siC_->getMaxControlDuration());
     duration = siC_->propagateWhileValid(treeMotion->state, rctrl, duration, newState);
 
     if (duration >= siC_->getMinControlDuration())
@@ -104,9 +117,10 @@ void ompl::control::SyclopEST::selectAndExtend(Region &region, std::vector<Motio
         siC_->copyControl(motion->control, rctrl);
         motion->steps = duration;
         motion->parent = treeMotion;
-        motions_.push_back(motion);
         newMotions.push_back(motion);
 
+        std::lock_guard<std::mutex> lock(treeLock_);
+        motions_.push_back(motion);
         lastGoalMotion_ = motion;
     }
 
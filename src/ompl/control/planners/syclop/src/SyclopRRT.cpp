@@ -42,11 +42,12 @@ void ompl::control::SyclopRRT::setup()
 {
     Syclop::setup();
     sampler_ = si_->allocStateSampler();
-    controlSampler_ = siC_->allocDirectedControlSampler();
+    controlSamplers_.assign(1, siC_->allocDirectedControlSampler());
     lastGoalMotion_ = nullptr;
 
     // Create a default GNAT nearest neighbors structure if the user doesn't want
-    // the default regionalNN check from the discretization
+    // the default regionalNN check from the discretization. Threads expanding the
+    // tree only use it under treeLock_, so it need not be thread safe.
     if (!nn_ && !regionalNN_)
     {
         nn_.reset(tools::SelfConfig::getDefaultNearestNeighbors<Motion *>(this));
@@ -66,6 +67,14 @@ void ompl::control::SyclopRRT::clear()
     lastGoalMotion_ = nullptr;
 }
 
+ompl::base::PlannerStatus ompl::control::SyclopRRT::solve(const base::PlannerTerminationCondition &ptc)
+{
+    checkValidity();
+    while (controlSamplers_.size() < getThreadCount())
+        controlSamplers_.push_back(siC_->allocDirectedControlSampler());
+    return Syclop::solve(ptc);
+}
+
 void ompl::control::SyclopRRT::getPlannerData(base::PlannerData &data) const
 {
     Planner::getPlannerData(data);
@@ -108,7 +117,7 @@ void ompl::control::SyclopRRT::selectAndExtend(Region &region, std::vector<Motio
     auto *rmotion = new Motion(siC_);
     base::StateSamplerPtr sampler(si_->allocStateSampler());
     std::vector<double> coord(decomp_->getDimension());
-    decomp_->sampleFromRegion(region.index, rng_, coord);
+    decomp_->sampleFromRegion(region.index, getWorkerRNG(), coord);
     decomp_->sampleFullState(sampler, coord, rmotion->state);
 
     Motion *nmotion;
@@ -123,6 +132,7 @@ void ompl::control::SyclopRRT::selectAndExtend(Region &region, std::vector<Motio
         std::vector<Motion *> motions;
         for (const auto &i : searchRegions)
         {
+            std::lock_guard<std::mutex> lock(getRegionLock(i));
             const std::vector<Motion *> &regionMotions = getRegionFromIndex(i).motions;
             motions.insert(motions.end(), regionMotions.begin(), regionMotions.end());
         }
@@ -146,16 +156,18 @@ void ompl::control::SyclopRRT::selectAndExtend(Region &region, std::vector<Motio
     else
     {
         assert(nn_);
+        std::lock_guard<std::mutex> lock(treeLock_);
         nmotion = nn_->nearest(rmotion);
     }
 
-    unsigned int duration =
-        controlSampler_->sampleTo(rmotion->control, nmotion->control, nmotion->state, rmotion->state);
+    unsigned int duration = controlSamplers_[getWorkerIndex()]->sampleTo(rmotion->control, nmotion->control,
+                                                                         nmotion->state, rmotion->state);
     if (duration >= siC_->getMinControlDuration())
     {
         rmotion->steps = duration;
         rmotion->parent = nmotion;
         newMotions.push_back(rmotion);
+        std::lock_guard<std::mutex> lock(treeLock_);
         if (nn_)
             nn_->add(rmotion);
         lastGoalMotion_ = rmotion;
@@ -36,13 +36,27 @@
 
 #include "ompl/control/SimpleDirectedControlSampler.h"
 #include "ompl/control/SpaceInformation.h"
+#include <algorithm>
 
 ompl::control::SimpleDirectedControlSampler::SimpleDirectedControlSampler(const SpaceInformation *si, unsigned int k)
   : DirectedControlSampler(si), cs_(si->allocControlSampler()), numControlSamples_(k)
 {
 }
 
-ompl::control::SimpleDirectedControlSampler::~SimpleDirectedControlSampler() = default;
+ompl::control::SimpleDirectedControlSampler::~SimpleDirectedControlSampler()
+{
+    freeSamples();
+}
+
+void ompl::control::SimpleDirectedControlSampler::freeSamples()
+{
+    for (auto &control : controls_)
+        si_->freeControl(control);
+    for (auto &state : states_)
+        si_->freeState(state);
+    controls_.clear();
+    states_.clear();
+}
 
 unsigned int ompl::control::SimpleDirectedControlSampler::sampleTo(Control *control, const base::State *source,
                                                                    base::State *dest)
@@ -59,75 +73,58 @@ unsigned int ompl::control::SimpleDirectedControlSampler::sampleTo(Control *cont
 unsigned int ompl::control::SimpleDirectedControlSampler::getBestControl(Control *control, const base::State *source,
                                                                          base::State *dest, const Control *previous)
 {
-    // Sample the first control
-    if (previous != nullptr)
-        cs_->sampleNext(control, previous, source);
-    else
-        cs_->sample(control, source);
+    const unsigned int k = std::max(numControlSamples_, 1u);
+    if (controls_.size() != k)
+    {
+        freeSamples();
+        controls_.resize(k);
+        states_.resize(k);
+        for (unsigned int i = 0; i < k; ++i)
+        {
+            controls_[i] = si_->allocControl();
+            states_[i] = si_->allocState();
+        }
+        steps_.resize(k);
+        validSteps_.resize(k);
+        distances_.resize(k);
+    }
 
     const unsigned int minDuration = si_->getMinControlDuration();
     const unsigned int maxDuration = si_->getMaxControlDuration();
-    // std::cout << minDuration << "," << maxDuration << std::endl;
 
-    unsigned int steps = cs_->sampleStepCount(minDuration, maxDuration);
-    // Propagate the first control, and find how far it is from the target state
-    base::State *bestState = si_->allocState();
-    steps = si_->propagateWhileValid(source, control, steps, bestState);
+    // Sample all the controls, and propagate them together
+    for (unsigned int i = 0; i < k; ++i)
+    {
+        if (previous != nullptr)
+            cs_->sampleNext(controls_[i], previous, source);
+        else
+            cs_->sample(controls_[i], source);
+        steps_[i] = cs_->sampleStepCount(minDuration, maxDuration);
+    }
+    si_->propagateWhileValidBatch(source, controls_.data(), steps_.data(), k, states_.data(), validSteps_.data());
+    si_->distanceBatch(dest, states_.data(), k, distances_.data());
 
 //###############################################
     dist = si_->distance(source,dest);
-    //if((si_->getPropagationStepSize() * maxDuration) < (0.75*dist)){
-    //    std::cout << "too far away" << std::endl;
-    //    si_->copyState(dest, bestState);
-    //    si_->freeState(bestState);
-    //    return steps;
-    //}
 //###############################################
 
-    if (numControlSamples_ > 1)
-    {
-        Control *tempControl = si_->allocControl();
-        base::State *tempState = si_->allocState();
-        double bestDistance = si_->distance(bestState, dest);
-      //########################################
-        toleratedDistance_ = distanceFactor_ * dist;
-      //#######################################
-        // Sample k-1 more controls, and save the control that gets closest to target
-        for (unsigned int i = 1; i < numControlSamples_; ++i)
+    // Find the control that gets closest to target, in the order the controls were sampled
+    unsigned int best = 0;
+  //########################################
+    toleratedDistance_ = distanceFactor_ * dist;
+  //#######################################
+    for (unsigned int i = 1; i < k; ++i)
+        if (distances_[i] < distances_[best])
         {
-            unsigned int sampleSteps = cs_->sampleStepCount(minDuration, maxDuration);
-            if (previous != nullptr)
-                cs_->sampleNext(tempControl, previous, source);
-            else
-                cs_->sample(tempControl, source);
-
-            sampleSteps = si_->propagateWhileValid(source, tempControl, sampleSteps, tempState);
-            double tempDistance = si_->distance(tempState, dest);
-            if (tempDistance < bestDistance)
-            {
-                si_->copyState(bestState, tempState);
-                si_->copyControl(control, tempControl);
-                bestDistance = tempDistance;
-                steps = sampleSteps;
-            //###########################################		
-                if(bestDistance < toleratedDistance_){
-                  si_->freeState(tempState);
-                  si_->freeControl(tempControl);
-                  // std::cout << "Exited with " << i << " samples and " << steps << " steps" << std::endl;
-                  return steps;
-                }
-            //##########################################
-            }
+            best = i;
+        //###########################################
+            if (distances_[best] < toleratedDistance_)
+                break;
+        //##########################################
         }
 
-        si_->freeState(tempState);
-        si_->freeControl(tempControl);
-    }
-
-    // std::cout << "checked Motion not feasible" << std::endl;
-
-    si_->copyState(dest, bestState);
-    si_->freeState(bestState);
+    si_->copyControl(control, controls_[best]);
+    si_->copyState(dest, states_[best]);
 
-    return steps;
+    return validSteps_[best];
 }
@@ -38,7 +38,9 @@
 #include "ompl/control/SimpleDirectedControlSampler.h"
 #include "ompl/control/SteeredControlSampler.h"
 #include "ompl/util/Exception.h"
+#include <algorithm>
 #include <cassert>
+#include <memory>
 #include <utility>
 #include <limits>
 
@@ -311,6 +313,161 @@ unsigned int ompl::control::SpaceInformation::propagateWhileValid(const base::St
     return st;
 }
 
+void ompl::control::SpaceInformation::propagateBatch(const base::State *state, const Control *const *controls,
+                                                     const int *steps, std::size_t n, base::State **results) const
+{
+    // the items that still have steps to perform, and the arguments of the next call to the state propagator
+    std::vector<std::size_t> active;
+    std::vector<const base::State *> from;
+    std::vector<const Control *> ctrl;
+    std::vector<double> durations;
+    std::vector<base::State *> to;
+    active.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (steps[i] == 0)
+        {
+            if (results[i] != state)
+                copyState(results[i], state);
+        }
+        else
+            active.push_back(i);
+    }
+
+    for (int st = 0; !active.empty(); ++st)
+    {
+        from.clear();
+        ctrl.clear();
+        durations.clear();
+        to.clear();
+        for (std::size_t i : active)
+        {
+            from.push_back(st == 0 ? state : results[i]);
+            ctrl.push_back(controls[i]);
+            durations.push_back(steps[i] > 0 ? stepSize_ : -stepSize_);
+            to.push_back(results[i]);
+        }
+        statePropagator_->propagateBatch(from.data(), ctrl.data(), durations.data(), active.size(), to.data());
+
+        // drop the items that performed all their steps
+        active.erase(std::remove_if(active.begin(), active.end(),
+                                    [steps, st](std::size_t i) { return abs(steps[i]) <= st + 1; }),
+                     active.end());
+    }
+}
+
+void ompl::control::SpaceInformation::propagateWhileValidBatch(const base::State *state,
+                                                               const Control *const *controls, const int *steps,
+                                                               std::size_t n, base::State **results,
+                                                               unsigned int *validSteps) const
+{
+    // For each item, the last valid state is current[i] (initially the start state) and the next step is computed in
+    // whichever of results[i] and a scratch state does not hold current[i].
+    std::vector<const base::State *> current(n, state);
+    std::vector<base::State *> scratch(n, nullptr);
+    std::vector<std::size_t> active;
+    std::vector<const base::State *> from;
+    std::vector<const Control *> ctrl;
+    std::vector<double> durations;
+    std::vector<base::State *> to;
+    std::unique_ptr<bool[]> valid(new bool[n]);
+    active.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        validSteps[i] = 0;
+        if (steps[i] != 0)
+        {
+            scratch[i] = allocScratchState();
+            active.push_back(i);
+        }
+    }
+
+    while (!active.empty())
+    {
+        from.clear();
+        ctrl.clear();
+        durations.clear();
+        to.clear();
+        for (std::size_t i : active)
+        {
+            from.push_back(current[i]);
+            ctrl.push_back(controls[i]);
+            durations.push_back(steps[i] > 0 ? stepSize_ : -stepSize_);
+            to.push_back(current[i] == results[i] ? scratch[i] : results[i]);
+        }
+        statePropagator_->propagateBatch(from.data(), ctrl.data(), durations.data(), active.size(), to.data());
+        isValid(to.data(), to.size(), valid.get());
+
+        std::size_t k = 0;
+        for (std::size_t j = 0; j < active.size(); ++j)
+        {
+            std::size_t i = active[j];
+            if (!valid[j])
+                continue;
+            current[i] = to[j];
+            if (++validSteps[i] < (unsigned int)abs(steps[i]))
+                active[k++] = i;
+        }
+        active.resize(k);
+    }
+
+    // make sure the results contain the last valid states
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (current[i] != results[i])
+            copyState(results[i], current[i]);
+        if (scratch[i] != nullptr)
+            freeScratchState(scratch[i]);
+    }
+}
+
+void ompl::control::SpaceInformation::propagateWhileValidBatch(const base::State *state,
+                                                               const Control *const *controls, const int *steps,
+                                                               std::size_t n, std::vector<base::State *> *trajectories,
+                                                               unsigned int *validSteps) const
+{
+    // each step of an item is computed in the next state of its trajectory, and kept there if it is valid
+    std::vector<std::size_t> active;
+    std::vector<const base::State *> from;
+    std::vector<const Control *> ctrl;
+    std::vector<double> durations;
+    std::vector<base::State *> to;
+    std::unique_ptr<bool[]> valid(new bool[n]);
+    active.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        validSteps[i] = 0;
+        if (steps[i] != 0)
+            active.push_back(i);
+    }
+
+    while (!active.empty())
+    {
+        from.clear();
+        ctrl.clear();
+        durations.clear();
+        to.clear();
+        for (std::size_t i : active)
+        {
+            from.push_back(validSteps[i] == 0 ? state : trajectories[i][validSteps[i] - 1]);
+            ctrl.push_back(controls[i]);
+            durations.push_back(steps[i] > 0 ? stepSize_ : -stepSize_);
+            to.push_back(trajectories[i][validSteps[i]]);
+        }
+        statePropagator_->propagateBatch(from.data(), ctrl.data(), durations.data(), active.size(), to.data());
+        isValid(to.data(), to.size(), valid.get());
+
+        std::size_t k = 0;
+        for (std::size_t j = 0; j < active.size(); ++j)
+        {
+            std::size_t i = active[j];
+            if (valid[j] && ++validSteps[i] < (unsigned int)abs(steps[i]))
+                active[k++] = i;
+        }
+        active.resize(k);
+    }
+}
+
 void ompl::control::SpaceInformation::printSettings(std::ostream &out) const
 {
     base::SpaceInformation::printSettings(out);
@@ -37,6 +37,7 @@
 #ifndef OMPL_DATASTRUCTURES_BINARY_HEAP_
 #define OMPL_DATASTRUCTURES_BINARY_HEAP_
 
+#include <algorithm>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -210,6 +211,32 @@ namespace ompl
                 content.push_back(element->data);
         }
 
+        /** \brief Get (up to) the \e k first elements of the heap, in order, without removing them. This takes
+            O(k log k) time, independently of the size of the heap. */
+        void getTop(unsigned int k, std::vector<_T> &content) const
+        {
+            // best-first traversal of the heap: an element is never before its parent
+            auto after = [this](unsigned int a, unsigned int b)
+            {
+                return lt_(vector_[b]->data, vector_[a]->data);
+            };
+            std::vector<unsigned int> frontier;
+            if (!vector_.empty())
+                frontier.push_back(0);
+            for (unsigned int i = 0; i < k && !frontier.empty(); ++i)
+            {
+                std::pop_heap(frontier.begin(), frontier.end(), after);
+                const unsigned int pos = frontier.back();
+                frontier.pop_back();
+                content.push_back(vector_[pos]->data);
+                for (unsigned int child = 2 * pos + 1; child <= 2 * pos + 2 && child < vector_.size(); ++child)
+                {
+                    frontier.push_back(child);
+                    std::push_heap(frontier.begin(), frontier.end(), after);
+                }
+            }
+        }
+
         /** \brief Sort an array of elements. This does not affect the content of the heap */
         void sort(std::vector<_T> &list)
         {
@@ -242,9 +269,9 @@ namespace ompl
         std::vector<Element *> vector_;
 
         EventAfterInsert eventAfterInsert_;
-        void *eventAfterInsertData_;
+        void *eventAfterInsertData_{nullptr};
         EventBeforeRemove eventBeforeRemove_;
-        void *eventBeforeRemoveData_;
+        void *eventBeforeRemoveData_{nullptr};
 
         void removePos(unsigned int pos)
         {
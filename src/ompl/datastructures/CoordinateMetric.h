@@ -0,0 +1,164 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_DATASTRUCTURES_COORDINATE_METRIC_
+#define OMPL_DATASTRUCTURES_COORDINATE_METRIC_
+
+#include <boost/math/constants/constants.hpp>
+#include <cmath>
+#include <vector>
+
+namespace ompl
+{
+    /** \brief A distance function on flat arrays of coordinates.
+
+        The coordinates are split into consecutive segments, and the distance
+        is the weighted sum of the distances within the segments. A segment
+        is either a Euclidean space, an angle (the distance wraps around at
+        2 pi, as for base::SO2StateSpace), or a unit quaternion (the distance
+        is the arc length, as for base::SO3StateSpace). This is enough to
+        describe the distance of the common state spaces in a form that
+        nearest neighbor datastructures can evaluate without calling back
+        into the state space. */
+    class CoordinateMetric
+    {
+    public:
+        /** \brief The kinds of segments */
+        enum SegmentType
+        {
+            EUCLIDEAN,
+            ANGLE,
+            QUATERNION
+        };
+
+        /** \brief A segment of the coordinates */
+        struct Segment
+        {
+            SegmentType type;
+            unsigned int dimension;
+            double weight;
+        };
+
+        /** \brief Append a Euclidean segment of dimension \e dimension */
+        void addEuclidean(unsigned int dimension, double weight = 1.0)
+        {
+            if (dimension > 0)
+                addSegment(EUCLIDEAN, dimension, weight);
+        }
+
+        /** \brief Append a segment that holds one angle in [-pi, pi] */
+        void addAngle(double weight = 1.0)
+        {
+            addSegment(ANGLE, 1, weight);
+        }
+
+        /** \brief Append a segment that holds a unit quaternion (x, y, z, w) */
+        void addQuaternion(double weight = 1.0)
+        {
+            addSegment(QUATERNION, 4, weight);
+        }
+
+        /** \brief Remove all segments */
+        void clear()
+        {
+            segments_.clear();
+            dimension_ = 0;
+        }
+
+        /** \brief Get the total number of coordinates */
+        unsigned int getDimension() const
+        {
+            return dimension_;
+        }
+
+        /** \brief Get the segments */
+        const std::vector<Segment> &getSegments() const
+        {
+            return segments_;
+        }
+
+        /** \brief Compute the distance between the coordinates \e a and \e b */
+        double distance(const double *a, const double *b) const
+        {
+            double dist = 0.0;
+            for (const auto &segment : segments_)
+            {
+                double d;
+                switch (segment.type)
+                {
+                    case EUCLIDEAN:
+                    {
+                        double sq = 0.0;
+                        for (unsigned int i = 0; i < segment.dimension; ++i)
+                        {
+                            double diff = a[i] - b[i];
+                            sq += diff * diff;
+                        }
+                        d = std::sqrt(sq);
+                        break;
+                    }
+                    case ANGLE:
+                    {
+                        d = std::fabs(a[0] - b[0]);
+                        if (d > boost::math::constants::pi<double>())
+                            d = 2.0 * boost::math::constants::pi<double>() - d;
+                        break;
+                    }
+                    default:
+                    {
+                        double dq = std::fabs(a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3]);
+                        d = dq > 1.0 - 1e-9 ? 0.0 : std::acos(dq);
+                        break;
+                    }
+                }
+                dist += segment.weight * d;
+                a += segment.dimension;
+                b += segment.dimension;
+            }
+            return dist;
+        }
+
+    private:
+        void addSegment(SegmentType type, unsigned int dimension, double weight)
+        {
+            segments_.push_back(Segment{type, dimension, weight});
+            dimension_ += dimension;
+        }
+
+        std::vector<Segment> segments_;
+        unsigned int dimension_{0};
+    };
+}
+
+#endif
@@ -153,10 +153,8 @@ namespace ompl
         /// Update all cells and reconstruct the heaps
         void updateAll()
         {
-            std::vector<Cell *> cells;
-            this->getCells(cells);
-            for (int i = cells.size() - 1; i >= 0; --i)
-                eventCellUpdate_(cells[i], eventCellUpdateData_);
+            for (const auto &it : *this)
+                eventCellUpdate_(static_cast<Cell *>(it.second), eventCellUpdateData_);
             external_.rebuild();
             internal_.rebuild();
         }
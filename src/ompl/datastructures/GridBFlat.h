@@ -0,0 +1,793 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_DATASTRUCTURES_GRID_B_FLAT_
+#define OMPL_DATASTRUCTURES_GRID_B_FLAT_
+
+#include "ompl/datastructures/BinaryHeap.h"
+#include <Eigen/Core>
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ompl
+{
+    /** \brief A grid that keeps track of its boundary, like GridB, but stores its cells in a flat hash table
+        indexed by integer keys.
+
+        For grids of up to 4 dimensions, the coordinates of a cell are packed into a 64-bit key (64 / dimension
+        bits per coordinate), so lookups compare keys only and the neighbors of a cell are found by adjusting one
+        field of its key, without building coordinate vectors. Coordinates that do not fit in their field, and grids
+        of more than 4 dimensions, use a hash of the coordinates as key and compare the coordinates on lookup. The
+        hash table uses open addressing with linear probing, and cells are allocated from a pool that reuses the
+        cells released by destroyCell(). */
+    template <typename _T, class LessThanExternal = std::less<_T>, class LessThanInternal = LessThanExternal>
+    class GridBFlat
+    {
+    public:
+        /// Definition of a coordinate within this grid
+        using Coord = Eigen::VectorXi;
+
+        /// Definition of a cell in this grid
+        struct Cell
+        {
+            /// The data we store in the cell
+            _T data;
+
+            /// The coordinate of the cell
+            Coord coord;
+
+            /// The number of neighbors
+            unsigned int neighbors{0};
+
+            /// A flag indicating whether this cell is on the border or not
+            bool border{true};
+
+            /// \cond IGNORE
+            // the key of the cell in the hash table, whether the key identifies the coordinate uniquely, and
+            // the element of the cell in the heap of internal or external cells
+            std::uint64_t key{0};
+            bool exact{false};
+            void *heapElement{nullptr};
+            /// \endcond
+        };
+
+        /// The datatype for arrays of cells
+        using CellArray = std::vector<Cell *>;
+
+        /// Event to be called when a cell's priority is to be updated
+        using EventCellUpdate = void (*)(Cell *, void *);
+
+        /// An entry of the hash table: the key of a cell and the cell (nullptr for empty entries)
+        using Entry = std::pair<std::uint64_t, Cell *>;
+
+        /// Iterator over the entries of the hash table that hold a cell. As for Grid, the cell is \e second.
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Entry;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Entry *;
+            using reference = const Entry &;
+
+            iterator(const Entry *pos, const Entry *end) : pos_(pos), end_(end)
+            {
+                skip();
+            }
+
+            reference operator*() const
+            {
+                return *pos_;
+            }
+
+            pointer operator->() const
+            {
+                return pos_;
+            }
+
+            iterator &operator++()
+            {
+                ++pos_;
+                skip();
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator it = *this;
+                ++*this;
+                return it;
+            }
+
+            bool operator==(const iterator &other) const
+            {
+                return pos_ == other.pos_;
+            }
+
+            bool operator!=(const iterator &other) const
+            {
+                return pos_ != other.pos_;
+            }
+
+        private:
+            void skip()
+            {
+                while (pos_ != end_ && pos_->second == nullptr)
+                    ++pos_;
+            }
+
+            const Entry *pos_;
+            const Entry *end_;
+        };
+
+        /// The constructor takes the dimension of the grid as argument
+        explicit GridBFlat(unsigned int dimension)
+        {
+            eventCellUpdate_ = &noCellUpdate;
+            eventCellUpdateData_ = nullptr;
+            internal_.onAfterInsert(&setHeapElementI, nullptr);
+            external_.onAfterInsert(&setHeapElementE, nullptr);
+            setDimension(dimension);
+        }
+
+        ~GridBFlat()
+        {
+            clear();
+        }
+
+        GridBFlat(const GridBFlat &) = delete;
+        GridBFlat &operator=(const GridBFlat &) = delete;
+
+        /// Return the dimension of the grid
+        unsigned int getDimension() const
+        {
+            return dimension_;
+        }
+
+        /// Update the dimension of the grid; this should not be done
+        /// unless the grid is empty
+        void setDimension(unsigned int dimension)
+        {
+            assert(empty());
+            dimension_ = dimension;
+            if (!overrideCellNeighborsLimit_)
+                interiorCellNeighborsLimit_ = 2 * dimension_;
+
+            packed_ = dimension_ > 0 && dimension_ <= 4;
+            exact_ = packed_;
+            fieldBits_ = packed_ ? 64 / dimension_ : 0;
+            fieldMask_ = fieldBits_ >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << fieldBits_) - 1;
+            if (!packed_ || fieldBits_ >= 32)
+            {
+                lowCoord_ = INT_MIN;
+                highCoord_ = INT_MAX;
+            }
+            else
+            {
+                lowCoord_ = -(std::int64_t(1) << (fieldBits_ - 1));
+                highCoord_ = (std::int64_t(1) << (fieldBits_ - 1)) - 1;
+            }
+        }
+
+        /// If bounds for the grid need to be considered, we can set them here (see GridN::setBounds())
+        void setBounds(const Coord &low, const Coord &up)
+        {
+            lowBound_ = low;
+            upBound_ = up;
+            hasBounds_ = true;
+        }
+
+        /// Set the limit of neighboring cells to determine when a cell becomes interior
+        /// by default, this is 2 * dimension of grid
+        void setInteriorCellNeighborLimit(unsigned int count)
+        {
+            interiorCellNeighborsLimit_ = count;
+            assert(interiorCellNeighborsLimit_ > 0);
+            overrideCellNeighborsLimit_ = true;
+        }
+
+        /// Set the function callback and to be called when a cell's
+        /// priority is updated
+        void onCellUpdate(EventCellUpdate event, void *arg)
+        {
+            eventCellUpdate_ = event;
+            eventCellUpdateData_ = arg;
+        }
+
+        /// Check if a cell exists at the specified coordinate
+        bool has(const Coord &coord) const
+        {
+            return getCell(coord) != nullptr;
+        }
+
+        /// Get the cell at a specified coordinate
+        Cell *getCell(const Coord &coord) const
+        {
+            bool exact;
+            std::uint64_t key = computeKey(coord, exact);
+            return find(key, exact_ && exact ? nullptr : &coord);
+        }
+
+        /// Get the list of neighbors for a given cell
+        void neighbors(const Cell *cell, CellArray &list) const
+        {
+            neighbors(cell->coord, cell->key, cell->exact, list);
+        }
+
+        /// Get the list of neighbors for a given coordinate
+        void neighbors(const Coord &coord, CellArray &list) const
+        {
+            bool exact;
+            std::uint64_t key = computeKey(coord, exact);
+            neighbors(coord, key, exact, list);
+        }
+
+        /// Instantiate a new cell at given coordinates; optionally
+        /// return the list of future neighbors.
+        /// Note: this call only creates the cell, but does not add it to the grid.
+        /// It however updates the neighbor count for neighboring cells
+        Cell *createCell(const Coord &coord, CellArray *nbh = nullptr)
+        {
+            Cell *cell = allocCell();
+            cell->coord = coord;
+            cell->key = computeKey(cell->coord, cell->exact);
+
+            CellArray &list = nbh ? *nbh : scratch_;
+            if (!nbh)
+                list.clear();
+            const std::size_t first = list.size();
+            neighbors(cell->coord, cell->key, cell->exact, list);
+
+            for (std::size_t i = first; i < list.size(); ++i)
+            {
+                Cell *c = list[i];
+                bool wasBorder = c->border;
+                c->neighbors++;
+                if (c->border && c->neighbors >= interiorCellNeighborsLimit_)
+                    c->border = false;
+
+                eventCellUpdate_(c, eventCellUpdateData_);
+
+                if (c->border)
+                    external_.update(reinterpret_cast<typename externalBHeap::Element *>(c->heapElement));
+                else
+                {
+                    if (wasBorder)
+                    {
+                        external_.remove(reinterpret_cast<typename externalBHeap::Element *>(c->heapElement));
+                        internal_.insert(c);
+                    }
+                    else
+                        internal_.update(reinterpret_cast<typename internalBHeap::Element *>(c->heapElement));
+                }
+            }
+
+            cell->neighbors = numberOfBoundaryDimensions(cell->coord) + (list.size() - first);
+            if (cell->border && cell->neighbors >= interiorCellNeighborsLimit_)
+                cell->border = false;
+
+            return cell;
+        }
+
+        /// Add an instantiated cell to the grid
+        void add(Cell *cell)
+        {
+            eventCellUpdate_(cell, eventCellUpdateData_);
+
+            insert(cell);
+            if (!cell->exact)
+                exact_ = false;
+
+            if (cell->border)
+                external_.insert(cell);
+            else
+                internal_.insert(cell);
+        }
+
+        /// Remove a cell from the grid
+        bool remove(Cell *cell)
+        {
+            if (cell)
+            {
+                scratch_.clear();
+                neighbors(cell->coord, cell->key, cell->exact, scratch_);
+
+                for (auto &c : scratch_)
+                {
+                    bool wasBorder = c->border;
+                    c->neighbors--;
+                    if (!c->border && c->neighbors < interiorCellNeighborsLimit_)
+                        c->border = true;
+
+                    eventCellUpdate_(c, eventCellUpdateData_);
+
+                    if (c->border)
+                    {
+                        if (wasBorder)
+                            external_.update(reinterpret_cast<typename externalBHeap::Element *>(c->heapElement));
+                        else
+                        {
+                            internal_.remove(reinterpret_cast<typename internalBHeap::Element *>(c->heapElement));
+                            external_.insert(c);
+                        }
+                    }
+                    else
+                        internal_.update(reinterpret_cast<typename internalBHeap::Element *>(c->heapElement));
+                }
+
+                if (erase(cell))
+                {
+                    if (cell->border)
+                        external_.remove(reinterpret_cast<typename externalBHeap::Element *>(cell->heapElement));
+                    else
+                        internal_.remove(reinterpret_cast<typename internalBHeap::Element *>(cell->heapElement));
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// Return the memory of a cell to the pool; do not call this function unless remove() was called first
+        void destroyCell(Cell *cell)
+        {
+            cell->data = _T();
+            freeCells_.push_back(cell);
+        }
+
+        /// Return the cell that is at the top of the heap maintaining internal cells
+        Cell *topInternal() const
+        {
+            auto *top = static_cast<Cell *>(internal_.top()->data);
+            return top ? top : topExternal();
+        }
+
+        /// Return the cell that is at the top of the heap maintaining external cells
+        Cell *topExternal() const
+        {
+            auto *top = static_cast<Cell *>(external_.top()->data);
+            return top ? top : topInternal();
+        }
+
+        /// Return the number of internal cells
+        unsigned int countInternal() const
+        {
+            return internal_.size();
+        }
+
+        /// Return the number of external cells
+        unsigned int countExternal() const
+        {
+            return external_.size();
+        }
+
+        /// Return the fraction of external cells
+        double fracExternal() const
+        {
+            return external_.empty() ? 0.0 : (double)(external_.size()) / (double)(external_.size() + internal_.size());
+        }
+
+        /// Return the fraction of internal cells
+        double fracInternal() const
+        {
+            return 1.0 - fracExternal();
+        }
+
+        /// Update the position in the heaps for a particular cell.
+        void update(Cell *cell)
+        {
+            eventCellUpdate_(cell, eventCellUpdateData_);
+            if (cell->border)
+                external_.update(reinterpret_cast<typename externalBHeap::Element *>(cell->heapElement));
+            else
+                internal_.update(reinterpret_cast<typename internalBHeap::Element *>(cell->heapElement));
+        }
+
+        /// Update all cells and reconstruct the heaps
+        void updateAll()
+        {
+            for (const auto &it : *this)
+                eventCellUpdate_(it.second, eventCellUpdateData_);
+            external_.rebuild();
+            internal_.rebuild();
+        }
+
+        /// Get the data stored in the cells we are aware of
+        void getContent(std::vector<_T> &content) const
+        {
+            for (const auto &it : *this)
+                content.push_back(it.second->data);
+        }
+
+        /// Get the set of instantiated cells in the grid
+        void getCells(CellArray &cells) const
+        {
+            for (const auto &it : *this)
+                cells.push_back(it.second);
+        }
+
+        /// Check if the grid is empty
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        /// Check the size of the grid
+        unsigned int size() const
+        {
+            return size_;
+        }
+
+        /// Remove all cells from the grid and release the memory of the cell pool
+        void clear()
+        {
+            table_.clear();
+            mask_ = 0;
+            size_ = 0;
+            internal_.clear();
+            external_.clear();
+            freeCells_.clear();
+            blocks_.clear();
+            blockUsed_ = 0;
+            exact_ = packed_;
+        }
+
+        /// Print information about the data in this grid structure
+        void status(std::ostream &out = std::cout) const
+        {
+            out << size() << " total cells " << std::endl;
+            out << countInternal() << " internal cells" << std::endl;
+            out << countExternal() << " external cells" << std::endl;
+        }
+
+        /// Return the begin() iterator for the grid
+        iterator begin() const
+        {
+            return iterator(table_.data(), table_.data() + table_.size());
+        }
+
+        /// Return the end() iterator for the grid
+        iterator end() const
+        {
+            return iterator(table_.data() + table_.size(), table_.data() + table_.size());
+        }
+
+    protected:
+        /// Compute the key of a coordinate. \e exact is set to true if the key identifies the coordinate uniquely,
+        /// i.e., if the grid packs coordinates and every coordinate fits in its field.
+        std::uint64_t computeKey(const Coord &coord, bool &exact) const
+        {
+            std::uint64_t key = 0;
+            if (packed_)
+            {
+                exact = true;
+                for (unsigned int i = 0; i < dimension_; ++i)
+                {
+                    if (coord[i] < lowCoord_ || coord[i] > highCoord_)
+                        exact = false;
+                    key |= (static_cast<std::uint64_t>(static_cast<std::int64_t>(coord[i])) & fieldMask_)
+                           << (i * fieldBits_);
+                }
+            }
+            else
+            {
+                exact = false;
+                for (unsigned int i = 0; i < dimension_; ++i)
+                    key = (key ^ static_cast<std::uint32_t>(coord[i])) * 0x100000001b3ULL;
+            }
+            return key;
+        }
+
+        /// Get the list of neighbors of the coordinate \e coord, whose key is \e key
+        void neighbors(const Coord &coord, std::uint64_t key, bool exact, CellArray &list) const
+        {
+            list.reserve(list.size() + 2 * dimension_);
+
+            if (exact_ && exact)
+            {
+                // every cell in the grid has an exact key, so a neighbor that exists has a coordinate that fits in
+                // its field, and its key is that of coord with one field incremented or decremented
+                for (int i = dimension_ - 1; i >= 0; --i)
+                {
+                    const unsigned int shift = i * fieldBits_;
+                    const std::uint64_t field = (key >> shift) & fieldMask_;
+                    const std::uint64_t rest = key & ~(fieldMask_ << shift);
+                    if (coord[i] > lowCoord_)
+                        if (Cell *cell = find(rest | (((field - 1) & fieldMask_) << shift), nullptr))
+                            list.push_back(cell);
+                    if (coord[i] < highCoord_)
+                        if (Cell *cell = find(rest | (((field + 1) & fieldMask_) << shift), nullptr))
+                            list.push_back(cell);
+                }
+            }
+            else
+            {
+                Coord test = coord;
+                for (int i = dimension_ - 1; i >= 0; --i)
+                {
+                    for (int delta : {-1, 2})
+                    {
+                        test[i] += delta;
+                        bool testExact;
+                        std::uint64_t testKey = computeKey(test, testExact);
+                        if (Cell *cell = find(testKey, exact_ && testExact ? nullptr : &test))
+                            list.push_back(cell);
+                    }
+                    test[i]--;
+                }
+            }
+        }
+
+        /// Compute how many sides of a coordinate touch the boundaries of the grid
+        unsigned int numberOfBoundaryDimensions(const Coord &coord) const
+        {
+            unsigned int result = 0;
+            if (hasBounds_)
+            {
+                for (unsigned int i = 0; i < dimension_; ++i)
+                    if (coord[i] == lowBound_[i] || coord[i] == upBound_[i])
+                        result++;
+            }
+            return result;
+        }
+
+        /// The position in the hash table at which the search for \e key starts
+        std::size_t home(std::uint64_t key) const
+        {
+            // mix the bits of the key, since packed keys differ mostly in their low bits
+            key ^= key >> 33;
+            key *= 0xff51afd7ed558ccdULL;
+            key ^= key >> 33;
+            key *= 0xc4ceb9fe1a85ec53ULL;
+            key ^= key >> 33;
+            return static_cast<std::size_t>(key) & mask_;
+        }
+
+        /// Find the cell with key \e key. If \e coord is not nullptr, the coordinate of the cell is compared too.
+        Cell *find(std::uint64_t key, const Coord *coord) const
+        {
+            if (table_.empty())
+                return nullptr;
+            for (std::size_t i = home(key);; i = (i + 1) & mask_)
+            {
+                const Entry &entry = table_[i];
+                if (entry.second == nullptr)
+                    return nullptr;
+                if (entry.first == key && (coord == nullptr || entry.second->coord == *coord))
+                    return entry.second;
+            }
+        }
+
+        /// Insert a cell in the hash table, growing the table to keep it at most half full
+        void insert(Cell *cell)
+        {
+            if (2 * (size_ + 1) > table_.size())
+            {
+                std::vector<Entry> old(std::max<std::size_t>(16, 2 * table_.size()), Entry(0, nullptr));
+                old.swap(table_);
+                mask_ = table_.size() - 1;
+                for (const auto &entry : old)
+                    if (entry.second)
+                        place(entry);
+            }
+            place(Entry(cell->key, cell));
+            ++size_;
+        }
+
+        /// Store an entry in the first free position of its probe sequence
+        void place(const Entry &entry)
+        {
+            std::size_t i = home(entry.first);
+            while (table_[i].second)
+                i = (i + 1) & mask_;
+            table_[i] = entry;
+        }
+
+        /// Remove a cell from the hash table, shifting back the entries that follow it so no tombstones are needed
+        bool erase(const Cell *cell)
+        {
+            if (table_.empty())
+                return false;
+            std::size_t i = home(cell->key);
+            while (table_[i].second != cell)
+            {
+                if (table_[i].second == nullptr)
+                    return false;
+                i = (i + 1) & mask_;
+            }
+            for (std::size_t j = (i + 1) & mask_; table_[j].second; j = (j + 1) & mask_)
+            {
+                // an entry can fill the hole at i only if its probe sequence starts at or before i
+                const std::size_t k = home(table_[j].first);
+                if (((j - k) & mask_) >= ((j - i) & mask_))
+                {
+                    table_[i] = table_[j];
+                    i = j;
+                }
+            }
+            table_[i] = Entry(0, nullptr);
+            --size_;
+            return true;
+        }
+
+        /// Take a cell from the pool
+        Cell *allocCell()
+        {
+            if (!freeCells_.empty())
+            {
+                Cell *cell = freeCells_.back();
+                freeCells_.pop_back();
+                cell->neighbors = 0;
+                cell->border = true;
+                cell->heapElement = nullptr;
+                return cell;
+            }
+            if (blocks_.empty() || blockUsed_ == blockSize_)
+            {
+                blockSize_ = blocks_.empty() ? 16 : std::min<std::size_t>(2 * blockSize_, 1024);
+                blocks_.emplace_back(new Cell[blockSize_]);
+                blockUsed_ = 0;
+            }
+            return &blocks_.back()[blockUsed_++];
+        }
+
+        /// Default no-op update routine for a cell
+        static void noCellUpdate(Cell * /*unused*/, void * /*unused*/)
+        {
+        }
+
+        /// Define order for internal cells
+        struct LessThanInternalCell
+        {
+            bool operator()(const Cell *const a, const Cell *const b) const
+            {
+                return lt_(a->data, b->data);
+            }
+
+        private:
+            LessThanInternal lt_;
+        };
+
+        /// Define order for external cells
+        struct LessThanExternalCell
+        {
+            bool operator()(const Cell *const a, const Cell *const b) const
+            {
+                return lt_(a->data, b->data);
+            }
+
+        private:
+            LessThanExternal lt_;
+        };
+
+        /// Datatype for a heap of cells containing interior cells
+        using internalBHeap = BinaryHeap<Cell *, LessThanInternalCell>;
+
+        /// Datatype for a heap of cells containing exterior cells
+        using externalBHeap = BinaryHeap<Cell *, LessThanExternalCell>;
+
+        /// Routine used internally for keeping track of binary heap elements for internal cells
+        static void setHeapElementI(typename internalBHeap::Element *element, void * /*unused*/)
+        {
+            element->data->heapElement = reinterpret_cast<void *>(element);
+        }
+
+        /// Routine used internally for keeping track of binary heap elements for external cells
+        static void setHeapElementE(typename externalBHeap::Element *element, void * /*unused*/)
+        {
+            element->data->heapElement = reinterpret_cast<void *>(element);
+        }
+
+        /// The dimension of the grid
+        unsigned int dimension_{0};
+
+        /// Flag indicating whether coordinates are packed into keys (grids of up to 4 dimensions)
+        bool packed_{false};
+
+        /// Flag indicating whether every cell in the grid has an exact key
+        bool exact_{false};
+
+        /// The number of bits of a key used for each coordinate
+        unsigned int fieldBits_{0};
+
+        /// The mask of the bits of a key used for a coordinate
+        std::uint64_t fieldMask_{0};
+
+        /// The smallest coordinate that fits in a field
+        std::int64_t lowCoord_{0};
+
+        /// The largest coordinate that fits in a field
+        std::int64_t highCoord_{0};
+
+        /// The hash table holding the cells; its size is a power of two
+        std::vector<Entry> table_;
+
+        /// The size of the hash table minus one
+        std::size_t mask_{0};
+
+        /// The number of cells in the hash table
+        std::size_t size_{0};
+
+        /// The blocks of memory cells are allocated from
+        std::vector<std::unique_ptr<Cell[]>> blocks_;
+
+        /// The size of the last block
+        std::size_t blockSize_{0};
+
+        /// The number of cells taken from the last block
+        std::size_t blockUsed_{0};
+
+        /// Cells released by destroyCell(), to be reused
+        CellArray freeCells_;
+
+        /// Scratch list of neighbors for createCell() and remove()
+        CellArray scratch_;
+
+        /// Flag indicating whether bounds are in effect for this grid
+        bool hasBounds_{false};
+
+        /// If bounds are set, this defines the lower corner cell
+        Coord lowBound_;
+
+        /// If bounds are set, this defines the upper corner cell
+        Coord upBound_;
+
+        /// The number of neighbors for a cell to be considered interior
+        unsigned int interiorCellNeighborsLimit_{0};
+
+        /// Flag indicating whether the neighbor count limit was set by the user
+        bool overrideCellNeighborsLimit_{false};
+
+        /// Pointer to function to be called when a cell needs to be updated
+        EventCellUpdate eventCellUpdate_;
+
+        /// Data to be passed to function pointer above
+        void *eventCellUpdateData_;
+
+        /// The heap of interior cells
+        internalBHeap internal_;
+
+        /// The heap of external cells
+        externalBHeap external_;
+    };
+}
+
+#endif
@@ -0,0 +1,193 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_DATASTRUCTURES_INCREMENTAL_SHORTEST_PATH_
+#define OMPL_DATASTRUCTURES_INCREMENTAL_SHORTEST_PATH_
+
+#include "ompl/datastructures/LPAstarOnGraph.h"
+
+#include <boost/graph/adjacency_list.hpp>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace ompl
+{
+    /** \brief Shortest path from a fixed source vertex to the closest of a fixed set of target vertices, on a
+        directed graph with nonnegative edge weights that change over time.
+
+        Weight changes are only recorded by setEdgeWeight(). The next call to computeShortestPath() repairs the
+        previous shortest path with LPAstarOnGraph, which only revisits the vertices whose distance from the
+        source is affected by the changes. If more than a quarter of the edges changed, or if the repaired search
+        does not reach a target, the search is restarted instead. Several targets are handled by connecting them
+        to an extra sink vertex with edges of weight 0. */
+    class IncrementalShortestPath
+    {
+    public:
+        /** \brief Create a graph with vertices 0 to \e numVertices - 1 and no edges. Paths start at \e source and
+            end at one of \e targets. */
+        IncrementalShortestPath(std::size_t numVertices, std::size_t source, const std::vector<std::size_t> &targets)
+          : graph_(numVertices), source_(source), target_(numVertices), hasTargets_(!targets.empty())
+          , hasSink_(targets.size() > 1)
+        {
+            if (hasSink_)
+            {
+                boost::add_vertex(graph_);
+                for (std::size_t t : targets)
+                    boost::add_edge(t, target_, WeightProperty(0.), graph_);
+            }
+            else if (hasTargets_)
+                target_ = targets.front();
+        }
+
+        // non-copyable
+        IncrementalShortestPath(const IncrementalShortestPath &) = delete;
+        IncrementalShortestPath &operator=(const IncrementalShortestPath &) = delete;
+
+        /** \brief Add an edge from \e u to \e v and return its index, to use with setEdgeWeight(). */
+        std::size_t addEdge(std::size_t u, std::size_t v, double weight)
+        {
+            edges_.push_back(boost::add_edge(u, v, WeightProperty(weight), graph_).first);
+            previous_.push_back(std::numeric_limits<double>::quiet_NaN());
+            return edges_.size() - 1;
+        }
+
+        /** \brief Get the current weight of the edge with index \e edge */
+        double getEdgeWeight(std::size_t edge) const
+        {
+            return boost::get(boost::edge_weight, graph_, edges_[edge]);
+        }
+
+        /** \brief Change the weight of the edge with index \e edge. The shortest path is repaired by the next call
+            to computeShortestPath(). */
+        void setEdgeWeight(std::size_t edge, double weight)
+        {
+            const double current = getEdgeWeight(edge);
+            if (current == weight)
+                return;
+
+            // remember the weight the search knows about
+            if (std::isnan(previous_[edge]))
+            {
+                previous_[edge] = current;
+                changed_.push_back(edge);
+            }
+            boost::put(boost::edge_weight, graph_, edges_[edge], weight);
+        }
+
+        /** \brief Compute the shortest path from the source to the closest target. The vertices of the path, from
+            the source to the target, are stored in \e path, which is empty if no target can be reached. Return the
+            cost of the path. */
+        double computeShortestPath(std::vector<std::size_t> &path)
+        {
+            path.clear();
+            if (!hasTargets_)
+                return std::numeric_limits<double>::infinity();
+            if (!hasSink_ && target_ == source_)
+            {
+                path.push_back(source_);
+                return 0.;
+            }
+
+            const bool repair = search_ && 4 * changed_.size() <= edges_.size();
+            if (repair)
+                for (std::size_t edge : changed_)
+                    search_->updateEdge(boost::source(edges_[edge], graph_), boost::target(edges_[edge], graph_),
+                                        previous_[edge], getEdgeWeight(edge));
+            else
+                search_.reset(new Search(source_, target_, graph_, heuristic_));
+
+            for (std::size_t edge : changed_)
+                previous_[edge] = std::numeric_limits<double>::quiet_NaN();
+            changed_.clear();
+
+            std::list<std::size_t> vertices;
+            double cost = search_->computeShortestPath(vertices);
+
+            // LPA* only repairs correctly if edge weights are positive; weights that are negligible next to the
+            // cost of the path can leave it without a path to the source. A new search does not have that problem.
+            if (repair && vertices.empty())
+            {
+                search_.reset(new Search(source_, target_, graph_, heuristic_));
+                cost = search_->computeShortestPath(vertices);
+            }
+            for (std::size_t v : vertices)
+                if (!hasSink_ || v != target_)
+                    path.push_back(v);
+            return cost;
+        }
+
+    private:
+        using WeightProperty = boost::property<boost::edge_weight_t, double>;
+        using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::bidirectionalS, boost::no_property,
+                                            WeightProperty>;
+        using EdgeDescriptor = boost::graph_traits<Graph>::edge_descriptor;
+
+        /** \brief Paths are not guided by a heuristic, so they are exact shortest paths. */
+        struct ZeroHeuristic
+        {
+            double operator()(std::size_t /*v*/) const
+            {
+                return 0.;
+            }
+        };
+
+        using Search = LPAstarOnGraph<Graph, ZeroHeuristic>;
+
+        Graph graph_;
+        std::size_t source_;
+
+        /** \brief The target of the search: the only target, or the sink joining the targets */
+        std::size_t target_;
+        bool hasTargets_;
+        bool hasSink_;
+
+        /** \brief The edges added by addEdge(), by index */
+        std::vector<EdgeDescriptor> edges_;
+
+        /** \brief For each edge changed since the last search, the weight the search knows about (NaN otherwise) */
+        std::vector<double> previous_;
+
+        /** \brief The edges changed since the last search */
+        std::vector<std::size_t> changed_;
+
+        ZeroHeuristic heuristic_;
+        std::unique_ptr<Search> search_;
+    };
+}
+
+#endif
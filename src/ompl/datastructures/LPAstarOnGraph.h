@@ -113,14 +113,26 @@ namespace ompl
 
             updateVertex(n_v);
         }
+        /// the weight of edge (u,v) in the graph was changed from \e previous to \e current
+        void updateEdge(std::size_t u, std::size_t v, double previous, double current)
+        {
+            if (v == source_->getId() || previous == current)
+                return;
+
+            if (current < previous)
+                insertEdge(u, v, current);
+            else
+                removeEdge(u, v);
+        }
         double computeShortestPath(std::list<std::size_t> &path)
         {
             WeightMap weights = boost::get(boost::edge_weight_t(), graph_);
 
-            if (queue_.empty())
-                return std::numeric_limits<double>::infinity();
-
-            while (topHead()->key() < target_->calculateKey() || target_->rhs() != target_->costToCome())
+            // the queue is empty when nothing changed since the last call; the path is still valid.
+            // nodes whose key ties with the target's are processed too, which keeps the result
+            // exact in the presence of edges of weight 0
+            while (!queue_.empty() &&
+                   (!(target_->currentKey() < topHead()->key()) || target_->rhs() != target_->costToCome()))
             {
                 // pop from queue and process
                 Node *u = topHead();
@@ -165,9 +177,6 @@ namespace ompl
                         updateVertex(n_v);
                     }
                 }
-
-                if (queue_.empty())
-                    break;
             }
 
             // now get path
@@ -176,6 +185,14 @@ namespace ompl
             {
                 path.push_front(res->getId());
                 res = res->getParent();
+
+                // edge weights that are 0 (or negligible next to the cost to come) can leave a cycle of parents
+                // after a repair; report that no path was found rather than following it forever
+                if (path.size() > idNodeMap_.size())
+                {
+                    path.clear();
+                    return std::numeric_limits<double>::infinity();
+                }
             }
 
             return target_->costToCome();
@@ -230,9 +247,14 @@ namespace ompl
             }
             Key calculateKey()
             {
-                k = Key(std::min(g, r + h), std::min(g, r));
+                k = currentKey();
                 return k;
             }
+            // key for the current costs, without changing the key used to order the queue
+            Key currentKey() const
+            {
+                return Key(std::min(g, r + h), std::min(g, r));
+            }
             // cost modifiers
             double setCostToCome(double val)
             {
@@ -342,7 +364,15 @@ namespace ompl
             if (node->isInQueue())
             {
                 node->inQueue(false);
-                queue_.erase(node);
+
+                // other nodes may have the same key; erase only this one
+                auto range = queue_.equal_range(node);
+                for (auto it = range.first; it != range.second; ++it)
+                    if (*it == node)
+                    {
+                        queue_.erase(it);
+                        break;
+                    }
             }
         }
         void updateQueue(Node *node)
@@ -37,8 +37,12 @@
 #ifndef OMPL_DATASTRUCTURES_NEAREST_NEIGHBORS_
 #define OMPL_DATASTRUCTURES_NEAREST_NEIGHBORS_
 
-#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <functional>
+#include <thread>
+#include <vector>
 
 namespace ompl
 {
@@ -103,6 +107,43 @@ namespace ompl
          */
         virtual void nearestR(const _T &data, double radius, std::vector<_T> &nbh) const = 0;
 
+        /** \brief Get the k-nearest neighbors of each of the points in \e data; \e nbh[i] receives the
+            neighbors of \e data[i], as reported by nearestK().
+
+            The default implementation calls nearestK() for each point. Structures that can answer queries
+            concurrently spread the points over getBatchThreads() threads. */
+        virtual void nearestKBatch(const std::vector<_T> &data, std::size_t k, std::vector<std::vector<_T>> &nbh) const
+        {
+            nbh.resize(data.size());
+            for (std::size_t i = 0; i < data.size(); ++i)
+                nearestK(data[i], k, nbh[i]);
+        }
+
+        /** \brief Get the neighbors within \e radius of each of the points in \e data; \e nbh[i] receives the
+            neighbors of \e data[i], as reported by nearestR().
+
+            The default implementation calls nearestR() for each point. Structures that can answer queries
+            concurrently spread the points over getBatchThreads() threads. */
+        virtual void nearestRBatch(const std::vector<_T> &data, double radius, std::vector<std::vector<_T>> &nbh) const
+        {
+            nbh.resize(data.size());
+            for (std::size_t i = 0; i < data.size(); ++i)
+                nearestR(data[i], radius, nbh[i]);
+        }
+
+        /** \brief Set the number of threads nearestKBatch() and nearestRBatch() may use. A value of 0 selects
+            the number of hardware threads. */
+        void setBatchThreads(unsigned int threads)
+        {
+            batchThreads_ = threads > 0 ? threads : std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        /** \brief Get the number of threads nearestKBatch() and nearestRBatch() may use */
+        unsigned int getBatchThreads() const
+        {
+            return batchThreads_;
+        }
+
         /** \brief Get the number of elements in the datastructure */
         virtual std::size_t size() const = 0;
 
@@ -110,8 +151,59 @@ namespace ompl
         virtual void list(std::vector<_T> &data) const = 0;
 
     protected:
+        /** \brief The number of ranges each thread of parallelFor() must get for the thread to be started */
+        static const std::size_t PARALLEL_FOR_MIN_GRAINS = 4;
+
+        /** \brief Call \e f(begin, end) on consecutive ranges that cover [0, \e n), from up to
+            getBatchThreads() threads. Threads take ranges of at least \e grain indices as they become idle,
+            so queries of uneven cost are balanced. Threads are started for each call, so a thread is only
+            started if it gets at least PARALLEL_FOR_MIN_GRAINS ranges of \e grain indices; smaller batches
+            are processed by the calling thread. An exception thrown by \e f is rethrown once all threads
+            have finished. */
+        template <typename F>
+        void parallelFor(std::size_t n, std::size_t grain, const F &f) const
+        {
+            grain = std::max<std::size_t>(grain, 1u);
+            std::size_t threads = std::min<std::size_t>(batchThreads_, n / (PARALLEL_FOR_MIN_GRAINS * grain));
+            if (threads <= 1)
+            {
+                if (n > 0)
+                    f(0, n);
+                return;
+            }
+
+            // hand out ranges of about an eighth of a thread's share, so that idle threads can help the others
+            grain = std::max(grain, n / (8 * threads));
+            std::atomic<std::size_t> next{0};
+            std::vector<std::exception_ptr> errors(threads);
+            std::vector<std::thread> workers;
+            workers.reserve(threads);
+            for (std::size_t t = 0; t < threads; ++t)
+                workers.emplace_back([&, t]
+                                     {
+                                         try
+                                         {
+                                             std::size_t begin;
+                                             while ((begin = next.fetch_add(grain)) < n)
+                                                 f(begin, std::min(n, begin + grain));
+                                         }
+                                         catch (...)
+                                         {
+                                             errors[t] = std::current_exception();
+                                         }
+                                     });
+            for (auto &worker : workers)
+                worker.join();
+            for (const auto &error : errors)
+                if (error)
+                    std::rethrow_exception(error);
+        }
+
         /** \brief The used distance function */
         DistanceFunction distFun_;
+
+        /** \brief The number of threads used by batched queries */
+        unsigned int batchThreads_{1};
     };
 }
 
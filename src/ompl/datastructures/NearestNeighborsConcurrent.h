@@ -0,0 +1,574 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_DATASTRUCTURES_NEAREST_NEIGHBORS_CONCURRENT_
+#define OMPL_DATASTRUCTURES_NEAREST_NEIGHBORS_CONCURRENT_
+
+#include "ompl/datastructures/NearestNeighbors.h"
+#include "ompl/util/Exception.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ompl
+{
+    /** \brief A nearest neighbors datastructure that supports concurrent
+        queries and insertions from many threads without a global lock.
+
+        Elements are appended to a chunked array: a thread inserting an
+        element reserves a slot with an atomic increment and publishes the
+        element with a release store, so insertions never wait for each
+        other or for readers. The published elements are indexed by a set of
+        immutable vantage-point trees with sizes that grow geometrically (a
+        logarithmic method, as in Bentley and Saxe). When enough elements
+        accumulate outside the trees, one of the inserting threads merges them
+        with the smaller trees into a new tree and atomically publishes a new
+        snapshot of the tree set. Queries read the current snapshot, search its
+        trees and scan the few elements that are not indexed yet. Replaced
+        snapshots are reclaimed with a two-epoch scheme: queries register in
+        the current epoch, and the thread that publishes a new snapshot flips
+        the epoch and frees the old snapshot once no query of the previous
+        epoch is running.
+
+        Removal finds the element with a search of radius zero, like a
+        query, and marks it as deleted; removed elements are skipped by
+        queries and dropped when the trees they belong to are merged. The
+        distance function is not evaluated on removed elements, so they may
+        be freed once no concurrent operation can still be using them.
+
+        add(), remove() and all queries may be called concurrently.
+        clear() and setDistanceFunction() must not be called concurrently with
+        any other operation. The distance function must be a metric.
+    */
+    template <typename _T>
+    class NearestNeighborsConcurrent : public NearestNeighbors<_T>
+    {
+    public:
+        /** \brief Constructor. A new tree is built once \e maxUnindexed
+            elements are not part of any tree. */
+        NearestNeighborsConcurrent(std::size_t maxUnindexed = 64)
+          : NearestNeighbors<_T>(), maxUnindexed_(std::max<std::size_t>(maxUnindexed, 1u))
+        {
+            for (auto &chunk : chunks_)
+                chunk.store(nullptr, std::memory_order_relaxed);
+        }
+
+        ~NearestNeighborsConcurrent() override
+        {
+            freeChunks();
+            delete snapshot_.load();
+        }
+
+        bool reportsSortedResults() const override
+        {
+            return true;
+        }
+
+        void clear() override
+        {
+            freeChunks();
+            reserved_.store(0, std::memory_order_relaxed);
+            size_.store(0, std::memory_order_relaxed);
+            indexed_.store(0, std::memory_order_relaxed);
+            delete snapshot_.exchange(new Snapshot());
+        }
+
+        void add(const _T &data) override
+        {
+            const std::size_t index = reserved_.fetch_add(1, std::memory_order_relaxed);
+            Slot &slot = allocSlot(index);
+            slot.data = data;
+            slot.state.store(READY, std::memory_order_release);
+            size_.fetch_add(1, std::memory_order_relaxed);
+
+            if (index + 1 >= indexed_.load(std::memory_order_relaxed) + maxUnindexed_)
+                buildIndex();
+        }
+
+        bool remove(const _T &data) override
+        {
+            // the element is at distance zero from itself, so the trees lead to it
+            Matches matches(data);
+            search(data, matches);
+            for (const Slot *slot : matches.slots)
+            {
+                unsigned char state = READY;
+                if (const_cast<Slot *>(slot)->state.compare_exchange_strong(state, REMOVED,
+                                                                            std::memory_order_acq_rel))
+                {
+                    size_.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        _T nearest(const _T &data) const override
+        {
+            Neighbors nbh(1, std::numeric_limits<double>::infinity());
+            search(data, nbh);
+            if (nbh.empty())
+                throw Exception("No elements found in nearest neighbors data structure");
+            return nbh.top().second;
+        }
+
+        /// Return the k nearest neighbors in sorted order
+        void nearestK(const _T &data, std::size_t k, std::vector<_T> &nbh) const override
+        {
+            nbh.clear();
+            if (k == 0)
+                return;
+            Neighbors result(k, std::numeric_limits<double>::infinity());
+            search(data, result);
+            result.extract(nbh);
+        }
+
+        /// Return the nearest neighbors within distance \c radius in sorted order
+        void nearestR(const _T &data, double radius, std::vector<_T> &nbh) const override
+        {
+            nbh.clear();
+            Neighbors result(std::numeric_limits<std::size_t>::max(), radius);
+            search(data, result);
+            result.extract(nbh);
+        }
+
+        std::size_t size() const override
+        {
+            return size_.load(std::memory_order_relaxed);
+        }
+
+        void list(std::vector<_T> &data) const override
+        {
+            data.clear();
+            data.reserve(size());
+            forEachSlot(0, reserved_.load(std::memory_order_acquire), [&data](Slot &slot)
+                        {
+                            if (slot.state.load(std::memory_order_acquire) == READY)
+                                data.push_back(slot.data);
+                        });
+        }
+
+    protected:
+        /** \brief The possible states of a slot */
+        enum SlotState : unsigned char
+        {
+            EMPTY = 0,
+            READY,
+            REMOVED
+        };
+
+        /** \brief Storage for one element */
+        struct Slot
+        {
+            _T data;
+            std::atomic<unsigned char> state{EMPTY};
+        };
+
+        /** \brief A node of a vantage-point tree, stored in preorder. The
+            elements closer than \e radius to the vantage point follow the node
+            directly; the others start at \e outside. */
+        struct Node
+        {
+            const Slot *slot;
+            double radius;
+            std::size_t outside;
+            std::size_t end;
+        };
+
+        /** \brief An immutable vantage-point tree */
+        using Tree = std::vector<Node>;
+
+        /** \brief The set of trees that index the elements in the slots before \e indexed */
+        struct Snapshot
+        {
+            std::vector<std::shared_ptr<const Tree>> trees;
+            std::size_t indexed{0};
+        };
+
+        /** \brief Order (distance, element) pairs by distance only */
+        struct FartherFirst
+        {
+            bool operator()(const std::pair<double, _T> &a, const std::pair<double, _T> &b) const
+            {
+                return a.first < b.first;
+            }
+        };
+
+        /** \brief A bounded max-heap of (distance, element) pairs */
+        class Neighbors
+          : public std::priority_queue<std::pair<double, _T>, std::vector<std::pair<double, _T>>, FartherFirst>
+        {
+        public:
+            Neighbors(std::size_t k, double radius) : k_(k), radius_(radius)
+            {
+            }
+
+            /** \brief The distance beyond which elements cannot be neighbors */
+            double bound() const
+            {
+                return this->size() < k_ ? radius_ : this->top().first;
+            }
+
+            void consider(double dist, const Slot &slot)
+            {
+                if (dist > radius_)
+                    return;
+                if (this->size() < k_)
+                    this->emplace(dist, slot.data);
+                else if (dist < this->top().first)
+                {
+                    this->pop();
+                    this->emplace(dist, slot.data);
+                }
+            }
+
+            /** \brief Move the elements to \e nbh, sorted by increasing distance */
+            void extract(std::vector<_T> &nbh)
+            {
+                nbh.resize(this->size());
+                for (auto it = nbh.rbegin(); it != nbh.rend(); ++it)
+                {
+                    *it = this->top().second;
+                    this->pop();
+                }
+            }
+
+        private:
+            std::size_t k_;
+            double radius_;
+        };
+
+        /** \brief The result of a search for the slots that hold a given element */
+        class Matches
+        {
+        public:
+            Matches(const _T &data) : data_(data)
+            {
+            }
+
+            /** \brief Only elements at distance zero can be the element searched for */
+            double bound() const
+            {
+                return 0.0;
+            }
+
+            /** \brief Keep the slot if it holds the element searched for. Slots are only considered once they
+                are published, so their data is not being written. */
+            void consider(double dist, const Slot &slot)
+            {
+                if (dist <= 0.0 && slot.data == data_)
+                    slots.push_back(&slot);
+            }
+
+            /** \brief The slots found */
+            std::vector<const Slot *> slots;
+
+        private:
+            const _T &data_;
+        };
+
+        /** \brief The number of slots in the first chunk; chunk i has FIRST_CHUNK_SIZE * 2^i slots */
+        static const std::size_t FIRST_CHUNK_SIZE = 256;
+
+        /** \brief The maximum number of chunks */
+        static const unsigned int MAX_CHUNKS = 40;
+
+        /** \brief Find the chunk that holds slot \e index and the index of the slot in that chunk */
+        static unsigned int locate(std::size_t index, std::size_t &offset)
+        {
+            unsigned int chunk = 0;
+            std::size_t chunkSize = FIRST_CHUNK_SIZE;
+            while (index >= chunkSize)
+            {
+                index -= chunkSize;
+                chunkSize *= 2;
+                ++chunk;
+            }
+            offset = index;
+            return chunk;
+        }
+
+        /** \brief Get the chunk \e chunk, allocating it if needed */
+        Slot *allocChunk(unsigned int chunk)
+        {
+            if (chunk >= MAX_CHUNKS)
+                throw Exception("Too many elements in concurrent nearest neighbors data structure");
+            Slot *slots = chunks_[chunk].load(std::memory_order_acquire);
+            if (slots == nullptr)
+            {
+                auto *fresh = new Slot[FIRST_CHUNK_SIZE << chunk];
+                if (chunks_[chunk].compare_exchange_strong(slots, fresh, std::memory_order_acq_rel))
+                    slots = fresh;
+                else
+                    delete[] fresh;
+            }
+            return slots;
+        }
+
+        /** \brief Get the slot \e index, allocating its chunk if needed */
+        Slot &allocSlot(std::size_t index)
+        {
+            std::size_t offset;
+            unsigned int chunk = locate(index, offset);
+            return allocChunk(chunk)[offset];
+        }
+
+        /** \brief Call \e f on the slots in [\e begin, \e end) that have been allocated */
+        template <typename F>
+        void forEachSlot(std::size_t begin, std::size_t end, const F &f) const
+        {
+            std::size_t offset;
+            unsigned int chunk = locate(begin, offset);
+            std::size_t index = begin;
+            while (index < end)
+            {
+                std::size_t chunkSize = FIRST_CHUNK_SIZE << chunk;
+                Slot *slots = chunks_[chunk].load(std::memory_order_acquire);
+                std::size_t count = std::min(chunkSize - offset, end - index);
+                if (slots != nullptr)
+                    for (std::size_t i = 0; i < count; ++i)
+                        f(slots[offset + i]);
+                index += count;
+                offset = 0;
+                ++chunk;
+            }
+        }
+
+        /** \brief Free all chunks */
+        void freeChunks()
+        {
+            for (auto &chunk : chunks_)
+                delete[] chunk.exchange(nullptr);
+        }
+
+        /** \brief Build a vantage-point tree in \e tree over \e slots[lo, hi) */
+        void buildTree(Tree &tree, std::vector<const Slot *> &slots, std::size_t lo, std::size_t hi) const
+        {
+            // use the middle element as the vantage point
+            std::swap(slots[lo], slots[lo + (hi - lo) / 2]);
+            const Slot *vp = slots[lo];
+            std::size_t node = tree.size();
+            tree.push_back(Node{vp, 0.0, 0, 0});
+
+            if (hi - lo > 1)
+            {
+                std::size_t mid = lo + 1 + (hi - lo - 1) / 2;
+                std::vector<std::pair<double, const Slot *>> sorted;
+                sorted.reserve(hi - lo - 1);
+                for (std::size_t i = lo + 1; i < hi; ++i)
+                    sorted.emplace_back(NearestNeighbors<_T>::distFun_(slots[i]->data, vp->data), slots[i]);
+                std::nth_element(sorted.begin(), sorted.begin() + (mid - lo - 1), sorted.end(),
+                                 [](const std::pair<double, const Slot *> &a, const std::pair<double, const Slot *> &b)
+                                 {
+                                     return a.first < b.first;
+                                 });
+                for (std::size_t i = lo + 1; i < hi; ++i)
+                    slots[i] = sorted[i - lo - 1].second;
+                tree[node].radius = sorted[mid - lo - 1].first;
+
+                if (mid > lo + 1)
+                    buildTree(tree, slots, lo + 1, mid);
+                tree[node].outside = tree.size();
+                buildTree(tree, slots, mid, hi);
+            }
+            else
+                tree[node].outside = tree.size();
+            tree[node].end = tree.size();
+        }
+
+        /** \brief Search the subtree rooted at \e node */
+        template <typename Result>
+        void searchTree(const Tree &tree, std::size_t node, const _T &data, Result &nbh) const
+        {
+            const Node &n = tree[node];
+            bool hasInside = node + 1 < n.outside;
+            bool hasOutside = n.outside < n.end;
+
+            // removed elements may have been freed, so a removed vantage point cannot guide the search
+            if (n.slot->state.load(std::memory_order_acquire) != READY)
+            {
+                if (hasInside)
+                    searchTree(tree, node + 1, data, nbh);
+                if (hasOutside)
+                    searchTree(tree, n.outside, data, nbh);
+                return;
+            }
+
+            double dist = NearestNeighbors<_T>::distFun_(n.slot->data, data);
+            nbh.consider(dist, *n.slot);
+            // the elements before the outside subtree are at most radius away from the vantage point
+            if (dist <= n.radius)
+            {
+                if (hasInside && dist - nbh.bound() <= n.radius)
+                    searchTree(tree, node + 1, data, nbh);
+                if (hasOutside && dist + nbh.bound() >= n.radius)
+                    searchTree(tree, n.outside, data, nbh);
+            }
+            else
+            {
+                if (hasOutside && dist + nbh.bound() >= n.radius)
+                    searchTree(tree, n.outside, data, nbh);
+                if (hasInside && dist - nbh.bound() <= n.radius)
+                    searchTree(tree, node + 1, data, nbh);
+            }
+        }
+
+        /** \brief Find the neighbors of \e data in the current snapshot and the elements that are not indexed.
+            \e nbh is a Neighbors or Matches instance. */
+        template <typename Result>
+        void search(const _T &data, Result &nbh) const
+        {
+            // register as a reader in the current epoch before loading the snapshot, so it is not freed. If the
+            // epoch changed before the registration was visible, buildIndex() may not wait for this reader, so
+            // register again in the new epoch.
+            unsigned int epoch = epoch_.load();
+            while (true)
+            {
+                readers_[epoch].fetch_add(1);
+                unsigned int current = epoch_.load();
+                if (current == epoch)
+                    break;
+                readers_[epoch].fetch_sub(1);
+                epoch = current;
+            }
+            const Snapshot *snapshot = snapshot_.load();
+            for (const auto &tree : snapshot->trees)
+                searchTree(*tree, 0, data, nbh);
+            forEachSlot(snapshot->indexed, reserved_.load(std::memory_order_acquire), [&](Slot &slot)
+                        {
+                            if (slot.state.load(std::memory_order_acquire) == READY)
+                                nbh.consider(NearestNeighbors<_T>::distFun_(slot.data, data), slot);
+                        });
+            readers_[epoch].fetch_sub(1);
+        }
+
+        /** \brief Merge the elements that are not indexed with the smaller trees of the current snapshot into a
+            new tree, unless another thread is already doing so */
+        void buildIndex()
+        {
+            bool expected = false;
+            if (!indexing_.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                return;
+
+            // only the thread that holds indexing_ replaces snapshots, so this one cannot be freed meanwhile
+            const Snapshot *snapshot = snapshot_.load();
+
+            // only the longest prefix of published slots can be indexed
+            std::vector<const Slot *> slots;
+            std::size_t indexed = snapshot->indexed;
+            bool published = true;
+            forEachSlot(indexed, reserved_.load(std::memory_order_acquire), [&](Slot &slot)
+                        {
+                            unsigned char state = slot.state.load(std::memory_order_acquire);
+                            published = published && state != EMPTY;
+                            if (!published)
+                                return;
+                            ++indexed;
+                            if (state == READY)
+                                slots.push_back(&slot);
+                        });
+
+            if (indexed > snapshot->indexed)
+            {
+                auto *next = new Snapshot();
+                next->indexed = indexed;
+                next->trees = snapshot->trees;
+
+                // merge trees that are not larger than the new one, as in a binary counter
+                std::size_t count = indexed - snapshot->indexed;
+                while (!next->trees.empty() && next->trees.back()->size() <= 2 * count)
+                {
+                    for (const auto &node : *next->trees.back())
+                        if (node.slot->state.load(std::memory_order_acquire) == READY)
+                            slots.push_back(node.slot);
+                    count += next->trees.back()->size();
+                    next->trees.pop_back();
+                }
+
+                if (!slots.empty())
+                {
+                    auto tree = std::make_shared<Tree>();
+                    tree->reserve(slots.size());
+                    buildTree(*tree, slots, 0, slots.size());
+                    next->trees.push_back(tree);
+                }
+                snapshot_.store(next);
+                indexed_.store(indexed, std::memory_order_relaxed);
+
+                // wait for the queries that may still read the old snapshot
+                unsigned int epoch = epoch_.load();
+                epoch_.store(1 - epoch);
+                while (readers_[epoch].load() != 0)
+                    std::this_thread::yield();
+                delete snapshot;
+            }
+
+            indexing_.store(false, std::memory_order_release);
+        }
+
+        /** \brief The maximum number of elements outside the trees before a new tree is built */
+        std::size_t maxUnindexed_;
+
+        /** \brief The chunks of slots */
+        std::atomic<Slot *> chunks_[MAX_CHUNKS];
+
+        /** \brief The number of slots reserved by add() */
+        std::atomic<std::size_t> reserved_{0};
+
+        /** \brief The number of elements in the structure */
+        std::atomic<std::size_t> size_{0};
+
+        /** \brief The number of slots indexed by the current snapshot */
+        std::atomic<std::size_t> indexed_{0};
+
+        /** \brief Flag indicating whether a thread is building a new tree */
+        std::atomic<bool> indexing_{false};
+
+        /** \brief The current set of trees */
+        std::atomic<const Snapshot *> snapshot_{new Snapshot()};
+
+        /** \brief The current reader epoch (0 or 1) */
+        std::atomic<unsigned int> epoch_{0};
+
+        /** \brief The number of queries running in each epoch */
+        mutable std::atomic<std::size_t> readers_[2]{{0}, {0}};
+    };
+}
+
+#endif
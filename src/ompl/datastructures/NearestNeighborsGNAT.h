@@ -193,7 +193,7 @@ namespace ompl
                 return false;
             NearQueue nbhQueue;
             // find data in tree
-            bool isPivot = nearestKInternal(data, 1, nbhQueue);
+            bool isPivot = nearestKInternal(data, 1, nbhQueue, offset_);
             const _T *d = nbhQueue.top().second;
             if (*d != data)
                 return false;
@@ -211,7 +211,7 @@ namespace ompl
             if (size_)
             {
                 NearQueue nbhQueue;
-                nearestKInternal(data, 1, nbhQueue);
+                nearestKInternal(data, 1, nbhQueue, offset_);
                 if (!nbhQueue.empty())
                     return *nbhQueue.top().second;
             }
@@ -227,7 +227,7 @@ namespace ompl
             if (size_)
             {
                 NearQueue nbhQueue;
-                nearestKInternal(data, k, nbhQueue);
+                nearestKInternal(data, k, nbhQueue, offset_);
                 postprocessNearest(nbhQueue, nbh);
             }
         }
@@ -239,11 +239,55 @@ namespace ompl
             if (size_)
             {
                 NearQueue nbhQueue;
-                nearestRInternal(data, radius, nbhQueue);
+                nearestRInternal(data, radius, nbhQueue, offset_);
                 postprocessNearest(nbhQueue, nbh);
             }
         }
 
+        /// Return the k nearest neighbors of each point in sorted order, searching from up to
+        /// getBatchThreads() threads
+        void nearestKBatch(const std::vector<_T> &data, std::size_t k,
+                           std::vector<std::vector<_T>> &nbh) const override
+        {
+            nbh.resize(data.size());
+            NearestNeighbors<_T>::parallelFor(data.size(), 16, [&](std::size_t begin, std::size_t end)
+                {
+                    // the queue keeps its storage between queries; each range cycles through the children of
+                    // the nodes with its own offset, so that the threads do not share offset_
+                    NearQueue nbhQueue;
+                    std::size_t offset = begin;
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        nbh[i].clear();
+                        if (k == 0 || !size_)
+                            continue;
+                        nearestKInternal(data[i], k, nbhQueue, offset);
+                        postprocessNearest(nbhQueue, nbh[i]);
+                    }
+                });
+        }
+
+        /// Return the nearest neighbors of each point within distance \c radius in sorted order, searching
+        /// from up to getBatchThreads() threads
+        void nearestRBatch(const std::vector<_T> &data, double radius,
+                           std::vector<std::vector<_T>> &nbh) const override
+        {
+            nbh.resize(data.size());
+            NearestNeighbors<_T>::parallelFor(data.size(), 16, [&](std::size_t begin, std::size_t end)
+                {
+                    NearQueue nbhQueue;
+                    std::size_t offset = begin;
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        nbh[i].clear();
+                        if (!size_)
+                            continue;
+                        nearestRInternal(data[i], radius, nbhQueue, offset);
+                        postprocessNearest(nbhQueue, nbh[i]);
+                    }
+                });
+        }
+
         std::size_t size() const override
         {
             return size_;
@@ -331,8 +375,9 @@ namespace ompl
         /// \brief Return in nbhQueue the k nearest neighbors of data.
         /// For k=1, return true if the nearest neighbor is a pivot.
         /// (which is important during removal; removing pivots is a
-        /// special case).
-        bool nearestKInternal(const _T &data, std::size_t k, NearQueue &nbhQueue) const
+        /// special case). The order in which the children of nodes are
+        /// visited is cycled using \e offset.
+        bool nearestKInternal(const _T &data, std::size_t k, NearQueue &nbhQueue, std::size_t &offset) const
         {
             bool isPivot;
             double dist;
@@ -341,7 +386,7 @@ namespace ompl
 
             dist = NearestNeighbors<_T>::distFun_(data, tree_->pivot_);
             isPivot = tree_->insertNeighborK(nbhQueue, k, tree_->pivot_, data, dist);
-            tree_->nearestK(*this, data, k, nbhQueue, nodeQueue, isPivot);
+            tree_->nearestK(*this, data, k, nbhQueue, nodeQueue, isPivot, offset);
             while (!nodeQueue.empty())
             {
                 dist = nbhQueue.top().first;  // note the difference with nearestRInternal
@@ -350,12 +395,12 @@ namespace ompl
                 if (nbhQueue.size() == k && (nodeDist.second > nodeDist.first->maxRadius_ + dist ||
                                              nodeDist.second < nodeDist.first->minRadius_ - dist))
                     continue;
-                nodeDist.first->nearestK(*this, data, k, nbhQueue, nodeQueue, isPivot);
+                nodeDist.first->nearestK(*this, data, k, nbhQueue, nodeQueue, isPivot, offset);
             }
             return isPivot;
         }
         /// \brief Return in nbhQueue the elements that are within distance radius of data.
-        void nearestRInternal(const _T &data, double radius, NearQueue &nbhQueue) const
+        void nearestRInternal(const _T &data, double radius, NearQueue &nbhQueue, std::size_t &offset) const
         {
             double dist = radius;  // note the difference with nearestKInternal
             NodeQueue nodeQueue;
@@ -363,7 +408,7 @@ namespace ompl
 
             tree_->insertNeighborR(nbhQueue, radius, tree_->pivot_,
                                    NearestNeighbors<_T>::distFun_(data, tree_->pivot_));
-            tree_->nearestR(*this, data, radius, nbhQueue, nodeQueue);
+            tree_->nearestR(*this, data, radius, nbhQueue, nodeQueue, offset);
             while (!nodeQueue.empty())
             {
                 nodeDist = nodeQueue.top();
@@ -371,7 +416,7 @@ namespace ompl
                 if (nodeDist.second > nodeDist.first->maxRadius_ + dist ||
                     nodeDist.second < nodeDist.first->minRadius_ - dist)
                     continue;
-                nodeDist.first->nearestR(*this, data, radius, nbhQueue, nodeQueue);
+                nodeDist.first->nearestR(*this, data, radius, nbhQueue, nodeQueue, offset);
             }
         }
         /// \brief Convert the internal data structure used for storing neighbors
@@ -562,8 +607,10 @@ namespace ompl
             /// (which is important during removal; removing pivots is a
             /// special case). The nodeQueue, which contains other Nodes
             /// that need to be checked for nearest neighbors, is updated.
+            /// The children are visited starting at index \e offset, which
+            /// is then incremented.
             void nearestK(const GNAT &gnat, const _T &data, std::size_t k, NearQueue &nbh, NodeQueue &nodeQueue,
-                          bool &isPivot) const
+                          bool &isPivot, std::size_t &offset) const
             {
                 for (const auto &d : data_)
                     if (!gnat.isRemoved(d))
@@ -575,11 +622,11 @@ namespace ompl
                 {
                     double dist;
                     Node *child;
-                    std::size_t sz = children_.size(), offset = gnat.offset_++;
+                    std::size_t sz = children_.size(), first = offset++;
                     std::vector<double> distToPivot(sz);
                     std::vector<int> permutation(sz);
                     for (unsigned int i = 0; i < sz; ++i)
-                        permutation[i] = (i + offset) % sz;
+                        permutation[i] = (i + first) % sz;
 
                     for (unsigned int i = 0; i < sz; ++i)
                         if (permutation[i] >= 0)
@@ -619,7 +666,8 @@ namespace ompl
             /// \brief Return all elements that are within distance r in nbh.
             /// The nodeQueue, which contains other Nodes that need to
             /// be checked for nearest neighbors, is updated.
-            void nearestR(const GNAT &gnat, const _T &data, double r, NearQueue &nbh, NodeQueue &nodeQueue) const
+            void nearestR(const GNAT &gnat, const _T &data, double r, NearQueue &nbh, NodeQueue &nodeQueue,
+                          std::size_t &offset) const
             {
                 double dist = r;  // note difference with nearestK
 
@@ -629,13 +677,13 @@ namespace ompl
                 if (!children_.empty())
                 {
                     Node *child;
-                    std::size_t sz = children_.size(), offset = gnat.offset_++;
+                    std::size_t sz = children_.size(), first = offset++;
                     std::vector<double> distToPivot(sz);
                     std::vector<int> permutation(sz);
                     // Not a random permutation, but processing the children in slightly different order is
                     // "good enough" to get a performance boost. A call to std::shuffle takes too long.
                     for (unsigned int i = 0; i < sz; ++i)
-                        permutation[i] = (i + offset) % sz;
+                        permutation[i] = (i + first) % sz;
 
                     for (unsigned int i = 0; i < sz; ++i)
                         if (permutation[i] >= 0)
@@ -40,6 +40,8 @@
 #include "ompl/datastructures/NearestNeighbors.h"
 #include "ompl/util/Exception.h"
 #include <algorithm>
+#include <limits>
+#include <utility>
 
 namespace ompl
 {
@@ -51,6 +53,9 @@ namespace ompl
         \li Search for neighbors within a range is O(n log(n)).
         \li Adding an element to the datastructure is O(1).
         \li Removing an element from the datastructure O(n).
+
+        Batched queries visit the elements once per block of queries and
+        can run on multiple threads (see setBatchThreads()).
     */
     template <typename _T>
     class NearestNeighborsLinear : public NearestNeighbors<_T>
@@ -141,6 +146,20 @@ namespace ompl
             std::sort(nbh.begin(), nbh.end(), ElemSort(data, NearestNeighbors<_T>::distFun_));
         }
 
+        /// Return the k nearest neighbors of each point in sorted order
+        void nearestKBatch(const std::vector<_T> &data, std::size_t k,
+                           std::vector<std::vector<_T>> &nbh) const override
+        {
+            nearestBatch(data, k, std::numeric_limits<double>::infinity(), nbh);
+        }
+
+        /// Return the nearest neighbors of each point within distance \c radius in sorted order
+        void nearestRBatch(const std::vector<_T> &data, double radius,
+                           std::vector<std::vector<_T>> &nbh) const override
+        {
+            nearestBatch(data, std::numeric_limits<std::size_t>::max(), radius, nbh);
+        }
+
         std::size_t size() const override
         {
             return data_.size();
@@ -152,6 +171,66 @@ namespace ompl
         }
 
     protected:
+        /** \brief The number of queries that share one pass over the elements in batched queries */
+        static const std::size_t QUERY_BLOCK = 16;
+
+        /** \brief Find the at most \e k nearest neighbors within \e radius of each point in \e data. The
+            elements are scanned once per block of queries, so each element is loaded once for a whole
+            block of distance evaluations. */
+        void nearestBatch(const std::vector<_T> &data, std::size_t k, double radius,
+                          std::vector<std::vector<_T>> &nbh) const
+        {
+            nbh.resize(data.size());
+            if (k == 0)
+            {
+                for (auto &n : nbh)
+                    n.clear();
+                return;
+            }
+
+            // candidates are (distance, index) pairs; for bounded k they form a max-heap
+            using Candidates = std::vector<std::pair<double, std::size_t>>;
+            const bool bounded = k != std::numeric_limits<std::size_t>::max();
+            NearestNeighbors<_T>::parallelFor(data.size(), QUERY_BLOCK, [&](std::size_t begin, std::size_t end)
+                {
+                    std::vector<Candidates> candidates(QUERY_BLOCK);
+                    for (std::size_t block = begin; block < end; block += QUERY_BLOCK)
+                    {
+                        std::size_t blockEnd = std::min(end, block + QUERY_BLOCK);
+                        for (auto &c : candidates)
+                            c.clear();
+                        for (std::size_t i = 0; i < data_.size(); ++i)
+                            for (std::size_t q = block; q < blockEnd; ++q)
+                            {
+                                double dist = NearestNeighbors<_T>::distFun_(data_[i], data[q]);
+                                if (dist > radius)
+                                    continue;
+                                Candidates &c = candidates[q - block];
+                                if (c.size() < k)
+                                {
+                                    c.emplace_back(dist, i);
+                                    if (bounded)
+                                        std::push_heap(c.begin(), c.end());
+                                }
+                                else if (dist < c.front().first)
+                                {
+                                    std::pop_heap(c.begin(), c.end());
+                                    c.back() = std::make_pair(dist, i);
+                                    std::push_heap(c.begin(), c.end());
+                                }
+                            }
+                        for (std::size_t q = block; q < blockEnd; ++q)
+                        {
+                            Candidates &c = candidates[q - block];
+                            std::sort(c.begin(), c.end());
+                            nbh[q].resize(c.size());
+                            for (std::size_t j = 0; j < c.size(); ++j)
+                                nbh[q][j] = data_[c[j].second];
+                        }
+                    }
+                });
+        }
+
         /** \brief The data elements stored in this structure */
         std::vector<_T> data_;
 
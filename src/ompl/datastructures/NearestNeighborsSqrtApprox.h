@@ -52,6 +52,10 @@ namespace ompl
         \li Search for neighbors within a range is O(n log(n)).
         \li Adding an element to the datastructure is O(1).
         \li Removing an element from the datastructure O(n).
+
+        Only nearest() is approximate; nearestK(), nearestR() and their
+        batched versions are the exact, blocked and multi-threaded
+        implementations of NearestNeighborsLinear.
     */
     template <typename _T>
     class NearestNeighborsSqrtApprox : public NearestNeighborsLinear<_T>
@@ -0,0 +1,729 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_DATASTRUCTURES_NEAREST_NEIGHBORS_VPTREE_
+#define OMPL_DATASTRUCTURES_NEAREST_NEIGHBORS_VPTREE_
+
+#include "ompl/datastructures/NearestNeighbors.h"
+#include "ompl/datastructures/CoordinateMetric.h"
+#include "ompl/util/Exception.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace ompl
+{
+    /** \brief Nearest neighbors datastructure that stores elements in flat
+        arrays indexed by implicit vantage-point trees.
+
+        A vantage-point tree over a range of the element array keeps its
+        vantage point at the front of the range, the elements closer to it
+        than a radius in the first half of the rest of the range and the
+        remaining elements in the second half. No nodes or pointers are
+        stored: the only per-element bookkeeping is the range of distances
+        from the vantage point to each half, so queries walk contiguous
+        memory.
+
+        New elements are appended to an unindexed tail that is scanned
+        linearly. Once the tail holds \e maxUnindexed elements, it is merged
+        with the smaller trees at the end of the array into a new tree (the
+        logarithmic method of Bentley and Saxe), so insertions cost
+        O(log^2 n) amortized distance evaluations and there are O(log n)
+        trees. Removed elements are marked and dropped when their tree is
+        rebuilt; when too many elements are marked, everything is rebuilt.
+
+        If setCoordinates() is called, a copy of the coordinates of every
+        element is kept next to it and distances are evaluated with a
+        CoordinateMetric instead of the distance function, which avoids
+        calls through std::function and pointer chasing into states. The
+        coordinate distance is compared with the distance function for the
+        first few elements that are added; if they disagree, the
+        coordinates are dropped and the distance function is used. The
+        coordinates are copied when an element is added, so the elements
+        must not change afterwards. Planners can opt in to this mode with
+        tools::SelfConfig::getCoordinateNearestNeighbors() for the common
+        Euclidean, SO(2), SO(3), SE(2) and SE(3) state spaces.
+
+        The distance function must be a metric. Queries may run
+        concurrently with each other, but not with modifications, so batched
+        queries use up to getBatchThreads() threads. */
+    template <typename _T>
+    class NearestNeighborsVPTree : public NearestNeighbors<_T>
+    {
+    public:
+        /** \brief A function that writes the coordinates of an element to an array */
+        using CoordinateFunction = std::function<void(const _T &, double *)>;
+
+        /** \brief Constructor. The unindexed elements are merged into a
+            tree once there are \e maxUnindexed of them, and all trees are
+            rebuilt once more than a fraction \e maxRemovedFraction of the
+            stored elements has been removed. */
+        NearestNeighborsVPTree(std::size_t maxUnindexed = 32, double maxRemovedFraction = 0.25)
+          : NearestNeighbors<_T>()
+          , maxUnindexed_(std::max<std::size_t>(maxUnindexed, 1u))
+          , maxRemovedFraction_(maxRemovedFraction)
+        {
+        }
+
+        ~NearestNeighborsVPTree() override = default;
+
+        void setDistanceFunction(const typename NearestNeighbors<_T>::DistanceFunction &distFun) override
+        {
+            NearestNeighbors<_T>::setDistanceFunction(distFun);
+            useCoordinates_ = static_cast<bool>(coordinates_);
+            checked_ = 0;
+            rebuildDataStructure();
+        }
+
+        /** \brief Evaluate distances with \e metric on the coordinates
+            computed by \e coordinates. The metric should agree with the
+            distance function. */
+        void setCoordinates(const CoordinateMetric &metric, const CoordinateFunction &coordinates)
+        {
+            metric_ = metric;
+            coordinates_ = coordinates;
+            useCoordinates_ = static_cast<bool>(coordinates_) && metric_.getDimension() > 0;
+            checked_ = 0;
+            rebuildDataStructure();
+        }
+
+        /** \brief Evaluate distances with the distance function only */
+        void clearCoordinates()
+        {
+            coordinates_ = CoordinateFunction();
+            metric_.clear();
+            useCoordinates_ = false;
+            rebuildDataStructure();
+        }
+
+        /** \brief Return true if distances are evaluated on coordinates */
+        bool usesCoordinates() const
+        {
+            return useCoordinates_;
+        }
+
+        bool reportsSortedResults() const override
+        {
+            return true;
+        }
+
+        void clear() override
+        {
+            data_.clear();
+            coords_.clear();
+            removed_.clear();
+            shells_.clear();
+            trees_.clear();
+            indexed_ = 0;
+            removedCount_ = 0;
+        }
+
+        void add(const _T &data) override
+        {
+            std::size_t first = data_.size();
+            append(data);
+            checkCoordinates(first);
+            if (data_.size() - indexed_ >= maxUnindexed_)
+                mergeTrees();
+        }
+
+        void add(const std::vector<_T> &data) override
+        {
+            std::size_t first = data_.size();
+            data_.reserve(first + data.size());
+            for (const auto &elt : data)
+                append(elt);
+            checkCoordinates(first);
+            if (data_.size() - indexed_ >= maxUnindexed_)
+                mergeTrees();
+        }
+
+        bool remove(const _T &data) override
+        {
+            if (size() == 0)
+                return false;
+
+            std::size_t index = find(data);
+            if (index == data_.size())
+                return false;
+            removed_[index] = 1;
+            ++removedCount_;
+            if (removedCount_ > maxUnindexed_ && (double)removedCount_ > maxRemovedFraction_ * data_.size())
+                rebuildTrees();
+            else if (!useCoordinates_ && index < indexed_)
+            {
+                // the caller may free removed elements, so without coordinates a removed
+                // vantage point cannot guide queries; rebuild the tree it belongs to, and
+                // merge the smaller trees with it
+                std::size_t t = trees_.size() - 1;
+                while (trees_[t] > index)
+                    --t;
+                if (isVantagePoint(trees_[t], treeEnd(t), index))
+                {
+                    indexed_ = trees_[t];
+                    trees_.resize(t);
+                    buildTree(indexed_);
+                }
+            }
+            return true;
+        }
+
+        _T nearest(const _T &data) const override
+        {
+            Neighbors nbh(1, std::numeric_limits<double>::infinity());
+            search(data, nbh);
+            if (nbh.empty())
+                throw Exception("No elements found in nearest neighbors data structure");
+            return data_[nbh.front()];
+        }
+
+        void nearestK(const _T &data, std::size_t k, std::vector<_T> &nbh) const override
+        {
+            nbh.clear();
+            if (k == 0)
+                return;
+            Neighbors result(k, std::numeric_limits<double>::infinity());
+            search(data, result);
+            result.extract(data_, nbh);
+        }
+
+        void nearestR(const _T &data, double radius, std::vector<_T> &nbh) const override
+        {
+            Neighbors result(std::numeric_limits<std::size_t>::max(), radius);
+            search(data, result);
+            result.extract(data_, nbh);
+        }
+
+        void nearestKBatch(const std::vector<_T> &data, std::size_t k,
+                           std::vector<std::vector<_T>> &nbh) const override
+        {
+            nbh.resize(data.size());
+            NearestNeighbors<_T>::parallelFor(data.size(), 16, [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                        nearestK(data[i], k, nbh[i]);
+                });
+        }
+
+        void nearestRBatch(const std::vector<_T> &data, double radius,
+                           std::vector<std::vector<_T>> &nbh) const override
+        {
+            nbh.resize(data.size());
+            NearestNeighbors<_T>::parallelFor(data.size(), 16, [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                        nearestR(data[i], radius, nbh[i]);
+                });
+        }
+
+        std::size_t size() const override
+        {
+            return data_.size() - removedCount_;
+        }
+
+        void list(std::vector<_T> &data) const override
+        {
+            data.clear();
+            data.reserve(size());
+            for (std::size_t i = 0; i < data_.size(); ++i)
+                if (!removed_[i])
+                    data.push_back(data_[i]);
+        }
+
+    protected:
+        /** \brief The number of elements for which the coordinate distance is checked against the distance function */
+        static const std::size_t CHECKED_ELEMENTS = 8;
+
+        /** \brief Ranges with at most this many elements are not split further */
+        static const std::size_t LEAF_SIZE = 4;
+
+        /** \brief Queries with at most this many coordinates do not allocate memory */
+        static const unsigned int LOCAL_COORDINATES = 32;
+
+        /** \brief The distances from a vantage point to the elements in the two halves of its range */
+        struct Shells
+        {
+            double insideMin;
+            double insideMax;
+            double outsideMin;
+            double outsideMax;
+        };
+
+        /** \brief The element a query is about, with its coordinates if they are used */
+        class Query
+        {
+        public:
+            Query(const NearestNeighborsVPTree &nn, const _T &data) : data(data)
+            {
+                if (nn.useCoordinates_)
+                {
+                    unsigned int dim = nn.metric_.getDimension();
+                    if (dim > LOCAL_COORDINATES)
+                    {
+                        heap_.resize(dim);
+                        coords = heap_.data();
+                    }
+                    else
+                        coords = local_;
+                    nn.coordinates_(data, coords);
+                }
+            }
+
+            const _T &data;
+            double *coords{nullptr};
+
+        private:
+            double local_[LOCAL_COORDINATES];
+            std::vector<double> heap_;
+        };
+
+        /** \brief The indices of the closest elements found so far, at most \e k of them within \e radius */
+        class Neighbors
+        {
+        public:
+            Neighbors(std::size_t k, double radius) : k_(k), radius_(radius)
+            {
+                // reuse the memory of an earlier query of the same thread
+                items_.swap(spare());
+            }
+
+            ~Neighbors()
+            {
+                items_.clear();
+                spare().swap(items_);
+            }
+
+            Neighbors(const Neighbors &) = delete;
+            Neighbors &operator=(const Neighbors &) = delete;
+
+            /** \brief The distance beyond which elements cannot be neighbors */
+            double bound() const
+            {
+                return items_.size() < k_ ? radius_ : items_.front().first;
+            }
+
+            bool empty() const
+            {
+                return items_.empty();
+            }
+
+            /** \brief The index of the farthest element (the only one, for k = 1) */
+            std::size_t front() const
+            {
+                return items_.front().second;
+            }
+
+            void consider(double dist, std::size_t index)
+            {
+                if (dist > radius_)
+                    return;
+                if (items_.size() < k_)
+                {
+                    items_.emplace_back(dist, index);
+                    // radius queries never need the farthest element, so they skip the heap
+                    if (k_ != std::numeric_limits<std::size_t>::max())
+                        std::push_heap(items_.begin(), items_.end());
+                }
+                else if (dist < items_.front().first)
+                {
+                    std::pop_heap(items_.begin(), items_.end());
+                    items_.back() = std::make_pair(dist, index);
+                    std::push_heap(items_.begin(), items_.end());
+                }
+            }
+
+            /** \brief The indices of the elements found, in no particular order */
+            std::vector<std::size_t> indices() const
+            {
+                std::vector<std::size_t> result;
+                result.reserve(items_.size());
+                for (const auto &item : items_)
+                    result.push_back(item.second);
+                return result;
+            }
+
+            /** \brief Copy the elements to \e nbh, sorted by increasing distance */
+            void extract(const std::vector<_T> &data, std::vector<_T> &nbh)
+            {
+                std::sort(items_.begin(), items_.end());
+                nbh.resize(items_.size());
+                for (std::size_t i = 0; i < items_.size(); ++i)
+                    nbh[i] = data[items_[i].second];
+            }
+
+        private:
+            /** \brief The storage left behind by the last query of the calling thread */
+            static std::vector<std::pair<double, std::size_t>> &spare()
+            {
+                thread_local std::vector<std::pair<double, std::size_t>> items;
+                return items;
+            }
+
+            std::size_t k_;
+            double radius_;
+            std::vector<std::pair<double, std::size_t>> items_;
+        };
+
+        /** \brief Append \e data to the unindexed elements */
+        void append(const _T &data)
+        {
+            data_.push_back(data);
+            removed_.push_back(0);
+            if (useCoordinates_)
+            {
+                unsigned int dim = metric_.getDimension();
+                coords_.resize(data_.size() * dim);
+                coordinates_(data, &coords_[(data_.size() - 1) * dim]);
+            }
+        }
+
+        /** \brief Compare the coordinate distance with the distance function for the first elements */
+        void checkCoordinates(std::size_t first)
+        {
+            if (!useCoordinates_ || !NearestNeighbors<_T>::distFun_ || checked_ >= CHECKED_ELEMENTS)
+                return;
+            std::size_t end = data_.size() < CHECKED_ELEMENTS ? data_.size() : CHECKED_ELEMENTS;
+            for (std::size_t i = std::max(first, checked_); i < end; ++i)
+                for (std::size_t j = 0; j < i; ++j)
+                {
+                    double expected = NearestNeighbors<_T>::distFun_(data_[i], data_[j]);
+                    if (std::fabs(distance(i, j) - expected) > 1e-7 * std::max(1.0, std::fabs(expected)))
+                    {
+                        useCoordinates_ = false;
+                        coords_.clear();
+                        rebuildDataStructure();
+                        return;
+                    }
+                }
+            checked_ = std::max(checked_, end);
+        }
+
+        /** \brief Distance between the stored elements \e i and \e j */
+        double distance(std::size_t i, std::size_t j) const
+        {
+            if (useCoordinates_)
+            {
+                unsigned int dim = metric_.getDimension();
+                return metric_.distance(&coords_[i * dim], &coords_[j * dim]);
+            }
+            return NearestNeighbors<_T>::distFun_(data_[i], data_[j]);
+        }
+
+        /** \brief Distance between the stored element \e i and the query \e q */
+        double distance(std::size_t i, const Query &q) const
+        {
+            if (useCoordinates_)
+                return metric_.distance(&coords_[i * metric_.getDimension()], q.coords);
+            return NearestNeighbors<_T>::distFun_(data_[i], q.data);
+        }
+
+        /** \brief Find the index of \e data, or data_.size() if it is not stored */
+        std::size_t find(const _T &data) const
+        {
+            for (std::size_t i = indexed_; i < data_.size(); ++i)
+                if (!removed_[i] && data_[i] == data)
+                    return i;
+            if (NearestNeighbors<_T>::distFun_)
+            {
+                // elements equal to data are at distance 0, so a radius search locates them
+                Query q(*this, data);
+                Neighbors nbh(std::numeric_limits<std::size_t>::max(), 0.0);
+                for (std::size_t t = 0; t < trees_.size(); ++t)
+                    searchTree(trees_[t], treeEnd(t), q, nbh);
+                for (std::size_t i : nbh.indices())
+                    if (data_[i] == data)
+                        return i;
+            }
+            for (std::size_t i = 0; i < indexed_; ++i)
+                if (!removed_[i] && data_[i] == data)
+                    return i;
+            return data_.size();
+        }
+
+        /** \brief The end of the range of tree \e t */
+        std::size_t treeEnd(std::size_t t) const
+        {
+            return t + 1 < trees_.size() ? trees_[t + 1] : indexed_;
+        }
+
+        /** \brief Return true if \e index is the vantage point of a range in the tree over [\e lo, \e hi) */
+        static bool isVantagePoint(std::size_t lo, std::size_t hi, std::size_t index)
+        {
+            while (hi - lo > LEAF_SIZE)
+            {
+                if (index == lo)
+                    return true;
+                std::size_t mid = lo + 1 + (hi - lo - 1) / 2;
+                if (index < mid)
+                {
+                    ++lo;
+                    hi = mid;
+                }
+                else
+                    lo = mid;
+            }
+            return false;
+        }
+
+        /** \brief Merge the unindexed elements with the trees that are not much larger */
+        void mergeTrees()
+        {
+            std::size_t start = indexed_;
+            std::size_t count = data_.size() - indexed_;
+            while (!trees_.empty() && indexed_ - trees_.back() <= count)
+            {
+                start = trees_.back();
+                count += indexed_ - start;
+                trees_.pop_back();
+                indexed_ = start;
+            }
+            buildTree(start);
+        }
+
+        /** \brief Build a single tree over all elements */
+        void rebuildTrees()
+        {
+            trees_.clear();
+            indexed_ = 0;
+            buildTree(0);
+        }
+
+        /** \brief Recompute coordinates and trees from scratch, for a new distance function or metric */
+        void rebuildDataStructure()
+        {
+            if (data_.empty())
+                return;
+            std::vector<_T> data;
+            list(data);
+            clear();
+            add(data);
+        }
+
+        /** \brief Drop the removed elements in [\e start, end) and build a tree over the rest */
+        void buildTree(std::size_t start)
+        {
+            unsigned int dim = useCoordinates_ ? metric_.getDimension() : 0;
+            std::size_t last = start;
+            for (std::size_t i = start; i < data_.size(); ++i)
+            {
+                if (removed_[i])
+                {
+                    --removedCount_;
+                    continue;
+                }
+                if (i != last)
+                {
+                    data_[last] = std::move(data_[i]);
+                    std::copy(coords_.begin() + i * dim, coords_.begin() + (i + 1) * dim,
+                              coords_.begin() + last * dim);
+                }
+                ++last;
+            }
+            data_.resize(last);
+            removed_.resize(last);
+            std::fill(removed_.begin() + start, removed_.end(), 0);
+            coords_.resize(last * dim);
+            shells_.resize(last);
+            indexed_ = last;
+            if (last == start)
+                return;
+
+            std::vector<std::size_t> order(last - start);
+            std::iota(order.begin(), order.end(), start);
+            std::vector<std::pair<double, std::size_t>> scratch;
+            scratch.reserve(order.size());
+            buildNode(order, 0, order.size(), start, scratch);
+
+            // move the elements into tree order
+            std::vector<_T> data(order.size());
+            std::vector<double> coords(order.size() * dim);
+            for (std::size_t i = 0; i < order.size(); ++i)
+            {
+                data[i] = std::move(data_[order[i]]);
+                std::copy(coords_.begin() + order[i] * dim, coords_.begin() + (order[i] + 1) * dim,
+                          coords.begin() + i * dim);
+            }
+            std::move(data.begin(), data.end(), data_.begin() + start);
+            std::copy(coords.begin(), coords.end(), coords_.begin() + start * dim);
+            trees_.push_back(start);
+        }
+
+        /** \brief Arrange \e order[lo, hi) as a tree and set the shells of its root */
+        void buildNode(std::vector<std::size_t> &order, std::size_t lo, std::size_t hi, std::size_t offset,
+                       std::vector<std::pair<double, std::size_t>> &scratch)
+        {
+            while (hi - lo > LEAF_SIZE)
+            {
+                // use the element farthest from an arbitrary one as the vantage point;
+                // points near the boundary of the data split it with less overlap
+                std::size_t pivot = order[lo + (hi - lo) / 2], farthest = lo;
+                double maxDist = -1.0;
+                for (std::size_t i = lo; i < hi; ++i)
+                {
+                    double dist = distance(order[i], pivot);
+                    if (dist > maxDist)
+                    {
+                        maxDist = dist;
+                        farthest = i;
+                    }
+                }
+                std::swap(order[lo], order[farthest]);
+                std::size_t vp = order[lo];
+                std::size_t mid = lo + 1 + (hi - lo - 1) / 2;
+
+                scratch.clear();
+                for (std::size_t i = lo + 1; i < hi; ++i)
+                    scratch.emplace_back(distance(order[i], vp), order[i]);
+                std::nth_element(scratch.begin(), scratch.begin() + (mid - lo - 1), scratch.end());
+                Shells &shells = shells_[offset + lo];
+                shells.insideMin = shells.outsideMax = scratch[mid - lo - 1].first;
+                shells.insideMax = 0.0;
+                shells.outsideMin = scratch[mid - lo - 1].first;
+                for (std::size_t i = lo + 1; i < hi; ++i)
+                {
+                    const auto &elt = scratch[i - lo - 1];
+                    order[i] = elt.second;
+                    if (i < mid)
+                    {
+                        shells.insideMin = std::min(shells.insideMin, elt.first);
+                        shells.insideMax = std::max(shells.insideMax, elt.first);
+                    }
+                    else
+                        shells.outsideMax = std::max(shells.outsideMax, elt.first);
+                }
+
+                buildNode(order, lo + 1, mid, offset, scratch);
+                lo = mid;
+            }
+        }
+
+        /** \brief Return true if the ball of radius \e bound around a point at distance \e dist from a vantage
+            point intersects the shell of radii [\e inner, \e outer] around the vantage point */
+        static bool intersects(double dist, double bound, double inner, double outer)
+        {
+            return dist + bound >= inner && dist - bound <= outer;
+        }
+
+        /** \brief Search the tree over [\e lo, \e hi) */
+        void searchTree(std::size_t lo, std::size_t hi, const Query &q, Neighbors &nbh) const
+        {
+            while (hi - lo > LEAF_SIZE)
+            {
+                double dist = distance(lo, q);
+                if (!removed_[lo])
+                    nbh.consider(dist, lo);
+
+                // a half needs to be searched only if the ball around the query
+                // intersects the shell that holds the elements of that half
+                std::size_t mid = lo + 1 + (hi - lo - 1) / 2;
+                const Shells &shells = shells_[lo];
+                if (2.0 * dist < shells.insideMax + shells.outsideMin)
+                {
+                    if (mid > lo + 1 && intersects(dist, nbh.bound(), shells.insideMin, shells.insideMax))
+                        searchTree(lo + 1, mid, q, nbh);
+                    if (!intersects(dist, nbh.bound(), shells.outsideMin, shells.outsideMax))
+                        return;
+                    lo = mid;
+                }
+                else
+                {
+                    if (intersects(dist, nbh.bound(), shells.outsideMin, shells.outsideMax))
+                        searchTree(mid, hi, q, nbh);
+                    if (mid == lo + 1 || !intersects(dist, nbh.bound(), shells.insideMin, shells.insideMax))
+                        return;
+                    hi = mid;
+                    ++lo;
+                }
+            }
+            for (; lo < hi; ++lo)
+                if (!removed_[lo])
+                    nbh.consider(distance(lo, q), lo);
+        }
+
+        /** \brief Find the neighbors of \e data among all elements */
+        void search(const _T &data, Neighbors &nbh) const
+        {
+            Query q(*this, data);
+            // recently added elements are often close to the query, so scan them first to tighten the bound
+            for (std::size_t i = indexed_; i < data_.size(); ++i)
+                if (!removed_[i])
+                    nbh.consider(distance(i, q), i);
+            for (std::size_t t = trees_.size(); t-- > 0;)
+                searchTree(trees_[t], treeEnd(t), q, nbh);
+        }
+
+        /** \brief The elements; the trees come first, followed by the unindexed elements */
+        std::vector<_T> data_;
+
+        /** \brief The coordinates of the elements, if they are used */
+        std::vector<double> coords_;
+
+        /** \brief Flags for removed elements */
+        std::vector<char> removed_;
+
+        /** \brief The shells of the vantage point at each position of a tree */
+        std::vector<Shells> shells_;
+
+        /** \brief The start of each tree in data_, by decreasing tree size */
+        std::vector<std::size_t> trees_;
+
+        /** \brief The number of elements that are part of a tree */
+        std::size_t indexed_{0};
+
+        /** \brief The number of elements marked as removed */
+        std::size_t removedCount_{0};
+
+        /** \brief The number of unindexed elements that triggers a merge */
+        std::size_t maxUnindexed_;
+
+        /** \brief The fraction of removed elements that triggers a rebuild */
+        double maxRemovedFraction_;
+
+        /** \brief The metric on coordinates */
+        CoordinateMetric metric_;
+
+        /** \brief The function that computes the coordinates of an element */
+        CoordinateFunction coordinates_;
+
+        /** \brief Whether distances are evaluated on coordinates */
+        bool useCoordinates_{false};
+
+        /** \brief The number of elements for which the coordinate distance has been checked */
+        std::size_t checked_{0};
+    };
+}
+
+#endif
@@ -38,8 +38,14 @@
 #define OMPL_GEOMETRIC_PLANNERS_BITSTAR_BITSTAR_
 
 // STL:
+// std::uint64_t
+#include <cstdint>
+// std::shared_ptr
+#include <memory>
 // std::string
 #include <string>
+// std::unordered_map
+#include <unordered_map>
 // std::pair
 #include <utility>
 // std::vector
@@ -119,6 +125,8 @@ namespace ompl
             /** \brief The queue of edges to process as a dual-stage queue (tracks both the expansion of vertices and
              * the resulting edges) */
             class SearchQueue;
+            /** \brief The threads that check edges for collision in parallel during solve(). */
+            class EdgeCheckPool;
             // Helpful alias declarations:
             /** \brief A vertex shared pointer. */
             using VertexPtr = std::shared_ptr<Vertex>;
@@ -150,7 +158,7 @@ namespace ompl
             BITstar(const base::SpaceInformationPtr &si, const std::string &name = "BITstar");
 
             /** \brief Destruct! */
-            ~BITstar() override = default;
+            ~BITstar() override;
 
             /** \brief Setup */
             void setup() override;
@@ -284,6 +292,17 @@ namespace ompl
             /** \brief Get whether BIT* is considering approximate solutions. */
             bool getConsiderApproximateSolutions() const;
 
+            /** @anchor gBITstarSetNumCollisionCheckThreads \brief Set the number of threads used to check edges for
+             * collision. With more than one thread, an edge that needs a collision check is checked together with the
+             * best edges that follow it in the queue and could also need one, and the results are remembered until
+             * BIT* gets to those edges. Edges are still processed one at a time and in queue order, so the search is
+             * exactly the same as with a single thread; only the collision checks of edges that end up being skipped
+             * are wasted. The state validity checker must be safe to call from several threads at once. */
+            void setNumCollisionCheckThreads(unsigned int numThreads);
+
+            /** \brief Get the number of threads used to check edges for collision. */
+            unsigned int getNumCollisionCheckThreads() const;
+
             /** \brief Set a different nearest neighbours datastructure */
             template <template <typename T> class NN>
             void setNearestNeighbors();
@@ -315,6 +334,10 @@ namespace ompl
              * collision checks. */
             bool checkEdge(const VertexConstPtrPair &edge);
 
+            /** \brief Check the given edge and the best edges in the queue that could need a collision check, in
+             * parallel, and store the results in edgeCheckCache_. */
+            void checkEdgeBatch(const VertexConstPtrPair &edge);
+
             /** \brief Add an edge from the edge queue to the tree. Will add the state to the vertex queue if it's new
              * to the tree or otherwise replace the parent. Updates solution information if the solution improves. */
             void addEdge(const VertexPtrPair &newEdge, const ompl::base::Cost &edgeCost);
@@ -470,6 +493,17 @@ namespace ompl
 
             /** \brief The number of edge collision checks. Accessible via edgeCollisionCheckProgressProperty */
             unsigned int numEdgeCollisionChecks_{0u};
+
+            /** \brief The results of the collision checks done ahead of time by checkEdgeBatch, keyed on the ids of
+             * the source and target vertices of the edge. Emptied at each new batch. */
+            std::unordered_map<std::uint64_t, bool> edgeCheckCache_;
+
+            /** \brief The threads used by checkEdgeBatch, started at the beginning of solve() and stopped at its end.
+             * Empty when edges are checked on the calling thread only. */
+            std::shared_ptr<EdgeCheckPool> checkPool_;
+
+            /** \brief The state pool vertex states are allocated from, while this planner is registered as a user */
+            base::StatePoolPtr statePool_;
             ///////////////////////////////////////////////////////////////////
 
             ///////////////////////////////////////////////////////////////////
@@ -485,6 +519,9 @@ namespace ompl
 
             /** \brief Whether to stop the planner as soon as the path changes (param) */
             bool stopOnSolnChange_{false};
+
+            /** \brief The number of threads used to check edges for collision (param) */
+            unsigned int numCollisionCheckThreads_{1u};
             ///////////////////////////////////////////////////////////////////
         };  // class: BITstar
     }  // geometric
@@ -285,6 +285,10 @@ namespace ompl
 
             /** \brief Get a copy of the edge queue. This is expensive and is only meant for animations/debugging. */
             void getEdges(VertexConstPtrPairVector *edgeQueue);
+
+            /** \brief Get (up to) the \e k best edges currently in the edge queue, best first. Unlike frontEdge(), this
+             * neither expands vertices nor resorts the queue, so the queue is left exactly as it was. */
+            void getFrontEdges(unsigned int k, VertexPtrPairVector *edges) const;
             //////////////////
 
             //////////////////
@@ -932,6 +932,26 @@ namespace ompl
                 edgeQueue->push_back(queueElement.second);
             }
         }
+
+        void BITstar::SearchQueue::getFrontEdges(unsigned int k, VertexPtrPairVector *edges) const
+        {
+            ASSERT_SETUP
+
+            // Variable
+            // The best elements of the binary heap (key and edge)
+            std::vector<CostTripleAndVertexPtrPair> queueFront;
+
+            // Get them, without updating the queue
+            edgeQueue_.getTop(k, queueFront);
+
+            // Clear the vector
+            edges->clear();
+
+            for (const auto &queueElement : queueFront)
+            {
+                edges->push_back(queueElement.second);
+            }
+        }
         /////////////////////////////////////////////////////////////////////////////////////////////
 
         /////////////////////////////////////////////////////////////////////////////////////////////
@@ -104,7 +104,7 @@ namespace ompl
           : vId_(getIdGenerator().getNewId())
           , si_(std::move(si))
           , costHelpPtr_(std::move(costHelpPtr))
-          , state_(si_->allocState())
+          , state_(si_->allocPooledState())
           , isRoot_(root)
           , edgeCost_(costHelpPtr_->infiniteCost())
           , cost_(costHelpPtr_->infiniteCost())
@@ -123,7 +123,7 @@ namespace ompl
             PRINT_VERTEX_CHANGE
 
             // Free the state on destruction
-            si_->freeState(state_);
+            si_->freePooledState(state_);
         }
 
         BITstar::VertexId BITstar::Vertex::getId() const
@@ -43,6 +43,14 @@
 #include <iomanip>
 // For smart pointers
 #include <memory>
+// For std::find
+#include <algorithm>
+// For the collision checking threads
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 // For boost::adaptors::reverse which let "for (auto ...)" loops iterate in reverse
 #include <boost/range/adaptor/reversed.hpp>
 
@@ -79,6 +87,90 @@ namespace ompl
 {
     namespace geometric
     {
+        /////////////////////////////////////////////////////////////////////////////////////////////
+        // The collision checking threads:
+        class BITstar::EdgeCheckPool
+        {
+        public:
+            /** \brief Start numThreads - 1 workers, the thread calling run() being the last one. */
+            explicit EdgeCheckPool(unsigned int numThreads)
+            {
+                for (unsigned int i = 1u; i < numThreads; ++i)
+                {
+                    workers_.emplace_back([this] { this->work(); });
+                }
+            }
+
+            ~EdgeCheckPool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stop_ = true;
+                }
+                wakeUp_.notify_all();
+                for (auto &worker : workers_)
+                {
+                    worker.join();
+                }
+            }
+
+            /** \brief Run the task on every worker and on the calling thread, and return once they have all
+             * returned from it. */
+            void run(const std::function<void()> &task)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    task_ = &task;
+                    numActive_ = workers_.size();
+                    ++batch_;
+                }
+                wakeUp_.notify_all();
+
+                task();
+
+                std::unique_lock<std::mutex> lock(mutex_);
+                done_.wait(lock, [this] { return numActive_ == 0u; });
+                task_ = nullptr;
+            }
+
+        private:
+            void work()
+            {
+                // The last batch this worker took part in
+                unsigned long seen = 0u;
+
+                std::unique_lock<std::mutex> lock(mutex_);
+                while (true)
+                {
+                    wakeUp_.wait(lock, [this, &seen] { return stop_ || batch_ != seen; });
+                    if (stop_)
+                    {
+                        return;
+                    }
+                    seen = batch_;
+
+                    const std::function<void()> *task = task_;
+                    lock.unlock();
+                    (*task)();
+                    lock.lock();
+
+                    if (--numActive_ == 0u)
+                    {
+                        done_.notify_one();
+                    }
+                }
+            }
+
+            std::vector<std::thread> workers_;
+            std::mutex mutex_;
+            std::condition_variable wakeUp_;
+            std::condition_variable done_;
+            const std::function<void()> *task_{nullptr};
+            std::size_t numActive_{0u};
+            unsigned long batch_{0u};
+            bool stop_{false};
+        };
+
         /////////////////////////////////////////////////////////////////////////////////////////////
         // Public functions:
         BITstar::BITstar(const ompl::base::SpaceInformationPtr &si, const std::string &name /*= "BITstar"*/)
@@ -149,6 +241,8 @@ namespace ompl
                                         &BITstar::getStrictQueueOrdering, "0,1");
             Planner::declareParam<bool>("find_approximate_solutions", this, &BITstar::setConsiderApproximateSolutions,
                                         &BITstar::getConsiderApproximateSolutions, "0,1");
+            Planner::declareParam<unsigned int>("collision_check_threads", this, &BITstar::setNumCollisionCheckThreads,
+                                                &BITstar::getNumCollisionCheckThreads, "1:1:64");
 
             // Register my progress info:
             addPlannerProgressProperty("best cost DOUBLE", [this]
@@ -225,11 +319,20 @@ namespace ompl
             */
         }
 
+        BITstar::~BITstar()
+        {
+            base::SpaceInformation::releaseStatePool(statePool_, false);
+        }
+
         void BITstar::setup()
         {
             // Call the base class setup. Marks Planner::setup_ as true.
             Planner::setup();
 
+            // Register with the state pool the vertices are allocated from:
+            if (!statePool_)
+                statePool_ = Planner::si_->acquireStatePool();
+
             // Check if we have a problem definition
             if (static_cast<bool>(Planner::pdef_))
             {
@@ -309,12 +412,18 @@ namespace ompl
             numIterations_ = 0u;
             numEdgeCollisionChecks_ = 0u;
             numRewirings_ = 0u;
+            edgeCheckCache_.clear();
 
             // DO NOT reset the configuration parameters:
             // samplesPerBatch_
             // usePruning_
             // pruneFraction_
             // stopOnSolnChange_
+            // numCollisionCheckThreads_
+
+            // With nothing referencing the vertices anymore, release the state pool; if no other planner uses it,
+            // a pool in reset-on-clear mode frees all its states:
+            base::SpaceInformation::releaseStatePool(statePool_);
 
             // Mark as not setup:
             Planner::setup_ = false;
@@ -363,6 +472,12 @@ namespace ompl
             }
             // No else, there's a goal to all of this
 
+            // Start the threads that check edges ahead of the search for this call
+            if (numCollisionCheckThreads_ > 1u)
+            {
+                checkPool_ = std::make_shared<EdgeCheckPool>(numCollisionCheckThreads_);
+            }
+
             /* Iterate as long as:
               - We're allowed (ptc == false && stopLoop_ == false), AND
               - We haven't found a good enough solution (costHelpPtr_->isSatisfied(bestCost) == false),
@@ -379,6 +494,9 @@ namespace ompl
                 this->iterate();
             }
 
+            // Stop the collision checking threads
+            checkPool_.reset();
+
             // Announce
             if (hasExactSolution_)
             {
@@ -599,6 +717,9 @@ namespace ompl
             // Reset the queue:
             queuePtr_->reset();
 
+            // Forget the edges checked ahead of time, pruning may remove their vertices:
+            edgeCheckCache_.clear();
+
             // Do we need to update our starts or goals?
             if (Planner::pis_.haveMoreStartStates() || Planner::pis_.haveMoreGoalStates())
             {
@@ -756,8 +877,93 @@ namespace ompl
 
         bool BITstar::checkEdge(const VertexConstPtrPair &edge)
         {
-            ++numEdgeCollisionChecks_;
-            return Planner::si_->checkMotion(edge.first->stateConst(), edge.second->stateConst());
+            if (numCollisionCheckThreads_ <= 1u)
+            {
+                ++numEdgeCollisionChecks_;
+                return Planner::si_->checkMotion(edge.first->stateConst(), edge.second->stateConst());
+            }
+
+            // Variable:
+            // The key of the edge in the cache
+            std::uint64_t key = (static_cast<std::uint64_t>(edge.first->getId()) << 32) | edge.second->getId();
+
+            // Was it checked ahead of time?
+            auto cached = edgeCheckCache_.find(key);
+            if (cached == edgeCheckCache_.end())
+            {
+                // No, check it along with the edges that are likely to come next
+                this->checkEdgeBatch(edge);
+                cached = edgeCheckCache_.find(key);
+            }
+
+            return cached->second;
+        }
+
+        void BITstar::checkEdgeBatch(const VertexConstPtrPair &edge)
+        {
+            // Variables:
+            // The edges after this one in the queue. A few per thread keeps the threads busy without wasting too many
+            // checks on edges that get skipped.
+            VertexPtrPairVector nextEdges;
+            // The edges to check and their keys in the cache
+            VertexConstPtrPairVector toCheck{edge};
+            std::vector<std::uint64_t> keys{(static_cast<std::uint64_t>(edge.first->getId()) << 32) |
+                                            edge.second->getId()};
+
+            queuePtr_->getFrontEdges(4u * numCollisionCheckThreads_, &nextEdges);
+            for (const auto &nextEdge : nextEdges)
+            {
+                std::uint64_t key =
+                    (static_cast<std::uint64_t>(nextEdge.first->getId()) << 32) | nextEdge.second->getId();
+                if (edgeCheckCache_.count(key) > 0u || std::find(keys.begin(), keys.end(), key) != keys.end())
+                {
+                    continue;
+                }
+
+                // Only check the edges that would pass the same tests as in iterate() given the current graph:
+                // g_t(v) + c_hat(v,x) + h_hat(x) < g_t(x_g), g_t(v) + c_hat(v,x) < g_t(x) and
+                // g_hat(v) + c(v,x) + h_hat(x) < g_t(x_g)
+                if (costHelpPtr_->isCostBetterThan(costHelpPtr_->currentHeuristicEdge(nextEdge), bestCost_) &&
+                    costHelpPtr_->isCostBetterThan(costHelpPtr_->currentHeuristicToTarget(nextEdge),
+                                                   nextEdge.second->getCost()) &&
+                    costHelpPtr_->isCostBetterThan(
+                        costHelpPtr_->combineCosts(costHelpPtr_->costToComeHeuristic(nextEdge.first),
+                                                   costHelpPtr_->trueEdgeCost(nextEdge),
+                                                   costHelpPtr_->costToGoHeuristic(nextEdge.second)),
+                        bestCost_))
+                {
+                    toCheck.push_back(nextEdge);
+                    keys.push_back(key);
+                }
+            }
+
+            // Check them all, handing out edges to the threads one at a time
+            std::vector<char> results(toCheck.size());
+            std::atomic<std::size_t> nextCheck{0u};
+            std::function<void()> checkEdges = [this, &toCheck, &results, &nextCheck]
+            {
+                std::size_t i;
+                while ((i = nextCheck++) < toCheck.size())
+                {
+                    results[i] = static_cast<char>(
+                        Planner::si_->checkMotion(toCheck[i].first->stateConst(), toCheck[i].second->stateConst()));
+                }
+            };
+            if (checkPool_ && toCheck.size() > 1u)
+            {
+                checkPool_->run(checkEdges);
+            }
+            else
+            {
+                checkEdges();
+            }
+
+            // Remember the results
+            for (std::size_t i = 0u; i < toCheck.size(); ++i)
+            {
+                edgeCheckCache_[keys[i]] = results[i] != 0;
+            }
+            numEdgeCollisionChecks_ += toCheck.size();
         }
 
         void BITstar::addEdge(const VertexPtrPair &newEdge, const ompl::base::Cost &edgeCost)
@@ -930,6 +1136,19 @@ namespace ompl
                     // conveniently allows us to reuse code.
                     Planner::pdef_->getIntermediateSolutionCallback()(this, this->bestPathFromGoalToStart(), bestCost_);
                 }
+
+                // Publish the new solution if anyone listens for improvements:
+                if (Planner::pdef_->getSolutionChannel()->hasSubscribers())
+                {
+                    const std::vector<const ompl::base::State *> reversePath = this->bestPathFromGoalToStart();
+                    auto pathGeoPtr = std::make_shared<ompl::geometric::PathGeometric>(Planner::si_);
+                    for (const auto &solnState : boost::adaptors::reverse(reversePath))
+                    {
+                        pathGeoPtr->append(solnState);
+                    }
+                    Planner::pdef_->getSolutionChannel()->publish(pathGeoPtr, bestCost_, Planner::getName(),
+                                                                  Planner::pdef_->getOptimizationObjective().get());
+                }
             }
             // No else, the goal didn't change
         }
@@ -1192,6 +1411,17 @@ namespace ompl
             return graphPtr_->getTrackApproximateSolutions();
         }
 
+        void BITstar::setNumCollisionCheckThreads(unsigned int numThreads)
+        {
+            numCollisionCheckThreads_ = std::max(numThreads, 1u);
+            edgeCheckCache_.clear();
+        }
+
+        unsigned int BITstar::getNumCollisionCheckThreads() const
+        {
+            return numCollisionCheckThreads_;
+        }
+
         template <template <typename T> class NN>
         void BITstar::setNearestNeighbors()
         {
@@ -126,7 +126,7 @@ ompl::base::PlannerStatus ompl::geometric::EST::solve(const base::PlannerTermina
     Motion *solution = nullptr;
     Motion *approxsol = nullptr;
     double approxdif = std::numeric_limits<double>::infinity();
-    base::State *xstate = si_->allocState();
+    base::State *xstate = si_->allocScratchState();
     auto *xmotion = new Motion();
 
     while (!ptc)
@@ -174,6 +174,11 @@ ompl::base::PlannerStatus ompl::geometric::EST::solve(const base::PlannerTermina
             // add it to everything
             addMotion(motion, neighbors);
 
+            // a neighborhood holds at most every motion; grow its buffer with the tree so that
+            // rejected samples never reallocate it
+            if (neighbors.capacity() < motions_.size())
+                neighbors.reserve(2 * motions_.size());
+
             // done?
             double dist = 0.0;
             bool solved = goal->isSatisfied(motion->state, &dist);
@@ -219,7 +224,7 @@ ompl::base::PlannerStatus ompl::geometric::EST::solve(const base::PlannerTermina
         solved = true;
     }
 
-    si_->freeState(xstate);
+    si_->freeScratchState(xstate);
     delete xmotion;
 
     OMPL_INFORM("%s: Created %u states", getName().c_str(), motions_.size());
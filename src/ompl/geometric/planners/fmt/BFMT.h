@@ -46,6 +46,8 @@
 #include <ompl/datastructures/NearestNeighbors.h>
 #include <ompl/datastructures/BinaryHeap.h>
 #include <ompl/base/OptimizationObjective.h>
+#include <ompl/geometric/planners/fmt/NeighborhoodCache.h>
+#include <limits>
 #include <map>
 #include <utility>
 
@@ -256,8 +258,35 @@ namespace ompl
                 return (termination_ == OPTIMALITY);
             }
 
+            /** \brief Store the cost of the motion from each neighbor of a sample to the sample
+                next to the neighbor, so that it is computed only once. This is worthwhile for
+                expensive optimization objectives, at the price of one cost per neighbor of memory. */
+            void setCacheCosts(bool cacheCosts)
+            {
+                neighborhoods_.setStoreCosts(cacheCosts);
+            }
+
+            /** \brief Returns true if the costs between neighbors are cached */
+            bool getCacheCosts() const
+            {
+                return neighborhoods_.getStoreCosts();
+            }
+
+            /** \brief Set the number of threads used to precompute the neighborhoods of the
+                samples (0 means one per hardware thread) */
+            void setNumThreads(unsigned int numThreads)
+            {
+                numThreads_ = numThreads > 0 ? numThreads : std::max(std::thread::hardware_concurrency(), 1u);
+            }
+
+            /** \brief Get the number of threads used to precompute the neighborhoods of the samples */
+            unsigned int getNumThreads() const
+            {
+                return numThreads_;
+            }
+
             /** \brief Sets Nearest Neighbors precomputation. Currently, it precomputes
-                once solve() has been called. */
+                once solve() has been called, with batched nearest neighbor queries. */
             void setPrecomputeNN(bool p)
             {
                 precomputeNN_ = p;
@@ -338,6 +367,9 @@ namespace ompl
                 /** \brief Contains the connections attempted FROM this node */
                 std::set<BiDirMotion *> collChecksDone_;
 
+                /** \brief The number of the motion in the neighborhood cache */
+                std::size_t id_{std::numeric_limits<std::size_t>::max()};
+
                 /** \brief Set the state associated with the motion */
                 inline base::Cost getCost() const
                 {
@@ -435,6 +467,24 @@ namespace ompl
                     collChecksDone_.insert(m);
                 }
 
+                /** \brief Set the number of the motion in the neighborhood cache */
+                void setId(std::size_t id)
+                {
+                    id_ = id;
+                }
+
+                /** \brief Get the number of the motion in the neighborhood cache */
+                std::size_t getId() const
+                {
+                    return id_;
+                }
+
+                /** \brief Returns true if the neighborhood of the motion has been saved */
+                bool hasNeighborhood() const
+                {
+                    return id_ != std::numeric_limits<std::size_t>::max();
+                }
+
                 /** \brief Set the cost to go heuristic cost */
                 void setHeuristicCost(const base::Cost h)
                 {
@@ -511,6 +561,13 @@ namespace ompl
                 used (nearestK or nearestR depends on the planner configuration */
             void saveNeighborhood(BiDirMotion *m);
 
+            /** \brief Save the neighborhoods of all the motions in the nearest neighbors
+                datastructure at once, using numThreads_ threads */
+            void precomputeNeighborhoods();
+
+            /** \brief The cost of the motion from the furthest neighbor of \e m to \e m */
+            base::Cost worstNeighborCost(const BiDirMotion *m) const;
+
             /** \brief Sample a state from the free configuration space and save
                 it into the nearest neighbors data structure */
             void sampleFree(const std::shared_ptr<NearestNeighbors<BiDirMotion *>> &nn,
@@ -588,14 +645,16 @@ namespace ompl
             TerminateType termination_{OPTIMALITY};
 
             /** \brief If true all the nearest neighbors maps are precomputed before solving. */
-            bool precomputeNN_{false};
+            bool precomputeNN_{true};
+
+            /** \brief The number of threads used to precompute the neighborhoods */
+            unsigned int numThreads_{1u};
 
             /** \brief A nearest-neighbor datastructure containing the set of all motions */
             std::shared_ptr<NearestNeighbors<BiDirMotion *>> nn_;
 
-            /** \brief A map linking a motion to all of the motions within a
-                distance r of that motion */
-            std::map<BiDirMotion *, BiDirMotionPtrs> neighborhoods_;
+            /** \brief The motions within a distance r of each motion, indexed by BiDirMotion::getId() */
+            NeighborhoodCache<BiDirMotion *> neighborhoods_;
 
             /** \brief A binary heap for storing explored motions in
                 cost-to-come sorted order. The motions in Open have been explored,
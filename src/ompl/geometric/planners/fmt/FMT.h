@@ -47,7 +47,8 @@
 #include <ompl/datastructures/NearestNeighbors.h>
 #include <ompl/datastructures/BinaryHeap.h>
 #include <ompl/base/OptimizationObjective.h>
-#include <map>
+#include <ompl/geometric/planners/fmt/NeighborhoodCache.h>
+#include <limits>
 
 namespace ompl
 {
@@ -208,6 +209,33 @@ namespace ompl
                 return extendedFMT_;
             }
 
+            /** \brief Store the cost of the motion from each neighbor of a sample to the sample
+                next to the neighbor, so that it is computed only once. This is worthwhile for
+                expensive optimization objectives, at the price of one cost per neighbor of memory. */
+            void setCacheCosts(bool cacheCosts)
+            {
+                neighborhoods_.setStoreCosts(cacheCosts);
+            }
+
+            /** \brief Returns true if the costs between neighbors are cached */
+            bool getCacheCosts() const
+            {
+                return neighborhoods_.getStoreCosts();
+            }
+
+            /** \brief Set the number of threads used to compute the neighborhoods of the samples
+                before the search starts (0 means one per hardware thread) */
+            void setNumThreads(unsigned int numThreads)
+            {
+                numThreads_ = numThreads > 0 ? numThreads : std::max(std::thread::hardware_concurrency(), 1u);
+            }
+
+            /** \brief Get the number of threads used to compute the neighborhoods of the samples */
+            unsigned int getNumThreads() const
+            {
+                return numThreads_;
+            }
+
         protected:
             /** \brief Representation of a motion
               */
@@ -317,6 +345,24 @@ namespace ompl
                     return children_;
                 }
 
+                /** \brief Set the number of the motion in the neighborhood cache */
+                void setId(std::size_t id)
+                {
+                    id_ = id;
+                }
+
+                /** \brief Get the number of the motion in the neighborhood cache */
+                std::size_t getId() const
+                {
+                    return id_;
+                }
+
+                /** \brief Returns true if the neighborhood of the motion has been saved */
+                bool hasNeighborhood() const
+                {
+                    return id_ != std::numeric_limits<std::size_t>::max();
+                }
+
             protected:
                 /** \brief The state contained by the motion */
                 base::State *state_{nullptr};
@@ -338,6 +384,9 @@ namespace ompl
 
                 /** \brief The set of motions descending from the current motion */
                 std::vector<Motion *> children_;
+
+                /** \brief The number of the motion in the neighborhood cache */
+                std::size_t id_{std::numeric_limits<std::size_t>::max()};
             };
 
             /** \brief Comparator used to order motions in a binary heap */
@@ -399,6 +448,13 @@ namespace ompl
                 used (nearestK or nearestR depends on the planner configuration */
             void saveNeighborhood(Motion *m);
 
+            /** \brief Save the neighborhoods of all the motions in the nearest neighbors
+                datastructure at once, using numThreads_ threads */
+            void precomputeNeighborhoods();
+
+            /** \brief The cost of the motion from the furthest neighbor of \e m to \e m */
+            base::Cost worstNeighborCost(const Motion *m) const;
+
             /** \brief Trace the path from a goal state back to the start state
                 and save the result as a solution in the Problem Definiton. */
             void traceSolutionPathThroughTree(Motion *goalMotion);
@@ -416,8 +472,10 @@ namespace ompl
                 if there is no stored neighborhood. */
             void updateNeighborhood(Motion *m, std::vector<Motion *> nbh);
 
-            /** \brief Returns the best parent and the connection cost in the neighborhood of a motion m. */
-            Motion *getBestParent(Motion *m, std::vector<Motion *> &neighbors, base::Cost &cMin);
+            /** \brief Returns the best parent and the connection cost in the neighborhood of a motion m,
+                given the costs of the motions from the neighbors to m. */
+            Motion *getBestParent(Motion *m, std::vector<Motion *> &neighbors, const std::vector<base::Cost> &costs,
+                                  base::Cost &cMin);
 
             /** \brief A binary heap for storing explored motions in
                 cost-to-come sorted order */
@@ -429,9 +487,11 @@ namespace ompl
                 to be connected to nodes in the unexplored set Unvisited */
             MotionBinHeap Open_;
 
-            /** \brief A map linking a motion to all of the motions within a
-                distance r of that motion */
-            std::map<Motion *, std::vector<Motion *>> neighborhoods_;
+            /** \brief The motions within a distance r of each motion, indexed by Motion::getId() */
+            NeighborhoodCache<Motion *> neighborhoods_;
+
+            /** \brief The number of threads used to compute the neighborhoods */
+            unsigned int numThreads_{1u};
 
             /** \brief The number of samples to use when planning */
             unsigned int numSamples_{1000u};
@@ -0,0 +1,246 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_GEOMETRIC_PLANNERS_FMT_NEIGHBORHOOD_CACHE_
+#define OMPL_GEOMETRIC_PLANNERS_FMT_NEIGHBORHOOD_CACHE_
+
+#include <ompl/base/Cost.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace ompl
+{
+    namespace geometric
+    {
+        /** \brief Neighborhoods of the samples of \ref gFMT "FMT*" and \ref gBFMT "BFMT*".
+
+            Samples are numbered consecutively from 0 by the planner. The neighbors of all samples
+            are kept in a single array, in compressed sparse row form: finding a neighborhood is an
+            index computation and there is no allocation per sample. Optionally, the cost of the
+            motion from each neighbor to the sample is stored next to the neighbor, so planners
+            do not need to compute it again. A neighborhood that grows beyond the room left for it
+            is moved to the end of the array. */
+        template <typename _T>
+        class NeighborhoodCache
+        {
+        public:
+            /** \brief Read-only view of the neighborhood of one sample. The view remains valid
+                while neighborhoods are added to the cache or grown. */
+            class Neighborhood
+            {
+            public:
+                /** \brief The number of neighbors */
+                std::size_t size() const
+                {
+                    return cache_->ranges_[id_].size;
+                }
+
+                /** \brief Check whether the sample has no neighbors */
+                bool empty() const
+                {
+                    return size() == 0;
+                }
+
+                /** \brief Neighbor \e i */
+                const _T &operator[](std::size_t i) const
+                {
+                    return cache_->neighbors_[cache_->ranges_[id_].begin + i];
+                }
+
+                /** \brief The last (furthest) neighbor */
+                const _T &back() const
+                {
+                    return (*this)[size() - 1];
+                }
+
+                /** \brief The cost of the motion from neighbor \e i to the sample. Only available
+                    if the cache stores costs. */
+                const base::Cost &cost(std::size_t i) const
+                {
+                    return cache_->costs_[cache_->ranges_[id_].begin + i];
+                }
+
+            private:
+                friend class NeighborhoodCache;
+
+                Neighborhood(const NeighborhoodCache *cache, std::size_t id) : cache_(cache), id_(id)
+                {
+                }
+
+                const NeighborhoodCache *cache_;
+                std::size_t id_;
+            };
+
+            /** \brief Remove all neighborhoods */
+            void clear()
+            {
+                ranges_.clear();
+                neighbors_.clear();
+                costs_.clear();
+            }
+
+            /** \brief Set whether the cost of the motion from each neighbor to the sample is stored */
+            void setStoreCosts(bool storeCosts)
+            {
+                storeCosts_ = storeCosts;
+            }
+
+            /** \brief Check whether the cost of the motion from each neighbor to the sample is stored */
+            bool getStoreCosts() const
+            {
+                return storeCosts_;
+            }
+
+            /** \brief The number of samples the cache holds neighborhoods for. The next sample
+                added gets this number. */
+            std::size_t size() const
+            {
+                return ranges_.size();
+            }
+
+            /** \brief The neighborhood of sample \e id */
+            Neighborhood operator[](std::size_t id) const
+            {
+                return Neighborhood(this, id);
+            }
+
+            /** \brief Add the neighborhood \e nbh of the next sample, with the cost of the motion
+                from each neighbor given by \e cost(id, neighbor) if costs are stored. Returns the
+                number of the sample. */
+            template <typename CostFn>
+            std::size_t add(const std::vector<_T> &nbh, const CostFn &cost)
+            {
+                const std::size_t id = ranges_.size();
+                ranges_.push_back(Range{neighbors_.size(), nbh.size(), nbh.size()});
+                neighbors_.insert(neighbors_.end(), nbh.begin(), nbh.end());
+                if (storeCosts_)
+                    for (const _T &n : nbh)
+                        costs_.push_back(cost(id, n));
+                return id;
+            }
+
+            /** \brief Replace all neighborhoods by \e nbh, where \e nbh[i] is the neighborhood of
+                sample \e i. If costs are stored, they are computed by \e cost(id, neighbor) on up
+                to \e threads threads. */
+            template <typename CostFn>
+            void build(const std::vector<std::vector<_T>> &nbh, unsigned int threads, const CostFn &cost)
+            {
+                clear();
+                ranges_.resize(nbh.size());
+                std::size_t total = 0;
+                for (std::size_t i = 0; i < nbh.size(); ++i)
+                {
+                    ranges_[i] = Range{total, nbh[i].size(), nbh[i].size()};
+                    total += nbh[i].size();
+                }
+                neighbors_.reserve(total);
+                for (const auto &n : nbh)
+                    neighbors_.insert(neighbors_.end(), n.begin(), n.end());
+                if (!storeCosts_)
+                    return;
+
+                costs_.resize(total);
+                std::atomic<std::size_t> next{0};
+                auto work = [&]
+                {
+                    std::size_t i;
+                    while ((i = next++) < nbh.size())
+                        for (std::size_t j = 0; j < ranges_[i].size; ++j)
+                            costs_[ranges_[i].begin + j] = cost(i, neighbors_[ranges_[i].begin + j]);
+                };
+                std::vector<std::thread> workers;
+                for (unsigned int t = 1; t < std::min<std::size_t>(threads, nbh.size()); ++t)
+                    workers.emplace_back(work);
+                work();
+                for (auto &worker : workers)
+                    worker.join();
+            }
+
+            /** \brief Insert \e neighbor before neighbor \e pos of sample \e id. \e cost is the cost of the
+                motion from \e neighbor to the sample and is ignored unless costs are stored. */
+            void insert(std::size_t id, std::size_t pos, const _T &neighbor, const base::Cost &cost)
+            {
+                Range &r = ranges_[id];
+                if (r.size == r.capacity)
+                {
+                    // no room left, move the neighborhood to the end with twice the room
+                    const std::size_t begin = neighbors_.size();
+                    const std::size_t capacity = std::max<std::size_t>(2 * r.capacity, 4);
+                    neighbors_.resize(begin + capacity);
+                    std::copy(neighbors_.begin() + r.begin, neighbors_.begin() + r.begin + r.size,
+                              neighbors_.begin() + begin);
+                    if (storeCosts_)
+                    {
+                        costs_.resize(begin + capacity);
+                        std::copy(costs_.begin() + r.begin, costs_.begin() + r.begin + r.size,
+                                  costs_.begin() + begin);
+                    }
+                    r.begin = begin;
+                    r.capacity = capacity;
+                }
+                std::copy_backward(neighbors_.begin() + r.begin + pos, neighbors_.begin() + r.begin + r.size,
+                                   neighbors_.begin() + r.begin + r.size + 1);
+                neighbors_[r.begin + pos] = neighbor;
+                if (storeCosts_)
+                {
+                    std::copy_backward(costs_.begin() + r.begin + pos, costs_.begin() + r.begin + r.size,
+                                       costs_.begin() + r.begin + r.size + 1);
+                    costs_[r.begin + pos] = cost;
+                }
+                ++r.size;
+            }
+
+        private:
+            /** \brief The place of a neighborhood in neighbors_ and costs_ */
+            struct Range
+            {
+                std::size_t begin;
+                std::size_t size;
+                std::size_t capacity;
+            };
+
+            std::vector<Range> ranges_;
+
+            std::vector<_T> neighbors_;
+
+            std::vector<base::Cost> costs_;
+
+            bool storeCosts_{false};
+        };
+    }
+}
+
+#endif
@@ -38,6 +38,10 @@ namespace ompl
             ompl::base::Planner::declareParam<bool>("cache_cc", this, &BFMT::setCacheCC, &BFMT::getCacheCC, "0,1");
             ompl::base::Planner::declareParam<bool>("extended_fmt", this, &BFMT::setExtendedFMT, &BFMT::getExtendedFMT,
                                                     "0,1");
+            ompl::base::Planner::declareParam<bool>("cache_costs", this, &BFMT::setCacheCosts, &BFMT::getCacheCosts,
+                                                    "0,1");
+            ompl::base::Planner::declareParam<unsigned int>("num_threads", this, &BFMT::setNumThreads,
+                                                            &BFMT::getNumThreads, "0:1:64");
         }
 
         ompl::geometric::BFMT::~BFMT()
@@ -190,7 +194,7 @@ namespace ompl
         void BFMT::saveNeighborhood(BiDirMotion *m)
         {
             // Check if neighborhood has already been saved
-            if (neighborhoods_.find(m) == neighborhoods_.end())
+            if (!m->hasNeighborhood())
             {
                 BiDirMotionPtrs neighborhood;
                 if (nearestK_)
@@ -198,20 +202,48 @@ namespace ompl
                 else
                     nn_->nearestR(m, NNr_, neighborhood);
 
+                // Save the neighborhood but skip the first element (m)
                 if (!neighborhood.empty())
-                {
-                    // Save the neighborhood but skip the first element (m)
-                    neighborhoods_[m] = std::vector<BiDirMotion *>(neighborhood.size() - 1, nullptr);
-                    std::copy(neighborhood.begin() + 1, neighborhood.end(), neighborhoods_[m].begin());
-                }
-                else
-                {
-                    // Save an empty neighborhood
-                    neighborhoods_[m] = std::vector<BiDirMotion *>(0);
-                }
+                    neighborhood.erase(neighborhood.begin());
+                m->setId(neighborhoods_.add(neighborhood, [this, m](std::size_t, const BiDirMotion *n)
+                                            {
+                                                return opt_->motionCost(n->getState(), m->getState());
+                                            }));
             }
         }
 
+        void BFMT::precomputeNeighborhoods()
+        {
+            BiDirMotionPtrs motions;
+            nn_->list(motions);
+            for (std::size_t i = 0; i < motions.size(); ++i)
+                motions[i]->setId(i);
+
+            std::vector<BiDirMotionPtrs> neighborhoods;
+            nn_->setBatchThreads(numThreads_);
+            if (nearestK_)
+                nn_->nearestKBatch(motions, NNk_, neighborhoods);
+            else
+                nn_->nearestRBatch(motions, NNr_, neighborhoods);
+            // Skip the first element of each neighborhood, since it will be the motion itself
+            for (auto &neighborhood : neighborhoods)
+                if (!neighborhood.empty())
+                    neighborhood.erase(neighborhood.begin());
+
+            neighborhoods_.build(neighborhoods, numThreads_, [this, &motions](std::size_t i, const BiDirMotion *n)
+                                 {
+                                     return opt_->motionCost(n->getState(), motions[i]->getState());
+                                 });
+        }
+
+        base::Cost BFMT::worstNeighborCost(const BiDirMotion *m) const
+        {
+            const NeighborhoodCache<BiDirMotion *>::Neighborhood neighborhood = neighborhoods_[m->getId()];
+            if (neighborhoods_.getStoreCosts())
+                return neighborhood.cost(neighborhood.size() - 1);
+            return opt_->motionCost(neighborhood.back()->getState(), m->getState());
+        }
+
         void BFMT::sampleFree(const std::shared_ptr<NearestNeighbors<BiDirMotion *>> &nn,
                               const base::PlannerTerminationCondition &ptc)
         {
@@ -451,13 +483,13 @@ namespace ompl
 
             // Define Znear as all unexplored nodes in the neighborhood around z
             BiDirMotionPtrs zNear;
-            const BiDirMotionPtrs &zNeighborhood = neighborhoods_[z];
+            const NeighborhoodCache<BiDirMotion *>::Neighborhood zNeighborhood = neighborhoods_[z->getId()];
 
-            for (auto i : zNeighborhood)
+            for (std::size_t i = 0; i < zNeighborhood.size(); ++i)
             {
-                if (i->getCurrentSet() == BiDirMotion::SET_UNVISITED)
+                if (zNeighborhood[i]->getCurrentSet() == BiDirMotion::SET_UNVISITED)
                 {
-                    zNear.push_back(i);
+                    zNear.push_back(zNeighborhood[i]);
                 }
             }
 
@@ -469,21 +501,26 @@ namespace ompl
 
                 // Define Xnear as all frontier nodes in the neighborhood around the unexplored node x
                 BiDirMotionPtrs xNear;
-                const BiDirMotionPtrs &xNeighborhood = neighborhoods_[x];
-                for (auto j : xNeighborhood)
+                std::vector<double> xNearCosts;
+                const NeighborhoodCache<BiDirMotion *>::Neighborhood xNeighborhood = neighborhoods_[x->getId()];
+                for (std::size_t j = 0; j < xNeighborhood.size(); ++j)
                 {
-                    if (j->getCurrentSet() == BiDirMotion::SET_OPEN)
+                    if (xNeighborhood[j]->getCurrentSet() == BiDirMotion::SET_OPEN)
                     {
-                        xNear.push_back(j);
+                        xNear.push_back(xNeighborhood[j]);
+                        xNearCosts.push_back(neighborhoods_.getStoreCosts() ?
+                                                 xNeighborhood.cost(j).value() :
+                                                 distanceFunction(xNeighborhood[j], x));
                     }
                 }
                 // Find the node in Xnear with minimum cost-to-come in the current tree
                 BiDirMotion *xMin = nullptr;
                 double cMin = std::numeric_limits<double>::infinity();
-                for (auto &j : xNear)
+                for (std::size_t k = 0; k < xNear.size(); ++k)
                 {
+                    BiDirMotion *j = xNear[k];
                     // check if node costs are smaller than minimum
-                    double cNew = j->getCost().value() + distanceFunction(j, x);
+                    double cNew = j->getCost().value() + xNearCosts[k];
 
                     if (cNew < cMin)
                     {
@@ -580,10 +617,7 @@ namespace ompl
             /// otherwise is probably a waste of time. Do a real precomputation before calling solve().
             if (precomputeNN_)
             {
-                for (auto &sampleNode : sampleNodes)
-                {
-                    saveNeighborhood(sampleNode);  // nearest neighbors
-                }
+                precomputeNeighborhoods();  // nearest neighbors
             }
             else
             {
@@ -689,8 +723,7 @@ namespace ompl
                             // Only include neighbors that are mutually k-nearest
                             // Relies on NN datastructure returning k-nearest in sorted order
                             const base::Cost connCost = opt_->motionCost(j->getState(), m->getState());
-                            const base::Cost worstCost =
-                                opt_->motionCost(neighborhoods_[j].back()->getState(), j->getState());
+                            const base::Cost worstCost = worstNeighborCost(j);
 
                             if (opt_->isCostBetterThan(worstCost, connCost))
                                 continue;
@@ -854,27 +887,29 @@ namespace ompl
                 if (i->getCurrentSet() == BiDirMotion::SET_CLOSED)
                     continue;
 
-                auto it = neighborhoods_.find(i);
-                if (it != neighborhoods_.end())
+                if (i->hasNeighborhood())
                 {
-                    if (it->second.empty())
+                    const NeighborhoodCache<BiDirMotion *>::Neighborhood nbhToUpdate = neighborhoods_[i->getId()];
+                    if (nbhToUpdate.empty())
                         continue;
 
                     const base::Cost connCost = opt_->motionCost(i->getState(), m->getState());
-                    const base::Cost worstCost = opt_->motionCost(it->second.back()->getState(), i->getState());
+                    const base::Cost worstCost = worstNeighborCost(i);
 
                     if (opt_->isCostBetterThan(worstCost, connCost))
                         continue;
 
                     // insert the neighbor in the vector in the correct order
-                    std::vector<BiDirMotion *> &nbhToUpdate = it->second;
                     for (std::size_t j = 0; j < nbhToUpdate.size(); ++j)
                     {
                         // If connection to the new state is better than the current neighbor tested, insert.
                         const base::Cost cost = opt_->motionCost(i->getState(), nbhToUpdate[j]->getState());
                         if (opt_->isCostBetterThan(connCost, cost))
                         {
-                            nbhToUpdate.insert(nbhToUpdate.begin() + j, m);
+                            neighborhoods_.insert(i->getId(), j, m,
+                                                  neighborhoods_.getStoreCosts() ?
+                                                      opt_->motionCost(m->getState(), i->getState()) :
+                                                      base::Cost());
                             break;
                         }
                     }
@@ -68,6 +68,9 @@ ompl::geometric::FMT::FMT(const base::SpaceInformationPtr &si)
     ompl::base::Planner::declareParam<bool>("cache_cc", this, &FMT::setCacheCC, &FMT::getCacheCC, "0,1");
     ompl::base::Planner::declareParam<bool>("heuristics", this, &FMT::setHeuristics, &FMT::getHeuristics, "0,1");
     ompl::base::Planner::declareParam<bool>("extended_fmt", this, &FMT::setExtendedFMT, &FMT::getExtendedFMT, "0,1");
+    ompl::base::Planner::declareParam<bool>("cache_costs", this, &FMT::setCacheCosts, &FMT::getCacheCosts, "0,1");
+    ompl::base::Planner::declareParam<unsigned int>("num_threads", this, &FMT::setNumThreads, &FMT::getNumThreads,
+                                                    "0:1:64");
 }
 
 ompl::geometric::FMT::~FMT()
@@ -169,27 +172,55 @@ void ompl::geometric::FMT::getPlannerData(base::PlannerData &data) const
 void ompl::geometric::FMT::saveNeighborhood(Motion *m)
 {
     // Check to see if neighborhood has not been saved yet
-    if (neighborhoods_.find(m) == neighborhoods_.end())
+    if (!m->hasNeighborhood())
     {
         std::vector<Motion *> nbh;
         if (nearestK_)
             nn_->nearestK(m, NNk_, nbh);
         else
             nn_->nearestR(m, NNr_, nbh);
+        // Save the neighborhood but skip the first element, since it will be motion m
         if (!nbh.empty())
-        {
-            // Save the neighborhood but skip the first element, since it will be motion m
-            neighborhoods_[m] = std::vector<Motion *>(nbh.size() - 1, nullptr);
-            std::copy(nbh.begin() + 1, nbh.end(), neighborhoods_[m].begin());
-        }
-        else
-        {
-            // Save an empty neighborhood
-            neighborhoods_[m] = std::vector<Motion *>(0);
-        }
+            nbh.erase(nbh.begin());
+        m->setId(neighborhoods_.add(nbh, [this, m](std::size_t, const Motion *n)
+                                    {
+                                        return opt_->motionCost(n->getState(), m->getState());
+                                    }));
     }  // If neighborhood hadn't been saved yet
 }
 
+void ompl::geometric::FMT::precomputeNeighborhoods()
+{
+    std::vector<Motion *> motions;
+    nn_->list(motions);
+    for (std::size_t i = 0; i < motions.size(); ++i)
+        motions[i]->setId(i);
+
+    std::vector<std::vector<Motion *>> nbh;
+    nn_->setBatchThreads(numThreads_);
+    if (nearestK_)
+        nn_->nearestKBatch(motions, NNk_, nbh);
+    else
+        nn_->nearestRBatch(motions, NNr_, nbh);
+    // Skip the first element of each neighborhood, since it will be the motion itself
+    for (auto &n : nbh)
+        if (!n.empty())
+            n.erase(n.begin());
+
+    neighborhoods_.build(nbh, numThreads_, [this, &motions](std::size_t i, const Motion *n)
+                         {
+                             return opt_->motionCost(n->getState(), motions[i]->getState());
+                         });
+}
+
+ompl::base::Cost ompl::geometric::FMT::worstNeighborCost(const Motion *m) const
+{
+    const NeighborhoodCache<Motion *>::Neighborhood nbh = neighborhoods_[m->getId()];
+    if (neighborhoods_.getStoreCosts())
+        return nbh.cost(nbh.size() - 1);
+    return opt_->motionCost(nbh.back()->getState(), m->getState());
+}
+
 // Calculate the unit ball volume for a given dimension
 double ompl::geometric::FMT::calculateUnitBallVolume(const unsigned int dimension) const
 {
@@ -341,7 +372,7 @@ ompl::base::PlannerStatus ompl::geometric::FMT::solve(const base::PlannerTermina
     bool plannerSuccess = false;
     bool successfulExpansion = false;
     Motion *z = initMotion;  // z <-- xinit
-    saveNeighborhood(z);
+    precomputeNeighborhoods();
 
     while (!ptc)
     {
@@ -388,8 +419,7 @@ ompl::base::PlannerStatus ompl::geometric::FMT::solve(const base::PlannerTermina
                             // Only include neighbors that are mutually k-nearest
                             // Relies on NN datastructure returning k-nearest in sorted order
                             const base::Cost connCost = opt_->motionCost(j->getState(), m->getState());
-                            const base::Cost worstCost =
-                                opt_->motionCost(neighborhoods_[j].back()->getState(), j->getState());
+                            const base::Cost worstCost = worstNeighborCost(j);
 
                             if (opt_->isCostBetterThan(worstCost, connCost))
                                 continue;
@@ -500,7 +530,7 @@ bool ompl::geometric::FMT::expandTreeFromNode(Motion **z)
     // Find all nodes that are near z, and also in set Unvisited
 
     std::vector<Motion *> xNear;
-    const std::vector<Motion *> &zNeighborhood = neighborhoods_[*z];
+    const NeighborhoodCache<Motion *>::Neighborhood zNeighborhood = neighborhoods_[(*z)->getId()];
     const unsigned int zNeighborhoodSize = zNeighborhood.size();
     xNear.reserve(zNeighborhoodSize);
 
@@ -515,7 +545,7 @@ bool ompl::geometric::FMT::expandTreeFromNode(Motion **z)
                 // Only include neighbors that are mutually k-nearest
                 // Relies on NN datastructure returning k-nearest in sorted order
                 const base::Cost connCost = opt_->motionCost((*z)->getState(), x->getState());
-                const base::Cost worstCost = opt_->motionCost(neighborhoods_[x].back()->getState(), x->getState());
+                const base::Cost worstCost = worstNeighborCost(x);
 
                 if (opt_->isCostBetterThan(worstCost, connCost))
                     continue;
@@ -528,6 +558,7 @@ bool ompl::geometric::FMT::expandTreeFromNode(Motion **z)
 
     // For each node near z and in set Unvisited, attempt to connect it to set Open
     std::vector<Motion *> yNear;
+    std::vector<base::Cost> yNearCosts;
     std::vector<Motion *> Open_new;
     const unsigned int xNearSize = xNear.size();
     for (unsigned int i = 0; i < xNearSize; ++i)
@@ -535,20 +566,26 @@ bool ompl::geometric::FMT::expandTreeFromNode(Motion **z)
         Motion *x = xNear[i];
 
         // Find all nodes that are near x and in set Open
-        const std::vector<Motion *> &xNeighborhood = neighborhoods_[x];
+        const NeighborhoodCache<Motion *>::Neighborhood xNeighborhood = neighborhoods_[x->getId()];
 
         const unsigned int xNeighborhoodSize = xNeighborhood.size();
         yNear.reserve(xNeighborhoodSize);
         for (unsigned int j = 0; j < xNeighborhoodSize; ++j)
         {
             if (xNeighborhood[j]->getSetType() == Motion::SET_OPEN)
+            {
                 yNear.push_back(xNeighborhood[j]);
+                yNearCosts.push_back(neighborhoods_.getStoreCosts() ?
+                                         xNeighborhood.cost(j) :
+                                         opt_->motionCost(xNeighborhood[j]->getState(), x->getState()));
+            }
         }
 
         // Find the lowest cost-to-come connection from Open to x
         base::Cost cMin(std::numeric_limits<double>::infinity());
-        Motion *yMin = getBestParent(x, yNear, cMin);
+        Motion *yMin = getBestParent(x, yNear, yNearCosts, cMin);
         yNear.clear();
+        yNearCosts.clear();
 
         // If an optimal connection from Open to x was found
         if (yMin != nullptr)
@@ -614,16 +651,15 @@ bool ompl::geometric::FMT::expandTreeFromNode(Motion **z)
     return true;
 }
 
-ompl::geometric::FMT::Motion *ompl::geometric::FMT::getBestParent(Motion *m, std::vector<Motion *> &neighbors,
+ompl::geometric::FMT::Motion *ompl::geometric::FMT::getBestParent(Motion * /*m*/, std::vector<Motion *> &neighbors,
+                                                                  const std::vector<base::Cost> &costs,
                                                                   base::Cost &cMin)
 {
     Motion *min = nullptr;
     const unsigned int neighborsSize = neighbors.size();
     for (unsigned int j = 0; j < neighborsSize; ++j)
     {
-        const base::State *s = neighbors[j]->getState();
-        const base::Cost dist = opt_->motionCost(s, m->getState());
-        const base::Cost cNew = opt_->combineCosts(neighbors[j]->getCost(), dist);
+        const base::Cost cNew = opt_->combineCosts(neighbors[j]->getCost(), costs[j]);
 
         if (opt_->isCostBetterThan(cNew, cMin))
         {
@@ -640,46 +676,31 @@ void ompl::geometric::FMT::updateNeighborhood(Motion *m, const std::vector<Motio
     {
         // If CLOSED, the neighborhood already exists. If neighborhood already exists, we have
         // to insert the node in the corresponding place of the neighborhood of the neighbor of m.
-        if (i->getSetType() == Motion::SET_CLOSED || neighborhoods_.find(i) != neighborhoods_.end())
+        if (i->getSetType() == Motion::SET_CLOSED || i->hasNeighborhood())
         {
             const base::Cost connCost = opt_->motionCost(i->getState(), m->getState());
-            const base::Cost worstCost = opt_->motionCost(neighborhoods_[i].back()->getState(), i->getState());
+            const base::Cost worstCost = worstNeighborCost(i);
 
             if (opt_->isCostBetterThan(worstCost, connCost))
                 continue;
 
             // Insert the neighbor in the vector in the correct order
-            std::vector<Motion *> &nbhToUpdate = neighborhoods_[i];
+            const NeighborhoodCache<Motion *>::Neighborhood nbhToUpdate = neighborhoods_[i->getId()];
             for (std::size_t j = 0; j < nbhToUpdate.size(); ++j)
             {
                 // If connection to the new state is better than the current neighbor tested, insert.
                 const base::Cost cost = opt_->motionCost(i->getState(), nbhToUpdate[j]->getState());
                 if (opt_->isCostBetterThan(connCost, cost))
                 {
-                    nbhToUpdate.insert(nbhToUpdate.begin() + j, m);
+                    neighborhoods_.insert(i->getId(), j, m,
+                                          neighborhoods_.getStoreCosts() ?
+                                              opt_->motionCost(m->getState(), i->getState()) :
+                                              base::Cost());
                     break;
                 }
             }
         }
         else
-        {
-            std::vector<Motion *> nbh2;
-            if (nearestK_)
-                nn_->nearestK(m, NNk_, nbh2);
-            else
-                nn_->nearestR(m, NNr_, nbh2);
-
-            if (!nbh2.empty())
-            {
-                // Save the neighborhood but skip the first element, since it will be motion m
-                neighborhoods_[i] = std::vector<Motion *>(nbh2.size() - 1, nullptr);
-                std::copy(nbh2.begin() + 1, nbh2.end(), neighborhoods_[i].begin());
-            }
-            else
-            {
-                // Save an empty neighborhood
-                neighborhoods_[i] = std::vector<Motion *>(0);
-            }
-        }
+            saveNeighborhood(i);
     }
 }
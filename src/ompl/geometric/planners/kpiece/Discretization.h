@@ -38,7 +38,7 @@
 #define OMPL_GEOMETRIC_PLANNERS_KPIECE_DISCRETIZATION_
 
 #include "ompl/base/Planner.h"
-#include "ompl/datastructures/GridB.h"
+#include "ompl/datastructures/GridBFlat.h"
 #include "ompl/util/Exception.h"
 #include <functional>
 #include <utility>
@@ -101,7 +101,7 @@ namespace ompl
             };
 
             /** \brief The datatype for the maintained grid datastructure */
-            using Grid = GridB<CellData *, OrderCellsByImportance>;
+            using Grid = GridBFlat<CellData *, OrderCellsByImportance>;
 
             /** \brief The datatype for the maintained grid cells */
             using Cell = typename Grid::Cell;
@@ -230,11 +230,8 @@ namespace ompl
                 // with 0 values for the score. This is where we fix the problem
                 if (scell->data->score < std::numeric_limits<double>::epsilon())
                 {
-                    std::vector<CellData *> content;
-                    content.reserve(grid_.size());
-                    grid_.getContent(content);
-                    for (auto it = content.begin(); it != content.end(); ++it)
-                        (*it)->score += 1.0 + log((double)((*it)->iteration));
+                    for (const auto &it : grid_)
+                        it.second->data->score += 1.0 + log((double)(it.second->data->iteration));
                     grid_.updateAll();
                 }
 
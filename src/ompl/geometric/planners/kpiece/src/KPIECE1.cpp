@@ -119,7 +119,7 @@ ompl::base::PlannerStatus ompl::geometric::KPIECE1::solve(const base::PlannerTer
     Motion *solution = nullptr;
     Motion *approxsol = nullptr;
     double approxdif = std::numeric_limits<double>::infinity();
-    base::State *xstate = si_->allocState();
+    base::State *xstate = si_->allocScratchState();
 
     while (!ptc)
     {
@@ -200,7 +200,7 @@ ompl::base::PlannerStatus ompl::geometric::KPIECE1::solve(const base::PlannerTer
         solved = true;
     }
 
-    si_->freeState(xstate);
+    si_->freeScratchState(xstate);
 
     OMPL_INFORM("%s: Created %u states in %u cells (%u internal + %u external)", getName().c_str(),
                 disc_.getMotionCount(), disc_.getCellCount(), disc_.getGrid().countInternal(),
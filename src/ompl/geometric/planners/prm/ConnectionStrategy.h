@@ -38,6 +38,7 @@
 #define OMPL_GEOMETRIC_PLANNERS_PRM_CONNECTION_STRATEGY_
 
 #include "ompl/datastructures/NearestNeighbors.h"
+#include "ompl/util/Tracer.h"
 #include <functional>
 #include <memory>
 #include <boost/math/constants/constants.hpp>
@@ -76,6 +77,7 @@ namespace ompl
                 according to the connection strategy */
             const std::vector<Milestone> &operator()(const Milestone &m)
             {
+                OMPL_TRACE_SCOPE("nearest");
                 nn_->nearestK(m, k_, neighbors_);
                 return neighbors_;
             }
@@ -172,6 +174,7 @@ namespace ompl
 
             const auto &operator()(const Milestone &m)
             {
+                OMPL_TRACE_SCOPE("nearest");
                 auto &result = KStrategy<Milestone>::neighbors_;
                 KStrategy<Milestone>::nn_->nearestK(m, KStrategy<Milestone>::k_, result);
                 if (result.empty())
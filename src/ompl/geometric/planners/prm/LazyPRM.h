@@ -146,6 +146,13 @@ namespace ompl
             /** \brief Constructor */
             LazyPRM(const base::SpaceInformationPtr &si, bool starStrategy = false);
 
+            /** \brief Constructor that restores a roadmap extracted with getPlannerData(), for instance
+                one built ahead of time by PRM. The states are copied, so \e data may be released once
+                the planner is constructed. If \e checked is true, the milestones and motions of
+                \e data are known to be valid (as for a roadmap built by PRM) and are never checked
+                again; otherwise they are checked lazily like any other part of the roadmap. */
+            LazyPRM(const base::PlannerData &data, bool starStrategy = false, bool checked = false);
+
             ~LazyPRM() override;
 
             /** \brief Set the maximum length of a motion to be added to the roadmap. */
@@ -42,6 +42,7 @@
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/pending/disjoint_sets.hpp>
+#include <memory>
 #include <mutex>
 #include <utility>
 #include <vector>
@@ -143,6 +144,11 @@ namespace ompl
             /** \brief Constructor */
             PRM(const base::SpaceInformationPtr &si, bool starStrategy = false);
 
+            /** \brief Constructor that restores a roadmap extracted with getPlannerData(), for
+                instance one opened from a base::MappedPlannerDataStorage. The states are copied,
+                so \e data may be released once the planner is constructed. */
+            PRM(const base::PlannerData &data, bool starStrategy = false);
+
             ~PRM() override;
 
             void setProblemDefinition(const base::ProblemDefinitionPtr &pdef) override;
@@ -191,6 +197,26 @@ namespace ompl
                 connectionFilter_ = connectionFilter;
             }
 
+            /** \brief Set the number of threads used to grow the roadmap (0 means one per hardware thread).
+
+             \par With more than one thread, the roadmap is grown in batches: the threads sample a few
+             valid milestones each, the milestones are added to the roadmap together with their
+             candidate connections, and the threads then check the candidate connections. The valid
+             connections of a batch are added to the roadmap at once. The connection filter is called
+             while a batch is added, so it does not see the connections of the milestones of the same
+             batch. The state validity checker must be safe to call from several threads at once.
+
+             \par The roadmap can also be built ahead of time with growRoadmap() and saved with
+             getPlannerData(), to be loaded by the PRM, PRMstar or LazyPRM constructors that take
+             base::PlannerData. */
+            void setNumThreads(unsigned int numThreads);
+
+            /** \brief Get the number of threads used to grow the roadmap */
+            unsigned int getNumThreads() const
+            {
+                return numThreads_;
+            }
+
             void getPlannerData(base::PlannerData &data) const override;
 
             /** \brief While the termination condition allows, this function will construct the roadmap (using
@@ -280,6 +306,9 @@ namespace ompl
             }
 
         protected:
+            /** \brief The threads that grow the roadmap in parallel */
+            class WorkerPool;
+
             /** \brief Free all the memory allocated by the planner */
             void freeMemory();
 
@@ -301,6 +330,10 @@ namespace ompl
                  \e ptc returns true.  Use \e workState as temporary memory. */
             void growRoadmap(const base::PlannerTerminationCondition &ptc, base::State *workState);
 
+            /** \brief Randomly sample the state space, add and connect milestones in the roadmap using
+                numThreads_ threads, in batches, until the termination condition \e ptc returns true. */
+            void growRoadmapParallel(const base::PlannerTerminationCondition &ptc);
+
             /** \brief Attempt to connect disjoint components in the
                 roadmap using random bounding motions (the PRM
                 expansion step) */
@@ -365,6 +398,19 @@ namespace ompl
             /** \brief Sampler user for generating random in the state space */
             base::StateSamplerPtr simpleSampler_;
 
+            /** \brief Samplers of the threads that grow the roadmap in parallel, one per thread */
+            std::vector<base::ValidStateSamplerPtr> threadSamplers_;
+
+            /** \brief The number of threads used to grow the roadmap */
+            unsigned int numThreads_{1u};
+
+            /** \brief The threads used by growRoadmapParallel(), started at the beginning of solve() and stopped
+                at its end. Empty when the roadmap is grown by the calling thread only. */
+            std::shared_ptr<WorkerPool> workerPool_;
+
+            /** \brief The state pool milestones are allocated from, while this planner is registered as a user */
+            base::StatePoolPtr statePool_;
+
             /** \brief Nearest neighbors data structure */
             RoadmapNeighbors nn_;
 
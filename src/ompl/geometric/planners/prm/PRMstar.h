@@ -67,6 +67,9 @@ namespace ompl
         public:
             /** \brief Constructor */
             PRMstar(const base::SpaceInformationPtr &si);
+
+            /** \brief Constructor that restores a roadmap extracted with getPlannerData() */
+            PRMstar(const base::PlannerData &data);
         };
     }
 }
@@ -101,6 +101,52 @@ ompl::geometric::LazyPRM::LazyPRM(const base::SpaceInformationPtr &si, bool star
                                });
 }
 
+ompl::geometric::LazyPRM::LazyPRM(const base::PlannerData &data, bool starStrategy, bool checked)
+  : LazyPRM(data.getSpaceInformation(), starStrategy)
+{
+    if (data.numVertices() == 0)
+        return;
+
+    nn_.reset(tools::SelfConfig::getDefaultNearestNeighbors<Vertex>(this));
+    nn_->setDistanceFunction([this](const Vertex a, const Vertex b)
+                             {
+                                 return distanceFunction(a, b);
+                             });
+
+    const unsigned int validity = checked ? VALIDITY_TRUE : VALIDITY_UNKNOWN;
+    std::vector<Vertex> vertices(data.numVertices());
+    for (unsigned int i = 0; i < data.numVertices(); ++i)
+    {
+        Vertex m = boost::add_vertex(g_);
+        stateProperty_[m] = si_->cloneState(data.getVertex(i).getState());
+        vertexValidityProperty_[m] = validity;
+        unsigned long int newComponent = componentCount_++;
+        vertexComponentProperty_[m] = newComponent;
+        componentSize_[newComponent] = 1;
+        vertices[i] = m;
+    }
+
+    std::vector<unsigned int> edges;
+    for (unsigned int i = 0; i < data.numVertices(); ++i)
+    {
+        edges.clear();
+        data.getEdges(i, edges);
+        for (unsigned int j : edges)
+        {
+            // getPlannerData() stores both directions of each undirected edge
+            if (boost::edge(vertices[i], vertices[j], g_).second)
+                continue;
+            base::Cost weight;
+            data.getEdgeWeight(i, j, &weight);
+            const Graph::edge_property_type properties(weight);
+            const Edge &e = boost::add_edge(vertices[i], vertices[j], properties, g_).first;
+            edgeValidityProperty_[e] = validity;
+            uniteComponents(vertices[i], vertices[j]);
+        }
+        nn_->add(vertices[i]);
+    }
+}
+
 ompl::geometric::LazyPRM::~LazyPRM() = default;
 
 void ompl::geometric::LazyPRM::setup()
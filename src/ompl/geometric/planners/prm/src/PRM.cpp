@@ -41,10 +41,13 @@
 #include "ompl/datastructures/PDF.h"
 #include "ompl/tools/config/SelfConfig.h"
 #include "ompl/tools/config/MagicConstants.h"
+#include "ompl/util/Tracer.h"
 #include <boost/graph/astar_search.hpp>
 #include <boost/graph/incremental_components.hpp>
 #include <boost/property_map/vector_property_map.hpp>
 #include <boost/foreach.hpp>
+#include <atomic>
+#include <condition_variable>
 #include <thread>
 
 #include "GoalVisitor.hpp"
@@ -65,9 +68,95 @@ namespace ompl
         /** \brief The number of nearest neighbors to consider by
             default in the construction of the PRM roadmap */
         static const unsigned int DEFAULT_NEAREST_NEIGHBORS = 10;
+
+        /** \brief The number of milestones each thread samples per batch when the
+            roadmap is grown by several threads */
+        static const unsigned int MILESTONES_PER_THREAD_BATCH = 8;
     }  // namespace magic
 }  // namespace ompl
 
+/* Runs a task on a set of worker threads and on the calling thread, so the threads that grow the
+   roadmap are started once per solve() rather than for every batch of milestones */
+class ompl::geometric::PRM::WorkerPool
+{
+public:
+    /* Start numThreads - 1 workers, the thread calling run() being the first one */
+    explicit WorkerPool(unsigned int numThreads)
+    {
+        for (unsigned int t = 1; t < numThreads; ++t)
+            workers_.emplace_back([this, t] { work(t); });
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wakeUp_.notify_all();
+        for (auto &worker : workers_)
+            worker.join();
+    }
+
+    /* The number of threads running a task, including the calling thread */
+    unsigned int size() const
+    {
+        return workers_.size() + 1;
+    }
+
+    /* Run task(t) on worker t, for t from 1 to size() - 1, and on the calling thread as t = 0, and
+       return once they have all returned from it */
+    void run(const std::function<void(unsigned int)> &task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            numActive_ = workers_.size();
+            ++batch_;
+        }
+        wakeUp_.notify_all();
+
+        task(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return numActive_ == 0; });
+        task_ = nullptr;
+    }
+
+private:
+    void work(unsigned int t)
+    {
+        // the last batch this worker took part in
+        unsigned long seen = 0;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            wakeUp_.wait(lock, [this, &seen] { return stop_ || batch_ != seen; });
+            if (stop_)
+                return;
+            seen = batch_;
+
+            const std::function<void(unsigned int)> *task = task_;
+            lock.unlock();
+            (*task)(t);
+            lock.lock();
+
+            if (--numActive_ == 0)
+                done_.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::condition_variable done_;
+    const std::function<void(unsigned int)> *task_{nullptr};
+    std::size_t numActive_{0};
+    unsigned long batch_{0};
+    bool stop_{false};
+};
+
 ompl::geometric::PRM::PRM(const base::SpaceInformationPtr &si, bool starStrategy)
   : base::Planner(si, "PRM")
   , starStrategy_(starStrategy)
@@ -85,6 +174,7 @@ ompl::geometric::PRM::PRM(const base::SpaceInformationPtr &si, bool starStrategy
     if (!starStrategy_)
         Planner::declareParam<unsigned int>("max_nearest_neighbors", this, &PRM::setMaxNearestNeighbors,
                                             std::string("8:1000"));
+    Planner::declareParam<unsigned int>("num_threads", this, &PRM::setNumThreads, &PRM::getNumThreads, "0:1:64");
 
     addPlannerProgressProperty("iterations INTEGER", [this] { return getIterationCount(); });
     addPlannerProgressProperty("best cost REAL", [this] { return getBestCost(); });
@@ -92,9 +182,53 @@ ompl::geometric::PRM::PRM(const base::SpaceInformationPtr &si, bool starStrategy
     addPlannerProgressProperty("edge count INTEGER", [this] { return getEdgeCountString(); });
 }
 
+ompl::geometric::PRM::PRM(const base::PlannerData &data, bool starStrategy)
+  : PRM(data.getSpaceInformation(), starStrategy)
+{
+    if (data.numVertices() == 0)
+        return;
+
+    specs_.multithreaded = false;  // temporarily set to false since nn_ is used only in single thread
+    nn_.reset(tools::SelfConfig::getDefaultNearestNeighbors<Vertex>(this));
+    specs_.multithreaded = true;
+    nn_->setDistanceFunction([this](const Vertex a, const Vertex b) { return distanceFunction(a, b); });
+
+    statePool_ = si_->acquireStatePool();
+    std::vector<Vertex> vertices(data.numVertices());
+    for (unsigned int i = 0; i < data.numVertices(); ++i)
+    {
+        Vertex m = boost::add_vertex(g_);
+        stateProperty_[m] = si_->clonePooledState(data.getVertex(i).getState());
+        totalConnectionAttemptsProperty_[m] = 1;
+        successfulConnectionAttemptsProperty_[m] = 0;
+        disjointSets_.make_set(m);
+        vertices[i] = m;
+    }
+
+    std::vector<unsigned int> edges;
+    for (unsigned int i = 0; i < data.numVertices(); ++i)
+    {
+        edges.clear();
+        data.getEdges(i, edges);
+        for (unsigned int j : edges)
+        {
+            // getPlannerData() stores both directions of each undirected edge
+            if (boost::edge(vertices[i], vertices[j], g_).second)
+                continue;
+            base::Cost weight;
+            data.getEdgeWeight(i, j, &weight);
+            const Graph::edge_property_type properties(weight);
+            boost::add_edge(vertices[i], vertices[j], properties, g_);
+            uniteComponents(vertices[i], vertices[j]);
+        }
+        nn_->add(vertices[i]);
+    }
+}
+
 ompl::geometric::PRM::~PRM()
 {
     freeMemory();
+    base::SpaceInformation::releaseStatePool(statePool_, false);
 }
 
 void ompl::geometric::PRM::setup()
@@ -152,6 +286,11 @@ void ompl::geometric::PRM::setMaxNearestNeighbors(unsigned int k)
         setup();
 }
 
+void ompl::geometric::PRM::setNumThreads(unsigned int numThreads)
+{
+    numThreads_ = numThreads > 0 ? numThreads : std::max(std::thread::hardware_concurrency(), 1u);
+}
+
 void ompl::geometric::PRM::setDefaultConnectionStrategy()
 {
     if (starStrategy_)
@@ -178,7 +317,9 @@ void ompl::geometric::PRM::clear()
     Planner::clear();
     sampler_.reset();
     simpleSampler_.reset();
+    threadSamplers_.clear();
     freeMemory();
+    base::SpaceInformation::releaseStatePool(statePool_);
     if (nn_)
         nn_->clear();
     clearQuery();
@@ -190,7 +331,7 @@ void ompl::geometric::PRM::clear()
 void ompl::geometric::PRM::freeMemory()
 {
     foreach (Vertex v, boost::vertices(g_))
-        si_->freeState(stateProperty_[v]);
+        si_->freePooledState(stateProperty_[v]);
     g_.clear();
 }
 
@@ -203,6 +344,8 @@ void ompl::geometric::PRM::expandRoadmap(const base::PlannerTerminationCondition
 {
     if (!simpleSampler_)
         simpleSampler_ = si_->allocStateSampler();
+    if (!statePool_)
+        statePool_ = si_->acquireStatePool();
 
     std::vector<base::State *> states(magic::MAX_RANDOM_BOUNCE_STEPS);
     si_->allocStates(states);
@@ -237,14 +380,14 @@ void ompl::geometric::PRM::expandRoadmap(const base::PlannerTerminationCondition
         if (s > 0)
         {
             s--;
-            Vertex last = addMilestone(si_->cloneState(workStates[s]));
+            Vertex last = addMilestone(si_->clonePooledState(workStates[s]));
 
             graphMutex_.lock();
             for (unsigned int i = 0; i < s; ++i)
             {
                 // add the vertex along the bouncing motion
                 Vertex m = boost::add_vertex(g_);
-                stateProperty_[m] = si_->cloneState(workStates[i]);
+                stateProperty_[m] = si_->clonePooledState(workStates[i]);
                 totalConnectionAttemptsProperty_[m] = 1;
                 successfulConnectionAttemptsProperty_[m] = 0;
                 disjointSets_.make_set(m);
@@ -286,6 +429,8 @@ void ompl::geometric::PRM::growRoadmap(const base::PlannerTerminationCondition &
         setup();
     if (!sampler_)
         sampler_ = si_->allocValidStateSampler();
+    if (!statePool_)
+        statePool_ = si_->acquireStatePool();
 
     base::State *workState = si_->allocState();
     growRoadmap(ptc, workState);
@@ -294,6 +439,12 @@ void ompl::geometric::PRM::growRoadmap(const base::PlannerTerminationCondition &
 
 void ompl::geometric::PRM::growRoadmap(const base::PlannerTerminationCondition &ptc, base::State *workState)
 {
+    if (numThreads_ > 1)
+    {
+        growRoadmapParallel(ptc);
+        return;
+    }
+
     /* grow roadmap in the regular fashion -- sample valid states, add them to the roadmap, add valid connections */
     while (!ptc)
     {
@@ -311,7 +462,113 @@ void ompl::geometric::PRM::growRoadmap(const base::PlannerTerminationCondition &
         }
         // add it as a milestone
         if (found)
-            addMilestone(si_->cloneState(workState));
+            addMilestone(si_->clonePooledState(workState));
+    }
+}
+
+void ompl::geometric::PRM::growRoadmapParallel(const base::PlannerTerminationCondition &ptc)
+{
+    // A candidate connection between a milestone of the current batch and one of its neighbors
+    struct Connection
+    {
+        Vertex n, m;
+        const base::State *sn, *sm;
+        base::Cost weight;
+        bool valid;
+    };
+
+    // Samplers are not thread safe, so every thread gets its own
+    while (threadSamplers_.size() < numThreads_)
+        threadSamplers_.push_back(si_->allocValidStateSampler());
+
+    // Outside of solve(), the threads only last for this call
+    std::shared_ptr<WorkerPool> pool = workerPool_;
+    if (!pool || pool->size() != numThreads_)
+        pool = std::make_shared<WorkerPool>(numThreads_);
+
+    const std::size_t batchSize = magic::MILESTONES_PER_THREAD_BATCH * numThreads_;
+    std::vector<base::State *> milestones(batchSize);
+    std::vector<Connection> connections;
+    while (!ptc)
+    {
+        // sample valid milestones in parallel
+        std::atomic<std::size_t> next{0};
+        pool->run([&](unsigned int t)
+                  {
+                      base::ValidStateSampler &sampler = *threadSamplers_[t];
+                      base::State *workState = si_->allocState();
+                      std::size_t i;
+                      while ((i = next++) < batchSize)
+                      {
+                          bool found = false;
+                          while (!found && !ptc)
+                          {
+                              unsigned int attempts = 0;
+                              do
+                              {
+                                  found = sampler.sample(workState);
+                                  attempts++;
+                              } while (attempts < magic::FIND_VALID_STATE_ATTEMPTS_WITHOUT_TERMINATION_CHECK &&
+                                       !found);
+                          }
+                          milestones[i] = found ? si_->clonePooledState(workState) : nullptr;
+                      }
+                      si_->freeState(workState);
+                  });
+
+        // add the milestones to the roadmap and collect the connections to check; the states are
+        // copied out of the graph, since other threads may add milestones while they are checked
+        connections.clear();
+        {
+            std::lock_guard<std::mutex> _(graphMutex_);
+            for (base::State *state : milestones)
+            {
+                if (state == nullptr)
+                    continue;
+                iterations_++;
+                Vertex m = boost::add_vertex(g_);
+                stateProperty_[m] = state;
+                totalConnectionAttemptsProperty_[m] = 1;
+                successfulConnectionAttemptsProperty_[m] = 0;
+                disjointSets_.make_set(m);
+
+                foreach (Vertex n, connectionStrategy_(m))
+                    if (connectionFilter_(n, m))
+                    {
+                        totalConnectionAttemptsProperty_[m]++;
+                        totalConnectionAttemptsProperty_[n]++;
+                        connections.push_back(Connection{n, m, stateProperty_[n], state, base::Cost(), false});
+                    }
+
+                nn_->add(m);
+            }
+        }
+
+        // check the connections in parallel
+        next = 0;
+        pool->run([&](unsigned int)
+                  {
+                      std::size_t i;
+                      while ((i = next++) < connections.size())
+                      {
+                          Connection &c = connections[i];
+                          c.valid = si_->checkMotion(c.sn, c.sm);
+                          if (c.valid)
+                              c.weight = opt_->motionCost(c.sn, c.sm);
+                      }
+                  });
+
+        // add the valid connections to the roadmap
+        std::lock_guard<std::mutex> _(graphMutex_);
+        for (const Connection &c : connections)
+            if (c.valid)
+            {
+                successfulConnectionAttemptsProperty_[c.m]++;
+                successfulConnectionAttemptsProperty_[c.n]++;
+                const Graph::edge_property_type properties(c.weight);
+                boost::add_edge(c.n, c.m, properties, g_);
+                uniteComponents(c.n, c.m);
+            }
     }
 }
 
@@ -325,7 +582,7 @@ void ompl::geometric::PRM::checkForSolution(const base::PlannerTerminationCondit
         {
             const base::State *st = pis_.nextGoal();
             if (st != nullptr)
-                goalM_.push_back(addMilestone(si_->cloneState(st)));
+                goalM_.push_back(addMilestone(si_->clonePooledState(st)));
         }
 
         // Check for a solution
@@ -392,10 +649,12 @@ ompl::base::PlannerStatus ompl::geometric::PRM::solve(const base::PlannerTermina
         OMPL_ERROR("%s: Unknown type of goal", getName().c_str());
         return base::PlannerStatus::UNRECOGNIZED_GOAL_TYPE;
     }
+    if (!statePool_)
+        statePool_ = si_->acquireStatePool();
 
     // Add the valid start states as milestones
     while (const base::State *st = pis_.nextStart())
-        startM_.push_back(addMilestone(si_->cloneState(st)));
+        startM_.push_back(addMilestone(si_->clonePooledState(st)));
 
     if (startM_.empty())
     {
@@ -414,7 +673,7 @@ ompl::base::PlannerStatus ompl::geometric::PRM::solve(const base::PlannerTermina
     {
         const base::State *st = goalM_.empty() ? pis_.nextGoal(ptc) : pis_.nextGoal();
         if (st != nullptr)
-            goalM_.push_back(addMilestone(si_->cloneState(st)));
+            goalM_.push_back(addMilestone(si_->clonePooledState(st)));
 
         if (goalM_.empty())
         {
@@ -434,8 +693,15 @@ ompl::base::PlannerStatus ompl::geometric::PRM::solve(const base::PlannerTermina
     // construct new planner termination condition that fires when the given ptc is true, or a solution is found
     base::PlannerTerminationCondition ptcOrSolutionFound([this, &ptc] { return ptc || addedNewSolution(); });
 
+    // Start the threads that grow the roadmap for this call
+    if (numThreads_ > 1)
+        workerPool_ = std::make_shared<WorkerPool>(numThreads_);
+
     constructRoadmap(ptcOrSolutionFound);
 
+    // Stop the threads that grow the roadmap
+    workerPool_.reset();
+
     // Ensure slnThread is ceased before exiting solve
     slnThread.join();
 
@@ -500,6 +766,7 @@ void ompl::geometric::PRM::constructRoadmap(const base::PlannerTerminationCondit
 
 ompl::geometric::PRM::Vertex ompl::geometric::PRM::addMilestone(base::State *state)
 {
+    OMPL_TRACE_SCOPE("PRM::addMilestone");
     std::lock_guard<std::mutex> _(graphMutex_);
 
     Vertex m = boost::add_vertex(g_);
@@ -675,10 +942,12 @@ void ompl::geometric::PRM::getPlannerData(base::PlannerData &data) const
     {
         const Vertex v1 = boost::source(e, g_);
         const Vertex v2 = boost::target(e, g_);
-        data.addEdge(base::PlannerDataVertex(stateProperty_[v1]), base::PlannerDataVertex(stateProperty_[v2]));
+        data.addEdge(base::PlannerDataVertex(stateProperty_[v1]), base::PlannerDataVertex(stateProperty_[v2]),
+                     base::PlannerDataEdge(), weightProperty_[e]);
 
         // Add the reverse edge, since we're constructing an undirected roadmap
-        data.addEdge(base::PlannerDataVertex(stateProperty_[v2]), base::PlannerDataVertex(stateProperty_[v1]));
+        data.addEdge(base::PlannerDataVertex(stateProperty_[v2]), base::PlannerDataVertex(stateProperty_[v1]),
+                     base::PlannerDataEdge(), weightProperty_[e]);
 
         // Add tags for the newly added vertices
         data.tagState(stateProperty_[v1], const_cast<PRM *>(this)->disjointSets_.find_set(v1));
@@ -41,3 +41,9 @@ ompl::geometric::PRMstar::PRMstar(const base::SpaceInformationPtr &si) : PRM(si,
     setName("PRMstar");
     params_.remove("max_nearest_neighbors");
 }
+
+ompl::geometric::PRMstar::PRMstar(const base::PlannerData &data) : PRM(data, true)
+{
+    setName("PRMstar");
+    params_.remove("max_nearest_neighbors");
+}
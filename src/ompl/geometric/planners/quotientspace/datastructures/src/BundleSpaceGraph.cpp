@@ -374,7 +374,8 @@ void ompl::geometric::BundleSpaceGraph::getPathDenseGraphPath(const Vertex &star
                                     return opt_->combineCosts(c1.getCost(), c2.getCost());
                                 })
                                 .distance_inf(opt_->infiniteCost())
-                                .distance_zero(opt_->identityCost()));
+                                .distance_zero(opt_->identityCost())
+                                .visitor(boost::make_astar_visitor(boost::null_visitor())));
     }
     catch (BundleSpaceGraphFoundGoal &)
     {
@@ -413,7 +414,8 @@ ompl::base::PathPtr ompl::geometric::BundleSpaceGraph::getPath(const Vertex &sta
                                     return opt_->combineCosts(c1.getCost(), c2.getCost());
                                 })
                                 .distance_inf(opt_->infiniteCost())
-                                .distance_zero(opt_->identityCost()));
+                                .distance_zero(opt_->identityCost())
+                                .visitor(boost::make_astar_visitor(boost::null_visitor())));
     }
     catch (BundleSpaceGraphFoundGoal &)
     {
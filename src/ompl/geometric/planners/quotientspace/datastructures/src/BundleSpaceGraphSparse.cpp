@@ -197,7 +197,8 @@ ompl::base::PathPtr ompl::geometric::BundleSpaceGraphSparse::getPathSparse(const
                                     return opt_->combineCosts(c1.getCost(), c2.getCost());
                                 })
                                 .distance_inf(opt_->infiniteCost())
-                                .distance_zero(opt_->identityCost()));
+                                .distance_zero(opt_->identityCost())
+                                .visitor(boost::make_astar_visitor(boost::null_visitor())));
     }
     catch (BundleSpaceGraphFoundGoal &)
     {
@@ -149,8 +149,8 @@ namespace ompl
             public:
                 Motion() = default;
 
-                /** \brief Constructor that allocates memory for the state */
-                Motion(const base::SpaceInformationPtr &si) : state(si->allocState())
+                /** \brief Constructor that allocates memory for the state (from the state pool, if enabled) */
+                Motion(const base::SpaceInformationPtr &si) : state(si->allocPooledState())
                 {
                 }
 
@@ -175,6 +175,9 @@ namespace ompl
             /** \brief State sampler */
             base::StateSamplerPtr sampler_;
 
+            /** \brief The state pool motion states are allocated from, while this planner is registered as a user */
+            base::StatePoolPtr statePool_;
+
             /** \brief A nearest-neighbors datastructure containing the tree of motions */
             std::shared_ptr<NearestNeighbors<Motion *>> nn_;
 
@@ -41,6 +41,7 @@
 #include "ompl/base/OptimizationObjective.h"
 #include "ompl/datastructures/NearestNeighbors.h"
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 #include <queue>
@@ -166,6 +167,23 @@ namespace ompl
                 return delayCC_;
             }
 
+            /** \brief Set the number of threads used to check the motions between a new state and its neighbors.
+                With more than one thread, the candidate parents of a new state are checked concurrently, and the
+                planner takes the lowest-cost valid parent as soon as its result is known (with delayed collision
+                checking) or once all results are in. The rewiring checks of a new state are batched the same way.
+                The tree is only changed by the calling thread, and it is the same as with a single thread. The
+                state validity checker must be safe to call from several threads at once. */
+            void setNumCollisionCheckThreads(unsigned int numThreads)
+            {
+                numCollisionCheckThreads_ = std::max(numThreads, 1u);
+            }
+
+            /** \brief Get the number of threads used to check the motions between a new state and its neighbors */
+            unsigned int getNumCollisionCheckThreads() const
+            {
+                return numCollisionCheckThreads_;
+            }
+
             /** \brief Controls whether the tree is pruned during the search. This pruning removes
                 a vertex if and only if it \e and all its descendents passes the pruning condition.
                 The pruning condition is whether the lower-bounding estimate of a solution
@@ -335,7 +353,7 @@ namespace ompl
             public:
                 /** \brief Constructor that allocates memory for the state. This constructor automatically allocates
                  * memory for \e state, \e cost, and \e incCost */
-                Motion(const base::SpaceInformationPtr &si) : state(si->allocState()), parent(nullptr), inGoal(false)
+                Motion(const base::SpaceInformationPtr &si) : state(si->allocPooledState()), parent(nullptr), inGoal(false)
                 {
                 }
 
@@ -428,6 +446,9 @@ namespace ompl
             /** \brief An informed sampler */
             base::InformedSamplerPtr infSampler_;
 
+            /** \brief The state pool motion states are allocated from, while this planner is registered as a user */
+            base::StatePoolPtr statePool_;
+
             /** \brief A nearest-neighbors datastructure containing the tree of motions */
             std::shared_ptr<NearestNeighbors<Motion *>> nn_;
 
@@ -457,6 +478,9 @@ namespace ompl
             /** \brief Option to delay and reduce collision checking within iterations */
             bool delayCC_{true};
 
+            /** \brief Number of threads checking the motions to the neighbors of a new state */
+            unsigned int numCollisionCheckThreads_{1u};
+
             /** \brief Objective we're optimizing */
             base::OptimizationObjectivePtr opt_;
 
@@ -122,7 +122,8 @@ namespace ompl
                 return threadCount_;
             }
 
-            /** \brief Set a different nearest neighbors datastructure */
+            /** \brief Set a different nearest neighbors datastructure. Unless the datastructure is
+                ompl::NearestNeighborsConcurrent, the threads serialize their accesses to it with a lock. */
             template <template <typename T> class NN>
             void setNearestNeighbors()
             {
@@ -169,8 +170,13 @@ namespace ompl
 
             base::StateSamplerArray<base::StateSampler> samplerArray_;
             std::shared_ptr<NearestNeighbors<Motion *>> nn_;
+
+            /** \brief Lock for nn_, used only if nn_ does not support concurrent access */
             std::mutex nnLock_;
 
+            /** \brief Flag indicating whether nn_ supports concurrent queries and insertions */
+            bool nnConcurrent_{false};
+
             unsigned int threadCount_;
 
             double goalBias_{.05};
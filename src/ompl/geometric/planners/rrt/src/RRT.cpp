@@ -38,6 +38,7 @@
 #include <limits>
 #include "ompl/base/goals/GoalSampleableRegion.h"
 #include "ompl/tools/config/SelfConfig.h"
+#include "ompl/util/Tracer.h"
 
 ompl::geometric::RRT::RRT(const base::SpaceInformationPtr &si, bool addIntermediateStates)
   : base::Planner(si, addIntermediateStates ? "RRTintermediate" : "RRT")
@@ -56,6 +57,7 @@ ompl::geometric::RRT::RRT(const base::SpaceInformationPtr &si, bool addIntermedi
 ompl::geometric::RRT::~RRT()
 {
     freeMemory();
+    base::SpaceInformation::releaseStatePool(statePool_, false);
 }
 
 void ompl::geometric::RRT::clear()
@@ -63,6 +65,7 @@ void ompl::geometric::RRT::clear()
     Planner::clear();
     sampler_.reset();
     freeMemory();
+    base::SpaceInformation::releaseStatePool(statePool_);
     if (nn_)
         nn_->clear();
     lastGoalMotion_ = nullptr;
@@ -88,7 +91,7 @@ void ompl::geometric::RRT::freeMemory()
         for (auto &motion : motions)
         {
             if (motion->state != nullptr)
-                si_->freeState(motion->state);
+                si_->freePooledState(motion->state);
             delete motion;
         }
     }
@@ -97,6 +100,8 @@ void ompl::geometric::RRT::freeMemory()
 ompl::base::PlannerStatus ompl::geometric::RRT::solve(const base::PlannerTerminationCondition &ptc)
 {
     checkValidity();
+    if (!statePool_)
+        statePool_ = si_->acquireStatePool();
     base::Goal *goal = pdef_->getGoal().get();
     auto *goal_s = dynamic_cast<base::GoalSampleableRegion *>(goal);
 
@@ -121,20 +126,30 @@ ompl::base::PlannerStatus ompl::geometric::RRT::solve(const base::PlannerTermina
     Motion *solution = nullptr;
     Motion *approxsol = nullptr;
     double approxdif = std::numeric_limits<double>::infinity();
-    auto *rmotion = new Motion(si_);
+    auto *rmotion = new Motion;
+    rmotion->state = si_->allocScratchState();
     base::State *rstate = rmotion->state;
-    base::State *xstate = si_->allocState();
+    base::State *xstate = si_->allocScratchState();
 
     while (!ptc)
     {
+        OMPL_TRACE_SCOPE("RRT::iteration");
+
         /* sample random state (with goal biasing) */
-        if ((goal_s != nullptr) && rng_.uniform01() < goalBias_ && goal_s->canSample())
-            goal_s->sampleGoal(rstate);
-        else
-            sampler_->sampleUniform(rstate);
+        {
+            OMPL_TRACE_SCOPE("sample");
+            if ((goal_s != nullptr) && rng_.uniform01() < goalBias_ && goal_s->canSample())
+                goal_s->sampleGoal(rstate);
+            else
+                sampler_->sampleUniform(rstate);
+        }
 
         /* find closest state in the tree */
-        Motion *nmotion = nn_->nearest(rmotion);
+        Motion *nmotion;
+        {
+            OMPL_TRACE_SCOPE("nearest");
+            nmotion = nn_->nearest(rmotion);
+        }
         base::State *dstate = rstate;
 
         /* find state to add */
@@ -149,16 +164,18 @@ ompl::base::PlannerStatus ompl::geometric::RRT::solve(const base::PlannerTermina
         {
             if (addIntermediateStates_)
             {
-                std::vector<base::State *> states;
-                const unsigned int count = si_->getStateSpace()->validSegmentCount(nmotion->state, dstate);
-
-                if (si_->getMotionStates(nmotion->state, dstate, states, count, true, true))
-                    si_->freeState(states[0]);
+                // interpolate straight into the states of the new motions, as getMotionStates() would
+                const base::State *from = nmotion->state;
+                const unsigned int count = si_->getStateSpace()->validSegmentCount(from, dstate);
 
-                for (std::size_t i = 1; i < states.size(); ++i)
+                for (unsigned int j = 1; j <= count + 1; ++j)
                 {
-                    auto *motion = new Motion;
-                    motion->state = states[i];
+                    auto *motion = new Motion(si_);
+                    if (j <= count)
+                        si_->getStateSpace()->interpolate(from, dstate, (double)j / (double)(count + 1),
+                                                          motion->state);
+                    else
+                        si_->copyState(motion->state, dstate);
                     motion->parent = nmotion;
                     nn_->add(motion);
 
@@ -219,9 +236,8 @@ ompl::base::PlannerStatus ompl::geometric::RRT::solve(const base::PlannerTermina
         solved = true;
     }
 
-    si_->freeState(xstate);
-    if (rmotion->state != nullptr)
-        si_->freeState(rmotion->state);
+    si_->freeScratchState(xstate);
+    si_->freeScratchState(rstate);
     delete rmotion;
 
     OMPL_INFORM("%s: Created %u states", getName().c_str(), nn_->size());
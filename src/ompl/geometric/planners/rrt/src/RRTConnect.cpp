@@ -38,6 +38,7 @@
 #include "ompl/base/goals/GoalSampleableRegion.h"
 #include "ompl/tools/config/SelfConfig.h"
 #include "ompl/util/String.h"
+#include "ompl/util/Tracer.h"
 
 ompl::geometric::RRTConnect::RRTConnect(const base::SpaceInformationPtr &si, bool addIntermediateStates)
   : base::Planner(si, addIntermediateStates ? "RRTConnectIntermediate" : "RRTConnect")
@@ -116,8 +117,14 @@ void ompl::geometric::RRTConnect::clear()
 ompl::geometric::RRTConnect::GrowState ompl::geometric::RRTConnect::growTree(TreeData &tree, TreeGrowingInfo &tgi,
                                                                              Motion *rmotion)
 {
+    OMPL_TRACE_SCOPE("RRTConnect::growTree");
+
     /* find closest state in the tree */
-    Motion *nmotion = tree->nearest(rmotion);
+    Motion *nmotion;
+    {
+        OMPL_TRACE_SCOPE("nearest");
+        nmotion = tree->nearest(rmotion);
+    }
 
     /* assume we can reach the state we go towards */
     bool reach = true;
@@ -150,16 +157,16 @@ ompl::geometric::RRTConnect::GrowState ompl::geometric::RRTConnect::growTree(Tre
         const base::State *astate = tgi.start ? nmotion->state : dstate;
         const base::State *bstate = tgi.start ? dstate : nmotion->state;
 
-        std::vector<base::State *> states;
+        // interpolate straight into the states of the new motions, as getMotionStates() would
         const unsigned int count = si_->getStateSpace()->validSegmentCount(astate, bstate);
 
-        if (si_->getMotionStates(astate, bstate, states, count, true, true))
-            si_->freeState(states[0]);
-
-        for (std::size_t i = 1; i < states.size(); ++i)
+        for (unsigned int j = 1; j <= count + 1; ++j)
         {
-            auto *motion = new Motion;
-            motion->state = states[i];
+            auto *motion = new Motion(si_);
+            if (j <= count)
+                si_->getStateSpace()->interpolate(astate, bstate, (double)j / (double)(count + 1), motion->state);
+            else
+                si_->copyState(motion->state, bstate);
             motion->parent = nmotion;
             motion->root = nmotion->root;
             tree->add(motion);
@@ -221,11 +228,12 @@ ompl::base::PlannerStatus ompl::geometric::RRTConnect::solve(const base::Planner
                 (int)(tStart_->size() + tGoal_->size()));
 
     TreeGrowingInfo tgi;
-    tgi.xstate = si_->allocState();
+    tgi.xstate = si_->allocScratchState();
 
     Motion *approxsol = nullptr;
     double approxdif = std::numeric_limits<double>::infinity();
-    auto *rmotion = new Motion(si_);
+    auto *rmotion = new Motion;
+    rmotion->state = si_->allocScratchState();
     base::State *rstate = rmotion->state;
     bool startTree = true;
     bool solved = false;
@@ -256,7 +264,10 @@ ompl::base::PlannerStatus ompl::geometric::RRTConnect::solve(const base::Planner
         }
 
         /* sample random state */
-        sampler_->sampleUniform(rstate);
+        {
+            OMPL_TRACE_SCOPE("sample");
+            sampler_->sampleUniform(rstate);
+        }
 
         GrowState gs = growTree(tree, tgi, rmotion);
 
@@ -347,8 +358,8 @@ ompl::base::PlannerStatus ompl::geometric::RRTConnect::solve(const base::Planner
         }
     }
 
-    si_->freeState(tgi.xstate);
-    si_->freeState(rstate);
+    si_->freeScratchState(tgi.xstate);
+    si_->freeScratchState(rstate);
     delete rmotion;
 
     OMPL_INFORM("%s: Created %u states (%u start + %u goal)", getName().c_str(), tStart_->size() + tGoal_->size(),
@@ -36,8 +36,13 @@
 
 #include "ompl/geometric/planners/rrt/RRTstar.h"
 #include <algorithm>
+#include <atomic>
 #include <boost/math/constants/constants.hpp>
+#include <condition_variable>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include "ompl/base/Goal.h"
 #include "ompl/base/goals/GoalSampleableRegion.h"
@@ -49,6 +54,214 @@
 #include "ompl/tools/config/SelfConfig.h"
 #include "ompl/util/GeometricEquations.h"
 
+/// @cond IGNORE
+namespace
+{
+    /* Checks batches of motions on a set of worker threads. The thread that submits a batch helps
+       with the checks while it waits for the result it needs next. Workers stay at most a given
+       number of motions ahead of that result, which bounds the checks wasted when the submitting
+       thread stops at the first valid motion. Threads that have nothing to check block on condition
+       variables until there is. */
+    class MotionCheckPool
+    {
+    public:
+        MotionCheckPool(const ompl::base::SpaceInformation *si, unsigned int numThreads) : si_(si)
+        {
+            for (unsigned int i = 1; i < numThreads; ++i)
+                workers_.emplace_back([this] { run(); });
+        }
+
+        ~MotionCheckPool()
+        {
+            {
+                std::lock_guard<std::mutex> slock(lock_);
+                stop_ = true;
+            }
+            wakeUp_.notify_all();
+            for (auto &worker : workers_)
+                worker.join();
+        }
+
+        /* Add the motion from \e s1 to \e s2 to the next batch. A non-zero \e known result (1 for
+           valid, -1 for invalid) is used as is, without checking the motion. */
+        void add(const ompl::base::State *s1, const ompl::base::State *s2, int known = 0)
+        {
+            pending_.push_back(Check{s1, s2, known});
+        }
+
+        /* Start checking the motions added since the last call, in the order they were added. No
+           motion is checked more than \e lookahead positions past the result waited for. */
+        void start(std::size_t lookahead = std::numeric_limits<std::size_t>::max())
+        {
+            {
+                std::unique_lock<std::mutex> slock(lock_);
+
+                // a worker may still be leaving the previous batch
+                idle_.wait(slock, [this] { return busy_ == 0; });
+
+                checks_.swap(pending_);
+                pending_.clear();
+                if (capacity_ < checks_.size())
+                {
+                    capacity_ = checks_.size();
+                    results_.reset(new std::atomic<int>[capacity_]);
+                }
+                for (std::size_t i = 0; i < checks_.size(); ++i)
+                    results_[i].store(checks_[i].known, std::memory_order_relaxed);
+                size_ = checks_.size();
+                lookahead_ = lookahead;
+                waitingFor_.store(0);
+                next_.store(0);
+                ++batch_;
+            }
+            wakeUp_.notify_all();
+        }
+
+        /* Wait for motion \e k of the current batch to be checked, and return whether it is valid */
+        bool valid(std::size_t k)
+        {
+            waitingFor_.store(k);
+            // workers held back by the lookahead may continue
+            if (blocked_.load() != 0)
+            {
+                {
+                    std::lock_guard<std::mutex> slock(lock_);
+                }
+                progress_.notify_all();
+            }
+
+            int r;
+            while ((r = results_[k].load(std::memory_order_acquire)) == 0)
+                if (!checkNext())
+                {
+                    // motion k is being checked by a worker
+                    std::unique_lock<std::mutex> slock(lock_);
+                    checked_.wait(slock, [this, k] { return results_[k].load() != 0; });
+                }
+            return r > 0;
+        }
+
+        /* Cancel the checks of the current batch that have not started yet, and wait for the others
+           to finish. Afterwards, result() is final. */
+        void finish()
+        {
+            next_.store(size_);
+            std::unique_lock<std::mutex> slock(lock_);
+            progress_.notify_all();
+            idle_.wait(slock, [this] { return busy_ == 0; });
+        }
+
+        /* Result of motion \e k of the current batch: 1 if valid, -1 if invalid and 0 if not checked */
+        int result(std::size_t k) const
+        {
+            return results_[k].load(std::memory_order_acquire);
+        }
+
+    private:
+        struct Check
+        {
+            const ompl::base::State *s1;
+            const ompl::base::State *s2;
+            int known;
+        };
+
+        void run()
+        {
+            unsigned long seen = 0;
+            std::unique_lock<std::mutex> slock(lock_);
+            while (true)
+            {
+                wakeUp_.wait(slock, [this, seen] { return stop_ || batch_ != seen; });
+                if (stop_)
+                    return;
+                seen = batch_;
+                ++busy_;
+
+                while (next_.load() < size_)
+                {
+                    slock.unlock();
+                    while (checkNext())
+                        ;
+                    slock.lock();
+
+                    // wait for the submitting thread to move on, unless the batch is done meanwhile
+                    ++blocked_;
+                    progress_.wait(slock, [this] { return next_.load() >= size_ || canCheck(next_.load()); });
+                    --blocked_;
+                }
+
+                if (--busy_ == 0)
+                    idle_.notify_all();
+            }
+        }
+
+        /* Whether motion \e k may be checked, given the result the submitting thread waits for */
+        bool canCheck(std::size_t k) const
+        {
+            std::size_t front = waitingFor_.load();
+            return k < size_ && (k <= front || k - front < lookahead_);
+        }
+
+        /* Check the next motion of the current batch; returns false if there is none to check yet */
+        bool checkNext()
+        {
+            std::size_t k = next_.load();
+            do
+            {
+                if (!canCheck(k))
+                    return false;
+            } while (!next_.compare_exchange_weak(k, k + 1));
+            if (results_[k].load(std::memory_order_relaxed) == 0)
+            {
+                results_[k].store(si_->checkMotion(checks_[k].s1, checks_[k].s2) ? 1 : -1);
+                // wake the submitting thread if it waits for this result
+                if (waitingFor_.load() == k)
+                {
+                    {
+                        std::lock_guard<std::mutex> slock(lock_);
+                    }
+                    checked_.notify_all();
+                }
+            }
+            return true;
+        }
+
+        const ompl::base::SpaceInformation *si_;
+
+        std::vector<std::thread> workers_;
+
+        std::mutex lock_;
+        std::condition_variable wakeUp_;
+        bool stop_{false};
+        unsigned long batch_{0};
+
+        /* Number of workers taking part in a batch, and the condition signalled when it drops to zero */
+        unsigned int busy_{0};
+        std::condition_variable idle_;
+
+        /* Number of workers held back by the lookahead, and the condition signalled when the
+           submitting thread waits for a later result */
+        std::atomic<unsigned int> blocked_{0};
+        std::condition_variable progress_;
+
+        /* Signalled when the result the submitting thread waits for is known */
+        std::condition_variable checked_;
+
+        std::vector<Check> pending_;
+        std::vector<Check> checks_;
+        std::size_t size_{0};
+        std::size_t lookahead_{0};
+        std::atomic<std::size_t> next_{0};
+
+        /* The result the submitting thread waits for */
+        std::atomic<std::size_t> waitingFor_{0};
+
+        std::unique_ptr<std::atomic<int>[]> results_;
+        std::size_t capacity_{0};
+    };
+}
+/// @endcond
+
 ompl::geometric::RRTstar::RRTstar(const base::SpaceInformationPtr &si)
   : base::Planner(si, "RRTstar")
 {
@@ -81,6 +294,8 @@ ompl::geometric::RRTstar::RRTstar(const base::SpaceInformationPtr &si)
     Planner::declareParam<bool>("focus_search", this, &RRTstar::setFocusSearch, &RRTstar::getFocusSearch, "0,1");
     Planner::declareParam<unsigned int>("number_sampling_attempts", this, &RRTstar::setNumSamplingAttempts,
                                         &RRTstar::getNumSamplingAttempts, "10:10:100000");
+    Planner::declareParam<unsigned int>("collision_check_threads", this, &RRTstar::setNumCollisionCheckThreads,
+                                        &RRTstar::getNumCollisionCheckThreads, "1:1:64");
 
     addPlannerProgressProperty("iterations INTEGER", [this] { return numIterationsProperty(); });
     addPlannerProgressProperty("best cost REAL", [this] { return bestCostProperty(); });
@@ -89,6 +304,7 @@ ompl::geometric::RRTstar::RRTstar(const base::SpaceInformationPtr &si)
 ompl::geometric::RRTstar::~RRTstar()
 {
     freeMemory();
+    base::SpaceInformation::releaseStatePool(statePool_, false);
 }
 
 void ompl::geometric::RRTstar::setup()
@@ -149,6 +365,7 @@ void ompl::geometric::RRTstar::clear()
     sampler_.reset();
     infSampler_.reset();
     freeMemory();
+    base::SpaceInformation::releaseStatePool(statePool_);
     if (nn_)
         nn_->clear();
 
@@ -165,6 +382,8 @@ void ompl::geometric::RRTstar::clear()
 ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTerminationCondition &ptc)
 {
     checkValidity();
+    if (!statePool_)
+        statePool_ = si_->acquireStatePool();
     base::Goal *goal = pdef_->getGoal().get();
     auto *goal_s = dynamic_cast<base::GoalSampleableRegion *>(goal);
 
@@ -244,6 +463,10 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
     // our functor for sorting nearest neighbors
     CostIndexCompare compareFn(costs, *opt_);
 
+    std::unique_ptr<MotionCheckPool> checkPool;
+    if (numCollisionCheckThreads_ > 1)
+        checkPool.reset(new MotionCheckPool(si_.get(), numCollisionCheckThreads_));
+
     while (ptc == false)
     {
         iterations_++;
@@ -339,21 +562,103 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
                 // neighbors are valid. This is fine, because motion
                 // already has a connection to the tree through
                 // nmotion (with populated cost fields!).
-                for (std::vector<std::size_t>::const_iterator i = sortedCostIndices.begin();
-                     i != sortedCostIndices.begin() + nbh.size(); ++i)
+                if (checkPool)
+                {
+                    // check the candidates concurrently, but take them in order of cost
+                    for (std::size_t k = 0; k < nbh.size(); ++k)
+                    {
+                        Motion *candidate = nbh[sortedCostIndices[k]];
+                        int known = 0;
+                        if (candidate == nmotion)
+                            known = 1;
+                        else if (useKNearest_ && si_->distance(candidate->state, motion->state) >= maxDistance_)
+                            known = -1;
+                        checkPool->add(candidate->state, motion->state, known);
+                    }
+                    checkPool->start(numCollisionCheckThreads_);
+                    for (std::size_t k = 0; k < nbh.size(); ++k)
+                        if (checkPool->valid(k))
+                        {
+                            std::size_t i = sortedCostIndices[k];
+                            motion->incCost = incCosts[i];
+                            motion->cost = costs[i];
+                            motion->parent = nbh[i];
+                            break;
+                        }
+                    checkPool->finish();
+
+                    // keep the results of the checks that completed, for rewiring
+                    for (std::size_t k = 0; k < nbh.size(); ++k)
+                        valid[sortedCostIndices[k]] = checkPool->result(k);
+                }
+                else
+                {
+                    for (std::vector<std::size_t>::const_iterator i = sortedCostIndices.begin();
+                         i != sortedCostIndices.begin() + nbh.size(); ++i)
+                    {
+                        if (nbh[*i] == nmotion ||
+                            ((!useKNearest_ || si_->distance(nbh[*i]->state, motion->state) < maxDistance_) &&
+                             si_->checkMotion(nbh[*i]->state, motion->state)))
+                        {
+                            motion->incCost = incCosts[*i];
+                            motion->cost = costs[*i];
+                            motion->parent = nbh[*i];
+                            valid[*i] = 1;
+                            break;
+                        }
+                        else
+                            valid[*i] = -1;
+                    }
+                }
+            }
+            else if (checkPool)
+            {
+                motion->incCost = opt_->motionCost(nmotion->state, motion->state);
+                motion->cost = opt_->combineCosts(nmotion->cost, motion->incCost);
+
+                // check the neighbors that would be better parents concurrently, in order of cost;
+                // among equal costs the first neighbor wins, as it does in the loop below
+                std::size_t numChecks = 0;
+                for (std::size_t i = 0; i < nbh.size(); ++i)
                 {
-                    if (nbh[*i] == nmotion ||
-                        ((!useKNearest_ || si_->distance(nbh[*i]->state, motion->state) < maxDistance_) &&
-                         si_->checkMotion(nbh[*i]->state, motion->state)))
+                    if (nbh[i] != nmotion)
                     {
-                        motion->incCost = incCosts[*i];
-                        motion->cost = costs[*i];
-                        motion->parent = nbh[*i];
-                        valid[*i] = 1;
-                        break;
+                        incCosts[i] = opt_->motionCost(nbh[i]->state, motion->state);
+                        costs[i] = opt_->combineCosts(nbh[i]->cost, incCosts[i]);
+                        if (opt_->isCostBetterThan(costs[i], motion->cost))
+                            sortedCostIndices[numChecks++] = i;
                     }
                     else
-                        valid[*i] = -1;
+                    {
+                        incCosts[i] = motion->incCost;
+                        costs[i] = motion->cost;
+                        valid[i] = 1;
+                    }
+                }
+                std::stable_sort(sortedCostIndices.begin(), sortedCostIndices.begin() + numChecks, compareFn);
+
+                for (std::size_t k = 0; k < numChecks; ++k)
+                {
+                    Motion *candidate = nbh[sortedCostIndices[k]];
+                    bool inRange =
+                        !useKNearest_ || si_->distance(candidate->state, motion->state) < maxDistance_;
+                    checkPool->add(candidate->state, motion->state, inRange ? 0 : -1);
+                }
+                if (numChecks > 0)
+                {
+                    checkPool->start(numCollisionCheckThreads_);
+                    for (std::size_t k = 0; k < numChecks; ++k)
+                        if (checkPool->valid(k))
+                        {
+                            std::size_t i = sortedCostIndices[k];
+                            motion->incCost = incCosts[i];
+                            motion->cost = costs[i];
+                            motion->parent = nbh[i];
+                            break;
+                        }
+                    checkPool->finish();
+                    for (std::size_t k = 0; k < numChecks; ++k)
+                        valid[sortedCostIndices[k]] = checkPool->result(k);
                 }
             }
             else  // if not delayCC
@@ -399,7 +704,7 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
                 }
                 else  // If the new motion does not improve the best cost it is ignored.
                 {
-                    si_->freeState(motion->state);
+                    si_->freePooledState(motion->state);
                     delete motion;
                     continue;
                 }
@@ -411,6 +716,30 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
                 motion->parent->children.push_back(motion);
             }
 
+            // check all the rewiring candidates at once; the loop below then finds their results in valid
+            if (checkPool)
+            {
+                std::size_t numChecks = 0;
+                for (std::size_t i = 0; i < nbh.size(); ++i)
+                {
+                    if (nbh[i] == motion->parent || valid[i] != 0)
+                        continue;
+                    base::Cost nbhIncCost = symCost ? incCosts[i] : opt_->motionCost(motion->state, nbh[i]->state);
+                    if (!opt_->isCostBetterThan(opt_->combineCosts(motion->cost, nbhIncCost), nbh[i]->cost))
+                        continue;
+                    sortedCostIndices[numChecks++] = i;
+                    bool inRange = !useKNearest_ || si_->distance(nbh[i]->state, motion->state) < maxDistance_;
+                    checkPool->add(motion->state, nbh[i]->state, inRange ? 0 : -1);
+                }
+                if (numChecks > 0)
+                {
+                    checkPool->start();
+                    for (std::size_t k = 0; k < numChecks; ++k)
+                        valid[sortedCostIndices[k]] = checkPool->valid(k) ? 1 : -1;
+                    checkPool->finish();
+                }
+            }
+
             bool checkForSolution = false;
             for (std::size_t i = 0; i < nbh.size(); ++i)
             {
@@ -525,6 +854,19 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
 
                         intermediateSolutionCallback(this, spath, bestCost_);
                     }
+
+                    // Only construct the path if somebody listens for improvements
+                    if (pdef_->getSolutionChannel()->hasSubscribers())
+                    {
+                        std::vector<Motion *> mpath;
+                        for (Motion *m = bestGoalMotion_; m != nullptr; m = m->parent)
+                            mpath.push_back(m);
+
+                        auto path(std::make_shared<PathGeometric>(si_));
+                        for (auto it = mpath.rbegin(); it != mpath.rend(); ++it)
+                            path->append((*it)->state);
+                        pdef_->getSolutionChannel()->publish(path, bestCost_, getName(), opt_.get());
+                    }
                 }
             }
 
@@ -589,7 +931,7 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
 
     si_->freeState(xstate);
     if (rmotion->state)
-        si_->freeState(rmotion->state);
+        si_->freePooledState(rmotion->state);
     delete rmotion;
 
     OMPL_INFORM("%s: Created %u new states. Checked %u rewire options. %u goal states in tree. Final solution cost "
@@ -647,7 +989,7 @@ void ompl::geometric::RRTstar::freeMemory()
         for (auto &motion : motions)
         {
             if (motion->state)
-                si_->freeState(motion->state);
+                si_->freePooledState(motion->state);
             delete motion;
         }
     }
@@ -813,7 +1155,7 @@ int ompl::geometric::RRTstar::pruneTree(const base::Cost &pruneTreeCost)
 
                 // Erase the actual motion
                 // First free the state
-                si_->freeState(leavesToPrune.front()->state);
+                si_->freePooledState(leavesToPrune.front()->state);
 
                 // then delete the pointer
                 delete leavesToPrune.front();
@@ -37,6 +37,7 @@
 #include "ompl/geometric/planners/rrt/pRRT.h"
 #include "ompl/base/goals/GoalSampleableRegion.h"
 #include "ompl/tools/config/SelfConfig.h"
+#include "ompl/datastructures/NearestNeighborsConcurrent.h"
 #include <limits>
 
 ompl::geometric::pRRT::pRRT(const base::SpaceInformationPtr &si) : base::Planner(si, "pRRT"), samplerArray_(si)
@@ -69,6 +70,7 @@ void ompl::geometric::pRRT::setup()
                              {
                                  return distanceFunction(a, b);
                              });
+    nnConcurrent_ = dynamic_cast<NearestNeighborsConcurrent<Motion *> *>(nn_.get()) != nullptr;
 }
 
 void ompl::geometric::pRRT::clear()
@@ -116,9 +118,14 @@ void ompl::geometric::pRRT::threadSolve(unsigned int tid, const base::PlannerTer
             samplerArray_[tid]->sampleUniform(rstate);
 
         /* find closest state in the tree */
-        nnLock_.lock();
-        Motion *nmotion = nn_->nearest(rmotion);
-        nnLock_.unlock();
+        Motion *nmotion;
+        if (nnConcurrent_)
+            nmotion = nn_->nearest(rmotion);
+        else
+        {
+            std::lock_guard<std::mutex> slock(nnLock_);
+            nmotion = nn_->nearest(rmotion);
+        }
         base::State *dstate = rstate;
 
         /* find state to add */
@@ -136,9 +143,13 @@ void ompl::geometric::pRRT::threadSolve(unsigned int tid, const base::PlannerTer
             si_->copyState(motion->state, dstate);
             motion->parent = nmotion;
 
-            nnLock_.lock();
-            nn_->add(motion);
-            nnLock_.unlock();
+            if (nnConcurrent_)
+                nn_->add(motion);
+            else
+            {
+                std::lock_guard<std::mutex> slock(nnLock_);
+                nn_->add(motion);
+            }
 
             double dist = 0.0;
             bool solved = goal->isSatisfied(motion->state, &dist);
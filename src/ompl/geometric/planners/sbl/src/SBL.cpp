@@ -115,7 +115,7 @@ ompl::base::PlannerStatus ompl::geometric::SBL::solve(const base::PlannerTermina
                 (int)(tStart_.size + tGoal_.size));
 
     std::vector<Motion *> solution;
-    base::State *xstate = si_->allocState();
+    base::State *xstate = si_->allocScratchState();
 
     bool startTree = true;
     bool solved = false;
@@ -171,7 +171,7 @@ ompl::base::PlannerStatus ompl::geometric::SBL::solve(const base::PlannerTermina
         }
     }
 
-    si_->freeState(xstate);
+    si_->freeScratchState(xstate);
 
     OMPL_INFORM("%s: Created %u (%u start + %u goal) states in %u cells (%u start + %u goal)", getName().c_str(),
                 tStart_.size + tGoal_.size, tStart_.size, tGoal_.size, tStart_.grid.size() + tGoal_.grid.size(),
@@ -39,6 +39,7 @@
 
 #include "ompl/geometric/SimpleSetup.h"
 #include "ompl/control/SimpleSetup.h"
+#include "ompl/tools/benchmark/MachineSpecs.h"
 
 namespace ompl
 {
@@ -86,6 +87,12 @@ namespace ompl
             /** \brief Signature of function that can be called after a planner execution is completed */
             using PostSetupEvent = std::function<void(const base::PlannerPtr &, RunProperties &)>;
 
+            /** \brief Signature of function that constructs a new instance of the benchmarked geometric problem */
+            using GeometricSetupFactory = std::function<geometric::SimpleSetupPtr()>;
+
+            /** \brief Signature of function that constructs a new instance of the benchmarked control problem */
+            using ControlSetupFactory = std::function<control::SimpleSetupPtr()>;
+
             /** \brief The data collected after running a planner multiple times */
             struct PlannerExperiment
             {
@@ -158,7 +165,7 @@ namespace ompl
                 /** \brief Constructor that provides default values for all members */
                 Request(double maxTime = 5.0, double maxMem = 4096.0, unsigned int runCount = 100,
                         double timeBetweenUpdates = 0.05, bool displayProgress = true, bool saveConsoleOutput = true,
-                        bool useThreads = true, bool simplify = true)
+                        bool useThreads = true, bool simplify = true, unsigned int parallelRuns = 1)
                   : maxTime(maxTime)
                   , maxMem(maxMem)
                   , runCount(runCount)
@@ -167,6 +174,7 @@ namespace ompl
                   , saveConsoleOutput(saveConsoleOutput)
                   , useThreads(useThreads)
                   , simplify(simplify)
+                  , parallelRuns(parallelRuns)
                 {
                 }
 
@@ -197,6 +205,15 @@ namespace ompl
 
                 /// \brief flag indicating whether simplification should be applied to path; true by default
                 bool simplify;
+
+                /// \brief the number of runs of a planner to execute at the same time; 1 by default, 0 uses one run
+                /// per hardware thread. Concurrent runs need a setup factory (see Benchmark::setGeometricSetupFactory())
+                /// and planners added with Benchmark::addPlannerAllocator(), since every run plans on a problem
+                /// instance and a planner of its own, as returned by the allocator. Run \e j of planner \e i then seeds all its random number
+                /// generators from a sequence that only depends on \e i, \e j and the benchmark seed, so runs are
+                /// repeatable no matter how they are scheduled. The pre-run and post-run events are called with
+                /// the planner of the run, one run at a time.
+                unsigned int parallelRuns;
             };
 
             /** \brief Constructor needs the SimpleSetup instance needed for planning. Optionally, the experiment name
@@ -257,18 +274,37 @@ namespace ompl
                         (gsetup_ != nullptr ? gsetup_->getSpaceInformation().get() : csetup_->getSpaceInformation().get()))
                     throw Exception("Planner instance does not match space information");
                 planners_.push_back(planner);
+                allocators_.emplace_back();
             }
 
             /** \brief Add a planner allocator to use. */
             void addPlannerAllocator(const base::PlannerAllocator &pa)
             {
                 planners_.push_back(pa(gsetup_ != nullptr ? gsetup_->getSpaceInformation() : csetup_->getSpaceInformation()));
+                allocators_.push_back(pa);
             }
 
             /** \brief Clear the set of planners to be benchmarked */
             void clearPlanners()
             {
                 planners_.clear();
+                allocators_.clear();
+            }
+
+            /** \brief Set the function that constructs the independent problem instances used by concurrent runs
+                (see Request::parallelRuns). Every call must return a new SimpleSetup, with its own state space
+                and state validity checker, that describes the same problem as the one passed to the constructor. */
+            void setGeometricSetupFactory(const GeometricSetupFactory &factory)
+            {
+                gfactory_ = factory;
+            }
+
+            /** \brief Set the function that constructs the independent problem instances used by concurrent runs
+                (see Request::parallelRuns). Every call must return a new SimpleSetup, with its own state space
+                and state validity checker, that describes the same problem as the one passed to the constructor. */
+            void setControlSetupFactory(const ControlSetupFactory &factory)
+            {
+                cfactory_ = factory;
             }
 
             /// Set the event to be called before any runs of a particular planner (when the planner is switched)
@@ -300,6 +336,11 @@ namespace ompl
                 run was freed, the increase in usage may be close to
                 0. To get correct averages for memory usage, use \e
                 req.runCount = 1 and run the process multiple times.
+                When runs execute concurrently, memory usage can only be
+                measured for the whole process: the memory limit of
+                each run is scaled by the number of concurrent runs and
+                the reported values include the memory of the other
+                runs.
             */
             virtual void benchmark(const Request &req);
 
@@ -339,6 +380,15 @@ namespace ompl
             /// The set of planners to be tested
             std::vector<base::PlannerPtr> planners_;
 
+            /// The allocators of the planners to be tested, if they were added as allocators
+            std::vector<base::PlannerAllocator> allocators_;
+
+            /// Constructs problem instances for concurrent runs (if geometric planning)
+            GeometricSetupFactory gfactory_;
+
+            /// Constructs problem instances for concurrent runs (if planning with controls)
+            ControlSetupFactory cfactory_;
+
             /// The collected experimental data (for all planners)
             CompleteExperiment exp_;
 
@@ -353,6 +403,13 @@ namespace ompl
 
             /// Event to be called after the run of a planner
             PostSetupEvent postRun_;
+
+        private:
+            /// Execute the runs of planner \e i on \e workers threads at the same time (see Request::parallelRuns).
+            /// \e reportProgress is called after each run, once the status has been updated.
+            void runConcurrently(unsigned int i, const Request &req, unsigned int workers,
+                                 machine::MemUsage_t memStart, machine::MemUsage_t maxMem,
+                                 const std::function<void()> &reportProgress);
         };
     }
 }
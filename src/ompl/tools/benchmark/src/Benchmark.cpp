@@ -41,6 +41,9 @@
 #include "ompl/util/String.h"
 #include <boost/scoped_ptr.hpp>
 #include <boost/progress.hpp>
+#include <algorithm>
+#include <atomic>
+#include <random>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -73,11 +76,21 @@ namespace ompl
             return true;
         }
 
+        /** \brief The seed for the random number generators of run \e run of planner \e planner, in a benchmark
+         * that started with the random seed \e seed */
+        static std::uint_fast32_t getRunSeed(std::uint_fast32_t seed, unsigned int planner, unsigned int run)
+        {
+            std::seed_seq seq{(std::uint32_t)seed, (std::uint32_t)planner, (std::uint32_t)run};
+            std::uint32_t result;
+            seq.generate(&result, &result + 1);
+            return result > 0 ? result : 1;
+        }
+
         class RunPlanner
         {
         public:
-            RunPlanner(const Benchmark *benchmark)
-              : benchmark_(benchmark), timeUsed_(0.0), memUsed_(0)
+            RunPlanner(const std::string &plannerName, unsigned int run)
+              : plannerName_(plannerName), run_(run), timeUsed_(0.0), memUsed_(0)
             {
             }
 
@@ -146,8 +159,7 @@ namespace ompl
                 catch (std::runtime_error &e)
                 {
                     std::stringstream es;
-                    es << "There was an error executing planner " << benchmark_->getStatus().activePlanner
-                       << ", run = " << benchmark_->getStatus().activeRun << std::endl;
+                    es << "There was an error executing planner " << plannerName_ << ", run = " << run_ << std::endl;
                     es << "*** " << e.what() << std::endl;
                     std::cerr << es.str();
                     OMPL_ERROR(es.str().c_str());
@@ -182,7 +194,8 @@ namespace ompl
                 }
             }
 
-            const Benchmark *benchmark_;
+            std::string plannerName_;
+            unsigned int run_;
             double timeUsed_;
             machine::MemUsage_t memUsed_;
             base::PlannerStatus status_;
@@ -193,6 +206,96 @@ namespace ompl
             std::mutex solvedFlag_;
             std::condition_variable solvedCondition_;
         };
+
+        /** \brief Record the outcome of the run \e rp of \e planner on the problem instance given by \e gsetup or
+         * \e csetup */
+        static void extractRunProperties(geometric::SimpleSetup *gsetup, control::SimpleSetup *csetup,
+                                         const base::PlannerPtr &planner, const RunPlanner &rp, bool simplify,
+                                         Benchmark::RunProperties &run)
+        {
+            bool solved = gsetup ? gsetup->haveSolutionPath() : csetup->haveSolutionPath();
+
+            run["time REAL"] = ompl::toString(rp.getTimeUsed());
+            run["memory REAL"] = ompl::toString((double)rp.getMemUsed() / (1024.0 * 1024.0));
+            run["status ENUM"] = std::to_string((int)static_cast<base::PlannerStatus::StatusType>(rp.getStatus()));
+            if (gsetup)
+            {
+                run["solved BOOLEAN"] = std::to_string(gsetup->haveExactSolutionPath());
+                run["valid segment fraction REAL"] =
+                    ompl::toString(gsetup->getSpaceInformation()->getMotionValidator()->getValidMotionFraction());
+            }
+            else
+            {
+                run["solved BOOLEAN"] = std::to_string(csetup->haveExactSolutionPath());
+                run["valid segment fraction REAL"] =
+                    ompl::toString(csetup->getSpaceInformation()->getMotionValidator()->getValidMotionFraction());
+            }
+
+            if (solved)
+            {
+                if (gsetup)
+                {
+                    run["approximate solution BOOLEAN"] =
+                        std::to_string(gsetup->getProblemDefinition()->hasApproximateSolution());
+                    run["solution difference REAL"] =
+                        ompl::toString(gsetup->getProblemDefinition()->getSolutionDifference());
+                    run["solution length REAL"] = ompl::toString(gsetup->getSolutionPath().length());
+                    run["solution smoothness REAL"] = ompl::toString(gsetup->getSolutionPath().smoothness());
+                    run["solution clearance REAL"] = ompl::toString(gsetup->getSolutionPath().clearance());
+                    run["solution segments INTEGER"] =
+                        std::to_string(gsetup->getSolutionPath().getStateCount() - 1);
+                    run["correct solution BOOLEAN"] = std::to_string(gsetup->getSolutionPath().check());
+
+                    unsigned int factor = gsetup->getStateSpace()->getValidSegmentCountFactor();
+                    gsetup->getStateSpace()->setValidSegmentCountFactor(factor * 4);
+                    run["correct solution strict BOOLEAN"] = std::to_string(gsetup->getSolutionPath().check());
+                    gsetup->getStateSpace()->setValidSegmentCountFactor(factor);
+
+                    if (simplify)
+                    {
+                        // simplify solution
+                        time::point timeStart = time::now();
+                        gsetup->simplifySolution();
+                        double timeUsed = time::seconds(time::now() - timeStart);
+                        run["simplification time REAL"] = ompl::toString(timeUsed);
+                        run["simplified solution length REAL"] =
+                            ompl::toString(gsetup->getSolutionPath().length());
+                        run["simplified solution smoothness REAL"] =
+                            ompl::toString(gsetup->getSolutionPath().smoothness());
+                        run["simplified solution clearance REAL"] =
+                            ompl::toString(gsetup->getSolutionPath().clearance());
+                        run["simplified solution segments INTEGER"] =
+                            std::to_string(gsetup->getSolutionPath().getStateCount() - 1);
+                        run["simplified correct solution BOOLEAN"] =
+                            std::to_string(gsetup->getSolutionPath().check());
+                        gsetup->getStateSpace()->setValidSegmentCountFactor(factor * 4);
+                        run["simplified correct solution strict BOOLEAN"] =
+                            std::to_string(gsetup->getSolutionPath().check());
+                        gsetup->getStateSpace()->setValidSegmentCountFactor(factor);
+                    }
+                }
+                else
+                {
+                    run["approximate solution BOOLEAN"] =
+                        std::to_string(csetup->getProblemDefinition()->hasApproximateSolution());
+                    run["solution difference REAL"] =
+                        ompl::toString(csetup->getProblemDefinition()->getSolutionDifference());
+                    run["solution length REAL"] = ompl::toString(csetup->getSolutionPath().length());
+                    run["solution clearance REAL"] =
+                        ompl::toString(csetup->getSolutionPath().asGeometric().clearance());
+                    run["solution segments INTEGER"] = std::to_string(csetup->getSolutionPath().getControlCount());
+                    run["correct solution BOOLEAN"] = std::to_string(csetup->getSolutionPath().check());
+                }
+            }
+
+            base::PlannerData pd(gsetup ? gsetup->getSpaceInformation() : csetup->getSpaceInformation());
+            planner->getPlannerData(pd);
+            run["graph states INTEGER"] = std::to_string(pd.numVertices());
+            run["graph motions INTEGER"] = std::to_string(pd.numEdges());
+
+            for (const auto &prop : pd.properties)
+                run[prop.first] = prop.second;
+        }
     }
 }
 /// @endcond
@@ -377,6 +480,23 @@ void ompl::tools::Benchmark::benchmark(const Request &req)
         return;
     }
 
+    unsigned int workers = req.parallelRuns > 0 ? req.parallelRuns : std::thread::hardware_concurrency();
+    workers = std::min(workers, req.runCount);
+    if (workers > 1)
+    {
+        if (gsetup_ ? !gfactory_ : !cfactory_)
+        {
+            OMPL_WARN("Concurrent runs need a setup factory. Executing runs one at a time.");
+            workers = 1;
+        }
+        else if (std::any_of(allocators_.begin(), allocators_.end(),
+                             [](const base::PlannerAllocator &pa) { return !pa; }))
+        {
+            OMPL_WARN("Concurrent runs need planners added by their allocator. Executing runs one at a time.");
+            workers = 1;
+        }
+    }
+
     status_.running = true;
     exp_.totalDuration = 0.0;
     exp_.maxTime = req.maxTime;
@@ -486,6 +606,17 @@ void ompl::tools::Benchmark::benchmark(const Request &req)
         }
         std::sort(exp_.planners[i].progressPropertyNames.begin(), exp_.planners[i].progressPropertyNames.end());
 
+        if (workers > 1)
+        {
+            runConcurrently(i, req, workers, memStart, maxMemBytes * workers, [&]
+                            {
+                                if (req.displayProgress)
+                                    while (status_.progressPercentage > progress->count())
+                                        ++(*progress);
+                            });
+            continue;
+        }
+
         // run the planner
         for (unsigned int j = 0; j < req.runCount; ++j)
         {
@@ -545,95 +676,14 @@ void ompl::tools::Benchmark::benchmark(const Request &req)
                 OMPL_ERROR(es.str().c_str());
             }
 
-            RunPlanner rp(this);
+            RunPlanner rp(status_.activePlanner, status_.activeRun);
             rp.run(planners_[i], memStart, maxMemBytes, req.maxTime, req.timeBetweenUpdates);
-            bool solved = gsetup_ ? gsetup_->haveSolutionPath() : csetup_->haveSolutionPath();
 
             // store results
             try
             {
                 RunProperties run;
-
-                run["time REAL"] = ompl::toString(rp.getTimeUsed());
-                run["memory REAL"] = ompl::toString((double)rp.getMemUsed() / (1024.0 * 1024.0));
-                run["status ENUM"] = std::to_string((int)static_cast<base::PlannerStatus::StatusType>(rp.getStatus()));
-                if (gsetup_)
-                {
-                    run["solved BOOLEAN"] = std::to_string(gsetup_->haveExactSolutionPath());
-                    run["valid segment fraction REAL"] =
-                        ompl::toString(gsetup_->getSpaceInformation()->getMotionValidator()->getValidMotionFraction());
-                }
-                else
-                {
-                    run["solved BOOLEAN"] = std::to_string(csetup_->haveExactSolutionPath());
-                    run["valid segment fraction REAL"] =
-                        ompl::toString(csetup_->getSpaceInformation()->getMotionValidator()->getValidMotionFraction());
-                }
-
-                if (solved)
-                {
-                    if (gsetup_)
-                    {
-                        run["approximate solution BOOLEAN"] =
-                            std::to_string(gsetup_->getProblemDefinition()->hasApproximateSolution());
-                        run["solution difference REAL"] =
-                            ompl::toString(gsetup_->getProblemDefinition()->getSolutionDifference());
-                        run["solution length REAL"] = ompl::toString(gsetup_->getSolutionPath().length());
-                        run["solution smoothness REAL"] = ompl::toString(gsetup_->getSolutionPath().smoothness());
-                        run["solution clearance REAL"] = ompl::toString(gsetup_->getSolutionPath().clearance());
-                        run["solution segments INTEGER"] =
-                            std::to_string(gsetup_->getSolutionPath().getStateCount() - 1);
-                        run["correct solution BOOLEAN"] = std::to_string(gsetup_->getSolutionPath().check());
-
-                        unsigned int factor = gsetup_->getStateSpace()->getValidSegmentCountFactor();
-                        gsetup_->getStateSpace()->setValidSegmentCountFactor(factor * 4);
-                        run["correct solution strict BOOLEAN"] = std::to_string(gsetup_->getSolutionPath().check());
-                        gsetup_->getStateSpace()->setValidSegmentCountFactor(factor);
-
-                        if (req.simplify)
-                        {
-                            // simplify solution
-                            time::point timeStart = time::now();
-                            gsetup_->simplifySolution();
-                            double timeUsed = time::seconds(time::now() - timeStart);
-                            run["simplification time REAL"] = ompl::toString(timeUsed);
-                            run["simplified solution length REAL"] =
-                                ompl::toString(gsetup_->getSolutionPath().length());
-                            run["simplified solution smoothness REAL"] =
-                                ompl::toString(gsetup_->getSolutionPath().smoothness());
-                            run["simplified solution clearance REAL"] =
-                                ompl::toString(gsetup_->getSolutionPath().clearance());
-                            run["simplified solution segments INTEGER"] =
-                                std::to_string(gsetup_->getSolutionPath().getStateCount() - 1);
-                            run["simplified correct solution BOOLEAN"] =
-                                std::to_string(gsetup_->getSolutionPath().check());
-                            gsetup_->getStateSpace()->setValidSegmentCountFactor(factor * 4);
-                            run["simplified correct solution strict BOOLEAN"] =
-                                std::to_string(gsetup_->getSolutionPath().check());
-                            gsetup_->getStateSpace()->setValidSegmentCountFactor(factor);
-                        }
-                    }
-                    else
-                    {
-                        run["approximate solution BOOLEAN"] =
-                            std::to_string(csetup_->getProblemDefinition()->hasApproximateSolution());
-                        run["solution difference REAL"] =
-                            ompl::toString(csetup_->getProblemDefinition()->getSolutionDifference());
-                        run["solution length REAL"] = ompl::toString(csetup_->getSolutionPath().length());
-                        run["solution clearance REAL"] =
-                            ompl::toString(csetup_->getSolutionPath().asGeometric().clearance());
-                        run["solution segments INTEGER"] = std::to_string(csetup_->getSolutionPath().getControlCount());
-                        run["correct solution BOOLEAN"] = std::to_string(csetup_->getSolutionPath().check());
-                    }
-                }
-
-                base::PlannerData pd(gsetup_ ? gsetup_->getSpaceInformation() : csetup_->getSpaceInformation());
-                planners_[i]->getPlannerData(pd);
-                run["graph states INTEGER"] = std::to_string(pd.numVertices());
-                run["graph motions INTEGER"] = std::to_string(pd.numEdges());
-
-                for (const auto &prop : pd.properties)
-                    run[prop.first] = prop.second;
+                extractRunProperties(gsetup_, csetup_, planners_[i], rp, req.simplify, run);
 
                 // execute post-run event, if set
                 try
@@ -692,3 +742,113 @@ void ompl::tools::Benchmark::benchmark(const Request &req)
     msg::useOutputHandler(oh);
     OMPL_INFORM("Benchmark complete");
 }
+
+void ompl::tools::Benchmark::runConcurrently(unsigned int i, const Request &req, unsigned int workers,
+                                             machine::MemUsage_t memStart, machine::MemUsage_t maxMem,
+                                             const std::function<void()> &reportProgress)
+{
+    const std::string &plannerName = exp_.planners[i].name;
+    const bool collectProgress = planners_[i]->getPlannerProgressProperties().size() > 0;
+
+    // runs complete in any order; their results are kept by run number so the log looks as if they ran in sequence
+    std::vector<RunProperties> runs(req.runCount);
+    std::vector<RunProgressData> runsProgressData(req.runCount);
+    std::vector<char> recorded(req.runCount, 0);
+
+    std::atomic<unsigned int> nextRun(0);
+    unsigned int completed = 0;
+    std::mutex eventMutex;
+
+    auto executeRun = [&](unsigned int j)
+    {
+        try
+        {
+            // every run plans on its own problem instance, with its own planner
+            geometric::SimpleSetupPtr gsetup;
+            control::SimpleSetupPtr csetup;
+            base::PlannerPtr planner;
+            if (gsetup_)
+            {
+                gsetup = gfactory_();
+                planner = allocators_[i](gsetup->getSpaceInformation());
+                gsetup->setPlanner(planner);
+                gsetup->setup();
+            }
+            else
+            {
+                csetup = cfactory_();
+                planner = allocators_[i](csetup->getSpaceInformation());
+                csetup->setPlanner(planner);
+                csetup->setup();
+            }
+
+            if (preRun_)
+            {
+                std::lock_guard<std::mutex> lock(eventMutex);
+                OMPL_INFORM("Executing pre-run event for run %d of planner %s ...", j, plannerName.c_str());
+                preRun_(planner);
+                OMPL_INFORM("Completed execution of pre-run event");
+            }
+
+            RunPlanner rp(plannerName, j);
+            rp.run(planner, memStart, maxMem, req.maxTime, req.timeBetweenUpdates);
+
+            RunProperties run;
+            extractRunProperties(gsetup.get(), csetup.get(), planner, rp, req.simplify, run);
+
+            if (postRun_)
+            {
+                std::lock_guard<std::mutex> lock(eventMutex);
+                OMPL_INFORM("Executing post-run event for run %d of planner %s ...", j, plannerName.c_str());
+                postRun_(planner, run);
+                OMPL_INFORM("Completed execution of post-run event");
+            }
+
+            runs[j] = std::move(run);
+            if (collectProgress)
+                runsProgressData[j] = rp.getRunProgressData();
+            recorded[j] = 1;
+        }
+        catch (std::runtime_error &e)
+        {
+            std::stringstream es;
+            es << "There was an error in the execution of run " << j << " of planner " << plannerName << std::endl;
+            es << "*** " << e.what() << std::endl;
+            std::cerr << es.str();
+            OMPL_ERROR(es.str().c_str());
+        }
+
+        std::lock_guard<std::mutex> lock(eventMutex);
+        status_.activeRun = j;
+        status_.progressPercentage =
+            (double)(100 * (req.runCount * i + ++completed)) / (double)(planners_.size() * req.runCount);
+        reportProgress();
+    };
+
+    auto worker = [&]
+    {
+        unsigned int j;
+        while ((j = nextRun++) < req.runCount)
+        {
+            // the seeds of the run depend on nothing but its number, not on which worker executes it
+            RNG::setThreadSeed(getRunSeed(exp_.seed, i, j));
+            executeRun(j);
+        }
+        RNG::setThreadSeed(0);
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int w = 1; w < workers; ++w)
+        threads.emplace_back(worker);
+    worker();
+    for (auto &t : threads)
+        t.join();
+
+    for (unsigned int j = 0; j < req.runCount; ++j)
+        if (recorded[j] != 0)
+        {
+            exp_.planners[i].runs.push_back(std::move(runs[j]));
+            if (collectProgress)
+                exp_.planners[i].runsProgressData.push_back(std::move(runsProgressData[j]));
+        }
+}
@@ -44,9 +44,13 @@
 #include "ompl/datastructures/NearestNeighborsSqrtApprox.h"
 #include "ompl/datastructures/NearestNeighborsGNAT.h"
 #include "ompl/datastructures/NearestNeighborsGNATNoThreadSafety.h"
+#include "ompl/datastructures/NearestNeighborsConcurrent.h"
+#include "ompl/datastructures/NearestNeighborsVPTree.h"
 #include <mutex>
 #include <iostream>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace ompl
 {
@@ -98,7 +102,7 @@ namespace ompl
              * - If the space is a metric space and the planner is single-threaded,
              *   then the default is ompl::NearestNeighborsGNATNoThreadSafety.
              * - If the space is a metric space and the planner is multi-threaded,
-             *   then the default is ompl::NearestNeighborsGNAT.
+             *   then the default is ompl::NearestNeighborsConcurrent.
              * - If the space is a not a metric space,
              *   then the default is ompl::NearestNeighborsSqrtApprox.
              */
@@ -110,17 +114,82 @@ namespace ompl
                 if (space->isMetricSpace())
                 {
                     if (specs.multithreaded)
-                        return new NearestNeighborsGNAT<_T>();
+                        return new NearestNeighborsConcurrent<_T>();
                     return new NearestNeighborsGNATNoThreadSafety<_T>();
                 }
                 return new NearestNeighborsSqrtApprox<_T>();
             }
 
+            /** \brief Allocate an ompl::NearestNeighborsVPTree that evaluates distances on copies of the state
+             * coordinates, for planners that opt in to it. This is possible if the space is built from real
+             * vector, SO(2) and SO(3) spaces (see getCoordinateMetric()) and the elements hold their state in a
+             * member called \e state; otherwise, nullptr is returned.
+             *
+             * The coordinates are copied when an element is added, so the planner must not modify the states of
+             * stored elements in place. Removing elements is more expensive than with
+             * ompl::NearestNeighborsGNATNoThreadSafety, so this is best suited to planners that rarely remove
+             * elements.
+             */
+            template <typename _T>
+            static NearestNeighbors<_T> *getCoordinateNearestNeighbors(const base::Planner *planner)
+            {
+                return allocCoordinateNearestNeighbors<_T>(planner->getSpaceInformation()->getStateSpace(),
+                                                           ElementState<_T>());
+            }
+
+            /** \brief Describe the distance function of \e space as a metric on the values of its states, in the
+                order of base::StateSpace::getValueLocations(). This is possible for real vector, SO(2) and SO(3)
+                spaces, and compound spaces made of them (such as SE(2) and SE(3)), as identified by their
+                base::StateSpaceType. Return false if \e space contains other spaces. */
+            static bool getCoordinateMetric(const base::StateSpace *space, CoordinateMetric &metric);
+
             /** \brief Given a goal specification, decide on a planner for that goal */
             static base::PlannerPtr getDefaultPlanner(const base::GoalPtr &goal);
 
         private:
             /// @cond IGNORE
+            /* Detect element types that point to a struct with a state member, as the Motion types of most
+               planners do */
+            template <typename _T, typename = void>
+            struct ElementState : std::false_type
+            {
+            };
+
+            template <typename _T>
+            struct ElementState<_T, decltype((void)static_cast<const base::State *>(std::declval<const _T &>()->state))>
+              : std::true_type
+            {
+                static const base::State *get(const _T &data)
+                {
+                    return data->state;
+                }
+            };
+
+            template <typename _T>
+            static NearestNeighbors<_T> *allocCoordinateNearestNeighbors(const base::StateSpacePtr & /*space*/,
+                                                                        std::false_type)
+            {
+                return nullptr;
+            }
+
+            template <typename _T>
+            static NearestNeighbors<_T> *allocCoordinateNearestNeighbors(const base::StateSpacePtr &space,
+                                                                        std::true_type)
+            {
+                CoordinateMetric metric;
+                const std::vector<base::StateSpace::ValueLocation> &locations = space->getValueLocations();
+                if (!getCoordinateMetric(space.get(), metric) || metric.getDimension() != locations.size())
+                    return nullptr;
+                auto *nn = new NearestNeighborsVPTree<_T>();
+                nn->setCoordinates(metric, [space, locations](const _T &data, double *coords)
+                                   {
+                                       const base::State *state = ElementState<_T>::get(data);
+                                       for (std::size_t i = 0; i < locations.size(); ++i)
+                                           coords[i] = *space->getValueAddressAtLocation(state, locations[i]);
+                                   });
+                return nn;
+            }
+
             class SelfConfigImpl;
 
             SelfConfigImpl *impl_;
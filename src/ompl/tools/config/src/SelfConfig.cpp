@@ -240,6 +240,45 @@ void ompl::tools::SelfConfig::print(std::ostream &out) const
     impl_->print(out);
 }
 
+namespace
+{
+    bool addCoordinateMetric(const ompl::base::StateSpace *space, double weight, ompl::CoordinateMetric &metric)
+    {
+        if (space->isCompound())
+        {
+            const auto *compound = space->as<ompl::base::CompoundStateSpace>();
+            for (unsigned int i = 0; i < compound->getSubspaceCount(); ++i)
+                if (!addCoordinateMetric(compound->getSubspace(i).get(), weight * compound->getSubspaceWeight(i),
+                                         metric))
+                    return false;
+            return true;
+        }
+        switch (space->getType())
+        {
+            case ompl::base::STATE_SPACE_REAL_VECTOR:
+                metric.addEuclidean(space->getDimension(), weight);
+                return true;
+            case ompl::base::STATE_SPACE_SO2:
+                metric.addAngle(weight);
+                return true;
+            case ompl::base::STATE_SPACE_SO3:
+                metric.addQuaternion(weight);
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+bool ompl::tools::SelfConfig::getCoordinateMetric(const base::StateSpace *space, CoordinateMetric &metric)
+{
+    metric.clear();
+    if (addCoordinateMetric(space, 1.0, metric))
+        return true;
+    metric.clear();
+    return false;
+}
+
 ompl::base::PlannerPtr ompl::tools::SelfConfig::getDefaultPlanner(const base::GoalPtr &goal)
 {
     base::PlannerPtr planner;
@@ -68,7 +68,9 @@ namespace ompl
             spent in various chunks of code. This is different from
             external profiling tools in that it allows the user to count
             time spent in various bits of code (sub-function granularity)
-            or count how many times certain pieces of code are executed.*/
+            or count how many times certain pieces of code are executed.
+            Every call takes a global lock; see ompl::Tracer for instrumenting
+            code that runs often.*/
         class Profiler
         {
         public:
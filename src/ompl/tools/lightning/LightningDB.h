@@ -136,6 +136,20 @@ namespace ompl
                 return numUnsavedPaths_;
             }
 
+            /** \brief When enabled, saving to the file the database was last loaded from or saved to
+                only appends the paths added since, instead of rewriting the whole file. Every path
+                is stored as a self-contained record, so the log never needs compacting. */
+            void setAppendLog(bool appendLog)
+            {
+                appendLog_ = appendLog;
+            }
+
+            /** \brief Check whether saves append to the database file */
+            bool getAppendLog() const
+            {
+                return appendLog_;
+            }
+
             /**
              * \brief Check if anything has been loaded into DB
              * \return true if has no nodes
@@ -167,6 +181,16 @@ namespace ompl
             // Track unsaved paths to determine if a save is required
             int numUnsavedPaths_{0};
 
+            // Paths added since the last save, written on the next save in append log mode
+            std::vector<ompl::base::PlannerDataPtr> unsavedPlannerDatas_;
+
+            // Whether saves append to the database file
+            bool appendLog_{false};
+
+            // The file the database was last loaded from or saved to, and its size up to the last complete record
+            std::string logFile_;
+            std::uint64_t logSize_{0};
+
         };  // end of class LightningDB
 
     }  // end of namespace
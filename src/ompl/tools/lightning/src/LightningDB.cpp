@@ -40,10 +40,13 @@
 #include "ompl/util/Time.h"
 #include "ompl/tools/config/SelfConfig.h"
 #include "ompl/base/PlannerDataStorage.h"
+#include "ompl/base/MappedPlannerDataStorage.h"
 
 // Boost
 #include <boost/filesystem.hpp>
 
+#include <sstream>
+
 ompl::tools::LightningDB::LightningDB(const base::StateSpacePtr &space)
 {
     si_ = std::make_shared<base::SpaceInformation>(space);
@@ -86,6 +89,49 @@ bool ompl::tools::LightningDB::load(const std::string &fileName)
 
     OMPL_INFORM("Loading database from file: %s", fileName.c_str());
 
+    // Appending to this file later only keeps the database complete if it holds all saved paths
+    const bool appendable = nn_->size() == unsavedPlannerDatas_.size();
+    logFile_.clear();
+
+    // Databases in the mapped format are used in place
+    if (base::MappedPlannerDataStorage::isMappedFile(fileName.c_str()))
+    {
+        auto storage(std::make_shared<base::MappedPlannerDataStorage>());
+        if (!storage->open(si_, fileName.c_str()))
+            return false;
+
+        base::PlannerDataPtr plannerData;
+        for (std::size_t i = 0; i < storage->numRoadmaps(); ++i)
+        {
+            const base::MappedPlannerDataStorage::Roadmap &roadmap = storage->getRoadmap(i);
+            if (roadmap.getBaseVertex() == 0)
+            {
+                if (plannerData)
+                    nn_->add(plannerData);
+
+                // The vertices refer to states inside the mapping, so every planner data keeps the mapping alive
+                plannerData.reset(new base::PlannerData(si_), [storage](base::PlannerData *pd)
+                                  {
+                                      delete pd;
+                                  });
+            }
+            if (!roadmap.toPlannerData(*plannerData))
+                return false;
+        }
+        if (plannerData)
+            nn_->add(plannerData);
+
+        if (appendable)
+        {
+            logFile_ = fileName;
+            logSize_ = storage->getValidSize();
+        }
+
+        double loadTime = time::seconds(time::now() - start);
+        OMPL_INFORM("Loaded database from file in %f sec with %d paths", loadTime, nn_->size());
+        return true;
+    }
+
     // Open a binary input stream
     std::ifstream iStream(fileName.c_str(), std::ios::binary);
 
@@ -149,6 +195,7 @@ void ompl::tools::LightningDB::addPathHelper(ompl::geometric::PathGeometric &sol
 
     // Add to nearest neighbor tree
     nn_->add(plannerData);
+    unsavedPlannerDatas_.push_back(plannerData);
 
     numUnsavedPaths_++;
 }
@@ -176,33 +223,40 @@ bool ompl::tools::LightningDB::save(const std::string &fileName)
 
     OMPL_INFORM("Saving database to file: %s", fileName.c_str());
 
-    // Open a binary output stream
-    std::ofstream outStream(fileName.c_str(), std::ios::binary);
-
-    // Convert the NN tree to a vector
-    std::vector<ompl::base::PlannerDataPtr> plannerDatas;
-    nn_->list(plannerDatas);
-
-    // Write the number of paths we will be saving
-    double numPaths = plannerDatas.size();
-    outStream << numPaths;
-
-    // Start saving each planner data object
-    for (std::size_t i = 0; i < numPaths; ++i)
+    // Only write the new paths if the file holds everything else already
+    if (appendLog_ && fileName == logFile_ && base::MappedPlannerDataStorage::isMappedFile(fileName.c_str()))
     {
-        ompl::base::PlannerData &pd = *plannerDatas[i].get();
-
-        // Save a single planner data
-        plannerDataStorage_.store(pd, outStream);
+        std::ostringstream records;
+        for (const auto &pd : unsavedPlannerDatas_)
+            if (!base::MappedPlannerDataStorage::store(*pd, records))
+                return false;
+
+        std::uint64_t size = base::MappedPlannerDataStorage::appendRecords(records.str(), fileName.c_str(), logSize_);
+        if (size == 0)
+            return false;
+        logSize_ = size;
+
+        double saveTime = time::seconds(time::now() - start);
+        OMPL_INFORM("Appended %d paths to database file in %f sec", unsavedPlannerDatas_.size(), saveTime);
+    }
+    else
+    {
+        // Convert the NN tree to a vector
+        std::vector<ompl::base::PlannerDataPtr> plannerDatas;
+        nn_->list(plannerDatas);
+
+        // Write all paths, one roadmap record each
+        if (!base::MappedPlannerDataStorage::store(plannerDatas, fileName.c_str()))
+            return false;
+        logFile_ = fileName;
+        logSize_ = boost::filesystem::file_size(fileName);
+
+        // Benchmark
+        double loadTime = time::seconds(time::now() - start);
+        OMPL_INFORM("Saved database to file in %f sec with %d paths", loadTime, plannerDatas.size());
     }
 
-    // Close file
-    outStream.close();
-
-    // Benchmark
-    double loadTime = time::seconds(time::now() - start);
-    OMPL_INFORM("Saved database to file in %f sec with %d paths", loadTime, plannerDatas.size());
-
+    unsavedPlannerDatas_.clear();
     numUnsavedPaths_ = 0;
 
     return true;
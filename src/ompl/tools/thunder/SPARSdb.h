@@ -519,6 +519,32 @@ namespace ompl
                 return boost::num_edges(g_);
             }
 
+            /** \brief Get the number of times the roadmap has been cleared. Vertices are numbered in the order
+                they are added and are never removed individually, so a vertex index identifies the same
+                vertex for as long as this number does not change. */
+            unsigned int getNumRoadmapClears() const
+            {
+                return numRoadmapClears_;
+            }
+
+            /** \brief When enabled, the edges added to the roadmap are recorded until they are collected by
+                takeAddedEdges(), so that the roadmap can be saved incrementally. Disabling discards the
+                recorded edges. */
+            void setRecordAddedEdges(bool record)
+            {
+                recordAddedEdges_ = record;
+                if (!record)
+                    addedEdges_.clear();
+            }
+
+            /** \brief Move the edges added since the previous call, or since the roadmap was last cleared,
+                into \e edges. Edges are only recorded while setRecordAddedEdges() is enabled. */
+            void takeAddedEdges(std::vector<VertexPair> &edges)
+            {
+                edges.clear();
+                edges.swap(addedEdges_);
+            }
+
             /** \brief Get the number of disjoint sets in the sparse roadmap. */
             unsigned int getNumConnectedComponents() const
             {
@@ -781,6 +807,15 @@ namespace ompl
 
             /** \brief Option to enable debugging output */
             bool verbose_{false};
+
+            /** \brief The number of times the roadmap has been cleared */
+            unsigned int numRoadmapClears_{0u};
+
+            /** \brief Whether edges added to the roadmap are recorded in addedEdges_ */
+            bool recordAddedEdges_{false};
+
+            /** \brief The edges added since takeAddedEdges() was last called */
+            std::vector<VertexPair> addedEdges_;
         };
     }
 }
@@ -46,6 +46,12 @@
 #include <ompl/base/SpaceInformation.h>
 #include <ompl/datastructures/NearestNeighbors.h>
 #include <ompl/tools/thunder/SPARSdb.h>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace ompl
 {
@@ -146,6 +152,24 @@ namespace ompl
                 saving_enabled_ = saving_enabled;
             }
 
+            /** \brief When enabled, saving to the same file again only appends the guards and edges
+                SPARSdb added since the previous save, as a record that extends the stored roadmap.
+                If the roadmap was cleared meanwhile, the appended record starts a new roadmap that
+                replaces the stored one. The first save after loading, and any save once the appended
+                records have outgrown the last full snapshot, write a new snapshot in a background
+                thread instead. Saves made meanwhile are added to the new file once the snapshot is
+                complete. */
+            void setAppendLog(bool appendLog)
+            {
+                appendLog_ = appendLog;
+            }
+
+            /** \brief Check whether saves append to the database file */
+            bool getAppendLog() const
+            {
+                return appendLog_;
+            }
+
             /**
              * \brief Check if anything has been loaded into DB
              * \return true if has no nodes
@@ -156,6 +180,23 @@ namespace ompl
             }
 
         protected:
+            /** \brief Number the whole SPARSdb roadmap as saved and write it to \e fileName as a single
+                record, in a background thread */
+            void compact(const std::string &fileName);
+
+            /** \brief Add the SPARSdb vertices that are not numbered yet to \e data, numbering them after
+                the saved ones, and the edges in \e added. \e index receives the roadmap index of every
+                vertex of \e data, and \e edges the edges as pairs of vertices of \e data. */
+            void exportChanges(const std::vector<geometric::SPARSdb::VertexPair> &added, base::PlannerData &data,
+                               std::vector<unsigned int> &index,
+                               std::vector<std::pair<unsigned int, unsigned int>> &edges);
+
+            /** \brief Append encoded \e records to the log, or queue them while it is being compacted */
+            bool appendToLog(const std::string &records);
+
+            /** \brief Wait for a background compaction to complete */
+            void waitForCompaction();
+
             /// The created space information
             base::SpaceInformationPtr si_;  // TODO: is this even necessary?
 
@@ -171,6 +212,36 @@ namespace ompl
             // Allow the database to save to file (new experiences)
             bool saving_enabled_;
 
+            // Whether saves append to the database file
+            bool appendLog_{false};
+
+            // The file saves are appended to; empty if the next save writes a new snapshot
+            std::string logFile_;
+
+            // Roadmap index of every numbered SPARSdb vertex, by SPARSdb vertex index
+            std::vector<unsigned int> savedIndex_;
+
+            // Number of vertices in the saved roadmap
+            unsigned int numSavedVertices_{0};
+
+            // The number of times SPARSdb had cleared its roadmap when it was numbered
+            unsigned int savedClears_{0};
+
+            // Writes snapshots of the roadmap in the background
+            std::thread compactor_;
+
+            // Protects the members below, which are shared with the compaction thread
+            std::mutex logMutex_;
+
+            // Size of the log up to its last complete record, and of the snapshot it starts with
+            std::uint64_t logSize_{0};
+            std::uint64_t compactedSize_{0};
+
+            // Records saved while a snapshot is being written, appended to it once complete
+            bool compacting_{false};
+            bool compactionFailed_{false};
+            std::string pendingLog_;
+
         };  // end of class ThunderDB
 
     }  // end of namespace
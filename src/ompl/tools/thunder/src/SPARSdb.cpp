@@ -186,6 +186,8 @@ void ompl::geometric::SPARSdb::freeMemory()
         stateProperty_[v] = nullptr;
     }
     g_.clear();
+    ++numRoadmapClears_;
+    addedEdges_.clear();
 
     if (nn_)
         nn_->clear();
@@ -1644,6 +1646,9 @@ void ompl::geometric::SPARSdb::connectGuards(Vertex v, Vertex vp)
     // Add the edge to the incrementeal connected components datastructure
     disjointSets_.union_set(v, vp);
 
+    if (recordAddedEdges_)
+        addedEdges_.emplace_back(v, vp);
+
 // Debug in Rviz
 #ifdef OMPL_THUNDER_DEBUG
     visualizeEdgeCallback(stateProperty_[v], stateProperty_[vp]);
@@ -41,9 +41,13 @@
 #include <ompl/util/Console.h>
 #include <ompl/tools/config/SelfConfig.h>
 #include <ompl/base/PlannerDataStorage.h>
+#include <ompl/base/MappedPlannerDataStorage.h>
 
 // Boost
 #include <boost/filesystem.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include <sstream>
 
 ompl::tools::ThunderDB::ThunderDB(const base::StateSpacePtr &space) : numPathsInserted_(0), saving_enabled_(true)
 {
@@ -53,6 +57,7 @@ ompl::tools::ThunderDB::ThunderDB(const base::StateSpacePtr &space) : numPathsIn
 
 ompl::tools::ThunderDB::~ThunderDB()
 {
+    waitForCompaction();
     if (numPathsInserted_)
         OMPL_WARN("The database is being unloaded with unsaved experiences");
 }
@@ -81,31 +86,61 @@ bool ompl::tools::ThunderDB::load(const std::string &fileName)
 
     OMPL_INFORM("Loading database from file: %s", fileName.c_str());
 
-    // Open a binary input stream
-    std::ifstream iStream(fileName.c_str(), std::ios::binary);
+    // SPARSdb will hold copies of the loaded states, so the next save in append log mode starts a new snapshot
+    waitForCompaction();
+    logFile_.clear();
 
-    // Get the total number of paths saved
-    double numPaths = 0;
-    iStream >> numPaths;
+    // Databases in the mapped format are used in place. SPARSdb copies the states it keeps, so the
+    // mapping only needs to outlive the planner data below.
+    base::MappedPlannerDataStorage mappedStorage;
 
-    // Check that the number of paths makes sense
-    if (numPaths < 0 || numPaths > std::numeric_limits<double>::max())
-    {
-        OMPL_WARN("Number of paths to load %d is a bad value", numPaths);
-        return false;
-    }
+    // Create a new planner data instance
+    auto plannerData(std::make_shared<ompl::base::PlannerData>(si_));
 
-    if (numPaths > 1)
+    if (base::MappedPlannerDataStorage::isMappedFile(fileName.c_str()))
     {
-        OMPL_ERROR("Currently more than one planner data is disabled from loading");
-        return false;
+        if (!mappedStorage.open(si_, fileName.c_str()))
+            return false;
+
+        // Replay the snapshot and the records appended to it. A record that starts a new roadmap is
+        // appended when the roadmap was cleared, and replaces the roadmap before it.
+        for (std::size_t i = 0; i < mappedStorage.numRoadmaps(); ++i)
+        {
+            const base::MappedPlannerDataStorage::Roadmap &roadmap = mappedStorage.getRoadmap(i);
+            if (i > 0 && roadmap.getBaseVertex() == 0)
+                plannerData = std::make_shared<ompl::base::PlannerData>(si_);
+            if (!roadmap.toPlannerData(*plannerData))
+                return false;
+        }
     }
+    else
+    {
+        // Open a binary input stream
+        std::ifstream iStream(fileName.c_str(), std::ios::binary);
 
-    // Create a new planner data instance
-    auto plannerData(std::make_shared<ompl::base::PlannerData>(si_));
+        // Get the total number of paths saved
+        double numPaths = 0;
+        iStream >> numPaths;
 
-    // Note: the StateStorage class checks if the states match for us
-    plannerDataStorage_.load(iStream, *plannerData.get());
+        // Check that the number of paths makes sense
+        if (numPaths < 0 || numPaths > std::numeric_limits<double>::max())
+        {
+            OMPL_WARN("Number of paths to load %d is a bad value", numPaths);
+            return false;
+        }
+
+        if (numPaths > 1)
+        {
+            OMPL_ERROR("Currently more than one planner data is disabled from loading");
+            return false;
+        }
+
+        // Note: the StateStorage class checks if the states match for us
+        plannerDataStorage_.load(iStream, *plannerData.get());
+
+        // Close file
+        iStream.close();
+    }
 
     OMPL_INFORM("ThunderDB: Loaded planner data with \n  %d vertices\n  %d edges\n  %d start states\n  %d goal states",
                 plannerData->numVertices(), plannerData->numEdges(), plannerData->numStartVertices(),
@@ -118,9 +153,6 @@ bool ompl::tools::ThunderDB::load(const std::string &fileName)
     // Output the number of connected components
     OMPL_INFORM("  %d connected components", spars_->getNumConnectedComponents());
 
-    // Close file
-    iStream.close();
-
     double loadTime = time::seconds(time::now() - start);
     OMPL_INFORM("Loaded database from file in %f sec ", loadTime);
     return true;
@@ -197,62 +229,236 @@ bool ompl::tools::ThunderDB::save(const std::string &fileName)
 
     OMPL_INFORM("Saving database to file: %s", fileName.c_str());
 
-    // Open a binary output stream
-    std::ofstream outStream(fileName.c_str(), std::ios::binary);
-
-    // Populate multiple planner Datas
-    std::vector<ompl::base::PlannerDataPtr> plannerDatas;
+    if (appendLog_)
+    {
+        if (fileName != logFile_)
+            waitForCompaction();
 
-    // TODO: make this more than 1 planner data perhaps
-    auto data(std::make_shared<base::PlannerData>(si_));
-    spars_->getPlannerData(*data);
-    OMPL_INFORM("Get planner data from SPARS2 with \n  %d vertices\n  %d edges\n  %d start states\n  %d goal states",
-                data->numVertices(), data->numEdges(), data->numStartVertices(), data->numGoalVertices());
+        bool rebase = fileName != logFile_;
+        {
+            std::lock_guard<std::mutex> lock(logMutex_);
+            rebase = rebase || compactionFailed_ || (!compacting_ && logSize_ > 2 * compactedSize_);
+        }
+        if (rebase)
+        {
+            waitForCompaction();
+            compact(fileName);
+            OMPL_INFORM("Writing a snapshot of the database to file in the background");
+        }
+        else
+        {
+            // Vertices of a cleared roadmap are numbered anew, in a record that replaces the saved roadmap
+            const bool cleared = spars_->getNumRoadmapClears() != savedClears_;
+            if (cleared)
+            {
+                savedIndex_.clear();
+                numSavedVertices_ = 0;
+                savedClears_ = spars_->getNumRoadmapClears();
+            }
 
-    plannerDatas.push_back(data);
+            // Export only the guards and edges SPARSdb added since the previous save
+            const unsigned int baseVertex = numSavedVertices_;
+            std::vector<geometric::SPARSdb::VertexPair> added;
+            spars_->takeAddedEdges(added);
+            base::PlannerData data(si_);
+            std::vector<unsigned int> index;
+            std::vector<std::pair<unsigned int, unsigned int>> edges;
+            exportChanges(added, data, index, edges);
+
+            std::ostringstream records;
+            if (cleared || numSavedVertices_ > baseVertex || !edges.empty())
+                if (!base::MappedPlannerDataStorage::append(data, index, baseVertex, edges, records) ||
+                    !appendToLog(records.str()))
+                {
+                    // The saved numbering is no longer reliable; the next save writes a new snapshot
+                    logFile_.clear();
+                    return false;
+                }
+
+            double saveTime = time::seconds(time::now() - start);
+            OMPL_INFORM("Appended %d vertices and %d edges to database file in %f sec", numSavedVertices_ - baseVertex,
+                        edges.size(), saveTime);
+        }
+    }
+    else
+    {
+        waitForCompaction();
+        logFile_.clear();
+        spars_->setRecordAddedEdges(false);
 
-    // Write the number of paths we will be saving
-    double numPaths = plannerDatas.size();
-    outStream << numPaths;
+        // Populate multiple planner Datas
+        std::vector<ompl::base::PlannerDataPtr> plannerDatas;
 
-    // Start saving each planner data object
-    for (std::size_t i = 0; i < numPaths; ++i)
-    {
-        ompl::base::PlannerData &pd = *plannerDatas[i].get();
+        // TODO: make this more than 1 planner data perhaps
+        auto data(std::make_shared<base::PlannerData>(si_));
+        spars_->getPlannerData(*data);
+        OMPL_INFORM("Get planner data from SPARS2 with \n  %d vertices\n  %d edges\n  %d start states\n  %d goal "
+                    "states",
+                    data->numVertices(), data->numEdges(), data->numStartVertices(), data->numGoalVertices());
 
-        OMPL_INFORM("Saving experience %d with %d verticies and %d edges", i, pd.numVertices(), pd.numEdges());
+        plannerDatas.push_back(data);
 
         if (false)  // debug code
         {
-            for (std::size_t i = 0; i < pd.numVertices(); ++i)
+            for (std::size_t i = 0; i < data->numVertices(); ++i)
             {
                 OMPL_INFORM("Vertex %d:", i);
-                debugVertex(pd.getVertex(i));
+                debugVertex(data->getVertex(i));
             }
         }
 
-        // Save a single planner data
-        plannerDataStorage_.store(pd, outStream);
+        // Write each planner data as one roadmap record
+        if (!base::MappedPlannerDataStorage::store(plannerDatas, fileName.c_str()))
+            return false;
+
+        // Benchmark
+        double loadTime = time::seconds(time::now() - start);
+        OMPL_INFORM("Saved database to file in %f sec with %d planner datas", loadTime, plannerDatas.size());
     }
 
-    // Close file
-    outStream.close();
+    numPathsInserted_ = 0;
 
-    // Benchmark
-    double loadTime = time::seconds(time::now() - start);
-    OMPL_INFORM("Saved database to file in %f sec with %d planner datas", loadTime, plannerDatas.size());
+    return true;
+}
 
-    numPathsInserted_ = 0;
+void ompl::tools::ThunderDB::compact(const std::string &fileName)
+{
+    // Number the whole roadmap anew; edges SPARSdb adds from now on are saved by the next append
+    savedIndex_.clear();
+    numSavedVertices_ = 0;
+    savedClears_ = spars_->getNumRoadmapClears();
+    std::vector<geometric::SPARSdb::VertexPair> added;
+    spars_->setRecordAddedEdges(true);
+    spars_->takeAddedEdges(added);
+
+    // The snapshot holds all the edges, including those recorded so far
+    const geometric::SPARSdb::Graph &graph = spars_->getRoadmap();
+    added.clear();
+    added.reserve(boost::num_edges(graph));
+    for (const auto e : boost::make_iterator_range(boost::edges(graph)))
+        added.emplace_back(boost::source(e, graph), boost::target(e, graph));
+
+    // New vertices are added to the planner data first, so its vertices are numbered like the roadmap
+    auto data(std::make_shared<base::PlannerData>(si_));
+    std::vector<unsigned int> index;
+    std::vector<std::pair<unsigned int, unsigned int>> edges;
+    exportChanges(added, *data, index, edges);
+
+    // The snapshot is written while planning continues, so it needs its own copy of the states
+    data->decoupleFromPlanner();
+    logFile_ = fileName;
+    {
+        std::lock_guard<std::mutex> lock(logMutex_);
+        compacting_ = true;
+        compactionFailed_ = false;
+        pendingLog_.clear();
+    }
+
+    compactor_ = std::thread([this, fileName, data]
+                             {
+                                 // Write next to the destination, so the current log stays intact until the rename
+                                 const std::string temporary = fileName + ".tmp";
+                                 std::ofstream out(temporary.c_str(), std::ios::binary | std::ios::trunc);
+                                 bool result = base::MappedPlannerDataStorage::store(*data, out);
+                                 const std::uint64_t snapshotSize = out.tellp();
+
+                                 std::lock_guard<std::mutex> lock(logMutex_);
+                                 if (result)
+                                     out.write(pendingLog_.data(), pendingLog_.size());
+                                 out.close();
+
+                                 boost::system::error_code ec;
+                                 if (result && !out.fail())
+                                     boost::filesystem::rename(temporary, fileName, ec);
+                                 if (!result || out.fail() || ec)
+                                 {
+                                     OMPL_ERROR("Failed to write a snapshot of the database to %s", fileName.c_str());
+                                     boost::filesystem::remove(temporary, ec);
+                                     compactionFailed_ = true;
+                                 }
+                                 else
+                                 {
+                                     compactedSize_ = snapshotSize;
+                                     logSize_ = snapshotSize + pendingLog_.size();
+                                 }
+                                 pendingLog_.clear();
+                                 compacting_ = false;
+                             });
+}
+
+void ompl::tools::ThunderDB::exportChanges(const std::vector<geometric::SPARSdb::VertexPair> &added,
+                                           base::PlannerData &data, std::vector<unsigned int> &index,
+                                           std::vector<std::pair<unsigned int, unsigned int>> &edges)
+{
+    const geometric::SPARSdb::Graph &graph = spars_->getRoadmap();
+    const auto states = boost::get(geometric::SPARSdb::vertex_state_t(), graph);
+    const auto types = boost::get(geometric::SPARSdb::vertex_color_t(), graph);
 
+    // Add SPARSdb vertex v to data, unless it is already there, and return its index in data
+    auto addVertex = [&](geometric::SPARSdb::VertexIndexType v)
+    {
+        const unsigned int count = data.numVertices();
+        const unsigned int i = data.addVertex(base::PlannerDataVertex(states[v], (int)types[v]));
+        if (data.numVertices() > count)
+            index.push_back(savedIndex_[v]);
+        return i;
+    };
+
+    // SPARSdb never removes single vertices, so the vertices after the numbered ones are the new ones. The
+    // vertex SPARSdb uses for nearest neighbor queries has no state and is not saved.
+    for (std::size_t v = savedIndex_.size(); v < boost::num_vertices(graph); ++v)
+    {
+        if (states[v] == nullptr)
+        {
+            savedIndex_.push_back(base::PlannerData::INVALID_INDEX);
+            continue;
+        }
+        savedIndex_.push_back(numSavedVertices_++);
+        addVertex(v);
+    }
+
+    for (const auto &e : added)
+        if (savedIndex_[e.first] != base::PlannerData::INVALID_INDEX &&
+            savedIndex_[e.second] != base::PlannerData::INVALID_INDEX)
+        {
+            const unsigned int i = addVertex(e.first);
+            const unsigned int j = addVertex(e.second);
+            if (data.addEdge(i, j))
+                edges.emplace_back(i, j);
+        }
+}
+
+bool ompl::tools::ThunderDB::appendToLog(const std::string &records)
+{
+    std::lock_guard<std::mutex> lock(logMutex_);
+    if (compacting_)
+    {
+        pendingLog_ += records;
+        return true;
+    }
+    std::uint64_t size = base::MappedPlannerDataStorage::appendRecords(records, logFile_.c_str(), logSize_);
+    if (size == 0)
+        return false;
+    logSize_ = size;
     return true;
 }
 
+void ompl::tools::ThunderDB::waitForCompaction()
+{
+    if (compactor_.joinable())
+        compactor_.join();
+}
+
 void ompl::tools::ThunderDB::setSPARSdb(ompl::tools::SPARSdbPtr &prm)
 {
     // OMPL_INFORM("-------------------------------------------------------");
     // OMPL_INFORM("setSPARSdb ");
     // OMPL_INFORM("-------------------------------------------------------");
     spars_ = prm;
+
+    // The new roadmap is numbered anew by the next save
+    waitForCompaction();
+    logFile_.clear();
 }
 
 ompl::tools::SPARSdbPtr &ompl::tools::ThunderDB::getSPARSdb()
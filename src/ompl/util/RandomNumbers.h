@@ -130,6 +130,12 @@ namespace ompl
             (repeatable) behaviour across multiple instances of RNG. Useful for debugging. */
         static std::uint_fast32_t getSeed();
 
+        /** \brief Make the RNG instances constructed by the calling thread take their seeds from a
+            sequence private to that thread, started at \e seed, rather than from the sequence shared by
+            all threads. Work done on a thread of its own can then be repeated regardless of what other
+            threads do. Passing 0 returns the calling thread to the shared sequence. */
+        static void setThreadSeed(std::uint_fast32_t seed);
+
         /** \brief Set the seed used for the instance of a RNG. Use this function to ensure that an instance of
             an RNG generates the same deterministic sequence of numbers. This function resets the member generators*/
         void setLocalSeed(std::uint_fast32_t localSeed);
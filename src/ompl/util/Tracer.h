@@ -0,0 +1,244 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef OMPL_UTIL_TRACER_
+#define OMPL_UTIL_TRACER_
+
+#include "ompl/config.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ompl
+{
+    /** \brief Low-overhead recorder of nested timed scopes and counters.
+
+        Unlike tools::Profiler, recording an event takes no lock and does no string lookup. Scope and
+        counter names are interned once into integer ids (see Intern()), and every thread appends
+        fixed-size events to a ring buffer of its own. When a ring buffer is full, the oldest
+        events of that thread are overwritten. Recording is off until start() is called.
+
+        The recorded events can be exported as a Chrome trace (for chrome://tracing or Perfetto)
+        or as folded stacks (for flamegraph.pl and similar tools). Exporting while other threads
+        are recording is safe, but may miss the events recorded during the export.
+
+        The OMPL_TRACE_SCOPE() and OMPL_TRACE_COUNT() macros instrument code with the global
+        instance. They expand to nothing unless OMPL_ENABLE_TRACING is set. */
+    class Tracer
+    {
+    public:
+        /** \brief Interned name of a scope or counter */
+        using CounterId = std::uint32_t;
+
+        /** \brief Records the time spent in a scope: the scope begins when this object is
+            constructed and ends when it is destroyed. Nothing is recorded if the tracer is not
+            running when the scope begins. */
+        class ScopedTrace
+        {
+        public:
+            explicit ScopedTrace(CounterId id, Tracer &tracer = Tracer::Instance())
+              : tracer_(tracer), id_(id), active_(tracer.running())
+            {
+                if (active_)
+                    tracer_.record(id_, BEGIN, 0);
+            }
+
+            ~ScopedTrace()
+            {
+                if (active_)
+                    tracer_.record(id_, END, 0);
+            }
+
+            ScopedTrace(const ScopedTrace &) = delete;
+            ScopedTrace &operator=(const ScopedTrace &) = delete;
+
+        private:
+            Tracer &tracer_;
+            CounterId id_;
+            bool active_;
+        };
+
+        /** \brief Construct a tracer whose threads record at most \e eventsPerThread events
+            before overwriting the oldest ones. The capacity is rounded up to a power of two. */
+        explicit Tracer(std::size_t eventsPerThread = 1 << 16);
+
+        ~Tracer();
+
+        Tracer(const Tracer &) = delete;
+        Tracer &operator=(const Tracer &) = delete;
+
+        /** \brief Return the instance used by the instrumentation macros */
+        static Tracer &Instance();
+
+        /** \brief Return the id of \e name, registering it if needed. Ids are shared by all
+            tracers. This function takes a lock; call it once per call site, not per event. */
+        static CounterId Intern(const std::string &name);
+
+        /** \brief Return the name registered for \e id */
+        static std::string GetName(CounterId id);
+
+        /** \brief Start recording events */
+        void start()
+        {
+            running_.store(true, std::memory_order_relaxed);
+        }
+
+        /** \brief Stop recording events */
+        void stop()
+        {
+            running_.store(false, std::memory_order_relaxed);
+        }
+
+        /** \brief Check whether events are being recorded */
+        bool running() const
+        {
+            return running_.load(std::memory_order_relaxed);
+        }
+
+        /** \brief Discard all events recorded so far */
+        void clear();
+
+        /** \brief Mark the beginning of the scope \e id in the calling thread */
+        void begin(CounterId id)
+        {
+            if (running())
+                record(id, BEGIN, 0);
+        }
+
+        /** \brief Mark the end of the scope \e id in the calling thread */
+        void end(CounterId id)
+        {
+            if (running())
+                record(id, END, 0);
+        }
+
+        /** \brief Add \e times to the counter \e id */
+        void count(CounterId id, std::uint64_t times = 1)
+        {
+            if (running())
+                record(id, COUNT, times);
+        }
+
+        /** \brief Write the recorded events in the Chrome trace event format (JSON). Scopes
+            become duration events on the track of the thread that recorded them; counters become
+            counter tracks holding their running total over all threads. */
+        void exportChromeTrace(std::ostream &out) const;
+
+        /** \brief Write the recorded scopes as folded stacks: one line per distinct stack of
+            nested scopes, holding the names of the scopes separated by ';' and the time spent
+            in the innermost scope itself, in microseconds. Stacks of all threads are merged. */
+        void exportFoldedStacks(std::ostream &out) const;
+
+    private:
+        enum EventType : std::uint8_t
+        {
+            BEGIN,
+            END,
+            COUNT
+        };
+
+        /** \brief A recorded event; \e value is only used by counters */
+        struct Event
+        {
+            std::uint64_t time;
+            std::uint64_t value;
+            CounterId id;
+            EventType type;
+        };
+
+        /** \brief Ring buffer of the events of one thread. Only the owning thread writes to it. */
+        struct ThreadBuffer;
+
+        /** \brief Record an event in the buffer of the calling thread */
+        void record(CounterId id, EventType type, std::uint64_t value);
+
+        /** \brief Find or create the buffer of the calling thread */
+        ThreadBuffer &localBuffer();
+
+        /** \brief Copy the events that are still in the buffers, per thread, oldest first */
+        std::vector<std::vector<Event>> snapshot() const;
+
+        /** \brief Unique number of this tracer, used to find the buffers of a thread */
+        const std::uint64_t instance_;
+
+        /** \brief Number of events each buffer holds (a power of two) */
+        const std::size_t capacity_;
+
+        /** \brief Point in time events are measured from */
+        const std::chrono::steady_clock::time_point epoch_;
+
+        std::atomic<bool> running_{false};
+
+        /** \brief Protects the list of buffers, not their contents */
+        mutable std::mutex lock_;
+
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    };
+}
+
+#if OMPL_ENABLE_TRACING
+
+/// @cond IGNORE
+#define OMPL_TRACE_CONCAT_(a, b) a##b
+#define OMPL_TRACE_CONCAT(a, b) OMPL_TRACE_CONCAT_(a, b)
+/// @endcond
+
+/** \brief Record the time spent until the end of the enclosing block as the scope \e name */
+#define OMPL_TRACE_SCOPE(name)                                                                                         \
+    static const ::ompl::Tracer::CounterId OMPL_TRACE_CONCAT(ompl_trace_id_, __LINE__) =                               \
+        ::ompl::Tracer::Intern(name);                                                                                  \
+    ::ompl::Tracer::ScopedTrace OMPL_TRACE_CONCAT(ompl_trace_scope_, __LINE__)(                                        \
+        OMPL_TRACE_CONCAT(ompl_trace_id_, __LINE__))
+
+/** \brief Add \e times to the counter \e name */
+#define OMPL_TRACE_COUNT(name, times)                                                                                  \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        static const ::ompl::Tracer::CounterId ompl_trace_id = ::ompl::Tracer::Intern(name);                           \
+        ::ompl::Tracer::Instance().count(ompl_trace_id, times);                                                        \
+    } while (0)
+
+#else
+
+#define OMPL_TRACE_SCOPE(name)
+#define OMPL_TRACE_COUNT(name, times)
+
+#endif
+
+#endif
@@ -126,6 +126,33 @@ namespace
         std::call_once(g_once, &initRNGSeedGenerator);
         return *g_RNGSeedGenerator;
     }
+
+    /// Private seed sequence of a thread, installed by RNG::setThreadSeed()
+    class ThreadSeedGenerator
+    {
+    public:
+        explicit ThreadSeedGenerator(std::uint_fast32_t seed) : sGen_(seed), sDist_(1, 1000000000)
+        {
+        }
+
+        std::uint_fast32_t nextSeed()
+        {
+            return sDist_(sGen_);
+        }
+
+    private:
+        std::ranlux24_base sGen_;
+        std::uniform_int_distribution<> sDist_;
+    };
+
+    thread_local std::unique_ptr<ThreadSeedGenerator> t_threadSeedGenerator;
+
+    std::uint_fast32_t nextSeed()
+    {
+        if (t_threadSeedGenerator)
+            return t_threadSeedGenerator->nextSeed();
+        return getRNGSeedGenerator().nextSeed();
+    }
 }  // namespace
 /// @endcond
 
@@ -216,8 +243,16 @@ void ompl::RNG::setSeed(std::uint_fast32_t seed)
     getRNGSeedGenerator().setSeed(seed);
 }
 
+void ompl::RNG::setThreadSeed(std::uint_fast32_t seed)
+{
+    if (seed > 0)
+        t_threadSeedGenerator.reset(new ThreadSeedGenerator(seed));
+    else
+        t_threadSeedGenerator.reset();
+}
+
 ompl::RNG::RNG()
-  : localSeed_(getRNGSeedGenerator().nextSeed())
+  : localSeed_(nextSeed())
   , generator_(localSeed_)
   , sphericalDataPtr_(std::make_shared<SphericalData>(&generator_))
 {
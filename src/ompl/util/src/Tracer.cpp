@@ -0,0 +1,339 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "ompl/util/Tracer.h"
+#include <algorithm>
+#include <map>
+#include <ostream>
+#include <thread>
+#include <unordered_map>
+
+/// @cond IGNORE
+struct ompl::Tracer::ThreadBuffer
+{
+    ThreadBuffer(std::size_t capacity, std::thread::id owner, unsigned int number)
+      : events(capacity), owner(owner), number(number)
+    {
+    }
+
+    std::vector<Event> events;
+
+    /// Number of events ever written; the next event goes to events[written % capacity]
+    std::atomic<std::uint64_t> written{0};
+
+    /// Events before this index were discarded by clear()
+    std::atomic<std::uint64_t> cleared{0};
+
+    std::thread::id owner;
+
+    /// Track number of the thread in exported traces
+    unsigned int number;
+};
+
+namespace
+{
+    /// Names of scopes and counters, shared by all tracers
+    struct NameRegistry
+    {
+        std::mutex lock;
+        std::vector<std::string> names;
+        std::unordered_map<std::string, ompl::Tracer::CounterId> ids;
+    };
+
+    NameRegistry &getNameRegistry()
+    {
+        static NameRegistry registry;
+        return registry;
+    }
+
+    std::atomic<std::uint64_t> g_tracerCount{0};
+
+    /// The buffer the calling thread used last, and the tracer it belongs to
+    struct BufferCache
+    {
+        std::uint64_t instance{0};
+        void *buffer{nullptr};
+    };
+
+    thread_local BufferCache t_bufferCache;
+
+    void writeJSONString(std::ostream &out, const std::string &s)
+    {
+        out << '"';
+        for (char c : s)
+        {
+            if (c == '"' || c == '\\')
+                out << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20)
+                out << ' ';
+            else
+                out << c;
+        }
+        out << '"';
+    }
+}
+/// @endcond
+
+ompl::Tracer::Tracer(std::size_t eventsPerThread)
+  : instance_(++g_tracerCount)
+  , capacity_([eventsPerThread] {
+      std::size_t c = 1;
+      while (c < eventsPerThread)
+          c <<= 1;
+      return c;
+  }())
+  , epoch_(std::chrono::steady_clock::now())
+{
+}
+
+ompl::Tracer::~Tracer() = default;
+
+ompl::Tracer &ompl::Tracer::Instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+ompl::Tracer::CounterId ompl::Tracer::Intern(const std::string &name)
+{
+    NameRegistry &registry = getNameRegistry();
+    std::lock_guard<std::mutex> slock(registry.lock);
+    auto it = registry.ids.find(name);
+    if (it != registry.ids.end())
+        return it->second;
+    auto id = static_cast<CounterId>(registry.names.size());
+    registry.names.push_back(name);
+    registry.ids[name] = id;
+    return id;
+}
+
+std::string ompl::Tracer::GetName(CounterId id)
+{
+    NameRegistry &registry = getNameRegistry();
+    std::lock_guard<std::mutex> slock(registry.lock);
+    return id < registry.names.size() ? registry.names[id] : std::string();
+}
+
+void ompl::Tracer::clear()
+{
+    std::lock_guard<std::mutex> slock(lock_);
+    for (auto &buffer : buffers_)
+        buffer->cleared.store(buffer->written.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+ompl::Tracer::ThreadBuffer &ompl::Tracer::localBuffer()
+{
+    if (t_bufferCache.instance == instance_)
+        return *static_cast<ThreadBuffer *>(t_bufferCache.buffer);
+
+    // first event of this thread since it last used another tracer
+    std::lock_guard<std::mutex> slock(lock_);
+    const std::thread::id self = std::this_thread::get_id();
+    ThreadBuffer *buffer = nullptr;
+    for (auto &b : buffers_)
+        if (b->owner == self)
+        {
+            buffer = b.get();
+            break;
+        }
+    if (buffer == nullptr)
+    {
+        buffers_.emplace_back(new ThreadBuffer(capacity_, self, buffers_.size()));
+        buffer = buffers_.back().get();
+    }
+    t_bufferCache.instance = instance_;
+    t_bufferCache.buffer = buffer;
+    return *buffer;
+}
+
+void ompl::Tracer::record(CounterId id, EventType type, std::uint64_t value)
+{
+    ThreadBuffer &buffer = localBuffer();
+    const std::uint64_t n = buffer.written.load(std::memory_order_relaxed);
+    Event &e = buffer.events[n & (capacity_ - 1)];
+    e.time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch_).count();
+    e.value = value;
+    e.id = id;
+    e.type = type;
+    buffer.written.store(n + 1, std::memory_order_release);
+}
+
+std::vector<std::vector<ompl::Tracer::Event>> ompl::Tracer::snapshot() const
+{
+    std::lock_guard<std::mutex> slock(lock_);
+    std::vector<std::vector<Event>> result(buffers_.size());
+    for (const auto &buffer : buffers_)
+    {
+        const std::uint64_t end = buffer->written.load(std::memory_order_acquire);
+        std::uint64_t begin = std::max<std::uint64_t>(buffer->cleared.load(std::memory_order_acquire),
+                                                      end > capacity_ ? end - capacity_ : 0);
+        std::vector<Event> &events = result[buffer->number];
+        events.reserve(end - begin);
+        for (std::uint64_t i = begin; i < end; ++i)
+            events.push_back(buffer->events[i & (capacity_ - 1)]);
+
+        // drop the events the owning thread may have overwritten while they were copied
+        const std::uint64_t now = buffer->written.load(std::memory_order_acquire);
+        if (now > capacity_ && now - capacity_ > begin)
+            events.erase(events.begin(),
+                         events.begin() + std::min<std::uint64_t>(now - capacity_ - begin, events.size()));
+    }
+    return result;
+}
+
+void ompl::Tracer::exportChromeTrace(std::ostream &out) const
+{
+    std::vector<std::vector<Event>> threads = snapshot();
+
+    std::map<CounterId, std::string> names;
+    std::vector<std::pair<const Event *, unsigned int>> counts;
+    for (unsigned int t = 0; t < threads.size(); ++t)
+        for (const Event &e : threads[t])
+        {
+            if (names.find(e.id) == names.end())
+                names[e.id] = GetName(e.id);
+            if (e.type == COUNT)
+                counts.emplace_back(&e, t);
+        }
+
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    auto separate = [&out, &first]
+    {
+        if (!first)
+            out << ',';
+        out << '\n';
+        first = false;
+    };
+
+    for (unsigned int t = 0; t < threads.size(); ++t)
+    {
+        separate();
+        out << R"({"name":"thread_name","ph":"M","pid":0,"tid":)" << t << R"(,"args":{"name":"thread )" << t
+            << "\"}}";
+        for (const Event &e : threads[t])
+        {
+            if (e.type == COUNT)
+                continue;
+            separate();
+            out << "{\"name\":";
+            writeJSONString(out, names[e.id]);
+            out << ",\"ph\":\"" << (e.type == BEGIN ? 'B' : 'E') << "\",\"ts\":" << e.time / 1000 << '.'
+                << e.time / 100 % 10 << e.time / 10 % 10 << e.time % 10 << ",\"pid\":0,\"tid\":" << t << '}';
+        }
+    }
+
+    // counter tracks are per process, so they show the total over all threads
+    std::stable_sort(counts.begin(), counts.end(),
+                     [](const std::pair<const Event *, unsigned int> &a, const std::pair<const Event *, unsigned int> &b)
+                     { return a.first->time < b.first->time; });
+    std::map<CounterId, std::uint64_t> totals;
+    for (const auto &c : counts)
+    {
+        const Event &e = *c.first;
+        std::uint64_t &total = totals[e.id];
+        total += e.value;
+        separate();
+        out << "{\"name\":";
+        writeJSONString(out, names[e.id]);
+        out << ",\"ph\":\"C\",\"ts\":" << e.time / 1000 << '.' << e.time / 100 % 10 << e.time / 10 % 10
+            << e.time % 10 << ",\"pid\":0,\"tid\":" << c.second << ",\"args\":{\"value\":" << total << "}}";
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ns\"}" << std::endl;
+}
+
+void ompl::Tracer::exportFoldedStacks(std::ostream &out) const
+{
+    struct Frame
+    {
+        CounterId id;
+        std::uint64_t start;
+        std::uint64_t children;
+    };
+
+    std::vector<std::vector<Event>> threads = snapshot();
+    std::map<std::vector<CounterId>, std::uint64_t> stacks;
+    for (const auto &events : threads)
+    {
+        std::vector<Frame> open;
+        std::vector<CounterId> path;
+        for (const Event &e : events)
+        {
+            if (e.type == BEGIN)
+            {
+                open.push_back(Frame{e.id, e.time, 0});
+                path.push_back(e.id);
+            }
+            else if (e.type == END)
+            {
+                // an end without a matching begin was cut off by the ring buffer
+                auto it = std::find_if(open.rbegin(), open.rend(), [&e](const Frame &f) { return f.id == e.id; });
+                if (it == open.rend())
+                    continue;
+                while (!open.empty())
+                {
+                    Frame f = open.back();
+                    std::uint64_t total = e.time - f.start;
+                    stacks[path] += total > f.children ? total - f.children : 0;
+                    open.pop_back();
+                    path.pop_back();
+                    if (!open.empty())
+                        open.back().children += total;
+                    if (f.id == e.id)
+                        break;
+                }
+            }
+        }
+    }
+
+    std::map<CounterId, std::string> names;
+    for (const auto &stack : stacks)
+    {
+        std::uint64_t us = stack.second / 1000;
+        if (us == 0)
+            continue;
+        for (std::size_t i = 0; i < stack.first.size(); ++i)
+        {
+            CounterId id = stack.first[i];
+            if (names.find(id) == names.end())
+                names[id] = GetName(id);
+            if (i > 0)
+                out << ';';
+            out << names[id];
+        }
+        out << ' ' << us << '\n';
+    }
+    out.flush();
+}
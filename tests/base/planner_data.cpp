@@ -37,12 +37,17 @@
 #define BOOST_TEST_MODULE "PlannerData"
 #include <boost/test/unit_test.hpp>
 #include <boost/serialization/export.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <vector>
 
 #include "ompl/base/PlannerData.h"
 #include "ompl/base/PlannerDataStorage.h"
+#include "ompl/base/MappedPlannerDataStorage.h"
 #include "ompl/base/spaces/RealVectorStateSpace.h"
+#include "ompl/base/spaces/SE2StateSpace.h"
 
 using namespace ompl;
 
@@ -563,3 +568,212 @@ BOOST_AUTO_TEST_CASE(Serialization)
     for (auto & state : states)
         space->freeState(state);
 }
+
+BOOST_AUTO_TEST_CASE(MappedSerialization)
+{
+    auto space(std::make_shared<base::RealVectorStateSpace>(3));
+    space->setBounds(-1, 1);
+    auto si(std::make_shared<base::SpaceInformation>(space));
+    si->setup();
+
+    auto data(std::make_shared<base::PlannerData>(si));
+    std::vector<base::State*> states;
+    for (unsigned int i = 0; i < 500; ++i)
+    {
+        states.push_back(space->allocState());
+        for (unsigned int j = 0; j < 3; ++j)
+            states[i]->as<base::RealVectorStateSpace::StateType>()->values[j] = i + 0.1 * j;
+        BOOST_CHECK_EQUAL( data->addVertex(base::PlannerDataVertex(states[i], i % 7)), i );
+    }
+    data->markStartState(states[0]);
+    data->markGoalState(states[1]);
+    data->markStartState(states[2]);
+    data->markGoalState(states[2]);
+
+    ompl::RNG rng;
+    for (unsigned int i = 0; i < 3000; ++i)
+    {
+        unsigned int v2, v1 = rng.uniformInt(0, states.size()-1);
+        do v2 = rng.uniformInt(0, states.size()-1); while (v2 == v1 || data->edgeExists(v1, v2));
+        BOOST_CHECK( data->addEdge(v1, v2, base::PlannerDataEdge(), base::Cost(rng.uniform01())) );
+    }
+
+    // Two records in one file
+    auto empty(std::make_shared<base::PlannerData>(si));
+    BOOST_REQUIRE( base::MappedPlannerDataStorage::store({data, empty}, "testdata_mapped") );
+    BOOST_CHECK( base::MappedPlannerDataStorage::isMappedFile("testdata_mapped") );
+
+    {
+        base::MappedPlannerDataStorage storage;
+        BOOST_REQUIRE( storage.open(si, "testdata_mapped") );
+        BOOST_REQUIRE_EQUAL( storage.numRoadmaps(), 2u );
+        BOOST_CHECK_EQUAL( storage.getRoadmap(1).numVertices(), 0u );
+
+        const base::MappedPlannerDataStorage::Roadmap &roadmap = storage.getRoadmap(0);
+        BOOST_REQUIRE_EQUAL( roadmap.numVertices(), states.size() );
+        BOOST_CHECK_EQUAL( roadmap.numEdges(), data->numEdges() );
+        BOOST_CHECK( roadmap.isStartVertex(0) && !roadmap.isGoalVertex(0) );
+        BOOST_CHECK( roadmap.isGoalVertex(1) && !roadmap.isStartVertex(1) );
+        BOOST_CHECK( roadmap.isStartVertex(2) && roadmap.isGoalVertex(2) );
+        for (std::size_t i = 0; i < states.size(); ++i)
+        {
+            BOOST_CHECK( space->equalStates(roadmap.getState(i), states[i]) );
+            BOOST_CHECK_EQUAL( roadmap.getTag(i), (int)(i % 7) );
+            for (std::size_t j = 0; j < roadmap.getEdgeCount(i); ++j)
+            {
+                base::Cost w;
+                BOOST_REQUIRE( data->getEdgeWeight(i, roadmap.getEdges(i)[j], &w) );
+                BOOST_CHECK_EQUAL( w.value(), roadmap.getEdgeWeights(i)[j] );
+            }
+        }
+
+        // Converting back yields the same graph
+        base::PlannerData data2(si);
+        roadmap.toPlannerData(data2);
+        BOOST_CHECK_EQUAL( data2.numVertices(), data->numVertices() );
+        BOOST_CHECK_EQUAL( data2.numEdges(), data->numEdges() );
+        BOOST_CHECK_EQUAL( data2.numStartVertices(), 2u );
+        BOOST_CHECK_EQUAL( data2.numGoalVertices(), 2u );
+
+        // Changes to a state stay in memory
+        storage.getRoadmap(0).getMutableState(3)->as<base::RealVectorStateSpace::StateType>()->values[0] = -1.0;
+        BOOST_CHECK_EQUAL( roadmap.getState(3)->as<base::RealVectorStateSpace::StateType>()->values[0], -1.0 );
+    }
+    {
+        base::MappedPlannerDataStorage storage;
+        BOOST_REQUIRE( storage.open(si, "testdata_mapped") );
+        BOOST_CHECK( space->equalStates(storage.getRoadmap(0).getState(3), states[3]) );
+    }
+
+    // The signature of the state space is checked
+    auto other(std::make_shared<base::SpaceInformation>(std::make_shared<base::RealVectorStateSpace>(2)));
+    base::MappedPlannerDataStorage storage;
+    BOOST_CHECK( !storage.open(other, "testdata_mapped") );
+    BOOST_CHECK( !storage.isOpen() );
+
+    // Derived vertex types cannot be represented
+    base::PlannerData derived(si);
+    derived.addVertex(PlannerDataTestVertex(states[0], 0, 1));
+    BOOST_CHECK( !base::MappedPlannerDataStorage::store(derived, "testdata_mapped") );
+
+    for (auto & state : states)
+        space->freeState(state);
+}
+
+BOOST_AUTO_TEST_CASE(MappedSerializationCompound)
+{
+    auto space(std::make_shared<base::SE2StateSpace>());
+    base::RealVectorBounds bounds(2);
+    bounds.setLow(-10);
+    bounds.setHigh(10);
+    space->setBounds(bounds);
+    auto si(std::make_shared<base::SpaceInformation>(space));
+    si->setup();
+
+    base::PlannerData data(si);
+    base::StateSamplerPtr sampler = space->allocStateSampler();
+    std::vector<base::State*> states;
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+        states.push_back(space->allocState());
+        sampler->sampleUniform(states.back());
+        data.addVertex(base::PlannerDataVertex(states.back()));
+        if (i > 0)
+            data.addEdge(i - 1, i, base::PlannerDataEdge(), base::Cost(i));
+    }
+    BOOST_REQUIRE( base::MappedPlannerDataStorage::store(data, "testdata_mapped") );
+
+    base::MappedPlannerDataStorage storage;
+    BOOST_REQUIRE( storage.open(si, "testdata_mapped") );
+    const base::MappedPlannerDataStorage::Roadmap &roadmap = storage.getRoadmap(0);
+    BOOST_REQUIRE_EQUAL( roadmap.numVertices(), states.size() );
+    for (std::size_t i = 0; i < states.size(); ++i)
+    {
+        // States of compound spaces are deserialized once, on first access
+        const base::State *st = roadmap.getState(i);
+        BOOST_CHECK( space->equalStates(st, states[i]) );
+        BOOST_CHECK_EQUAL( roadmap.getState(i), st );
+        BOOST_CHECK_EQUAL( roadmap.getEdgeCount(i), i + 1 < states.size() ? 1u : 0u );
+    }
+    BOOST_CHECK_EQUAL( roadmap.getEdgeWeights(4)[0], 5.0 );
+
+    for (auto & state : states)
+        space->freeState(state);
+}
+
+BOOST_AUTO_TEST_CASE(MappedAppendLog)
+{
+    auto space(std::make_shared<base::RealVectorStateSpace>(2));
+    space->setBounds(-1, 1);
+    auto si(std::make_shared<base::SpaceInformation>(space));
+    si->setup();
+
+    std::vector<base::State*> states;
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+        states.push_back(space->allocState());
+        states[i]->as<base::RealVectorStateSpace::StateType>()->values[0] = i;
+        states[i]->as<base::RealVectorStateSpace::StateType>()->values[1] = -1.0 * i;
+    }
+
+    // A snapshot of vertices 0..3 with edges 0->1 and 2->3
+    base::PlannerData data(si);
+    for (unsigned int i = 0; i < 4; ++i)
+        data.addVertex(base::PlannerDataVertex(states[i], i));
+    data.addEdge(0, 1, base::PlannerDataEdge(), base::Cost(0.5));
+    data.addEdge(2, 3, base::PlannerDataEdge(), base::Cost(1.5));
+    BOOST_REQUIRE( base::MappedPlannerDataStorage::store(data, "testdata_log") );
+    std::uint64_t size = boost::filesystem::file_size("testdata_log");
+
+    // The roadmap grows by two vertices; the planner data lists them in a different order than the log
+    base::PlannerData grown(si);
+    std::vector<unsigned int> index = {5, 4, 3, 2, 1, 0};
+    for (unsigned int i = 0; i < 6; ++i)
+        grown.addVertex(base::PlannerDataVertex(states[index[i]], index[i]));
+    grown.addEdge(1, 0, base::PlannerDataEdge(), base::Cost(2.0));  // 4 -> 5
+    grown.addEdge(5, 3, base::PlannerDataEdge(), base::Cost(3.0));  // 0 -> 2
+    grown.markGoalState(states[5]);
+    std::vector<std::pair<unsigned int, unsigned int>> edges = {{1, 0}, {5, 3}};
+    std::ostringstream records;
+    BOOST_REQUIRE( base::MappedPlannerDataStorage::append(grown, index, 4, edges, records) );
+    size = base::MappedPlannerDataStorage::appendRecords(records.str(), "testdata_log", size);
+    BOOST_REQUIRE( size > 0 );
+
+    // A torn record at the end is ignored, and dropped by the next append
+    {
+        std::ofstream out("testdata_log", std::ios::binary | std::ios::app);
+        out.write(records.str().data(), records.str().size() / 2);
+    }
+    base::MappedPlannerDataStorage storage;
+    BOOST_REQUIRE( storage.open(si, "testdata_log") );
+    BOOST_CHECK_EQUAL( storage.getValidSize(), size );
+    BOOST_REQUIRE_EQUAL( storage.numRoadmaps(), 2u );
+    BOOST_CHECK_EQUAL( storage.getRoadmap(1).getBaseVertex(), 4u );
+    BOOST_CHECK_EQUAL( storage.getRoadmap(1).numVertices(), 2u );
+    BOOST_CHECK_EQUAL( storage.getRoadmap(1).numRows(), 2u );
+    storage.close();
+    BOOST_CHECK_EQUAL( base::MappedPlannerDataStorage::appendRecords(std::string(), "testdata_log", size), size );
+    BOOST_CHECK_EQUAL( boost::filesystem::file_size("testdata_log"), size );
+
+    // Replaying the log yields the grown roadmap in log order
+    BOOST_REQUIRE( storage.open(si, "testdata_log") );
+    base::PlannerData replayed(si);
+    BOOST_CHECK( !storage.getRoadmap(1).toPlannerData(replayed) );
+    BOOST_REQUIRE( storage.getRoadmap(0).toPlannerData(replayed) );
+    BOOST_REQUIRE( storage.getRoadmap(1).toPlannerData(replayed) );
+    BOOST_REQUIRE_EQUAL( replayed.numVertices(), 6u );
+    BOOST_CHECK_EQUAL( replayed.numEdges(), 4u );
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+        BOOST_CHECK( space->equalStates(replayed.getVertex(i).getState(), states[i]) );
+        BOOST_CHECK_EQUAL( replayed.getVertex(i).getTag(), (int)i );
+    }
+    BOOST_CHECK( replayed.isGoalVertex(5) );
+    base::Cost w;
+    BOOST_CHECK( replayed.getEdgeWeight(4, 5, &w) && w.value() == 2.0 );
+    BOOST_CHECK( replayed.getEdgeWeight(0, 2, &w) && w.value() == 3.0 );
+    BOOST_CHECK( replayed.getEdgeWeight(2, 3, &w) && w.value() == 1.5 );
+
+    for (auto & state : states)
+        space->freeState(state);
+}
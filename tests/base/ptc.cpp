@@ -40,6 +40,8 @@
 #include <thread>
 
 #include "ompl/base/PlannerTerminationCondition.h"
+#include "ompl/base/spaces/RealVectorStateSpace.h"
+#include "ompl/geometric/PathGeometric.h"
 #include "ompl/util/Time.h"
 
 using namespace ompl;
@@ -80,3 +82,52 @@ BOOST_AUTO_TEST_CASE(TestThreadedTermination)
   BOOST_CHECK(ptc_long);
   BOOST_CHECK(ptc_long());
 }
+
+BOOST_AUTO_TEST_CASE(TestCombinedTermination)
+{
+  static const double dt = 0.1;
+  base::PlannerTerminationCondition flag;
+  const base::PlannerTerminationCondition &either =
+      base::plannerOrTerminationCondition(flag, base::timedPlannerTerminationCondition(100.0 * dt));
+  const base::PlannerTerminationCondition &both =
+      base::plannerAndTerminationCondition(flag, base::timedPlannerTerminationCondition(dt));
+  BOOST_CHECK(!flag);
+  BOOST_CHECK(!either);
+  BOOST_CHECK(!both);
+  std::this_thread::sleep_for(ompl::time::seconds(dt + 0.01));
+  BOOST_CHECK(!either);
+  BOOST_CHECK(!both);
+  flag.terminate();
+  BOOST_CHECK(either);
+  BOOST_CHECK(both);
+
+  // conditions that call functions are combined by calling them
+  bool done = false;
+  const base::PlannerTerminationCondition &polled =
+      base::plannerOrTerminationCondition(base::PlannerTerminationCondition([&done] { return done; }),
+                                          base::timedPlannerTerminationCondition(100.0 * dt));
+  BOOST_CHECK(!polled);
+  done = true;
+  BOOST_CHECK(polled);
+}
+
+BOOST_AUTO_TEST_CASE(TestExactSolutionTermination)
+{
+  auto space(std::make_shared<base::RealVectorStateSpace>(2));
+  space->setBounds(0, 1);
+  auto si(std::make_shared<base::SpaceInformation>(space));
+  si->setup();
+  auto pdef(std::make_shared<base::ProblemDefinition>(si));
+
+  const base::PlannerTerminationCondition &ptc = base::plannerOrTerminationCondition(
+      base::exactSolnPlannerTerminationCondition(pdef), base::timedPlannerTerminationCondition(100.0));
+  BOOST_CHECK(!ptc);
+  auto path(std::make_shared<geometric::PathGeometric>(si));
+  pdef->addSolutionPath(path, true, 1.0);
+  BOOST_CHECK(!ptc);
+  pdef->addSolutionPath(path);
+  BOOST_CHECK(ptc);
+
+  // a condition created after the solution was found is terminated right away
+  BOOST_CHECK(base::exactSolnPlannerTerminationCondition(pdef));
+}
@@ -0,0 +1,257 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#define BOOST_TEST_MODULE "ScratchStates"
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#include "ompl/base/SpaceInformation.h"
+#include "ompl/base/BatchedDiscreteMotionValidator.h"
+#include "ompl/base/ScopedState.h"
+#include "ompl/base/goals/GoalState.h"
+#include "ompl/base/spaces/RealVectorStateSpace.h"
+#include "ompl/geometric/planners/est/EST.h"
+#include "ompl/geometric/planners/kpiece/KPIECE1.h"
+#include "ompl/geometric/planners/rrt/RRT.h"
+#include "ompl/geometric/planners/rrt/RRTConnect.h"
+
+using namespace ompl;
+
+/* count the heap allocations made while counting is enabled */
+static std::atomic<bool> countAllocations{false};
+static std::atomic<unsigned long> allocations{0};
+
+void *operator new(std::size_t size)
+{
+    if (countAllocations)
+        ++allocations;
+    if (void *p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+/* return the number of allocations made by f() */
+template <typename F>
+static unsigned long countAllocationsOf(const F &f)
+{
+    allocations = 0;
+    countAllocations = true;
+    f();
+    countAllocations = false;
+    return allocations;
+}
+
+// states are valid in a thin diagonal band
+static bool isValid(const base::State *state)
+{
+    const double *x = state->as<base::RealVectorStateSpace::StateType>()->values;
+    return std::fabs(x[0] - x[1]) < 0.1;
+}
+
+static base::SpaceInformationPtr makeSpaceInformation()
+{
+    auto space(std::make_shared<base::RealVectorStateSpace>(2));
+    space->setBounds(0, 1);
+    auto si(std::make_shared<base::SpaceInformation>(space));
+    si->setStateValidityChecker(isValid);
+    si->setStateValidityCheckingResolution(0.001);
+    si->setup();
+    return si;
+}
+
+BOOST_AUTO_TEST_CASE(Reuse)
+{
+    base::SpaceInformationPtr si = makeSpaceInformation();
+
+    base::State *a = si->allocScratchState();
+    base::State *b = si->allocScratchState();
+    BOOST_CHECK(a != b);
+    si->freeScratchState(a);
+    si->freeScratchState(b);
+
+    BOOST_CHECK_EQUAL(countAllocationsOf([&] {
+        for (int i = 0; i < 100; ++i)
+        {
+            base::State *c = si->allocScratchState();
+            base::State *d = si->allocScratchState();
+            BOOST_CHECK(c == b && d == a);
+            si->freeScratchState(d);
+            si->freeScratchState(c);
+        }
+    }), 0u);
+
+    // other threads get their own states
+    base::State *other = nullptr;
+    std::thread([&] {
+        other = si->allocScratchState();
+        si->freeScratchState(other);
+    }).join();
+    BOOST_CHECK(other != a && other != b);
+
+    // and so do other instances
+    base::SpaceInformationPtr si2 = makeSpaceInformation();
+    base::State *e = si2->allocScratchState();
+    BOOST_CHECK(e != a && e != b);
+    si2->freeScratchState(e);
+}
+
+BOOST_AUTO_TEST_CASE(MotionValidators)
+{
+    base::SpaceInformationPtr si = makeSpaceInformation();
+    base::DiscreteMotionValidator discrete(si);
+    base::BatchedDiscreteMotionValidator batched(si);
+
+    base::ScopedState<base::RealVectorStateSpace> s1(si->getStateSpace()), s2(si->getStateSpace()),
+        last(si->getStateSpace());
+    s1[0] = s1[1] = 0.05;
+    s2[0] = s2[1] = 0.95;
+    base::ScopedState<base::RealVectorStateSpace> s3(s2);
+    s3[0] = 0.8;
+    std::pair<base::State *, double> lastValid(last.get(), 0.0);
+
+    auto check = [&] {
+        for (int i = 0; i < 100; ++i)
+        {
+            BOOST_CHECK(discrete.checkMotion(s1.get(), s2.get()));
+            BOOST_CHECK(!discrete.checkMotion(s1.get(), s3.get()));
+            BOOST_CHECK(!discrete.checkMotion(s1.get(), s3.get(), lastValid));
+            BOOST_CHECK(batched.checkMotion(s1.get(), s2.get()));
+            BOOST_CHECK(!batched.checkMotion(s1.get(), s3.get()));
+            BOOST_CHECK(!batched.checkMotion(s1.get(), s3.get(), lastValid));
+        }
+    };
+
+    // the first checks fill the scratch states and buffers of this thread
+    check();
+    BOOST_CHECK_EQUAL(countAllocationsOf(check), 0u);
+}
+
+/* a state space that counts the states it allocates */
+class CountingStateSpace : public base::RealVectorStateSpace
+{
+public:
+    CountingStateSpace() : base::RealVectorStateSpace(2)
+    {
+    }
+
+    base::State *allocState() const override
+    {
+        ++states;
+        return base::RealVectorStateSpace::allocState();
+    }
+
+    mutable std::atomic<unsigned long> states{0};
+};
+
+/* Run \e planner for \e warmup iterations and then \e iterations more, and return the number of
+   allocations made by the later iterations that did not add states to the tree. Iterations that do
+   also allocate motions and grow the datastructures of the planner; \e grown is set to their number. */
+static unsigned long planningAllocations(const base::PlannerPtr &planner, const CountingStateSpace &space,
+                                         unsigned int warmup, unsigned int iterations, unsigned int &grown)
+{
+    unsigned int iteration = 0;
+    unsigned long lastAllocations = 0, lastStates = 0, idleAllocations = 0;
+    grown = 0;
+    // the termination condition is evaluated once per iteration, so it sees each iteration end
+    base::PlannerTerminationCondition ptc([&] {
+        unsigned long a = allocations, s = space.states;
+        if (iteration > warmup)
+        {
+            if (s != lastStates)
+                ++grown;
+            else
+                idleAllocations += a - lastAllocations;
+        }
+        lastAllocations = a;
+        lastStates = s;
+        return ++iteration > warmup + iterations;
+    });
+    planner->clear();
+    planner->getProblemDefinition()->clearSolutionPaths();
+    countAllocationsOf([&] { planner->solve(ptc); });
+    return idleAllocations;
+}
+
+BOOST_AUTO_TEST_CASE(PlanningIterations)
+{
+    auto space(std::make_shared<CountingStateSpace>());
+    space->setBounds(0, 1);
+    auto si(std::make_shared<base::SpaceInformation>(space));
+    // the start is in a thin diagonal band and the goal in an island the band does not reach, so
+    // the trees grow along the band until the planners are stopped
+    si->setStateValidityChecker([](const base::State *state) {
+        const double *x = state->as<base::RealVectorStateSpace::StateType>()->values;
+        return std::fabs(x[0] - x[1]) < 0.1 || std::hypot(x[0] - 0.9, x[1] - 0.1) < 0.05;
+    });
+    si->setStateValidityCheckingResolution(0.001);
+    si->setup();
+
+    base::ScopedState<base::RealVectorStateSpace> start(space), goal(space);
+    start[0] = start[1] = 0.05;
+    goal[0] = 0.9;
+    goal[1] = 0.1;
+    auto pdef(std::make_shared<base::ProblemDefinition>(si));
+    pdef->setStartAndGoalStates(start, goal);
+
+    std::vector<base::PlannerPtr> planners;
+    planners.push_back(std::make_shared<geometric::RRT>(si));
+    planners.push_back(std::make_shared<geometric::RRTConnect>(si));
+    planners.push_back(std::make_shared<geometric::EST>(si));
+    planners.push_back(std::make_shared<geometric::KPIECE1>(si));
+    for (auto &planner : planners)
+    {
+        planner->setProblemDefinition(pdef);
+        planner->setup();
+        // after a warm-up, only the iterations that grow the tree allocate
+        unsigned int grown;
+        unsigned long idle = planningAllocations(planner, *space, 2000, 1000, grown);
+        BOOST_CHECK_MESSAGE(grown > 0, planner->getName() << ": the tree did not grow");
+        BOOST_CHECK_MESSAGE(idle == 0, planner->getName() << ": " << idle
+                                                          << " allocations in iterations that did not grow the tree");
+    }
+}
@@ -0,0 +1,164 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#define BOOST_TEST_MODULE "SolutionChannel"
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+#include "ompl/base/SolutionChannel.h"
+#include "ompl/base/ProblemDefinition.h"
+#include "ompl/base/objectives/PathLengthOptimizationObjective.h"
+#include "ompl/base/spaces/RealVectorStateSpace.h"
+#include "ompl/geometric/PathGeometric.h"
+#include "ompl/geometric/planners/rrt/RRTstar.h"
+
+using namespace ompl;
+
+static base::SpaceInformationPtr makeSpaceInformation()
+{
+    auto space(std::make_shared<base::RealVectorStateSpace>(2));
+    space->setBounds(0, 1);
+    auto si(std::make_shared<base::SpaceInformation>(space));
+    si->setStateValidityChecker([](const base::State *)
+                                {
+                                    return true;
+                                });
+    si->setup();
+    return si;
+}
+
+BOOST_AUTO_TEST_CASE(PublishAndSubscribe)
+{
+    auto si = makeSpaceInformation();
+    base::PathLengthOptimizationObjective opt(si);
+    auto channel(std::make_shared<base::SolutionChannel>());
+    auto path(std::make_shared<geometric::PathGeometric>(si));
+
+    BOOST_CHECK(!channel->hasSubscribers());
+    BOOST_CHECK(channel->publish(path, base::Cost(3.0), "first", &opt));
+
+    base::SolutionChannel::Subscriber late(channel, false);
+    base::SolutionChannel::Subscriber latest(channel);
+    BOOST_CHECK(channel->hasSubscribers());
+    BOOST_CHECK(!late.next());
+
+    // only improvements are published
+    BOOST_CHECK(!channel->publish(path, base::Cost(4.0), "worse", &opt));
+    BOOST_CHECK(channel->publish(path, base::Cost(2.0), "second", &opt));
+    BOOST_CHECK(channel->publish(path, base::Cost(1.0), "third", &opt));
+    BOOST_CHECK_EQUAL(channel->getPublishedCount(), 3u);
+
+    auto improvement = late.next();
+    BOOST_REQUIRE(improvement);
+    BOOST_CHECK_EQUAL(improvement->plannerName, "second");
+    BOOST_CHECK_EQUAL(improvement->index, 1u);
+    BOOST_CHECK_EQUAL(improvement->cost.value(), 2.0);
+    improvement = late.next();
+    BOOST_REQUIRE(improvement);
+    BOOST_CHECK_EQUAL(improvement->plannerName, "third");
+    BOOST_CHECK(!late.next());
+
+    improvement = latest.next();
+    BOOST_REQUIRE(improvement);
+    BOOST_CHECK_EQUAL(improvement->plannerName, "first");
+    improvement = latest.latest();
+    BOOST_REQUIRE(improvement);
+    BOOST_CHECK_EQUAL(improvement->plannerName, "third");
+    BOOST_CHECK(!latest.latest());
+
+    // after a reset, the next path is published regardless of its cost
+    channel->reset();
+    BOOST_CHECK(channel->publish(path, base::Cost(5.0), "fourth", &opt));
+    BOOST_CHECK_EQUAL(late.next()->plannerName, "fourth");
+}
+
+BOOST_AUTO_TEST_CASE(WaitForImprovement)
+{
+    auto si = makeSpaceInformation();
+    auto channel(std::make_shared<base::SolutionChannel>());
+    base::SolutionChannel::Subscriber subscriber(channel);
+
+    BOOST_CHECK(!subscriber.wait(0.01));
+
+    std::thread producer([&]
+                         {
+                             std::this_thread::sleep_for(time::seconds(0.05));
+                             for (unsigned int i = 0; i < 100; ++i)
+                                 channel->publish(std::make_shared<geometric::PathGeometric>(si),
+                                                  base::Cost(100.0 - i), "producer");
+                         });
+    unsigned int received = 0;
+    while (auto improvement = subscriber.wait(10.0))
+    {
+        BOOST_CHECK_EQUAL(improvement->index, received);
+        if (++received == 100)
+            break;
+    }
+    producer.join();
+    BOOST_CHECK_EQUAL(received, 100u);
+}
+
+BOOST_AUTO_TEST_CASE(PlannerImprovements)
+{
+    auto si = makeSpaceInformation();
+    auto pdef(std::make_shared<base::ProblemDefinition>(si));
+    base::ScopedState<> start(si), goal(si);
+    start[0] = start[1] = 0.1;
+    goal[0] = goal[1] = 0.9;
+    pdef->setStartAndGoalStates(start, goal, 0.05);
+    pdef->setOptimizationObjective(std::make_shared<base::PathLengthOptimizationObjective>(si));
+
+    base::SolutionChannel::Subscriber subscriber(pdef->getSolutionChannel());
+    auto planner(std::make_shared<geometric::RRTstar>(si));
+    planner->setProblemDefinition(pdef);
+    planner->setup();
+    BOOST_CHECK(planner->solve(base::timedPlannerTerminationCondition(0.5)));
+
+    std::shared_ptr<const base::SolutionImprovement> previous;
+    unsigned int count = 0;
+    while (auto improvement = subscriber.next())
+    {
+        ++count;
+        BOOST_CHECK_EQUAL(improvement->plannerName, planner->getName());
+        BOOST_CHECK(improvement->path->check());
+        if (previous)
+            BOOST_CHECK_LT(improvement->cost.value(), previous->cost.value());
+        previous = improvement;
+    }
+    BOOST_CHECK_GT(count, 0u);
+    BOOST_CHECK_EQUAL(count, pdef->getSolutionChannel()->getPublishedCount());
+
+    // the final solution added to the problem definition is no better than the last improvement
+    BOOST_CHECK(!subscriber.next());
+}
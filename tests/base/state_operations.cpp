@@ -42,6 +42,9 @@
 #include "ompl/base/ScopedState.h"
 #include "ompl/base/spaces/SE3StateSpace.h"
 #include "ompl/base/SpaceInformation.h"
+#include "ompl/base/BatchedDiscreteMotionValidator.h"
+#include "ompl/base/spaces/RealVectorStateSpace.h"
+#include "ompl/base/spaces/DiscreteStateSpace.h"
 #include "ompl/util/Time.h"
 
 using namespace ompl;
@@ -321,3 +324,310 @@ BOOST_AUTO_TEST_CASE(PartialCopy)
         BOOST_CHECK(copyStateData(q, dummy.get(), r3, state[r3].get()) == base::NO_DATA_COPIED);
     }
 }
+
+BOOST_AUTO_TEST_CASE(Pool)
+{
+    auto m(std::make_shared<base::SE3StateSpace>());
+    base::RealVectorBounds b(3);
+    b.setLow(0);
+    b.setHigh(1);
+    m->setBounds(b);
+    m->setup();
+
+    base::StatePool pool(m, 16);
+    BOOST_CHECK(pool.isInline());
+
+    base::StateSamplerPtr sampler = m->allocStateSampler();
+    std::vector<base::State *> states(100), copies(100);
+    for (std::size_t i = 0 ; i < states.size() ; ++i)
+    {
+        states[i] = pool.allocState();
+        copies[i] = m->allocState();
+        sampler->sampleUniform(copies[i]);
+        m->copyState(states[i], copies[i]);
+    }
+    BOOST_CHECK_EQUAL(pool.size(), 100u);
+    for (std::size_t i = 0 ; i < states.size() ; ++i)
+    {
+        BOOST_CHECK(m->equalStates(states[i], copies[i]));
+        BOOST_OMPL_EXPECT_NEAR(m->distance(states[i], copies[(i + 1) % copies.size()]),
+                               m->distance(copies[i], copies[(i + 1) % copies.size()]), 1e-12);
+    }
+
+    // freed states are handed out again
+    base::State *freed = states[10];
+    pool.freeState(freed);
+    BOOST_CHECK_EQUAL(pool.size(), 99u);
+    states[10] = pool.allocState();
+    BOOST_CHECK(states[10] == freed);
+
+    // after a bulk free, the slabs are reused
+    pool.clear();
+    BOOST_CHECK_EQUAL(pool.size(), 0u);
+    base::State *first = pool.allocState();
+    BOOST_CHECK(first == states[0]);
+    m->copyState(first, copies[0]);
+    BOOST_CHECK(m->equalStates(first, copies[0]));
+
+    // in reset-on-clear mode, states are only released by clear()
+    pool.setResetOnClear(true);
+    pool.freeState(first);
+    BOOST_CHECK(pool.allocState() != first);
+    pool.clear();
+
+    for (auto &copy : copies)
+        m->freeState(copy);
+
+    // spaces with unknown state layout are still recycled by the pool
+    auto d(std::make_shared<base::DiscreteStateSpace>(0, 10));
+    base::StatePool dpool(d);
+    BOOST_CHECK(!dpool.isInline());
+    base::State *ds = dpool.allocState();
+    dpool.freeState(ds);
+    BOOST_CHECK(dpool.allocState() == ds);
+
+    // the pool is reachable through the space information
+    base::SpaceInformation si(m);
+    BOOST_CHECK(!si.getStatePool());
+    si.enableStatePool(64);
+    BOOST_CHECK(si.getStatePool() && si.getStatePool()->isInline());
+    base::State *ps = si.allocPooledState();
+    BOOST_CHECK_EQUAL(si.getStatePool()->size(), 1u);
+    si.freePooledState(ps);
+    BOOST_CHECK_EQUAL(si.getStatePool()->size(), 0u);
+    si.disableStatePool();
+    BOOST_CHECK(!si.getStatePool());
+
+    // a pool in reset-on-clear mode is only cleared when its last user releases it
+    si.enableStatePool(64, true);
+    base::StatePoolPtr first_user = si.acquireStatePool();
+    base::StatePoolPtr second_user = si.acquireStatePool();
+    BOOST_CHECK_EQUAL(si.getStatePool()->getUserCount(), 2u);
+    ps = si.allocPooledState();
+    BOOST_CHECK_THROW(si.disableStatePool(), Exception);
+    base::SpaceInformation::releaseStatePool(first_user);
+    BOOST_CHECK(!first_user);
+    BOOST_CHECK_EQUAL(si.getStatePool()->size(), 1u);
+    base::SpaceInformation::releaseStatePool(second_user, false);
+    BOOST_CHECK_EQUAL(si.getStatePool()->size(), 1u);
+    second_user = si.acquireStatePool();
+    base::SpaceInformation::releaseStatePool(second_user);
+    BOOST_CHECK_EQUAL(si.getStatePool()->size(), 0u);
+    si.disableStatePool();
+
+    // states freed by one thread are handed out to others
+    si.enableStatePool(64);
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < 4; ++t)
+        threads.emplace_back([&si]
+                             {
+                                 std::vector<base::State *> mine(100);
+                                 for (unsigned int round = 0; round < 50; ++round)
+                                 {
+                                     for (auto &state : mine)
+                                         state = si.allocPooledState();
+                                     for (auto &state : mine)
+                                         si.freePooledState(state);
+                                 }
+                             });
+    for (auto &thread : threads)
+        thread.join();
+    BOOST_CHECK_EQUAL(si.getStatePool()->size(), 0u);
+    si.disableStatePool();
+}
+
+// states are invalid inside the band 0.4 < x < 0.6; counts how many batches were requested
+class BandValidityChecker : public base::StateValidityChecker
+{
+public:
+    BandValidityChecker(const base::SpaceInformationPtr &si) : base::StateValidityChecker(si)
+    {
+    }
+
+    bool isValid(const base::State *state) const override
+    {
+        double x = state->as<base::RealVectorStateSpace::StateType>()->values[0];
+        return x <= 0.4 || x >= 0.6;
+    }
+
+    bool isValid(const base::State *const *states, std::size_t n, bool *out) const override
+    {
+        ++batches;
+        maxBatch = std::max(maxBatch, n);
+        return base::StateValidityChecker::isValid(states, n, out);
+    }
+
+    mutable unsigned int batches{0};
+    mutable std::size_t maxBatch{0};
+};
+
+BOOST_AUTO_TEST_CASE(BatchedMotionValidation)
+{
+    auto m(std::make_shared<base::RealVectorStateSpace>(2));
+    m->setBounds(0, 1);
+    auto si(std::make_shared<base::SpaceInformation>(m));
+    auto svc(std::make_shared<BandValidityChecker>(si));
+    si->setStateValidityChecker(svc);
+    si->setStateValidityCheckingResolution(0.001);
+    si->setup();
+
+    base::DiscreteMotionValidator discrete(si);
+    base::BatchedDiscreteMotionValidator batched(si);
+    batched.setBatchSize(7);
+    BOOST_CHECK_THROW(batched.setBatchSize(0), Exception);
+
+    base::ScopedState<base::RealVectorStateSpace> s1(m), s2(m), last1(m), last2(m);
+    for (int i = 0 ; i < 200 ; ++i)
+    {
+        do
+            s1.random();
+        while (!si->isValid(s1.get()));
+        s2.random();
+
+        BOOST_CHECK_EQUAL(discrete.checkMotion(s1.get(), s2.get()), batched.checkMotion(s1.get(), s2.get()));
+
+        std::pair<base::State *, double> lv1(last1.get(), 0.0), lv2(last2.get(), 0.0);
+        bool r1 = discrete.checkMotion(s1.get(), s2.get(), lv1);
+        bool r2 = batched.checkMotion(s1.get(), s2.get(), lv2);
+        BOOST_CHECK_EQUAL(r1, r2);
+        if (!r1)
+        {
+            BOOST_OMPL_EXPECT_NEAR(lv1.second, lv2.second, 1e-12);
+            BOOST_OMPL_EXPECT_NEAR(si->distance(last1.get(), last2.get()), 0.0, 1e-12);
+        }
+    }
+    BOOST_CHECK(svc->batches > 0);
+    BOOST_CHECK(svc->maxBatch <= 7);
+    BOOST_CHECK_EQUAL(discrete.getValidMotionCount(), batched.getValidMotionCount());
+    BOOST_CHECK_EQUAL(discrete.getInvalidMotionCount(), batched.getInvalidMotionCount());
+}
+
+BOOST_AUTO_TEST_CASE(MotionValidityCache)
+{
+    auto m(std::make_shared<base::RealVectorStateSpace>(2));
+    m->setBounds(0, 1);
+    auto si(std::make_shared<base::SpaceInformation>(m));
+    si->setStateValidityChecker(std::make_shared<BandValidityChecker>(si));
+    si->setStateValidityCheckingResolution(0.001);
+    si->setup();
+    base::DiscreteMotionValidator discrete(si);
+
+    si->enableMotionValidityCache(1024);
+    const base::CachedMotionValidatorPtr &cache = si->getMotionValidityCache();
+    BOOST_REQUIRE(cache);
+    BOOST_CHECK(si->getMotionValidator() == cache);
+    BOOST_CHECK_THROW(cache->setCapacity(0), Exception);
+
+    std::vector<base::ScopedState<base::RealVectorStateSpace>> from, to;
+    for (int i = 0 ; i < 32 ; ++i)
+    {
+        from.emplace_back(m);
+        to.emplace_back(m);
+        from.back().random();
+        to.back().random();
+    }
+
+    // first pass: all misses; second pass, on copies of the states: all hits
+    for (int i = 0 ; i < 32 ; ++i)
+        BOOST_CHECK_EQUAL(si->checkMotion(from[i].get(), to[i].get()),
+                          discrete.checkMotion(from[i].get(), to[i].get()));
+    BOOST_CHECK_EQUAL(cache->getMissCount(), 32u);
+    BOOST_CHECK_EQUAL(cache->getHitCount(), 0u);
+    for (int i = 0 ; i < 32 ; ++i)
+    {
+        base::ScopedState<base::RealVectorStateSpace> a(from[i]), b(to[i]);
+        BOOST_CHECK_EQUAL(si->checkMotion(a.get(), b.get()), discrete.checkMotion(a.get(), b.get()));
+    }
+    BOOST_CHECK_EQUAL(cache->getHitCount(), 32u);
+    BOOST_CHECK_EQUAL(cache->getValidMotionCount() + cache->getInvalidMotionCount(), 64u);
+
+    // the last valid state of an invalid motion is always computed
+    base::ScopedState<base::RealVectorStateSpace> last1(m), last2(m);
+    for (int i = 0 ; i < 32 ; ++i)
+    {
+        std::pair<base::State *, double> lv1(last1.get(), 0.0), lv2(last2.get(), 0.0);
+        bool r = si->checkMotion(from[i].get(), to[i].get(), lv1);
+        BOOST_CHECK_EQUAL(r, discrete.checkMotion(from[i].get(), to[i].get(), lv2));
+        if (!r)
+            BOOST_OMPL_EXPECT_NEAR(lv1.second, lv2.second, 1e-12);
+    }
+
+    // reversed motions only share an entry in symmetric mode
+    cache->resetCacheStatistics();
+    for (int i = 0 ; i < 32 ; ++i)
+        si->checkMotion(to[i].get(), from[i].get());
+    BOOST_CHECK_EQUAL(cache->getHitCount(), 0u);
+    si->enableMotionValidityCache(1024, true);
+    BOOST_CHECK_EQUAL(cache->size(), 0u);
+    for (int i = 0 ; i < 32 ; ++i)
+        si->checkMotion(from[i].get(), to[i].get());
+    cache->resetCacheStatistics();
+    for (int i = 0 ; i < 32 ; ++i)
+        si->checkMotion(to[i].get(), from[i].get());
+    BOOST_CHECK_EQUAL(cache->getHitCount(), 32u);
+
+    // least recently used motions are evicted
+    cache->setCapacity(64);
+    base::ScopedState<base::RealVectorStateSpace> a(m), b(m);
+    for (int i = 0 ; i < 1000 ; ++i)
+    {
+        a.random();
+        b.random();
+        si->checkMotion(a.get(), b.get());
+    }
+    BOOST_CHECK(cache->size() <= cache->getCapacity() + 16);
+
+    // changing the validity checker invalidates the cache
+    si->setStateValidityChecker(std::make_shared<BandValidityChecker>(si));
+    BOOST_CHECK_EQUAL(cache->size(), 0u);
+
+    // results are consistent when the cache is used from several threads
+    std::vector<std::thread> threads;
+    std::atomic<unsigned int> mismatches{0};
+    for (int t = 0 ; t < 4 ; ++t)
+        threads.emplace_back([&] {
+            for (int k = 0 ; k < 200 ; ++k)
+            {
+                int i = k % 32;
+                if (si->checkMotion(from[i].get(), to[i].get()) != discrete.checkMotion(from[i].get(), to[i].get()))
+                    ++mismatches;
+            }
+        });
+    for (auto &thread : threads)
+        thread.join();
+    BOOST_CHECK_EQUAL(mismatches, 0u);
+
+    si->disableMotionValidityCache();
+    BOOST_CHECK(!si->getMotionValidityCache());
+    BOOST_CHECK(std::dynamic_pointer_cast<base::CachedMotionValidator>(si->getMotionValidator()) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(MotionValidityCacheBeforeSetup)
+{
+    auto m(std::make_shared<base::RealVectorStateSpace>(2));
+    m->setBounds(0, 1);
+    auto si(std::make_shared<base::SpaceInformation>(m));
+    si->setStateValidityChecker(std::make_shared<BandValidityChecker>(si));
+    si->setStateValidityCheckingResolution(0.001);
+
+    // without a motion validator, enabling the cache sets the default one, as setup() would
+    si->setMotionValidator(base::MotionValidatorPtr());
+    si->enableMotionValidityCache(1024);
+    const base::CachedMotionValidatorPtr &cache = si->getMotionValidityCache();
+    BOOST_REQUIRE(cache);
+    BOOST_REQUIRE(cache->getMotionValidator());
+    si->setup();
+    BOOST_CHECK(si->getMotionValidator() == cache);
+
+    base::DiscreteMotionValidator discrete(si);
+    base::ScopedState<base::RealVectorStateSpace> a(m), b(m);
+    for (int i = 0 ; i < 32 ; ++i)
+    {
+        a.random();
+        b.random();
+        BOOST_CHECK_EQUAL(si->checkMotion(a.get(), b.get()), discrete.checkMotion(a.get(), b.get()));
+        BOOST_CHECK_EQUAL(si->checkMotion(a.get(), b.get()), discrete.checkMotion(a.get(), b.get()));
+    }
+    BOOST_CHECK_EQUAL(cache->getMissCount(), 32u);
+    BOOST_CHECK_EQUAL(cache->getHitCount(), 32u);
+}
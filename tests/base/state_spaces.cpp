@@ -43,6 +43,7 @@
 
 #include "ompl/base/spaces/TimeStateSpace.h"
 #include "ompl/base/spaces/RealVectorStateSpace.h"
+#include "ompl/base/spaces/RealVectorKernels.h"
 #include "ompl/base/spaces/SO2StateSpace.h"
 #include "ompl/base/spaces/SO3StateSpace.h"
 #include "ompl/base/spaces/SE2StateSpace.h"
@@ -50,6 +51,9 @@
 #include "ompl/base/spaces/DiscreteStateSpace.h"
 #include "ompl/base/spaces/ReedsSheppStateSpace.h"
 #include "ompl/base/spaces/DubinsStateSpace.h"
+#include "ompl/base/spaces/FixedRealVectorStateSpace.h"
+#include "ompl/base/spaces/FixedSE3StateSpace.h"
+#include "ompl/base/spaces/StaticCompoundStateSpace.h"
 
 #include <boost/math/constants/constants.hpp>
 
@@ -304,6 +308,195 @@ BOOST_AUTO_TEST_CASE(RealVector_Simple)
     BOOST_CHECK_EQUAL(m2->getDimension(), 1u);
 }
 
+BOOST_AUTO_TEST_CASE(RealVector_Kernels)
+{
+    BOOST_TEST_MESSAGE("Using " << base::kernels::getInstructionSet() << " kernels");
+    RNG rng;
+    for (unsigned int n = 0 ; n <= 19 ; ++n)
+    {
+        std::vector<double> a(n), b(n), low(n, -0.5), high(n, 0.5), out(n), clamped(n);
+        for (unsigned int i = 0 ; i < n ; ++i)
+        {
+            a[i] = rng.uniformReal(-1.0, 1.0);
+            b[i] = rng.uniformReal(-1.0, 1.0);
+        }
+
+        double sq = 0.0;
+        bool within = true;
+        for (unsigned int i = 0 ; i < n ; ++i)
+        {
+            sq += (a[i] - b[i]) * (a[i] - b[i]);
+            clamped[i] = std::min(std::max(a[i], low[i]), high[i]);
+            within = within && a[i] >= low[i] && a[i] <= high[i];
+        }
+        BOOST_OMPL_EXPECT_NEAR(base::kernels::squaredDistance(a.data(), b.data(), n), sq, 1e-12);
+        BOOST_CHECK_EQUAL(base::kernels::withinBounds(a.data(), low.data(), high.data(), 0.0, n), within);
+
+        base::kernels::interpolate(a.data(), b.data(), 0.25, out.data(), n);
+        for (unsigned int i = 0 ; i < n ; ++i)
+            BOOST_OMPL_EXPECT_NEAR(out[i], a[i] + (b[i] - a[i]) * 0.25, 1e-12);
+
+        base::kernels::clamp(a.data(), low.data(), high.data(), n);
+        BOOST_CHECK(a == clamped);
+        BOOST_CHECK(base::kernels::withinBounds(a.data(), low.data(), high.data(), 0.0, n));
+    }
+}
+
+/* check that the batched distances from a state computed by \e space match distance() */
+static void checkDistanceBatch(const base::StateSpacePtr &space)
+{
+    base::StateSamplerPtr sampler = space->allocStateSampler();
+    std::vector<base::State *> states(150);
+    for (auto &state : states)
+    {
+        state = space->allocState();
+        sampler->sampleUniform(state);
+    }
+    std::vector<double> distances(states.size());
+    space->distanceBatch(states[0], states.data(), states.size(), distances.data());
+    for (std::size_t i = 0 ; i < states.size() ; ++i)
+        BOOST_OMPL_EXPECT_NEAR(distances[i], space->distance(states[0], states[i]), 1e-12);
+    for (auto &state : states)
+        space->freeState(state);
+}
+
+BOOST_AUTO_TEST_CASE(DistanceBatch)
+{
+    auto se3(std::make_shared<base::SE3StateSpace>());
+    base::RealVectorBounds b(3);
+    b.setLow(-1);
+    b.setHigh(1);
+    se3->setBounds(b);
+    auto rv(std::make_shared<base::RealVectorStateSpace>(7));
+    rv->setBounds(-1, 1);
+    auto m(std::make_shared<base::CompoundStateSpace>());
+    m->addSubspace(se3, 1.0);
+    m->addSubspace(std::make_shared<base::SO2StateSpace>(), 0.5);
+    m->addSubspace(rv, 2.0);
+    m->setup();
+    checkDistanceBatch(m);
+}
+
+BOOST_AUTO_TEST_CASE(DistanceBatch_Curves)
+{
+    // Dubins and Reeds-Shepp spaces are compound spaces that override distance()
+    base::RealVectorBounds bounds2(2);
+    bounds2.setLow(-3);
+    bounds2.setHigh(3);
+    for (const base::StateSpacePtr &space :
+         {base::StateSpacePtr(std::make_shared<base::DubinsStateSpace>()),
+          base::StateSpacePtr(std::make_shared<base::DubinsStateSpace>(1., true)),
+          base::StateSpacePtr(std::make_shared<base::ReedsSheppStateSpace>())})
+    {
+        space->as<base::SE2StateSpace>()->setBounds(bounds2);
+        space->setup();
+        checkDistanceBatch(space);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(DistanceBatch_Subclass)
+{
+    // a compound space defined by the user, with its own distance function
+    class MaxComponentStateSpace : public base::CompoundStateSpace
+    {
+    public:
+        double distance(const base::State *state1, const base::State *state2) const override
+        {
+            const auto *cstate1 = state1->as<base::CompoundState>();
+            const auto *cstate2 = state2->as<base::CompoundState>();
+            double dist = 0.0;
+            for (unsigned int i = 0 ; i < componentCount_ ; ++i)
+                dist = std::max(dist, components_[i]->distance(cstate1->components[i], cstate2->components[i]));
+            return dist;
+        }
+    };
+
+    auto rv(std::make_shared<base::RealVectorStateSpace>(3));
+    rv->setBounds(-1, 1);
+    auto m(std::make_shared<MaxComponentStateSpace>());
+    m->addSubspace(rv, 1.0);
+    m->addSubspace(std::make_shared<base::SO2StateSpace>(), 1.0);
+    m->setup();
+    checkDistanceBatch(m);
+}
+
+/* check that \e fixed computes the same as \e dynamic, on states allocated by \e fixed */
+static void compareSpaces(const base::StateSpacePtr &fixed, const base::StateSpacePtr &dynamic)
+{
+    StateSpaceTest mt(fixed, 1000, 1e-12);
+    mt.test();
+
+    base::StateSamplerPtr sampler = fixed->allocStateSampler();
+    base::State *s1 = fixed->allocState();
+    base::State *s2 = fixed->allocState();
+    base::State *s3 = fixed->allocState();
+    base::State *s4 = fixed->allocState();
+    for (unsigned int i = 0 ; i < 100 ; ++i)
+    {
+        sampler->sampleUniform(s1);
+        sampler->sampleUniform(s2);
+        BOOST_OMPL_EXPECT_NEAR(fixed->distance(s1, s2), dynamic->distance(s1, s2), 1e-12);
+        fixed->interpolate(s1, s2, 0.3, s3);
+        dynamic->interpolate(s1, s2, 0.3, s4);
+        BOOST_OMPL_EXPECT_NEAR(dynamic->distance(s3, s4), 0.0, 1e-12);
+        fixed->copyState(s4, s2);
+        BOOST_CHECK(fixed->equalStates(s4, s2));
+        BOOST_CHECK(dynamic->equalStates(s4, s2));
+        BOOST_CHECK(!fixed->equalStates(s1, s2));
+    }
+    fixed->freeState(s1);
+    fixed->freeState(s2);
+    fixed->freeState(s3);
+    fixed->freeState(s4);
+}
+
+BOOST_AUTO_TEST_CASE(Fixed_Simple)
+{
+    auto rv7(std::make_shared<base::FixedRealVectorStateSpace<7>>());
+    rv7->setBounds(-1, 1);
+    rv7->setup();
+    rv7->sanityChecks();
+    BOOST_CHECK_EQUAL(rv7->getDimension(), 7u);
+    auto drv7(std::make_shared<base::RealVectorStateSpace>(7));
+    drv7->setBounds(-1, 1);
+    drv7->setup();
+    compareSpaces(rv7, drv7);
+
+    base::RealVectorBounds b(3);
+    b.setLow(-1);
+    b.setHigh(1);
+    auto se3(std::make_shared<base::FixedSE3StateSpace>());
+    se3->setBounds(b);
+    se3->setSubspaceWeight(1, 0.5);
+    se3->setup();
+    se3->sanityChecks();
+    auto dse3(std::make_shared<base::SE3StateSpace>());
+    dse3->setBounds(b);
+    dse3->setSubspaceWeight(1, 0.5);
+    dse3->setup();
+    compareSpaces(se3, dse3);
+
+    base::ScopedState<base::FixedSE3StateSpace> s(se3);
+    s->setXYZ(0.1, 0.2, 0.3);
+    s->rotation().setIdentity();
+    BOOST_CHECK_EQUAL(s->getY(), 0.2);
+
+    using ArmOnBase = base::StaticCompoundStateSpace<base::FixedSE3StateSpace, base::FixedRealVectorStateSpace<7>>;
+    auto arm(std::make_shared<ArmOnBase>());
+    arm->getTypedSubspace<0>()->setBounds(b);
+    arm->getTypedSubspace<0>()->setSubspaceWeight(1, 0.5);
+    arm->getTypedSubspace<1>()->setBounds(-1, 1);
+    arm->setSubspaceWeight(1, 2.0);
+    arm->setup();
+    arm->sanityChecks();
+    BOOST_CHECK_EQUAL(arm->getDimension(), 13u);
+    auto darm(std::make_shared<base::CompoundStateSpace>());
+    darm->addSubspace(dse3, 1.0);
+    darm->addSubspace(drv7, 2.0);
+    darm->setup();
+    compareSpaces(arm, darm);
+}
+
 BOOST_AUTO_TEST_CASE(Time_Bounds)
 {
     base::TimeStateSpace t;
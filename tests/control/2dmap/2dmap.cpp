@@ -42,6 +42,7 @@
 #include "ompl/base/goals/GoalState.h"
 #include "ompl/base/spaces/RealVectorStateSpace.h"
 #include "ompl/control/spaces/RealVectorControlSpace.h"
+#include "ompl/control/ODESolver.h"
 #include "ompl/control/planners/rrt/RRT.h"
 #include "ompl/control/planners/kpiece/KPIECE1.h"
 #include "ompl/control/planners/est/EST.h"
@@ -367,6 +368,7 @@ private:
 
 class SyclopRRTTest : public TestPlanner
 {
+protected:
     base::PlannerPtr newPlanner(const control::SpaceInformationPtr &si) override
     {
         base::RealVectorBounds bounds(2);
@@ -391,6 +393,7 @@ class SyclopRRTTest : public TestPlanner
 
 class SyclopESTTest : public TestPlanner
 {
+protected:
     base::PlannerPtr newPlanner(const control::SpaceInformationPtr &si) override
     {
         base::RealVectorBounds bounds(2);
@@ -413,6 +416,30 @@ class SyclopESTTest : public TestPlanner
     }
 };
 
+class SyclopRRTParallelTest : public SyclopRRTTest
+{
+protected:
+    base::PlannerPtr newPlanner(const control::SpaceInformationPtr &si) override
+    {
+        base::PlannerPtr planner = SyclopRRTTest::newPlanner(si);
+        // search for nearest neighbors among the motions of nearby regions, which are guarded by region locks
+        planner->as<control::SyclopRRT>()->setRegionalNearestNeighbors(true);
+        planner->as<control::SyclopRRT>()->setThreadCount(4);
+        return planner;
+    }
+};
+
+class SyclopESTParallelTest : public SyclopESTTest
+{
+protected:
+    base::PlannerPtr newPlanner(const control::SpaceInformationPtr &si) override
+    {
+        base::PlannerPtr planner = SyclopESTTest::newPlanner(si);
+        planner->as<control::SyclopEST>()->setThreadCount(4);
+        return planner;
+    }
+};
+
 class KPIECETest : public TestPlanner
 {
 protected:
@@ -427,6 +454,21 @@ protected:
     }
 };
 
+class KPIECEBatchTest : public TestPlanner
+{
+protected:
+    base::PlannerPtr newPlanner(const control::SpaceInformationPtr &si) override
+    {
+        auto kpiece(std::make_shared<control::KPIECE1>(si));
+        kpiece->setNumControlSamples(4);
+
+        std::vector<double> cdim = {1, 1};
+        kpiece->setProjectionEvaluator(std::make_shared<myProjectionEvaluator>(si->getStateSpace(), cdim));
+
+        return kpiece;
+    }
+};
+
 class ESTTest : public TestPlanner
 {
 protected:
@@ -533,9 +575,159 @@ BOOST_FIXTURE_TEST_SUITE(MyPlanTestFixture, PlanTest)
 OMPL_PLANNER_TEST(RRT, 99.0, 0.05)
 OMPL_PLANNER_TEST(RRTIntermediate, 99.0, 0.25)
 OMPL_PLANNER_TEST(KPIECE, 99.0, 0.05)
+OMPL_PLANNER_TEST(KPIECEBatch, 99.0, 0.05)
 OMPL_PLANNER_TEST(EST, 99.0, 0.05)
 OMPL_PLANNER_TEST(SyclopRRT, 99.0, 0.05)
 OMPL_PLANNER_TEST(SyclopEST, 99.0, 0.05)
+OMPL_PLANNER_TEST(SyclopRRTParallel, 99.0, 0.05)
+OMPL_PLANNER_TEST(SyclopESTParallel, 99.0, 0.05)
 OMPL_PLANNER_TEST(PDST, 99.0, 0.05)
 
+BOOST_AUTO_TEST_CASE(control_PropagateWhileValidBatch)
+{
+    control::SpaceInformationPtr si = mySpaceInformation(env);
+    control::ControlSamplerPtr cs = si->allocControlSampler();
+    base::ValidStateSamplerPtr vss = si->allocValidStateSampler();
+    RNG rng;
+
+    const std::size_t n = 50;
+    base::State *start = si->allocState();
+    base::State *expected = si->allocState();
+    std::vector<control::Control *> controls(n);
+    std::vector<base::State *> results(n);
+    std::vector<int> steps(n);
+    std::vector<unsigned int> validSteps(n);
+    std::vector<std::vector<base::State *>> trajectories(n, std::vector<base::State *>(30));
+    std::vector<base::State *> expectedTrajectory(30);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        controls[i] = si->allocControl();
+        results[i] = si->allocState();
+        for (auto &state : trajectories[i])
+            state = si->allocState();
+    }
+    for (auto &state : expectedTrajectory)
+        state = si->allocState();
+
+    for (int k = 0; k < 20; ++k)
+    {
+        vss->sample(start);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            cs->sample(controls[i]);
+            steps[i] = rng.uniformInt(-10, 30);
+        }
+
+        si->propagateWhileValidBatch(start, controls.data(), steps.data(), n, results.data(), validSteps.data());
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            unsigned int r = si->propagateWhileValid(start, controls[i], steps[i], expected);
+            BOOST_CHECK_EQUAL(validSteps[i], r);
+            BOOST_CHECK(si->equalStates(results[i], expected));
+        }
+
+        // the states along each motion are those propagateWhileValid() computes
+        si->propagateWhileValidBatch(start, controls.data(), steps.data(), n, trajectories.data(), validSteps.data());
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            unsigned int r = si->propagateWhileValid(start, controls[i], steps[i], expectedTrajectory, false);
+            BOOST_REQUIRE_EQUAL(validSteps[i], r);
+            for (unsigned int j = 0; j < r; ++j)
+                BOOST_CHECK(si->equalStates(trajectories[i][j], expectedTrajectory[j]));
+        }
+
+        si->propagateBatch(start, controls.data(), steps.data(), n, results.data());
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            si->propagate(start, controls[i], steps[i], expected);
+            BOOST_CHECK(si->equalStates(results[i], expected));
+        }
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        si->freeControl(controls[i]);
+        si->freeState(results[i]);
+        for (auto &state : trajectories[i])
+            si->freeState(state);
+    }
+    for (auto &state : expectedTrajectory)
+        si->freeState(state);
+    si->freeState(start);
+    si->freeState(expected);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
+
+/* A pendulum with a torque input, integrated one state at a time and in batches */
+BOOST_AUTO_TEST_CASE(control_ODEBatchSolver)
+{
+    auto space(std::make_shared<base::RealVectorStateSpace>(2));
+    space->setBounds(-10.0, 10.0);
+    auto cspace(std::make_shared<control::RealVectorControlSpace>(space, 1));
+    base::RealVectorBounds cbounds(1);
+    cbounds.setLow(-1.0);
+    cbounds.setHigh(1.0);
+    cspace->setBounds(cbounds);
+    auto si(std::make_shared<control::SpaceInformation>(space, cspace));
+    si->setPropagationStepSize(0.25);
+
+    auto ode = [](const control::ODESolver::StateType &q, const control::Control *c, control::ODESolver::StateType &qdot)
+    {
+        qdot.resize(2);
+        qdot[0] = q[1];
+        qdot[1] = -std::sin(q[0]) + c->as<control::RealVectorControlSpace::ControlType>()->values[0];
+    };
+    auto batchODE = [](const double *q, const control::Control *const *c, std::size_t n, double *qdot)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            qdot[i] = q[n + i];
+            qdot[n + i] = -std::sin(q[i]) + c[i]->as<control::RealVectorControlSpace::ControlType>()->values[0];
+        }
+    };
+    control::StatePropagatorPtr basic =
+        control::ODESolver::getStatePropagator(std::make_shared<control::ODEBasicSolver<>>(si, ode));
+    control::StatePropagatorPtr batch =
+        control::ODESolver::getStatePropagator(std::make_shared<control::ODEBatchSolver>(si, batchODE));
+    si->setStatePropagator(batch);
+    si->setup();
+
+    const std::size_t n = 17;
+    control::ControlSamplerPtr cs = si->allocControlSampler();
+    base::StateSamplerPtr ss = si->allocStateSampler();
+    std::vector<base::State *> states(n), results(n);
+    std::vector<control::Control *> controls(n);
+    std::vector<double> durations(n);
+    base::State *expected = si->allocState();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        states[i] = si->allocState();
+        results[i] = si->allocState();
+        controls[i] = si->allocControl();
+        ss->sampleUniform(states[i]);
+        cs->sample(controls[i]);
+        durations[i] = 0.25 * (i % 4 + 1);
+    }
+
+    // the solver reuses its buffers for batches of another size
+    for (std::size_t m : {n, n / 2, n})
+    {
+        batch->propagateBatch(states.data(), controls.data(), durations.data(), m, results.data());
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            basic->propagate(states[i], controls[i], durations[i], expected);
+            BOOST_CHECK_SMALL(si->distance(results[i], expected), 1e-9);
+            batch->propagate(states[i], controls[i], durations[i], expected);
+            BOOST_CHECK_SMALL(si->distance(results[i], expected), 1e-12);
+        }
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        si->freeState(states[i]);
+        si->freeState(results[i]);
+        si->freeControl(controls[i]);
+    }
+    si->freeState(expected);
+}
@@ -0,0 +1,232 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#define BOOST_TEST_MODULE "LTL"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+#include "ompl/base/ScopedState.h"
+#include "ompl/base/spaces/SE2StateSpace.h"
+#include "ompl/control/PathControl.h"
+#include "ompl/control/spaces/RealVectorControlSpace.h"
+#include "ompl/control/planners/ltl/Automaton.h"
+#include "ompl/control/planners/ltl/LTLPlanner.h"
+#include "ompl/control/planners/ltl/LTLProblemDefinition.h"
+#include "ompl/control/planners/ltl/ProductGraph.h"
+#include "ompl/control/planners/ltl/PropositionalDecomposition.h"
+#include "ompl/control/planners/syclop/GridDecomposition.h"
+#include "ompl/util/RandomNumbers.h"
+
+using namespace ompl;
+
+/* A 20x20 grid over the (x, y) coordinates of SE(2) */
+class Grid : public control::GridDecomposition
+{
+public:
+    Grid(const base::RealVectorBounds &bounds) : control::GridDecomposition(20, 2, bounds)
+    {
+    }
+
+    using control::GridDecomposition::getRegionBounds;
+
+    void project(const base::State *s, std::vector<double> &coord) const override
+    {
+        const auto *se2 = s->as<base::SE2StateSpace::StateType>();
+        coord.resize(2);
+        coord[0] = se2->getX();
+        coord[1] = se2->getY();
+    }
+
+    void sampleFullState(const base::StateSamplerPtr &sampler, const std::vector<double> &coord,
+                         base::State *s) const override
+    {
+        sampler->sampleUniform(s);
+        s->as<base::SE2StateSpace::StateType>()->setXY(coord[0], coord[1]);
+    }
+};
+
+/* Three propositions, each true in a small box of the grid */
+class Propositions : public control::PropositionalDecomposition
+{
+public:
+    Propositions(const std::shared_ptr<Grid> &grid) : control::PropositionalDecomposition(grid), grid_(grid)
+    {
+    }
+
+    control::World worldAtRegion(int rid) override
+    {
+        const base::RealVectorBounds &bounds = grid_->getRegionBounds(rid);
+        const double x = (bounds.low[0] + bounds.high[0]) / 2.0;
+        const double y = (bounds.low[1] + bounds.high[1]) / 2.0;
+        control::World world(3);
+        world[0] = x > 0.9 && x < 1.1 && y > 0.3 && y < 0.5;
+        world[1] = x > 1.5 && x < 1.7 && y > 1.5 && y < 1.7;
+        world[2] = x > 0.2 && x < 0.35 && y > 1.6 && y < 1.8;
+        return world;
+    }
+
+    int getNumProps() const override
+    {
+        return 3;
+    }
+
+private:
+    std::shared_ptr<Grid> grid_;
+};
+
+/* The space [0, 2] x [0, 2] x SO(2) */
+static std::shared_ptr<base::SE2StateSpace> allocSpace()
+{
+    auto space(std::make_shared<base::SE2StateSpace>());
+    base::RealVectorBounds bounds(2);
+    bounds.setLow(0);
+    bounds.setHigh(2);
+    space->setBounds(bounds);
+    return space;
+}
+
+/* Visit the regions of proposition 2 and then 0, always avoiding those of proposition 1 */
+static control::ProductGraphPtr allocProductGraph(const base::StateSpacePtr &space)
+{
+    auto grid(std::make_shared<Grid>(space->as<base::SE2StateSpace>()->getBounds()));
+    return std::make_shared<control::ProductGraph>(std::make_shared<Propositions>(grid),
+                                                   control::Automaton::SequenceAutomaton(3, {2, 0}),
+                                                   control::Automaton::AvoidanceAutomaton(3, {1}));
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalLead)
+{
+    auto space(allocSpace());
+    control::ProductGraphPtr product(allocProductGraph(space));
+    base::ScopedState<base::SE2StateSpace> start(space);
+    start->setXY(0.2, 0.2);
+    start->setYaw(0.0);
+
+    using State = control::ProductGraph::State;
+    State *pstart = product->getState(start.get());
+    std::vector<State *> states;
+    product->buildGraph(pstart, [&states](State *s) { states.push_back(s); });
+    BOOST_REQUIRE(states.size() > 400u);
+
+    // the weight of an edge is the sum of the weights of its two states
+    std::unordered_map<State *, double> weights;
+    for (State *s : states)
+        weights[s] = 1.0;
+    auto edgeWeight = [&weights](State *a, State *b) { return weights[a] + weights[b]; };
+    auto leadCost = [&edgeWeight](const std::vector<State *> &lead)
+    {
+        double cost = 0.0;
+        for (std::size_t i = 1; i < lead.size(); ++i)
+            cost += edgeWeight(lead[i - 1], lead[i]);
+        return cost;
+    };
+
+    RNG rng;
+    for (int round = 0; round < 20; ++round)
+    {
+        if (round > 0)
+            for (int i = 0; i < 20; ++i)
+            {
+                State *s = states[rng.uniformInt(0, states.size() - 1)];
+                weights[s] = rng.uniformReal(0.1, 10.0);
+                product->invalidateEdgeWeights(s);
+            }
+
+        // computeLead() goes first, so that the graph already holds the new weights when the lead is repaired
+        std::vector<State *> lead = product->computeLead(pstart, edgeWeight);
+        std::vector<State *> incremental = product->computeLeadIncremental(pstart, edgeWeight);
+        BOOST_REQUIRE(!lead.empty() && !incremental.empty());
+        BOOST_CHECK(incremental.front() == pstart);
+        BOOST_CHECK(product->isSolution(lead.back()));
+        BOOST_CHECK(product->isSolution(incremental.back()));
+        BOOST_CHECK_CLOSE(leadCost(incremental), leadCost(lead), 1e-9);
+    }
+}
+
+/* A unicycle driving at speed control[0] after turning by control[1] */
+static void propagate(const base::State *start, const control::Control *control, const double duration,
+                      base::State *result)
+{
+    const auto *se2 = start->as<base::SE2StateSpace::StateType>();
+    const double *u = control->as<control::RealVectorControlSpace::ControlType>()->values;
+    auto *out = result->as<base::SE2StateSpace::StateType>();
+    out->setXY(se2->getX() + u[0] * duration * std::cos(se2->getYaw()),
+               se2->getY() + u[0] * duration * std::sin(se2->getYaw()));
+    out->setYaw(se2->getYaw() + u[1]);
+    base::SO2StateSpace().enforceBounds(out->as<base::SO2StateSpace::StateType>(1));
+}
+
+BOOST_AUTO_TEST_CASE(PlannerThreads)
+{
+    auto space(allocSpace());
+    auto cspace(std::make_shared<control::RealVectorControlSpace>(space, 2));
+    base::RealVectorBounds cbounds(2);
+    cbounds.setLow(-0.5);
+    cbounds.setHigh(0.5);
+    cspace->setBounds(cbounds);
+
+    auto si(std::make_shared<control::SpaceInformation>(space, cspace));
+    control::SpaceInformation *siPtr = si.get();
+    si->setStateValidityChecker([siPtr](const base::State *s) { return siPtr->satisfiesBounds(s); });
+    si->setStatePropagator(propagate);
+    si->setPropagationStepSize(0.025);
+
+    control::ProductGraphPtr product(allocProductGraph(space));
+    auto ltlsi(std::make_shared<control::LTLSpaceInformation>(si, product));
+    auto pdef(std::make_shared<control::LTLProblemDefinition>(ltlsi));
+    base::ScopedState<base::SE2StateSpace> start(space);
+    start->setXY(0.2, 0.2);
+    start->setYaw(0.0);
+    pdef->addLowerStartState(start.get());
+
+    // the propagator and the validity checker above are thread safe
+    control::LTLPlanner planner(ltlsi, product);
+    planner.params().setParam("thread_count", "4");
+    BOOST_CHECK_EQUAL(planner.getThreadCount(), 4u);
+    planner.setProblemDefinition(pdef);
+    BOOST_REQUIRE(planner.base::Planner::solve(30.0) == base::PlannerStatus::EXACT_SOLUTION);
+
+    auto path(std::static_pointer_cast<control::PathControl>(pdef->getLowerSolutionPath()));
+    BOOST_REQUIRE(path);
+    BOOST_CHECK(path->check());
+    BOOST_CHECK(space->equalStates(path->getState(0), start.get()));
+
+    // the solution in the product space ends in an accepting high-level state
+    auto productPath(std::static_pointer_cast<control::PathControl>(pdef->getSolutionPath()));
+    std::vector<control::ProductGraph::State *> highLevel = planner.getHighLevelPath(productPath->getStates());
+    BOOST_REQUIRE(!highLevel.empty());
+    BOOST_CHECK(product->isSolution(highLevel.back()));
+}
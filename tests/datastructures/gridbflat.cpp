@@ -0,0 +1,217 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#define BOOST_TEST_MODULE "GridBFlat"
+#include <boost/test/unit_test.hpp>
+#include "ompl/datastructures/GridB.h"
+#include "ompl/datastructures/GridBFlat.h"
+#include "ompl/util/RandomNumbers.h"
+#include <algorithm>
+#include <map>
+
+using namespace ompl;
+
+// define a convenience macro
+#define BOOST_OMPL_EXPECT_NEAR(a, b, diff) BOOST_CHECK_SMALL((a) - (b), diff)
+
+BOOST_AUTO_TEST_CASE(Simple)
+{
+    GridBFlat<int> g(2);
+
+    BOOST_CHECK_EQUAL((unsigned int)2, g.getDimension());
+
+    GridBFlat<int>::Coord coord(2);
+    coord[0] = 1;
+    coord[1] = 0;
+    BOOST_CHECK_EQUAL(g.has(coord), false);
+    GridBFlat<int>::Cell *cell1 = g.createCell(coord);
+    BOOST_CHECK(cell1 != nullptr);
+    BOOST_CHECK(cell1->neighbors == 0);
+    cell1->data = 1;
+    g.add(cell1);
+    BOOST_CHECK(g.has(coord));
+
+    coord[1] = 1;
+    GridBFlat<int>::Cell *cell2 = g.createCell(coord);
+    BOOST_CHECK(cell1->neighbors == 1);
+    BOOST_CHECK(cell2->neighbors == 1);
+    cell2->data = 2;
+    g.add(cell2);
+
+    GridBFlat<int>::CellArray ca;
+    g.neighbors(cell2, ca);
+    BOOST_CHECK_EQUAL((unsigned int)1, ca.size());
+    BOOST_CHECK_EQUAL(ca[0], cell1);
+
+    coord[0] = 0;
+    GridBFlat<int>::Cell *cell3 = g.createCell(coord);
+    cell3->data = 3;
+    g.add(cell3);
+    coord[0] = 2;
+    GridBFlat<int>::Cell *cell4 = g.createCell(coord);
+    cell4->data = 4;
+    g.add(cell4);
+    BOOST_CHECK(cell2->neighbors == 3);
+    BOOST_CHECK(cell2->border);
+
+    coord[0] = 1;
+    coord[1] = 2;
+    GridBFlat<int>::Cell *cell5 = g.createCell(coord);
+    cell5->data = 5;
+    g.add(cell5);
+    BOOST_CHECK(cell2->neighbors == 4);
+    BOOST_CHECK_EQUAL(cell2->border, false);
+    BOOST_CHECK_EQUAL((unsigned int)1, g.countInternal());
+    BOOST_OMPL_EXPECT_NEAR(g.fracExternal(), 0.8, 1e-12);
+
+    BOOST_CHECK_EQUAL(1, g.topExternal()->data);
+    BOOST_CHECK_EQUAL(2, g.topInternal()->data);
+
+    g.remove(cell1);
+    g.destroyCell(cell1);
+    BOOST_CHECK(cell2->border);
+    BOOST_CHECK_EQUAL((unsigned int)0, g.countInternal());
+    BOOST_CHECK_EQUAL(2, g.topExternal()->data);
+
+    BOOST_CHECK_EQUAL((unsigned int)4, g.size());
+    int sum = 0;
+    for (const auto &it : g)
+        sum += it.second->data;
+    BOOST_CHECK_EQUAL(14, sum);
+
+    // the destroyed cell is reused
+    coord[0] = 7;
+    coord[1] = 7;
+    BOOST_CHECK_EQUAL(g.createCell(coord), cell1);
+}
+
+// Apply the same random insertions and removals to a GridB and a GridBFlat and check that they agree. Some
+// coordinates are too large to be packed in a key, so both kinds of keys are exercised.
+void compareWithGridB(unsigned int dim, int range, int farRange)
+{
+    GridB<int> ref(dim);
+    GridBFlat<int> flat(dim);
+    RNG rng;
+
+    std::map<int, GridB<int>::Cell *> refCells;
+    std::map<int, GridBFlat<int>::Cell *> flatCells;
+    std::vector<GridB<int>::Coord> coords;
+
+    for (int step = 0; step < 3000; ++step)
+    {
+        GridB<int>::Coord coord(dim);
+        for (unsigned int i = 0; i < dim; ++i)
+            coord[i] = rng.uniformInt(-range, range);
+        if (farRange > 0 && rng.uniform01() < 0.1)
+            coord[rng.uniformInt(0, dim - 1)] = rng.uniformBool() ? farRange : -farRange - 1;
+
+        GridB<int>::Cell *refCell = ref.getCell(coord);
+        GridBFlat<int>::Cell *flatCell = flat.getCell(coord);
+        BOOST_REQUIRE_EQUAL(refCell == nullptr, flatCell == nullptr);
+
+        if (refCell == nullptr)
+        {
+            refCell = ref.createCell(coord);
+            flatCell = flat.createCell(coord);
+            BOOST_REQUIRE_EQUAL(refCell->neighbors, flatCell->neighbors);
+            refCell->data = flatCell->data = step;
+            ref.add(refCell);
+            flat.add(flatCell);
+            refCells[step] = refCell;
+            flatCells[step] = flatCell;
+        }
+        else if (rng.uniform01() < 0.5)
+        {
+            BOOST_REQUIRE_EQUAL(refCell->data, flatCell->data);
+            int id = refCell->data;
+            BOOST_REQUIRE(ref.remove(refCell));
+            BOOST_REQUIRE(flat.remove(flatCell));
+            ref.destroyCell(refCell);
+            flat.destroyCell(flatCell);
+            refCells.erase(id);
+            flatCells.erase(id);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(ref.size(), flat.size());
+    BOOST_CHECK_EQUAL(ref.countInternal(), flat.countInternal());
+    BOOST_CHECK_EQUAL(ref.countExternal(), flat.countExternal());
+
+    unsigned int count = 0;
+    for (const auto &it : flat)
+    {
+        ++count;
+        BOOST_REQUIRE(flatCells.count(it.second->data) == 1);
+    }
+    BOOST_CHECK_EQUAL(count, flat.size());
+
+    for (const auto &it : refCells)
+    {
+        GridBFlat<int>::Cell *flatCell = flatCells[it.first];
+        BOOST_CHECK_EQUAL(it.second->neighbors, flatCell->neighbors);
+        BOOST_CHECK_EQUAL(it.second->border, flatCell->border);
+
+        GridB<int>::CellArray refList;
+        GridBFlat<int>::CellArray flatList;
+        ref.neighbors(it.second, refList);
+        flat.neighbors(flatCell, flatList);
+        std::vector<int> refData, flatData;
+        for (auto c : refList)
+            refData.push_back(c->data);
+        for (auto c : flatList)
+            flatData.push_back(c->data);
+        std::sort(refData.begin(), refData.end());
+        std::sort(flatData.begin(), flatData.end());
+        BOOST_CHECK(refData == flatData);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(PackedKeys)
+{
+    for (unsigned int dim = 1; dim <= 4; ++dim)
+        compareWithGridB(dim, 6, 0);
+}
+
+BOOST_AUTO_TEST_CASE(UnpackedCoordinates)
+{
+    // 1 << 20 does not fit in the 21 bits of a 3-dimensional key, nor in the 16 bits of a 4-dimensional one
+    compareWithGridB(3, 6, 1 << 20);
+    compareWithGridB(4, 6, 1 << 20);
+}
+
+BOOST_AUTO_TEST_CASE(HashedKeys)
+{
+    for (unsigned int dim = 5; dim <= 6; ++dim)
+        compareWithGridB(dim, 3, 0);
+}
@@ -86,3 +86,31 @@ BOOST_AUTO_TEST_CASE(Simple)
     h.insert(-1);
     BOOST_CHECK(h.top()->data == -1);
 }
+
+BOOST_AUTO_TEST_CASE(Top)
+{
+    BinaryHeap<int> h;
+    std::vector<int> top;
+    h.getTop(3, top);
+    BOOST_CHECK(top.empty());
+
+    // insert in a scrambled order, with duplicates
+    for (int i = 0; i < 100; ++i)
+        h.insert((i * 37) % 50);
+
+    std::vector<int> s;
+    h.getContent(s);
+    h.sort(s);
+    for (unsigned int k : {0u, 1u, 2u, 7u, 50u, 100u, 150u})
+    {
+        top.clear();
+        h.getTop(k, top);
+        BOOST_REQUIRE_EQUAL(top.size(), std::min<std::size_t>(k, s.size()));
+        for (std::size_t i = 0; i < top.size(); ++i)
+            BOOST_CHECK_EQUAL(top[i], s[i]);
+    }
+
+    // the heap itself is left untouched
+    BOOST_CHECK_EQUAL(h.size(), 100u);
+    BOOST_CHECK_EQUAL(h.top()->data, 0);
+}
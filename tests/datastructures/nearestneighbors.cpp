@@ -38,18 +38,23 @@
 #include <boost/test/unit_test.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
 #include <unordered_set>
 
 #include "ompl/config.h"
 #include "ompl/datastructures/NearestNeighborsSqrtApprox.h"
 #include "ompl/datastructures/NearestNeighborsGNAT.h"
 #include "ompl/datastructures/NearestNeighborsGNATNoThreadSafety.h"
+#include "ompl/datastructures/NearestNeighborsConcurrent.h"
+#include "ompl/datastructures/NearestNeighborsVPTree.h"
 #if OMPL_HAVE_FLANN
 #include "ompl/datastructures/NearestNeighborsFLANN.h"
 #endif
 #include "ompl/base/ScopedState.h"
 #include "ompl/base/spaces/DiscreteStateSpace.h"
 #include "ompl/base/spaces/SE3StateSpace.h"
+#include "ompl/tools/config/SelfConfig.h"
 
 using namespace ompl;
 
@@ -102,6 +107,28 @@ public:
     }
 };
 
+// a concurrent structure that builds trees often, so that merges are exercised
+template<typename _T>
+class NearestNeighborsConcurrents : public NearestNeighborsConcurrent<_T>
+{
+public:
+    NearestNeighborsConcurrents() : NearestNeighborsConcurrent<_T>(3)
+    {
+    }
+
+    using NearestNeighborsConcurrent<_T>::buildIndex;
+};
+
+// a vantage-point tree structure that merges trees often
+template<typename _T>
+class NearestNeighborsVPTrees : public NearestNeighborsVPTree<_T>
+{
+public:
+    NearestNeighborsVPTrees() : NearestNeighborsVPTree<_T>(3)
+    {
+    }
+};
+
 
 NearestNeighborConfig nnConfig;
 
@@ -286,6 +313,63 @@ void randomAccessPatternTest(base::StateSpace& space, NearestNeighbors<base::Sta
         space.freeState(*it);
 }
 
+void batchTest(base::StateSpace& space, NearestNeighbors<base::State*>& proximity)
+{
+    base::StateSamplerPtr sampler(space.allocStateSampler());
+    // enough queries for batched queries to start several threads
+    std::vector<base::State*> states(n), queries(2*n), nghbr;
+    std::vector<std::vector<base::State*>> nghbrK, nghbrR;
+
+    proximity.setDistanceFunction([&space](const base::State *a, const base::State *b)
+        {
+            return space.distance(a, b);
+        });
+    for (auto & state : states)
+    {
+        state = space.allocState();
+        sampler->sampleUniform(state);
+    }
+    for (auto & query : queries)
+    {
+        query = space.allocState();
+        sampler->sampleUniform(query);
+    }
+    proximity.add(states);
+
+    for (unsigned int threads : {1u, 4u})
+    {
+        proximity.setBatchThreads(threads);
+        BOOST_CHECK_EQUAL(proximity.getBatchThreads(), threads);
+        proximity.nearestKBatch(queries, k, nghbrK);
+        proximity.nearestRBatch(queries, .5, nghbrR);
+        BOOST_REQUIRE_EQUAL(nghbrK.size(), queries.size());
+        BOOST_REQUIRE_EQUAL(nghbrR.size(), queries.size());
+        for (std::size_t i = 0; i < queries.size(); ++i)
+        {
+            proximity.nearestK(queries[i], k, nghbr);
+            BOOST_REQUIRE_EQUAL(nghbrK[i].size(), nghbr.size());
+            for (std::size_t j = 0; j < nghbr.size(); ++j)
+                BOOST_OMPL_EXPECT_NEAR(space.distance(queries[i], nghbrK[i][j]),
+                    space.distance(queries[i], nghbr[j]), eps);
+
+            proximity.nearestR(queries[i], .5, nghbr);
+            BOOST_REQUIRE_EQUAL(nghbrR[i].size(), nghbr.size());
+            for (std::size_t j = 0; j < nghbr.size(); ++j)
+                BOOST_OMPL_EXPECT_NEAR(space.distance(queries[i], nghbrR[i][j]),
+                    space.distance(queries[i], nghbr[j]), eps);
+        }
+    }
+
+    proximity.nearestKBatch(queries, 0, nghbrK);
+    for (const auto & nbh : nghbrK)
+        BOOST_CHECK(nbh.empty());
+
+    for (auto & state : states)
+        space.freeState(state);
+    for (auto & query : queries)
+        space.freeState(query);
+}
+
 #define NN_TEST_CASES(T,approx)                          \
 BOOST_AUTO_TEST_CASE(Int##T)                             \
 {                                                        \
@@ -306,12 +390,262 @@ BOOST_AUTO_TEST_CASE(RandomAccessPatternSE3##T)          \
 {                                                        \
     NearestNeighbors##T<base::State*> proximity;         \
     randomAccessPatternTest(nnConfig.space1, proximity); \
+}                                                        \
+BOOST_AUTO_TEST_CASE(BatchSE3##T)                        \
+{                                                        \
+    NearestNeighbors##T<base::State*> proximity;         \
+    batchTest(nnConfig.space1, proximity);               \
 }
 
 NN_TEST_CASES(Linear, false)
 NN_TEST_CASES(SqrtApprox, true)
 NN_TEST_CASES(GNATs, false)
 NN_TEST_CASES(GNATNoThreadSafetys, false)
+NN_TEST_CASES(Concurrents, false)
+NN_TEST_CASES(VPTrees, false)
+
+void setStateCoordinates(NearestNeighborsVPTree<base::State*> &proximity, base::StateSpace &space,
+                         const CoordinateMetric &metric)
+{
+    space.setup();
+    std::vector<base::StateSpace::ValueLocation> locations = space.getValueLocations();
+    proximity.setCoordinates(metric, [&space, locations](base::State *const &state, double *coords)
+        {
+            for (std::size_t i = 0; i < locations.size(); ++i)
+                coords[i] = *space.getValueAddressAtLocation(state, locations[i]);
+        });
+}
+
+BOOST_AUTO_TEST_CASE(VPTreeCoordinates)
+{
+    CoordinateMetric metric;
+    BOOST_CHECK(!tools::SelfConfig::getCoordinateMetric(&nnConfig.space0, metric));
+    BOOST_REQUIRE(tools::SelfConfig::getCoordinateMetric(&nnConfig.space1, metric));
+    BOOST_CHECK_EQUAL(metric.getDimension(), 7u);
+
+    NearestNeighborsVPTrees<base::State*> proximity;
+    setStateCoordinates(proximity, nnConfig.space1, metric);
+    stateSpaceTest(nnConfig.space1, proximity);
+    BOOST_CHECK(proximity.usesCoordinates());
+    randomAccessPatternTest(nnConfig.space1, proximity);
+    BOOST_CHECK(proximity.usesCoordinates());
+
+    // a metric that does not match the distance function is detected and not used
+    CoordinateMetric wrong;
+    wrong.addEuclidean(7);
+    NearestNeighborsVPTrees<base::State*> fallback;
+    setStateCoordinates(fallback, nnConfig.space1, wrong);
+    stateSpaceTest(nnConfig.space1, fallback);
+    BOOST_CHECK(!fallback.usesCoordinates());
+}
+
+BOOST_AUTO_TEST_CASE(CoordinateNearestNeighborsOptIn)
+{
+    // elements that hold their state in a member called state, as the motions of most planners do
+    struct Motion
+    {
+        base::State *state;
+    };
+    class DummyPlanner : public base::Planner
+    {
+    public:
+        DummyPlanner(const base::SpaceInformationPtr &si) : base::Planner(si, "Dummy")
+        {
+        }
+
+        base::PlannerStatus solve(const base::PlannerTerminationCondition & /*ptc*/) override
+        {
+            return base::PlannerStatus::ABORT;
+        }
+    };
+
+    auto space(std::make_shared<base::SE3StateSpace>());
+    base::RealVectorBounds b(3);
+    b.setLow(0);
+    b.setHigh(1);
+    space->setBounds(b);
+    space->setup();
+    DummyPlanner planner(std::make_shared<base::SpaceInformation>(space));
+
+    // single-threaded planners get GNAT unless they ask for the VP-tree on coordinates
+    std::unique_ptr<NearestNeighbors<Motion*>> nn(tools::SelfConfig::getDefaultNearestNeighbors<Motion*>(&planner));
+    BOOST_CHECK(dynamic_cast<NearestNeighborsGNATNoThreadSafety<Motion*>*>(nn.get()) != nullptr);
+
+    std::unique_ptr<NearestNeighbors<Motion*>> vp(tools::SelfConfig::getCoordinateNearestNeighbors<Motion*>(&planner));
+    auto *tree = dynamic_cast<NearestNeighborsVPTree<Motion*>*>(vp.get());
+    BOOST_REQUIRE(tree != nullptr);
+    tree->setDistanceFunction([&space](const Motion *a, const Motion *b)
+        {
+            return space->distance(a->state, b->state);
+        });
+    std::vector<Motion> motions(50);
+    base::StateSamplerPtr sampler(space->allocStateSampler());
+    for (auto &motion : motions)
+    {
+        motion.state = space->allocState();
+        sampler->sampleUniform(motion.state);
+        tree->add(&motion);
+    }
+    BOOST_CHECK(tree->usesCoordinates());
+    BOOST_CHECK(tree->nearest(&motions[7]) == &motions[7]);
+    for (auto &motion : motions)
+        space->freeState(motion.state);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentAddAndQuery)
+{
+    base::SE3StateSpace &space = nnConfig.space1;
+    const unsigned int nthreads = 8, perThread = 500;
+    NearestNeighborsConcurrents<base::State*> proximity;
+    NearestNeighborsLinear<base::State*> proximityLinear;
+    auto distance = [&space](const base::State *a, const base::State *b)
+        {
+            return space.distance(a, b);
+        };
+    proximity.setDistanceFunction(distance);
+    proximityLinear.setDistanceFunction(distance);
+
+    std::vector<base::State*> states(nthreads * perThread);
+    base::StateSamplerPtr sampler(space.allocStateSampler());
+    for (auto &state : states)
+    {
+        state = space.allocState();
+        sampler->sampleUniform(state);
+    }
+
+    // every thread inserts its share of the states while querying the structure;
+    // Boost.Test assertions are not thread safe, so failures are only counted here
+    std::atomic<unsigned int> failures(0);
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0 ; t < nthreads ; ++t)
+        threads.emplace_back([&, t]
+            {
+                std::vector<base::State*> nghbr;
+                for (unsigned int i = t ; i < states.size() ; i += nthreads)
+                {
+                    proximity.add(states[i]);
+                    proximity.nearestK(states[i], k, nghbr);
+                    // the state that was just added is its own nearest neighbor
+                    if (nghbr.empty() || nghbr.size() > (std::size_t)k || space.distance(nghbr[0], states[i]) > eps)
+                        ++failures;
+                }
+            });
+    for (auto &thread : threads)
+        thread.join();
+    BOOST_CHECK_EQUAL(failures.load(), 0u);
+
+    proximityLinear.add(states);
+    BOOST_CHECK_EQUAL(proximity.size(), states.size());
+
+    std::vector<base::State*> nghbr, nghbrGroundTruth;
+    base::State *s = space.allocState();
+    for (int i = 0 ; i < n ; ++i)
+    {
+        sampler->sampleUniform(s);
+        proximity.nearestK(s, k, nghbr);
+        proximityLinear.nearestK(s, k, nghbrGroundTruth);
+        BOOST_REQUIRE_EQUAL(nghbr.size(), nghbrGroundTruth.size());
+        for (std::size_t p = 0 ; p < nghbr.size() ; ++p)
+            BOOST_OMPL_EXPECT_NEAR(space.distance(s, nghbrGroundTruth[p]), space.distance(s, nghbr[p]), eps);
+    }
+    space.freeState(s);
+
+    for (auto &state : states)
+        space.freeState(state);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentQueryDuringRebuild)
+{
+    base::SE3StateSpace &space = nnConfig.space1;
+    const unsigned int nreaders = 4, nstates = 500;
+    NearestNeighborsConcurrents<base::State*> proximity;
+    proximity.setDistanceFunction([&space](const base::State *a, const base::State *b)
+        {
+            return space.distance(a, b);
+        });
+
+    std::vector<base::State*> states(nstates);
+    base::StateSamplerPtr sampler(space.allocStateSampler());
+    for (auto &state : states)
+    {
+        state = space.allocState();
+        sampler->sampleUniform(state);
+    }
+    proximity.add(states[0]);
+
+    // readers query the structure while the writer replaces its snapshot after every insertion, so that
+    // snapshots are freed while queries that started in an earlier epoch are still running
+    std::atomic<bool> done(false);
+    std::atomic<unsigned int> failures(0);
+    std::vector<std::thread> readers;
+    for (unsigned int t = 0 ; t < nreaders ; ++t)
+        readers.emplace_back([&, t]
+            {
+                std::vector<base::State*> nghbr;
+                for (unsigned int i = t ; !done ; i = (i + nreaders) % nstates)
+                {
+                    proximity.nearestK(states[i], k, nghbr);
+                    if (nghbr.empty() || nghbr.size() > (std::size_t)k)
+                        ++failures;
+                }
+            });
+    for (unsigned int i = 1 ; i < nstates ; ++i)
+    {
+        proximity.add(states[i]);
+        proximity.buildIndex();
+    }
+    done = true;
+    for (auto &reader : readers)
+        reader.join();
+    BOOST_CHECK_EQUAL(failures.load(), 0u);
+    BOOST_CHECK_EQUAL(proximity.size(), states.size());
+
+    for (auto &state : states)
+        space.freeState(state);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentRemoveDuplicates)
+{
+    base::SE3StateSpace &space = nnConfig.space1;
+    NearestNeighborsConcurrents<base::State*> proximity;
+    proximity.setDistanceFunction([&space](const base::State *a, const base::State *b)
+        {
+            return space.distance(a, b);
+        });
+
+    // every state is added twice, as two copies at distance zero from each other
+    std::vector<base::State*> states(300), copies(states.size());
+    base::StateSamplerPtr sampler(space.allocStateSampler());
+    for (std::size_t i = 0 ; i < states.size() ; ++i)
+    {
+        states[i] = space.allocState();
+        sampler->sampleUniform(states[i]);
+        copies[i] = space.cloneState(states[i]);
+        proximity.add(states[i]);
+        proximity.add(copies[i]);
+    }
+
+    // removal finds the exact element, in the trees as well as among the elements that are not indexed yet
+    for (std::size_t i = 0 ; i < copies.size() ; i += 2)
+        BOOST_CHECK(proximity.remove(copies[i]));
+    BOOST_CHECK(!proximity.remove(copies[0]));
+    BOOST_CHECK_EQUAL(proximity.size(), states.size() + copies.size() / 2);
+
+    std::vector<base::State*> listed;
+    proximity.list(listed);
+    for (std::size_t i = 0 ; i < states.size() ; ++i)
+    {
+        BOOST_CHECK(std::find(listed.begin(), listed.end(), states[i]) != listed.end());
+        BOOST_CHECK_EQUAL(std::find(listed.begin(), listed.end(), copies[i]) != listed.end(), i % 2 == 1);
+    }
+
+    for (std::size_t i = 0 ; i < states.size() ; ++i)
+    {
+        space.freeState(states[i]);
+        space.freeState(copies[i]);
+    }
+}
+
 #if OMPL_HAVE_FLANN
 NN_TEST_CASES(FLANNLinear, false)
 NN_TEST_CASES(FLANNHierarchicalClustering, true)
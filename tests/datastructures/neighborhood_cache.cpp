@@ -0,0 +1,152 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#define BOOST_TEST_MODULE "NeighborhoodCache"
+#include <boost/test/unit_test.hpp>
+#include "ompl/geometric/planners/fmt/NeighborhoodCache.h"
+#include <atomic>
+
+using namespace ompl;
+
+// the cost stored for neighbor n of sample id
+static base::Cost testCost(std::size_t id, int n)
+{
+    return base::Cost(1000.0 * id + n);
+}
+
+// check that neighborhood id holds the neighbors in expected, with the costs given by testCost()
+static void checkNeighborhood(const geometric::NeighborhoodCache<int> &cache, std::size_t id,
+                              const std::vector<int> &expected)
+{
+    geometric::NeighborhoodCache<int>::Neighborhood nbh = cache[id];
+    BOOST_REQUIRE_EQUAL(nbh.size(), expected.size());
+    BOOST_CHECK_EQUAL(nbh.empty(), expected.empty());
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(nbh[i], expected[i]);
+        if (cache.getStoreCosts())
+            BOOST_CHECK_EQUAL(nbh.cost(i).value(), testCost(id, expected[i]).value());
+    }
+    if (!expected.empty())
+        BOOST_CHECK_EQUAL(nbh.back(), expected.back());
+}
+
+BOOST_AUTO_TEST_CASE(AddAndInsert)
+{
+    geometric::NeighborhoodCache<int> cache;
+    cache.setStoreCosts(true);
+
+    std::vector<std::vector<int>> expected = {{1, 2, 3}, {}, {0, 5}};
+    for (std::size_t i = 0; i < expected.size(); ++i)
+        BOOST_CHECK_EQUAL(cache.add(expected[i], testCost), i);
+    BOOST_CHECK_EQUAL(cache.size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i)
+        checkNeighborhood(cache, i, expected[i]);
+
+    // neighborhoods that are full are moved to the end of the array as they grow; views stay valid
+    geometric::NeighborhoodCache<int>::Neighborhood first = cache[0];
+    for (int n = 10; n < 30; ++n)
+    {
+        std::size_t pos = n % 2 == 0 ? 0 : expected[0].size();
+        cache.insert(0, pos, n, testCost(0, n));
+        expected[0].insert(expected[0].begin() + pos, n);
+        cache.insert(1, expected[1].size(), n, testCost(1, n));
+        expected[1].push_back(n);
+    }
+    BOOST_CHECK_EQUAL(first.size(), expected[0].size());
+    for (std::size_t i = 0; i < expected.size(); ++i)
+        checkNeighborhood(cache, i, expected[i]);
+
+    // insertion in the middle, without costs
+    geometric::NeighborhoodCache<int> plain;
+    plain.add(std::vector<int>{1, 3}, [](std::size_t, int)
+                                      {
+                                          BOOST_ERROR("costs are not stored");
+                                          return base::Cost(0.0);
+                                      });
+    plain.insert(0, 1, 2, base::Cost(0.0));
+    checkNeighborhood(plain, 0, {1, 2, 3});
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(Build)
+{
+    std::vector<std::vector<int>> nbh(500);
+    for (std::size_t i = 0; i < nbh.size(); ++i)
+        for (int n = 0; n < (int)(i % 17); ++n)
+            nbh[i].push_back(n * 3 + 1);
+
+    for (unsigned int threads : {1u, 4u})
+    {
+        geometric::NeighborhoodCache<int> cache;
+        cache.setStoreCosts(true);
+        cache.add(std::vector<int>{7}, testCost);
+
+        // build replaces the existing neighborhoods and computes every cost exactly once
+        std::atomic<std::size_t> calls{0};
+        cache.build(nbh, threads, [&calls](std::size_t id, int n)
+                    {
+                        ++calls;
+                        return testCost(id, n);
+                    });
+        std::size_t total = 0;
+        for (const auto &n : nbh)
+            total += n.size();
+        BOOST_CHECK_EQUAL(calls.load(), total);
+        BOOST_REQUIRE_EQUAL(cache.size(), nbh.size());
+        for (std::size_t i = 0; i < nbh.size(); ++i)
+            checkNeighborhood(cache, i, nbh[i]);
+
+        // neighborhoods built at once can grow as well
+        cache.insert(3, 0, 100, testCost(3, 100));
+        nbh[3].insert(nbh[3].begin(), 100);
+        checkNeighborhood(cache, 3, nbh[3]);
+        checkNeighborhood(cache, 4, nbh[4]);
+        nbh[3].erase(nbh[3].begin());
+    }
+
+    // without costs, the cost function is not called
+    geometric::NeighborhoodCache<int> cache;
+    std::atomic<std::size_t> calls{0};
+    cache.build(nbh, 4, [&calls](std::size_t id, int n)
+                {
+                    ++calls;
+                    return testCost(id, n);
+                });
+    BOOST_CHECK_EQUAL(calls.load(), 0u);
+    for (std::size_t i = 0; i < nbh.size(); ++i)
+        checkNeighborhood(cache, i, nbh[i]);
+}
@@ -0,0 +1,170 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#define BOOST_TEST_MODULE "IncrementalShortestPath"
+#include <boost/test/unit_test.hpp>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include "ompl/datastructures/IncrementalShortestPath.h"
+#include "ompl/util/RandomNumbers.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+using Edge = std::tuple<std::size_t, std::size_t, double>;
+
+/* Cost of the shortest path from source to the closest target, computed from scratch */
+double dijkstra(std::size_t n, const std::vector<Edge> &edges, std::size_t source,
+                const std::vector<std::size_t> &targets)
+{
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, boost::no_property,
+                                        boost::property<boost::edge_weight_t, double>>;
+    Graph g(n);
+    for (const auto &e : edges)
+        boost::add_edge(std::get<0>(e), std::get<1>(e), std::get<2>(e), g);
+    std::vector<double> d(n);
+    boost::dijkstra_shortest_paths(g, source, boost::distance_map(d.data()));
+    double best = std::numeric_limits<double>::infinity();
+    for (std::size_t t : targets)
+        if (d[t] < std::numeric_limits<double>::max())  // unreachable vertices are at the largest double
+            best = std::min(best, d[t]);
+    return best;
+}
+
+/* Check that path is a path of the given cost from source to one of the targets */
+void checkPath(const std::vector<std::size_t> &path, double cost, const std::vector<Edge> &edges,
+               std::size_t source, const std::vector<std::size_t> &targets)
+{
+    BOOST_REQUIRE(!path.empty());
+    BOOST_CHECK_EQUAL(path.front(), source);
+    BOOST_CHECK(std::find(targets.begin(), targets.end(), path.back()) != targets.end());
+    double length = 0.;
+    for (std::size_t i = 0; i + 1 < path.size(); ++i)
+    {
+        double w = std::numeric_limits<double>::infinity();
+        for (const auto &e : edges)
+            if (std::get<0>(e) == path[i] && std::get<1>(e) == path[i + 1])
+                w = std::min(w, std::get<2>(e));
+        length += w;
+    }
+    BOOST_CHECK_CLOSE(length, cost, 1e-9);
+}
+
+/* Repeatedly change random edge weights and compare the repaired shortest paths with Dijkstra. A fraction
+   \e negligible of the weights is so small that adding it to the cost of a path does not change that cost. */
+void randomChanges(unsigned int numTargets, unsigned int changesPerStep, double negligible = 0.)
+{
+    ompl::RNG rng;
+    auto weight = [&rng, negligible]
+    {
+        return rng.uniform01() < negligible ? 1e-30 : rng.uniformReal(0.1, 10.);
+    };
+    const std::size_t n = 200;
+    std::vector<Edge> edges;
+    for (std::size_t v = 0; v < n; ++v)
+        for (unsigned int k = 0; k < 4; ++k)
+            edges.emplace_back(v, rng.uniformInt(0, n - 1), weight());
+
+    std::vector<std::size_t> targets;
+    for (unsigned int i = 0; i < numTargets; ++i)
+        targets.push_back(rng.uniformInt(1, n - 1));
+
+    ompl::IncrementalShortestPath sp(n, 0, targets);
+    for (const auto &e : edges)
+        sp.addEdge(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+
+    std::vector<std::size_t> path;
+    for (unsigned int step = 0; step < 50; ++step)
+    {
+        const double cost = sp.computeShortestPath(path);
+        BOOST_CHECK_CLOSE(cost, dijkstra(n, edges, 0, targets), 1e-9);
+        if (cost < std::numeric_limits<double>::infinity())
+            checkPath(path, cost, edges, 0, targets);
+        else
+            BOOST_CHECK(path.empty());
+
+        // make the edges heavier or lighter, sometimes twice before the next search
+        for (unsigned int i = 0; i < changesPerStep; ++i)
+        {
+            const std::size_t e = rng.uniformInt(0, edges.size() - 1);
+            std::get<2>(edges[e]) = weight();
+            sp.setEdgeWeight(e, std::get<2>(edges[e]));
+            BOOST_CHECK_EQUAL(sp.getEdgeWeight(e), std::get<2>(edges[e]));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(RepairSingleTarget)
+{
+    randomChanges(1, 5);
+}
+
+BOOST_AUTO_TEST_CASE(RepairSeveralTargets)
+{
+    randomChanges(5, 5);
+}
+
+BOOST_AUTO_TEST_CASE(RepairNegligibleWeights)
+{
+    // cycles of such edges are cycles of weight 0 for LPA*
+    randomChanges(3, 5, 0.5);
+}
+
+BOOST_AUTO_TEST_CASE(Restart)
+{
+    // more than a quarter of the edges changes between searches
+    randomChanges(3, 400);
+}
+
+BOOST_AUTO_TEST_CASE(Trivial)
+{
+    std::vector<std::size_t> path;
+
+    ompl::IncrementalShortestPath none(3, 0, {});
+    none.addEdge(0, 1, 1.);
+    BOOST_CHECK_EQUAL(none.computeShortestPath(path), std::numeric_limits<double>::infinity());
+    BOOST_CHECK(path.empty());
+
+    ompl::IncrementalShortestPath self(3, 1, {1});
+    self.addEdge(0, 1, 1.);
+    BOOST_CHECK_EQUAL(self.computeShortestPath(path), 0.);
+    BOOST_CHECK_EQUAL(path.size(), 1u);
+
+    ompl::IncrementalShortestPath unreachable(3, 0, {2});
+    unreachable.addEdge(0, 1, 1.);
+    BOOST_CHECK_EQUAL(unreachable.computeShortestPath(path), std::numeric_limits<double>::infinity());
+    BOOST_CHECK(path.empty());
+}
@@ -47,6 +47,10 @@ OMPL_POP_CLANG
 #include "ompl/geometric/planners/prm/PRMstar.h"
 #include "ompl/geometric/planners/rrt/RRTstar.h"
 #include "ompl/geometric/planners/cforest/CForest.h"
+#include "ompl/geometric/planners/fmt/FMT.h"
+#include "ompl/geometric/planners/fmt/BFMT.h"
+#include "ompl/geometric/planners/bitstar/BITstar.h"
+#include "ompl/base/spaces/RealVectorStateSpace.h"
 #include "ompl/base/objectives/PathLengthOptimizationObjective.h"
 #include "ompl/base/goals/GoalState.h"
 #include "ompl/util/RandomNumbers.h"
@@ -392,4 +396,168 @@ OMPL_PLANNER_TEST(PRM)
 OMPL_PLANNER_TEST(RRTstar)
 OMPL_PLANNER_TEST(CForest)
 
+/* A uniform sampler whose sequence of states only depends on a fixed seed, so that two planners sample
+   the same states */
+class SeededStateSampler : public base::RealVectorStateSampler
+{
+public:
+    SeededStateSampler(const base::StateSpace *space) : base::RealVectorStateSampler(space)
+    {
+        rng_.setLocalSeed(42);
+    }
+};
+
+/* Solve the first query of \e circles with \e planner on seeded samples and return the cost of the
+   solution, or infinity if none is found */
+static double seededSolutionCost(const Circles2D &circles, const base::PlannerPtr &planner)
+{
+    const base::SpaceInformationPtr &si = planner->getSpaceInformation();
+    auto pdef(std::make_shared<base::ProblemDefinition>(si));
+    pdef->setOptimizationObjective(std::make_shared<base::PathLengthOptimizationObjective>(si));
+    const Circles2D::Query &q = circles.getQuery(0);
+    base::ScopedState<> start(si), goal(si);
+    start[0] = q.startX_;
+    start[1] = q.startY_;
+    goal[0] = q.goalX_;
+    goal[1] = q.goalY_;
+    pdef->setStartAndGoalStates(start, goal, 1e-3);
+
+    planner->setProblemDefinition(pdef);
+    planner->setup();
+    if (planner->solve(10.0) != base::PlannerStatus::EXACT_SOLUTION)
+        return std::numeric_limits<double>::infinity();
+    return pdef->getSolutionPath()->cost(pdef->getOptimizationObjective()).value();
+}
+
+/* Compare the solution cost of an FMT*-like planner with the default parameters to that with cached
+   costs and several threads, on the same samples */
+template <typename FMTType>
+static void testCachedCosts(const Circles2D &circles)
+{
+    msg::setLogLevel(msg::LOG_ERROR);
+    double cost[2];
+    for (int cached = 0 ; cached < 2 ; ++cached)
+    {
+        base::SpaceInformationPtr si = geometric::spaceInformation2DCircles(circles);
+        si->getStateSpace()->setStateSamplerAllocator([](const base::StateSpace *space)
+            {
+                return std::make_shared<SeededStateSampler>(space);
+            });
+        auto planner(std::make_shared<FMTType>(si));
+        planner->setNumSamples(500);
+        if (cached != 0)
+        {
+            planner->params().setParam("cache_costs", "1");
+            planner->params().setParam("num_threads", "4");
+            BOOST_CHECK(planner->getCacheCosts());
+            BOOST_CHECK_EQUAL(planner->getNumThreads(), 4u);
+        }
+        cost[cached] = seededSolutionCost(circles, planner);
+    }
+    BOOST_REQUIRE(std::isfinite(cost[0]));
+    BOOST_CHECK_CLOSE(cost[0], cost[1], 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(geometric_FMTCachedCosts)
+{
+    testCachedCosts<geometric::FMT>(circles_);
+}
+
+BOOST_AUTO_TEST_CASE(geometric_BFMTCachedCosts)
+{
+    testCachedCosts<geometric::BFMT>(circles_);
+}
+
+/* Solve the first query of \e circles with BIT* checking edges on \e numThreads threads, first until a
+   solution is found and then for a while longer, and check the solutions */
+static void testBITstarThreads(const Circles2D &circles, unsigned int numThreads)
+{
+    msg::setLogLevel(msg::LOG_ERROR);
+    base::SpaceInformationPtr si = geometric::spaceInformation2DCircles(circles);
+    auto pdef(std::make_shared<base::ProblemDefinition>(si));
+    auto opt(std::make_shared<base::PathLengthOptimizationObjective>(si));
+    opt->setCostThreshold(opt->infiniteCost());
+    pdef->setOptimizationObjective(opt);
+    const Circles2D::Query &q = circles.getQuery(0);
+    base::ScopedState<> start(si), goal(si);
+    start[0] = q.startX_;
+    start[1] = q.startY_;
+    goal[0] = q.goalX_;
+    goal[1] = q.goalY_;
+    pdef->setStartAndGoalStates(start, goal, 1e-3);
+    base::Cost min_cost(std::hypot(q.goalX_ - q.startX_, q.goalY_ - q.startY_));
+
+    auto bitstar(std::make_shared<geometric::BITstar>(si));
+    bitstar->params().setParam("collision_check_threads", std::to_string(numThreads));
+    BOOST_CHECK_EQUAL(bitstar->getNumCollisionCheckThreads(), numThreads);
+    base::PlannerPtr planner(bitstar);
+    planner->setProblemDefinition(pdef);
+    planner->setup();
+
+    // each call to solve() starts and stops the collision checking threads
+    BOOST_REQUIRE(planner->solve(10.0) == base::PlannerStatus::EXACT_SOLUTION);
+    auto *path = static_cast<geometric::PathGeometric *>(pdef->getSolutionPath().get());
+    BOOST_CHECK(path->check());
+    base::Cost ini_cost = path->cost(opt);
+    BOOST_CHECK(!opt->isCostBetterThan(ini_cost, min_cost));
+
+    opt->setCostThreshold(base::Cost(std::numeric_limits<double>::epsilon()));
+    pdef->clearSolutionPaths();
+    BOOST_REQUIRE(planner->solve(0.5));
+    path = static_cast<geometric::PathGeometric *>(pdef->getSolutionPath().get());
+    BOOST_CHECK(path->check());
+    base::Cost cost = path->cost(opt);
+    BOOST_CHECK(!opt->isCostBetterThan(ini_cost, cost));
+    BOOST_CHECK(!opt->isCostBetterThan(cost, min_cost));
+}
+
+/* Solve the first query of \e circles with BIT* checking edges on \e numThreads threads for a fixed number of
+   iterations, with random number generators seeded from a fixed sequence, and return the solution */
+static std::vector<std::vector<double>> seededBITstarSolution(const Circles2D &circles, unsigned int numThreads)
+{
+    msg::setLogLevel(msg::LOG_ERROR);
+    RNG::setThreadSeed(42);
+    base::SpaceInformationPtr si = geometric::spaceInformation2DCircles(circles);
+    auto pdef(std::make_shared<base::ProblemDefinition>(si));
+    pdef->setOptimizationObjective(std::make_shared<base::PathLengthOptimizationObjective>(si));
+    const Circles2D::Query &q = circles.getQuery(0);
+    base::ScopedState<> start(si), goal(si);
+    start[0] = q.startX_;
+    start[1] = q.startY_;
+    goal[0] = q.goalX_;
+    goal[1] = q.goalY_;
+    pdef->setStartAndGoalStates(start, goal, 1e-3);
+
+    auto bitstar(std::make_shared<geometric::BITstar>(si));
+    bitstar->setNumCollisionCheckThreads(numThreads);
+    bitstar->setProblemDefinition(pdef);
+    bitstar->setup();
+    base::PlannerTerminationCondition ptc([&bitstar] { return bitstar->numIterations() >= 3000u; });
+    BOOST_CHECK(bitstar->solve(ptc) == base::PlannerStatus::EXACT_SOLUTION);
+    RNG::setThreadSeed(0);
+
+    std::vector<std::vector<double>> solution;
+    if (pdef->hasExactSolution())
+        for (const base::State *state : pdef->getSolutionPath()->as<geometric::PathGeometric>()->getStates())
+        {
+            solution.emplace_back();
+            si->getStateSpace()->copyToReals(solution.back(), state);
+        }
+    return solution;
+}
+
+BOOST_AUTO_TEST_CASE(geometric_BITstarCollisionCheckThreads)
+{
+    testBITstarThreads(circles_, 1);
+    testBITstarThreads(circles_, 4);
+
+    // checking edges in parallel does not change the search
+    std::vector<std::vector<double>> serial = seededBITstarSolution(circles_, 1);
+    std::vector<std::vector<double>> parallel = seededBITstarSolution(circles_, 4);
+    BOOST_REQUIRE(!serial.empty());
+    BOOST_REQUIRE_EQUAL(serial.size(), parallel.size());
+    for (std::size_t i = 0; i < serial.size(); ++i)
+        BOOST_CHECK(serial[i] == parallel[i]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -57,6 +57,7 @@ OMPL_POP_CLANG
 #include "ompl/geometric/planners/rrt/pRRT.h"
 #include "ompl/geometric/planners/rrt/TRRT.h"
 #include "ompl/geometric/planners/rrt/LazyRRT.h"
+#include "ompl/geometric/planners/rrt/RRTstar.h"
 #include "ompl/geometric/planners/pdst/PDST.h"
 #include "ompl/geometric/planners/est/EST.h"
 #include "ompl/geometric/planners/est/BiEST.h"
@@ -282,6 +283,19 @@ protected:
     }
 };
 
+class pRRTstarTest : public TestPlanner
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si) override
+    {
+        auto rrt(std::make_shared<geometric::RRTstar>(si));
+        rrt->setRange(10.0);
+        rrt->setNumCollisionCheckThreads(std::max(2u, std::min(4u, std::thread::hardware_concurrency())));
+        return rrt;
+    }
+};
+
 class TRRTTest : public TestPlanner
 {
 protected:
@@ -503,6 +517,17 @@ protected:
     }
 };
 
+class pPRMTest : public TestPlanner
+{
+protected:
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si) override
+    {
+        auto prm(std::make_shared<geometric::PRM>(si));
+        prm->setNumThreads(std::max(2u, std::min(4u, std::thread::hardware_concurrency())));
+        return prm;
+    }
+};
+
 class PRMstarTest : public TestPlanner
 {
 protected:
@@ -739,6 +764,7 @@ BOOST_FIXTURE_TEST_SUITE(MyPlanTestFixture, PlanTest)
 OMPL_PLANNER_TEST(RRT, 95.0, 0.01)
 OMPL_PLANNER_TEST(RRTConnect, 95.0, 0.01)
 OMPL_PLANNER_TEST(pRRT, 95.0, 0.02)
+OMPL_PLANNER_TEST(pRRTstar, 95.0, 0.02)
 
 // LazyRRT is a not so great, so we use more relaxed bounds
 //OMPL_PLANNER_TEST(LazyRRT, 80.0, 0.3)
@@ -758,10 +784,54 @@ OMPL_PLANNER_TEST(EST, 95.0, 0.02)
 OMPL_PLANNER_TEST(STRIDE, 95.0, 0.02)
 
 OMPL_PLANNER_TEST(PRM, 95.0, 0.04)
+OMPL_PLANNER_TEST(pPRM, 95.0, 0.04)
 OMPL_PLANNER_TEST(PRMstar, 95.0, 0.04)
 //OMPL_PLANNER_TEST(LazyPRM, 98.0, 0.04)
 OMPL_PLANNER_TEST(LazyPRMstar, 95.0, 0.04)
 OMPL_PLANNER_TEST(SPARS, 95.0, 0.04)
 OMPL_PLANNER_TEST(SPARStwo, 95.0, 0.04)
 
+BOOST_AUTO_TEST_CASE(geometric_SharedStatePool)
+{
+    // RRT and PRM share the state pool of one space information, in reset-on-clear mode
+    geometric::SimpleSetup2DMap s(env_);
+    s.setup();
+    base::SpaceInformationPtr si = s.getSpaceInformation();
+    si->enableStatePool(64, true);
+    base::PlannerPtr rrt(std::make_shared<geometric::RRT>(si));
+    base::PlannerPtr prm(std::make_shared<geometric::PRM>(si));
+    for (const auto &planner : {rrt, prm})
+    {
+        planner->setProblemDefinition(s.getProblemDefinition());
+        planner->setup();
+        BOOST_CHECK(planner->solve(1.0));
+        s.getProblemDefinition()->clearSolutionPaths();
+    }
+    BOOST_CHECK_EQUAL(si->getStatePool()->getUserCount(), 2u);
+
+    base::PlannerData data(si);
+    prm->getPlannerData(data);
+    BOOST_REQUIRE(data.numVertices() > 0);
+    std::vector<base::ScopedState<>> copies;
+    for (unsigned int i = 0; i < data.numVertices(); ++i)
+    {
+        copies.emplace_back(si);
+        copies.back() = data.getVertex(i).getState();
+    }
+
+    // clearing RRT and growing a new tree must not reuse the states of the PRM roadmap
+    rrt->clear();
+    BOOST_CHECK_EQUAL(si->getStatePool()->getUserCount(), 1u);
+    BOOST_CHECK_THROW(si->disableStatePool(), Exception);
+    BOOST_CHECK(rrt->solve(1.0));
+    for (unsigned int i = 0; i < data.numVertices(); ++i)
+        BOOST_CHECK(si->equalStates(data.getVertex(i).getState(), copies[i].get()));
+
+    rrt->clear();
+    prm->clear();
+    BOOST_CHECK_EQUAL(si->getStatePool()->getUserCount(), 0u);
+    BOOST_CHECK_EQUAL(si->getStatePool()->size(), 0u);
+    si->disableStatePool();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -38,6 +38,8 @@
 #include <boost/test/unit_test.hpp>
 
 #include <fstream>
+#include <sstream>
+#include <thread>
 
 #include <ompl/base/Constraint.h>
 #include <ompl/base/ConstrainedSpaceInformation.h>
@@ -452,3 +454,112 @@ OMPL_PLANNER_TEST(PRM, AT, 95.0, 1.0)
 OMPL_PLANNER_TEST(PRM, TB, 95.0, 1.0)
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_CASE(constraint_ProjectionMethods)
+{
+    auto constraint = std::make_shared<Sphere>();
+    auto rvss = std::make_shared<ob::RealVectorStateSpace>(3);
+    rvss->setBounds(-2, 2);
+    auto css = std::make_shared<ob::ProjectedStateSpace>(rvss, constraint);
+    auto csi = std::make_shared<ob::ConstrainedSpaceInformation>(css);
+
+    RNG rng;
+    const std::size_t n = 100;
+    std::vector<Eigen::VectorXd> samples(n, Eigen::VectorXd(3));
+    for (auto &sample : samples)
+        for (unsigned int i = 0; i < 3; ++i)
+            sample[i] = rng.uniformReal(-2, 2);
+
+    std::vector<ob::State *> states(n);
+    for (auto &state : states)
+        state = css->allocState();
+
+    for (auto method : {ob::Constraint::PROJECTION_SVD, ob::Constraint::PROJECTION_QR, ob::Constraint::PROJECTION_LDLT,
+                        ob::Constraint::PROJECTION_QUASI_NEWTON})
+    {
+        constraint->setProjectionMethod(method);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            states[i]->as<ob::ConstrainedStateSpace::StateType>()->copy(samples[i]);
+            BOOST_CHECK(constraint->project(states[i]));
+            BOOST_CHECK(constraint->isSatisfied(states[i]));
+
+            // the closest point of the sphere
+            auto &&x = *states[i]->as<ob::ConstrainedStateSpace::StateType>();
+            BOOST_CHECK_SMALL((x - samples[i].normalized()).norm(), 1e-3);
+        }
+    }
+
+    for (auto &state : states)
+        css->freeState(state);
+}
+
+BOOST_AUTO_TEST_CASE(constraint_SharedAtlas)
+{
+    auto constraint = std::make_shared<Sphere>();
+    auto rvss = std::make_shared<ob::RealVectorStateSpace>(3);
+    rvss->setBounds(-2, 2);
+    auto atlas = std::make_shared<ob::AtlasStateSpace>(rvss, constraint);
+    auto csi = std::make_shared<ob::ConstrainedSpaceInformation>(atlas);
+    csi->setStateValidityChecker([](const ob::State *) { return true; });
+    csi->setup();
+
+    Eigen::VectorXd x(3);
+    x << 0, 0, 1;
+    ob::ScopedState<> start(atlas);
+    start->as<ob::ConstrainedStateSpace::StateType>()->copy(x);
+    atlas->anchorChart(start.get());
+
+    // Grow the atlas from several threads at once
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < 4; ++t)
+        threads.emplace_back([&] {
+            ob::StateSamplerPtr sampler = atlas->allocStateSampler();
+            ob::State *from = atlas->cloneState(start.get());
+            ob::State *to = atlas->allocState();
+            for (unsigned int i = 0; i < 200; ++i)
+            {
+                sampler->sampleUniformNear(to, from, 1.);
+                atlas->discreteGeodesic(from, to, true);
+                atlas->copyState(from, to);
+            }
+            atlas->freeState(from);
+            atlas->freeState(to);
+        });
+    for (auto &thread : threads)
+        thread.join();
+
+    const std::size_t charts = atlas->getChartCount();
+    BOOST_CHECK(charts > 1);
+
+    // Every state sampled from the shared atlas lies on the manifold
+    ob::StateSamplerPtr sampler = atlas->allocStateSampler();
+    ob::ScopedState<> sample(atlas);
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+        sampler->sampleUniform(sample.get());
+        BOOST_CHECK(constraint->isSatisfied(sample.get()));
+    }
+
+    // A copy of the atlas loaded from storage has the same charts
+    std::stringstream stored;
+    atlas->saveAtlas(stored);
+
+    auto copy = std::make_shared<ob::AtlasStateSpace>(rvss, constraint);
+    auto copySI = std::make_shared<ob::ConstrainedSpaceInformation>(copy);
+    copySI->setStateValidityChecker([](const ob::State *) { return true; });
+    copySI->setup();
+    copy->loadAtlas(stored);
+    BOOST_CHECK_EQUAL(copy->getChartCount(), atlas->getChartCount());
+
+    std::stringstream restored;
+    copy->saveAtlas(restored);
+    BOOST_CHECK_EQUAL(restored.str(), stored.str());
+
+    // Clearing keeps only the anchor chart
+    copy->clear();
+    BOOST_CHECK_EQUAL(copy->getChartCount(), 1u);
+
+    std::stringstream wrong("atlas 4 2\n");
+    BOOST_CHECK_THROW(copy->loadAtlas(wrong), ompl::Exception);
+}
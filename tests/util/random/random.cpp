@@ -41,6 +41,7 @@
 #include "ompl/config.h"
 #include "ompl/util/RandomNumbers.h"
 #include <cmath>
+#include <thread>
 #include <vector>
 #include <cstdio>
 
@@ -96,6 +97,35 @@ BOOST_AUTO_TEST_CASE(DifferentSeeds)
     BOOST_CHECK(same < 2 * N);
 }
 
+/* RNGs constructed by a thread with a seed of its own repeat their values */
+BOOST_AUTO_TEST_CASE(ThreadSeeds)
+{
+    auto draw = [](std::uint_fast32_t seed, std::vector<int> &values)
+    {
+        RNG::setThreadSeed(seed);
+        RNG r1, r2;
+        for (int i = 0; i < 10; ++i)
+        {
+            values.push_back(r1.uniformInt(0, 1000000));
+            values.push_back(r2.uniformInt(0, 1000000));
+        }
+        RNG::setThreadSeed(0);
+    };
+
+    std::vector<int> a, b, c, d;
+    std::thread t1([&] { draw(42, a); });
+    std::thread t2([&] { draw(42, b); });
+    std::thread t3([&] { draw(43, c); });
+    t1.join();
+    t2.join();
+    t3.join();
+    draw(42, d);
+
+    BOOST_CHECK(a == b);
+    BOOST_CHECK(a == d);
+    BOOST_CHECK(a != c);
+}
+
 BOOST_AUTO_TEST_CASE(ValidRangeInts)
 {
     RNG r;
@@ -0,0 +1,194 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2024, Rice University
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Rice University nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#define BOOST_TEST_MODULE "Tracer"
+#include <boost/test/unit_test.hpp>
+
+#include "ompl/config.h"
+#include "ompl/util/Tracer.h"
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ompl;
+
+/* Number of times \e pattern occurs in \e text */
+static std::size_t occurrences(const std::string &text, const std::string &pattern)
+{
+    std::size_t n = 0;
+    for (std::size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+        ++n;
+    return n;
+}
+
+static std::string chromeTrace(const Tracer &tracer)
+{
+    std::ostringstream out;
+    tracer.exportChromeTrace(out);
+    return out.str();
+}
+
+static std::string foldedStacks(const Tracer &tracer)
+{
+    std::ostringstream out;
+    tracer.exportFoldedStacks(out);
+    return out.str();
+}
+
+BOOST_AUTO_TEST_CASE(Intern)
+{
+    Tracer::CounterId a = Tracer::Intern("tracer_test_a");
+    Tracer::CounterId b = Tracer::Intern("tracer_test_b");
+    BOOST_CHECK(a != b);
+    BOOST_CHECK_EQUAL(Tracer::Intern("tracer_test_a"), a);
+    BOOST_CHECK_EQUAL(Tracer::GetName(a), "tracer_test_a");
+    BOOST_CHECK_EQUAL(Tracer::GetName(b), "tracer_test_b");
+}
+
+BOOST_AUTO_TEST_CASE(Recording)
+{
+    Tracer tracer;
+    Tracer::CounterId outer = Tracer::Intern("tracer_test_outer");
+    Tracer::CounterId inner = Tracer::Intern("tracer_test_inner");
+    Tracer::CounterId calls = Tracer::Intern("tracer_test_calls");
+
+    // nothing is recorded before start()
+    tracer.begin(outer);
+    tracer.end(outer);
+    tracer.count(calls);
+    BOOST_CHECK_EQUAL(occurrences(chromeTrace(tracer), "\"ph\":"), 0u);
+
+    tracer.start();
+    BOOST_CHECK(tracer.running());
+    {
+        Tracer::ScopedTrace scope(outer, tracer);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        {
+            Tracer::ScopedTrace scope(inner, tracer);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        tracer.count(calls, 3);
+        tracer.count(calls, 4);
+    }
+    tracer.stop();
+    tracer.count(calls);
+
+    std::string trace = chromeTrace(tracer);
+    BOOST_CHECK_EQUAL(occurrences(trace, "\"name\":\"tracer_test_outer\",\"ph\":\"B\""), 1u);
+    BOOST_CHECK_EQUAL(occurrences(trace, "\"name\":\"tracer_test_outer\",\"ph\":\"E\""), 1u);
+    BOOST_CHECK_EQUAL(occurrences(trace, "\"name\":\"tracer_test_inner\",\"ph\":\"B\""), 1u);
+    BOOST_CHECK_EQUAL(occurrences(trace, "\"name\":\"tracer_test_inner\",\"ph\":\"E\""), 1u);
+    // counter tracks hold running totals
+    BOOST_CHECK_EQUAL(occurrences(trace, "\"ph\":\"C\""), 2u);
+    BOOST_CHECK_EQUAL(occurrences(trace, "\"args\":{\"value\":3}"), 1u);
+    BOOST_CHECK_EQUAL(occurrences(trace, "\"args\":{\"value\":7}"), 1u);
+
+    // both scopes last at least 2ms by themselves
+    std::istringstream stacks(foldedStacks(tracer));
+    std::string stack;
+    unsigned long us;
+    unsigned int lines = 0;
+    while (stacks >> stack >> us)
+    {
+        BOOST_CHECK(stack == "tracer_test_outer" || stack == "tracer_test_outer;tracer_test_inner");
+        BOOST_CHECK_GE(us, 2000u);
+        ++lines;
+    }
+    BOOST_CHECK_EQUAL(lines, 2u);
+
+    // the threads are still listed, but without events
+    tracer.clear();
+    BOOST_CHECK_EQUAL(occurrences(chromeTrace(tracer), "tracer_test_"), 0u);
+    BOOST_CHECK(foldedStacks(tracer).empty());
+}
+
+BOOST_AUTO_TEST_CASE(Snapshot)
+{
+    // each thread keeps its last 64 events
+    Tracer tracer(50);
+    Tracer::CounterId work = Tracer::Intern("tracer_test_work");
+    Tracer::CounterId calls = Tracer::Intern("tracer_test_calls");
+    tracer.start();
+
+    const unsigned int numThreads = 4;
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < numThreads; ++t)
+        threads.emplace_back([&tracer, work, calls, t]
+                             {
+                                 for (unsigned int i = 0; i < 10 + 100 * t; ++i)
+                                 {
+                                     Tracer::ScopedTrace scope(work, tracer);
+                                     tracer.count(calls);
+                                 }
+                             });
+    // exporting while the threads record is safe
+    for (int i = 0; i < 10; ++i)
+        chromeTrace(tracer);
+    for (auto &thread : threads)
+        thread.join();
+
+    std::string trace = chromeTrace(tracer);
+    BOOST_CHECK_EQUAL(occurrences(trace, "\"name\":\"thread_name\""), numThreads);
+    // the first thread recorded 30 events, the others overwrote their oldest events
+    std::size_t scopes = occurrences(trace, "\"name\":\"tracer_test_work\",\"ph\":");
+    std::size_t counts = occurrences(trace, "\"ph\":\"C\"");
+    BOOST_CHECK_EQUAL(scopes + counts, 30u + 64u * (numThreads - 1));
+    BOOST_CHECK_EQUAL(counts, 10u + 21u * (numThreads - 1));
+}
+
+BOOST_AUTO_TEST_CASE(Macros)
+{
+    Tracer &tracer = Tracer::Instance();
+    tracer.clear();
+    tracer.start();
+    for (int i = 0; i < 3; ++i)
+    {
+        OMPL_TRACE_SCOPE("tracer_test_macro_scope");
+        OMPL_TRACE_COUNT("tracer_test_macro_count", 2);
+    }
+    tracer.stop();
+
+    std::string trace = chromeTrace(tracer);
+#if OMPL_ENABLE_TRACING
+    BOOST_CHECK_EQUAL(occurrences(trace, "\"name\":\"tracer_test_macro_scope\",\"ph\":\"B\""), 3u);
+    BOOST_CHECK_EQUAL(occurrences(trace, "\"name\":\"tracer_test_macro_count\""), 3u);
+    BOOST_CHECK_EQUAL(occurrences(trace, "\"args\":{\"value\":6}"), 1u);
+#else
+    // the macros are compiled out
+    BOOST_CHECK_EQUAL(occurrences(trace, "tracer_test_macro"), 0u);
+#endif
+    tracer.clear();
+}